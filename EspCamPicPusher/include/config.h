@@ -31,12 +31,88 @@ const int NUM_CAPTURE_TIMES = sizeof(CAPTURE_TIMES) / sizeof(CaptureTime);
 // NTP Update Interval (in milliseconds)
 const unsigned long NTP_UPDATE_INTERVAL = (3600*1000*8); // 8 hours
 
+// Clock check against "server_time" of the upload response: NTP sync on the next wake if off by more
+const long SERVER_TIME_MAX_DRIFT_SEC = 30;
+
 // Web Configuration Server Settings
 const int DEFAULT_WEB_TIMEOUT_MIN = 15;        // Web server active time after boot/activity
 const int MAX_WEB_TIMEOUT_MIN = 240;           // Maximum web timeout (4 hours)
 const int DEFAULT_SLEEP_MARGIN_SEC = 60;      // Wake up N seconds before scheduled capture
 const int MIN_SLEEP_THRESHOLD_SEC = 300;      // Don't sleep if next capture < 5 minutes away
 
+// WiFi Connection Settings
+const unsigned long WIFI_CONNECT_TIMEOUT_MS = 15000;        // Full scan + association + DHCP
+const unsigned long WIFI_FAST_CONNECT_TIMEOUT_MS = 3000;    // Cached BSSID/channel/IP on timer wake
+const long WIFI_FAST_CONNECT_MAX_AGE_SEC = 86400;           // Re-run DHCP at least daily to renew the lease
+
+// Upload pre-connect on timer wake (see startUploadPreconnect): DNS, TCP and TLS overlap the sensor warm-up
+const bool UPLOAD_PRECONNECT_ENABLED = true;
+const uint32_t UPLOAD_PRECONNECT_WAIT_MS = 15000;           // Upload waits this long for an unfinished handshake
+
+// SHA-256 of each uploaded image in X-Content-SHA256 (see ImageDigest): the server refuses a truncated
+// body and answers a re-sent image it already has without storing it twice
+const bool UPLOAD_SHA256_ENABLED = true;
+const int UPLOAD_SHA256_CORE = 0;                           // Hash task runs beside the thumbnail encoder (loop core 1)
+
+// Resumable upload of large images (upload-resumable.php, see "Resumable Upload" in upload.cpp):
+// a broken connection continues from the server's offset, within the wake or from the queue
+const bool UPLOAD_RESUMABLE_ENABLED = true;
+const size_t UPLOAD_RESUMABLE_MIN_BYTES = 256 * 1024;       // Smaller images go in one upload.php request, unless the last was rejected
+const size_t UPLOAD_RESUMABLE_CHUNK_BYTES = 128 * 1024;     // JPEG bytes per PUT request
+const uint32_t UPLOAD_RESUMABLE_ATTEMPTS = 3;               // Connections per image and wake before it is queued
+
+// Store-and-forward Image Queue (LittleFS on the spiffs partition, see ImageQueue)
+const unsigned long QUEUE_DRAIN_BUDGET_MS = 20000;          // Max time spent sending queued images per wake
+const uint32_t QUEUE_DRAIN_MAX_IMAGES = 8;                  // Max queued images sent per wake
+const uint32_t QUEUE_MAX_RETRIES = 10;                      // Drop an entry after this many failed deliveries
+const uint32_t QUEUE_MAX_CHECKSUM_RETRIES = 3;              // Lower limit once an entry is answered 422 (checksum/CRC mismatch)
+const uint32_t QUEUE_BATCH_MAX_IMAGES = 4;                  // Images per upload-batch.php request
+const size_t QUEUE_BATCH_MAX_BYTES = 2 * 1024 * 1024;       // JPEG bytes per batch request (PHP post_max_size)
+
+// Exposure gating of timer-wake uploads (see gateExposure): black or blown-out frames are skipped
+const bool EXPOSURE_GATE_ENABLED = true;
+const float EXPOSURE_GATE_MAX_BYTES_PER_PIXEL = 0.1f;       // Larger JPEGs have too much detail to be black/white, not analyzed
+const uint8_t EXPOSURE_GATE_DARK_LEVEL = 24;                // 8x8 block mean at or below this counts as black
+const uint8_t EXPOSURE_GATE_BRIGHT_LEVEL = 245;             // 8x8 block mean at or above this counts as blown out
+const uint8_t EXPOSURE_GATE_BLOCK_PCT = 98;                 // Skip if this share of blocks is black (or blown out)
+const long EXPOSURE_GATE_KEEPALIVE_SEC = 6L * 3600;         // Upload a gated frame anyway after this long without upload
+
+// Scene change detection of timer-wake uploads (see checkSceneChange): an unchanged scene sends a heartbeat
+const bool SCENE_CHANGE_ENABLED = true;
+const float SCENE_CHANGE_MEAN_DIFF = 2.5f;                  // Unchanged if the mean cell difference (0..255) to the last upload is below this...
+const uint8_t SCENE_CHANGE_CELL_DELTA = 16;                 // ...and no more than SCENE_CHANGE_MAX_CELLS cells differ by more than this
+const uint16_t SCENE_CHANGE_MAX_CELLS = 3;                  // Of 40x30; one cell is 40x40 pixels at UXGA
+const long SCENE_CHANGE_MAX_UNCHANGED_SEC = 3L * 3600;      // Upload the image anyway after this long without one
+
+// Thumbnail uploaded with each live image (see Thumbnail): 1/8 scale, e.g. 200x150 for UXGA
+const bool THUMBNAIL_ENABLED = true;
+const uint8_t THUMBNAIL_JPEG_QUALITY = 80;                  // Software encoder quality 1..100 (higher is better)
+const size_t THUMBNAIL_MAX_BYTES = 32 * 1024;               // Thumbnail is dropped if its JPEG gets larger
+
+// Burst capture (see CameraCapture::captureBurst): defaults of each schedule slot, editable per slot
+const uint8_t BURST_DEFAULT_FRAMES = 3;                     // Frames per capture, the sharpest is uploaded (1 = single frame)
+const uint16_t BURST_DEFAULT_BUDGET_MS = 1000;              // Time budget of a burst
+const uint8_t BURST_MAX_FRAMES = 8;
+const uint16_t BURST_MAX_BUDGET_MS = 5000;
+
+// Adaptive JPEG quality of timer-wake uploads (see AdaptiveQuality): a slot's quality is the best used,
+// raised (coarser) when the measured link cannot carry the frame in ADAPTIVE_QUALITY_SEND_MS
+const bool ADAPTIVE_QUALITY_ENABLED = true;
+const uint32_t ADAPTIVE_QUALITY_SEND_MS = 3000;             // Upload time the byte target aims for
+const uint8_t ADAPTIVE_QUALITY_WORST = 40;                  // Coarsest quality the controller picks
+const uint32_t ADAPTIVE_QUALITY_MIN_BYTES = 24 * 1024;      // Never aim below this
+
+// Sensor warm-up policies of schedule slots (frame and time caps of CameraCapture::warmUpSensor)
+const int WARMUP_QUICK_MAX_FRAMES = 3;                      // "quick": steady scenes captured often
+const unsigned long WARMUP_QUICK_MAX_MS = 500;
+const int WARMUP_NORMAL_MAX_FRAMES = 8;                     // "normal" (default)
+const unsigned long WARMUP_NORMAL_MAX_MS = 1500;
+const int WARMUP_THOROUGH_MAX_FRAMES = 16;                  // "thorough": dawn/dusk, slow AEC
+const unsigned long WARMUP_THOROUGH_MAX_MS = 3000;
+
+// Sensor exposure seeding from RTC memory (see seedSensorExposure)
+const long SENSOR_STATE_MAX_AGE_SEC = 14L * 86400;          // Ignore time-of-day slots older than this
+
 // Camera Configuration for XIAO ESP32S3 Sense
 #define PWDN_GPIO_NUM     -1
 #define RESET_GPIO_NUM    -1
@@ -56,8 +132,27 @@ const int MIN_SLEEP_THRESHOLD_SEC = 300;      // Don't sleep if next capture < 5
 #define HREF_GPIO_NUM     47
 #define PCLK_GPIO_NUM     13
 
-// Camera Settings
+// Camera Settings (defaults of each schedule slot's capture profile, editable per slot)
 #define CAMERA_FRAME_SIZE FRAMESIZE_UXGA  // 1600x1200
 #define CAMERA_JPEG_QUALITY 10            // 0-63, lower means higher quality
+#define CAMERA_MIN_FRAME_SIZE FRAMESIZE_QVGA  // Smallest frame size a slot can select (320x240)
+
+// Region of interest (see captureWindow): cropped by the sensor window, set per device in the web UI
+const uint16_t ROI_SENSOR_WIDTH = 1600;   // ROI coordinates refer to the full UXGA frame
+const uint16_t ROI_SENSOR_HEIGHT = 1200;
+const uint16_t ROI_MIN_SIZE = 64;         // Smallest ROI width/height
+
+// PSRAM frame pool shared by upload, web preview and analysis (see FramePool)
+const uint8_t FRAME_POOL_SLOTS = 3;
+
+// MJPEG live stream (/stream), switched back to the settings above before every capture
+#define STREAM_FRAME_SIZE FRAMESIZE_VGA   // 640x480
+#define STREAM_JPEG_QUALITY 15            // 0-63, lower means higher quality
+const uint8_t STREAM_MAX_FPS = 10;        // Upper limit, /stream?fps=N can only lower it
+
+// Warm camera in config mode (see WarmCamera): previews and manual captures use its newest frame
+const uint32_t WARM_CAMERA_INTERVAL_MS = 500;           // Frame grab period (duty cycle), 0 = disabled
+const int WARM_CAMERA_CORE = 1;                         // Core the grab task is pinned to (loop core, idle in config mode)
+const int WARM_CAMERA_STOP_BEFORE_TIMEOUT_SEC = 30;     // Stop this long before the web timeout ends config mode
 
 #endif // CONFIG_H
@@ -0,0 +1,97 @@
+#include "AdaptiveQuality.h"
+#include <math.h>
+
+#define ADAPTIVE_QUALITY_MAGIC 0x41445154  // "ADQT"
+
+rtc_adaptive_quality_t* AdaptiveQuality::_cache = nullptr;
+
+void AdaptiveQuality::begin(rtc_adaptive_quality_t* cache) {
+    _cache = cache;
+    if (_cache && _cache->magic != ADAPTIVE_QUALITY_MAGIC) {
+        memset(_cache, 0, sizeof(rtc_adaptive_quality_t));
+        _cache->curveB = DEFAULT_CURVE_B;
+        _cache->magic = ADAPTIVE_QUALITY_MAGIC;
+    }
+}
+
+bool AdaptiveQuality::ready() {
+    return _cache && _cache->magic == ADAPTIVE_QUALITY_MAGIC;
+}
+
+uint32_t AdaptiveQuality::targetBytes(uint32_t sendMs, int rssi) {
+    if (!ready() || _cache->throughput <= 0.0f) {
+        return 0;
+    }
+
+    float scale = 1.0f;
+    if (rssi != 0 && _cache->rssi != 0) {
+        scale = powf(2.0f, (rssi - _cache->rssi) / RSSI_HALVING_DB);
+        scale = scale < MIN_RSSI_SCALE ? MIN_RSSI_SCALE : (scale > MAX_RSSI_SCALE ? MAX_RSSI_SCALE : scale);
+    }
+    return (uint32_t)(_cache->throughput * scale * sendMs / 1000.0f);
+}
+
+int AdaptiveQuality::qualityFor(uint32_t bytes, uint32_t pixels, int bestQuality, int worstQuality) {
+    if (!ready() || _cache->lastQuality == 0 || bytes == 0 || pixels == 0) {
+        return -1;
+    }
+
+    // ln(bpp) = A - B * ln(q)  =>  q = exp((A - ln(bpp)) / B), rounded up to stay under the target
+    float logBpp = logf((float)bytes / pixels);
+    float quality = expf((_cache->curveA - logBpp) / _cache->curveB);
+    int q = quality >= worstQuality ? worstQuality : (int)ceilf(quality);
+    return q < bestQuality ? bestQuality : q;
+}
+
+void AdaptiveQuality::recordFrame(int quality, size_t bytes, uint32_t pixels) {
+    if (!ready() || quality < 1 || bytes == 0 || pixels == 0) {
+        return;
+    }
+
+    float logQ = logf((float)quality);
+    float logBpp = logf((float)bytes / pixels);
+
+    // Slope from the previous frame if it was taken at a different quality;
+    // the scene changes between wakes, so each sample only nudges B
+    if (_cache->lastQuality > 0 && _cache->lastQuality != quality) {
+        float slope = (_cache->lastLogBpp - logBpp) / (logQ - logf((float)_cache->lastQuality));
+        slope = slope < MIN_CURVE_B ? MIN_CURVE_B : (slope > MAX_CURVE_B ? MAX_CURVE_B : slope);
+        _cache->curveB += CURVE_B_WEIGHT * (slope - _cache->curveB);
+    }
+
+    // The latest frame is the best estimate of the scene's detail level
+    _cache->curveA = logBpp + _cache->curveB * logQ;
+    _cache->lastQuality = (uint8_t)quality;
+    _cache->lastLogBpp = logBpp;
+}
+
+void AdaptiveQuality::recordUpload(size_t bytes, uint32_t sendMs, int rssi, bool completed) {
+    if (!ready()) {
+        return;
+    }
+
+    if (!completed) {
+        // Multiplicative decrease: the budget was too large for this link
+        float attempted = sendMs > 0 ? (float)bytes * 1000.0f / sendMs : 0.0f;
+        _cache->throughput = _cache->throughput > 0.0f ? _cache->throughput / 2 : attempted / 2;
+        _cache->failedCount++;
+        return;
+    }
+    if (bytes < MIN_SAMPLE_BYTES || sendMs < MIN_SAMPLE_MS) {
+        return;  // Too small to measure the link rather than the socket buffers
+    }
+
+    float sample = (float)bytes * 1000.0f / sendMs;
+    if (_cache->throughput <= 0.0f) {
+        _cache->throughput = sample;
+        _cache->rssi = (int8_t)rssi;
+    } else {
+        _cache->throughput += THROUGHPUT_WEIGHT * (sample - _cache->throughput);
+        _cache->rssi = (int8_t)lroundf(_cache->rssi + THROUGHPUT_WEIGHT * (rssi - _cache->rssi));
+    }
+    _cache->uploadCount++;
+}
+
+float AdaptiveQuality::getThroughput() {
+    return ready() ? _cache->throughput : 0.0f;
+}
@@ -0,0 +1,100 @@
+#ifndef ADAPTIVE_QUALITY_H
+#define ADAPTIVE_QUALITY_H
+
+#include <Arduino.h>
+#include "SleepManager.h"
+
+/**
+ * AdaptiveQuality - JPEG quality from a per-upload byte budget
+ *
+ * Keeps two things in RTC memory across wakes:
+ *
+ * - The upload throughput: body bytes over the send time of each timed
+ *   upload, smoothed, together with the RSSI it was measured at. An upload
+ *   that breaks off after connecting halves it. The byte target of the next
+ *   upload is this throughput times the wanted send time, scaled by the RSSI
+ *   change since (about half the rate per 6 dB).
+ * - The size-vs-quality curve of the scene: ln(bytes per pixel) =
+ *   A - B * ln(quality). The OV2640 quality is its quantizer scale, so size
+ *   falls roughly with 1/quality. Every captured frame re-anchors A (the
+ *   scene's detail level); B is learned slowly from consecutive frames taken
+ *   at different qualities.
+ *
+ * The quality for the target is read off the curve and clamped by the
+ * caller's limits. Until the first upload was measured there is no target
+ * and the caller keeps its configured quality.
+ *
+ * Not thread safe; call from the loop task only.
+ */
+class AdaptiveQuality {
+public:
+    /**
+     * Start using the RTC state (initialized on first use)
+     * @param cache Cache from SleepManager::getAdaptiveQualityCache()
+     */
+    static void begin(rtc_adaptive_quality_t* cache);
+
+    /**
+     * Byte target of the next upload
+     * @param sendMs Upload time to aim for
+     * @param rssi Current RSSI in dBm (0 = unknown, no scaling)
+     * @return Bytes, 0 if no upload was measured yet
+     */
+    static uint32_t targetBytes(uint32_t sendMs, int rssi);
+
+    /**
+     * Quality predicted to produce a JPEG of the given size
+     * @param bytes Target JPEG size
+     * @param pixels Output pixels of the frame
+     * @param bestQuality Lowest quality value allowed (largest files)
+     * @param worstQuality Highest quality value allowed (smallest files)
+     * @return Quality, -1 if no frame was recorded yet
+     */
+    static int qualityFor(uint32_t bytes, uint32_t pixels, int bestQuality, int worstQuality);
+
+    /**
+     * Learn the size curve from a captured frame
+     * @param quality JPEG quality the frame was taken with
+     * @param bytes JPEG size
+     * @param pixels Output pixels of the frame
+     */
+    static void recordFrame(int quality, size_t bytes, uint32_t pixels);
+
+    /**
+     * Learn the throughput from a timed upload
+     * @param bytes Request body size
+     * @param sendMs Time from connected to the last body write
+     * @param rssi RSSI during the upload in dBm
+     * @param completed false if the upload broke off after connecting
+     */
+    static void recordUpload(size_t bytes, uint32_t sendMs, int rssi, bool completed);
+
+    /**
+     * Smoothed upload throughput in bytes/s (0 = no sample yet)
+     */
+    static float getThroughput();
+
+private:
+    static rtc_adaptive_quality_t* _cache;
+
+    static constexpr float DEFAULT_CURVE_B = 1.0f;  // Size ~ 1/quality
+    static constexpr float MIN_CURVE_B = 0.3f;
+    static constexpr float MAX_CURVE_B = 2.0f;
+    static constexpr float CURVE_B_WEIGHT = 0.2f;   // Share of a new slope sample
+    static constexpr float THROUGHPUT_WEIGHT = 0.3f; // Share of a new throughput sample
+    static constexpr float RSSI_HALVING_DB = 6.0f;  // RSSI drop that halves the expected rate
+    static constexpr float MIN_RSSI_SCALE = 0.25f;
+    static constexpr float MAX_RSSI_SCALE = 2.0f;
+    static const uint32_t MIN_SAMPLE_BYTES = 16 * 1024;  // Smaller bodies fit the socket buffers
+    static const uint32_t MIN_SAMPLE_MS = 50;
+
+    static bool ready();
+
+    // Static utility class - no instances
+    AdaptiveQuality() = delete;
+    ~AdaptiveQuality() = delete;
+    AdaptiveQuality(const AdaptiveQuality&) = delete;
+    AdaptiveQuality& operator=(const AdaptiveQuality&) = delete;
+};
+
+#endif // ADAPTIVE_QUALITY_H
@@ -1,34 +1,267 @@
 #include "CameraCapture.h"
 #include "CameraMutex.h"
+#include "JpegDc.h"
 
-void CameraCapture::warmUpSensor(int numFrames, int frameDelay, int settlingDelay) {
+warmup_stats_t CameraCapture::lastWarmUp = {};
+burst_stats_t CameraCapture::lastBurst = {};
+framesize_t CameraCapture::captureFrameSize = FRAMESIZE_INVALID;
+int CameraCapture::captureQuality = -1;
+capture_window_t CameraCapture::captureWindow = {};
+
+namespace {
+
+// What warm-up compares between consecutive frames
+struct WarmUpSample {
+    size_t len;
+    bool haveDc;
+    jpeg_dc_stats_t dc;
+    bool haveExposure;
+    uint16_t aec;
+    uint8_t gain;
+};
+
+// Block luminance histogram of the burst frame being scored (CameraMutex held)
+uint32_t burstHistogram[JPEG_DC_HISTOGRAM_BINS];
+
+} // namespace
+
+bool CameraCapture::readExposure(uint16_t& aec, uint8_t& gain) {
+    sensor_t* s = esp_camera_sensor_get();
+    if (!s || s->id.PID != OV2640_PID || !s->get_reg) {
+        return false;
+    }
+
+    // Sensor bank (1): AEC[15:10] = 0x45[5:0], AEC[9:2] = 0x10, AEC[1:0] = 0x04[1:0], gain = 0x00
+    int high = s->get_reg(s, 0x145, 0x3F);
+    int mid = s->get_reg(s, 0x110, 0xFF);
+    int low = s->get_reg(s, 0x104, 0x03);
+    int agc = s->get_reg(s, 0x100, 0xFF);
+    if (high < 0 || mid < 0 || low < 0 || agc < 0) {
+        return false;
+    }
+    aec = (uint16_t)((high << 10) | (mid << 2) | low);
+    gain = (uint8_t)agc;
+    return true;
+}
+
+bool CameraCapture::setExposure(uint16_t aec, uint8_t gain) {
+    sensor_t* s = esp_camera_sensor_get();
+    if (!s || s->id.PID != OV2640_PID || !s->set_reg) {
+        return false;
+    }
+
+    return s->set_reg(s, 0x145, 0x3F, aec >> 10) == 0 &&
+           s->set_reg(s, 0x110, 0xFF, (aec >> 2) & 0xFF) == 0 &&
+           s->set_reg(s, 0x104, 0x03, aec & 0x03) == 0 &&
+           s->set_reg(s, 0x100, 0xFF, gain) == 0;
+}
+
+bool CameraCapture::applyProfile(framesize_t frameSize, int quality) {
+    sensor_t* s = esp_camera_sensor_get();
+    if (!s || frameSize >= FRAMESIZE_INVALID) {
+        return false;
+    }
+
+    // Only write what differs from the sensor's current state: a quality
+    // change is one JPEG encoder register (and one discarded frame), a frame
+    // size change reprograms the whole DSP window and restarts the auto controls
+    bool resized = s->status.framesize != frameSize;
+    if (s->status.quality != quality) {
+        s->set_quality(s, quality);
+    } else if (!resized) {
+        return false;
+    }
+    if (resized) {
+        // Frame buffers were sized at init, so only sizes up to the init size fit
+        s->set_framesize(s, frameSize);
+    } else {
+        // The frame in flight was encoded with the old quantizer
+        camera_fb_t* stale = esp_camera_fb_get();
+        if (stale) {
+            esp_camera_fb_return(stale);
+        }
+    }
+    Serial.printf("Camera profile: %ux%u, quality %d%s\n",
+                  resolution[frameSize].width, resolution[frameSize].height, quality,
+                  resized ? "" : " (quality only)");
+
+    // set_framesize() resets the DSP window to the full frame
+    if (resized && frameSize == captureFrameSize && captureWindow.width) {
+        applyWindow();
+    }
+    return resized;
+}
+
+bool CameraCapture::applyWindow() {
+    sensor_t* s = esp_camera_sensor_get();
+    if (!s || s->id.PID != OV2640_PID || !s->set_res_raw) {
+        return false;
+    }
+
+    const capture_window_t& w = captureWindow;
+    if (s->set_res_raw(s, OV2640_MODE_UXGA, 0, 0, 0, w.x, w.y, w.width, w.height,
+                       w.width, w.height, false, false) != 0) {
+        Serial.println("ERROR: Setting the sensor window failed");
+        return false;
+    }
+    Serial.printf("Camera window: %ux%u at %u,%u\n", w.width, w.height, w.x, w.y);
+    return true;
+}
+
+bool CameraCapture::setCaptureWindow(const capture_window_t& window) {
+    if (window.width &&
+        (window.width % 16 || window.height % 16 || window.height == 0 ||
+         window.x + window.width > resolution[FRAMESIZE_UXGA].width ||
+         window.y + window.height > resolution[FRAMESIZE_UXGA].height)) {
+        Serial.printf("ERROR: Invalid camera window %ux%u at %u,%u\n",
+                      window.width, window.height, window.x, window.y);
+        return false;
+    }
+
+    sensor_t* s = esp_camera_sensor_get();
+    if (window.width && (!s || s->id.PID != OV2640_PID)) {
+        Serial.println("Camera window needs an OV2640, capturing the full frame");
+        return false;
+    }
+
+    captureWindow = window;
+    if (!window.width) {
+        // Back to the full frame of the capture profile
+        return s && captureFrameSize < FRAMESIZE_INVALID && s->set_framesize(s, captureFrameSize) == 0;
+    }
+    return applyWindow();
+}
+
+framesize_t CameraCapture::coveringFrameSize(uint16_t width, uint16_t height) {
+    framesize_t best = FRAMESIZE_UXGA;
+    uint32_t bestArea = UINT32_MAX;
+    for (int size = 0; size <= FRAMESIZE_UXGA; size++) {
+        const resolution_info_t& r = resolution[size];
+        uint32_t area = (uint32_t)r.width * r.height;
+        if (r.width >= width && r.height >= height && area < bestArea) {
+            best = (framesize_t)size;
+            bestArea = area;
+        }
+    }
+    return best;
+}
+
+bool CameraCapture::setCaptureProfile(framesize_t frameSize, int quality) {
+    bool changed = frameSize != captureFrameSize || quality != captureQuality;
+    captureFrameSize = frameSize;
+    captureQuality = quality;
+    return changed;
+}
+
+framesize_t CameraCapture::getCaptureFrameSize() {
+    return captureFrameSize;
+}
+
+int CameraCapture::getCaptureQuality() {
+    return captureQuality;
+}
+
+uint32_t CameraCapture::getCaptureOutputPixels() {
+    if (captureWindow.width) {
+        return (uint32_t)captureWindow.width * captureWindow.height;
+    }
+    if (captureFrameSize >= FRAMESIZE_INVALID) {
+        return 0;
+    }
+    return (uint32_t)resolution[captureFrameSize].width * resolution[captureFrameSize].height;
+}
+
+bool CameraCapture::restoreCaptureProfile() {
+    return applyProfile(captureFrameSize, captureQuality);
+}
+
+bool CameraCapture::warmUpSensor(int maxFrames, unsigned long maxMs) {
+    restoreCaptureProfile();
     Serial.println("Warming up camera sensor...");
-    
-    // Capture and discard dummy frames to let AWB/AEC/AGC adapt
-    for (int i = 0; i < numFrames; i++) {
+    unsigned long start = millis();
+
+    WarmUpSample prev = {};
+    bool havePrev = false;
+    bool converged = false;
+    int frames = 0;
+
+    // Capture and discard dummy frames until AWB/AEC/AGC stop moving
+    while (frames < maxFrames && millis() - start < maxMs) {
         camera_fb_t* dummy = esp_camera_fb_get();
-        if (dummy) {
-            Serial.printf("  Dummy frame %d discarded (%d bytes)\n", i + 1, dummy->len);
-            esp_camera_fb_return(dummy);
-        } else {
-            Serial.printf("  Warning: Dummy frame %d capture failed\n", i + 1);
+        frames++;
+        if (!dummy) {
+            Serial.printf("  Warning: Dummy frame %d capture failed\n", frames);
+            havePrev = false;
+            continue;
+        }
+
+        WarmUpSample cur = {};
+        cur.len = dummy->len;
+        cur.haveDc = dummy->format == PIXFORMAT_JPEG && JpegDc::analyze(dummy->buf, dummy->len, cur.dc);
+        esp_camera_fb_return(dummy);
+        cur.haveExposure = readExposure(cur.aec, cur.gain);
+
+        Serial.printf("  Dummy frame %d discarded (%d bytes", frames, cur.len);
+        if (cur.haveDc) {
+            Serial.printf(", Y %.1f Cb %.1f Cr %.1f", cur.dc.meanY, cur.dc.meanCb, cur.dc.meanCr);
         }
-        
-        // Delay between frames (skip after last frame)
-        if (i < numFrames - 1) {
-            delay(frameDelay);
+        if (cur.haveExposure) {
+            Serial.printf(", AEC %u gain %u", cur.aec, cur.gain);
         }
+        Serial.println(")");
+
+        if (havePrev) {
+            size_t sizeDelta = cur.len > prev.len ? cur.len - prev.len : prev.len - cur.len;
+            bool stable = sizeDelta * 100 <= prev.len * SIZE_TOLERANCE_PCT;
+            if (cur.haveDc && prev.haveDc) {
+                stable = stable &&
+                         fabsf(cur.dc.meanY - prev.dc.meanY) <= LUMA_TOLERANCE &&
+                         fabsf(cur.dc.meanCb - prev.dc.meanCb) <= CHROMA_TOLERANCE &&
+                         fabsf(cur.dc.meanCr - prev.dc.meanCr) <= CHROMA_TOLERANCE;
+            }
+            if (cur.haveExposure && prev.haveExposure) {
+                int aecDelta = abs((int)cur.aec - (int)prev.aec);
+                int gainDelta = abs((int)cur.gain - (int)prev.gain);
+                stable = stable &&
+                         aecDelta * 100 <= (int)prev.aec * AEC_TOLERANCE_PCT + 100 &&
+                         gainDelta <= GAIN_TOLERANCE;
+            }
+            if (stable && frames >= MIN_WARMUP_FRAMES) {
+                converged = true;
+                prev = cur;
+                break;
+            }
+        }
+        prev = cur;
+        havePrev = true;
     }
-    
-    // Additional settling time for auto-parameters to fully converge
-    if (settlingDelay > 0) {
-        delay(settlingDelay);
+
+    lastWarmUp.frames = (uint8_t)frames;
+    lastWarmUp.durationMs = millis() - start;
+    lastWarmUp.converged = converged;
+    lastWarmUp.meanY = prev.haveDc ? prev.dc.meanY : -1.0f;
+    lastWarmUp.aec = prev.haveExposure ? prev.aec : 0;
+    lastWarmUp.gain = prev.haveExposure ? prev.gain : 0;
+
+    if (converged) {
+        Serial.printf("Sensor adaptation complete (%d frames, %lu ms)\n", frames, lastWarmUp.durationMs);
+    } else {
+        Serial.printf("Sensor adaptation stopped at cap (%d frames, %lu ms)\n", frames, lastWarmUp.durationMs);
     }
-    
-    Serial.println("Sensor adaptation complete");
+    return converged;
+}
+
+const warmup_stats_t& CameraCapture::getLastWarmUp() {
+    return lastWarmUp;
 }
 
 camera_fb_t* CameraCapture::captureFrame(bool withWarmup) {
+    // Coming back from the stream profile the auto controls have to settle
+    // on the larger window again, so warm up even if the caller did not ask
+    if (restoreCaptureProfile() && !withWarmup) {
+        Serial.println("Camera profile changed since warm-up, warming up again");
+        withWarmup = true;
+    }
     if (withWarmup) {
         warmUpSensor();
     }
@@ -45,6 +278,105 @@ camera_fb_t* CameraCapture::captureFrame(bool withWarmup) {
     return fb;
 }
 
+float CameraCapture::scoreFrame(const uint8_t* jpeg, size_t len, float& sharpness, float& clippedPct) {
+    sharpness = 0.0f;
+    clippedPct = 100.0f;
+    jpeg_dc_stats_t stats;
+    if (!JpegDc::analyze(jpeg, len, stats, nullptr, 0, burstHistogram, true)) {
+        return 0.0f;
+    }
+
+    uint32_t blocks = (uint32_t)stats.blocksX * stats.blocksY;
+    uint32_t clipped = 0;
+    for (int level = 0; level <= CLIP_DARK_LEVEL; level++) {
+        clipped += burstHistogram[level];
+    }
+    for (int level = CLIP_BRIGHT_LEVEL; level < JPEG_DC_HISTOGRAM_BINS; level++) {
+        clipped += burstHistogram[level];
+    }
+    clippedPct = blocks ? clipped * 100.0f / blocks : 100.0f;
+    float luma = stats.meanY > MIN_SCORE_LUMA ? stats.meanY : MIN_SCORE_LUMA;
+    sharpness = sqrtf(stats.acEnergy) / luma;
+    return sharpness * (100.0f - clippedPct) / 100.0f;
+}
+
+FrameRef CameraCapture::captureBurst(int maxFrames, unsigned long budgetMs) {
+    memset(&lastBurst, 0, sizeof(lastBurst));
+    restoreCaptureProfile();
+    unsigned long start = millis();
+
+    FrameRef best;
+    int frames = 0;
+    for (int i = 0; i < maxFrames; i++) {
+        // Stop if another frame at the average frame time would overrun the budget
+        unsigned long elapsed = millis() - start;
+        if (i > 0 && elapsed + elapsed / i > budgetMs) {
+            break;
+        }
+
+        camera_fb_t* fb = esp_camera_fb_get();
+        if (!fb) {
+            Serial.printf("  Warning: Burst frame %d capture failed\n", i + 1);
+            continue;
+        }
+        FrameRef frame = FramePool::copy(fb);
+        esp_camera_fb_return(fb);
+        if (!frame) {
+            Serial.println("  Warning: No free frame pool slot, burst stopped");
+            break;
+        }
+
+        float sharpness = 0.0f;
+        float clippedPct = 0.0f;
+        float score = scoreFrame(frame.data(), frame.length(), sharpness, clippedPct);
+        Serial.printf("  Burst frame %d: %u bytes, sharpness %.3f, %.1f%% clipped, score %.3f\n",
+                      i + 1, frame.length(), sharpness, clippedPct, score);
+
+        if (frames == 0 || score < lastBurst.worstScore) {
+            lastBurst.worstScore = score;
+        }
+        if (!best || score > lastBurst.bestScore) {
+            best = std::move(frame);
+            lastBurst.best = (uint8_t)frames;
+            lastBurst.bestScore = score;
+            lastBurst.sharpness = sharpness;
+            lastBurst.clippedPct = clippedPct;
+        }
+        frames++;
+    }
+
+    lastBurst.frames = (uint8_t)frames;
+    lastBurst.durationMs = millis() - start;
+    if (best) {
+        Serial.printf("Burst: kept frame %u of %u (score %.3f, worst %.3f, %lu ms)\n",
+                      lastBurst.best + 1, frames, lastBurst.bestScore, lastBurst.worstScore,
+                      lastBurst.durationMs);
+    } else {
+        Serial.println("ERROR: Burst capture failed");
+    }
+    return best;
+}
+
+const burst_stats_t& CameraCapture::getLastBurst() {
+    return lastBurst;
+}
+
+camera_fb_t* CameraCapture::captureWithProfile(framesize_t frameSize, int quality) {
+    if (applyProfile(frameSize, quality)) {
+        // With fb_count 1 and GRAB_LATEST the buffered frame predates the switch
+        camera_fb_t* stale = esp_camera_fb_get();
+        if (stale) {
+            esp_camera_fb_return(stale);
+        }
+    }
+
+    camera_fb_t* fb = esp_camera_fb_get();
+    if (!fb) {
+        Serial.println("ERROR: Camera capture failed");
+    }
+    return fb;
+}
+
 void CameraCapture::releaseFrame(camera_fb_t* fb) {
     if (fb) {
         esp_camera_fb_return(fb);
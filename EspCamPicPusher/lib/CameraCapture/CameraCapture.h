@@ -3,6 +3,36 @@
 
 #include <Arduino.h>
 #include "esp_camera.h"
+#include "FramePool.h"
+
+// Outcome of the last sensor warm-up (see CameraCapture::warmUpSensor)
+typedef struct {
+    uint8_t frames;                          // Dummy frames captured
+    uint32_t durationMs;                     // Time spent in warm-up
+    bool converged;                          // false = stopped by the frame/time cap
+    float meanY;                             // Mean luminance of the last frame (-1 = not decodable)
+    uint16_t aec;                            // OV2640 exposure of the last frame (0 = not available)
+    uint8_t gain;                            // OV2640 AGC gain of the last frame
+} warmup_stats_t;
+
+// Sensor window of a region-of-interest capture (see CameraCapture::setCaptureWindow)
+typedef struct {
+    uint16_t x;                              // Offset in full-frame (UXGA) sensor pixels
+    uint16_t y;
+    uint16_t width;                          // Window and output size, 0 = full frame
+    uint16_t height;
+} capture_window_t;
+
+// Outcome of the last burst capture (see CameraCapture::captureBurst)
+typedef struct {
+    uint8_t frames;                          // Frames captured and scored
+    uint8_t best;                            // Index of the kept frame (0 = first)
+    uint32_t durationMs;                     // First grab to last score
+    float bestScore;                         // Score of the kept frame
+    float worstScore;                        // Lowest score in the burst
+    float sharpness;                         // Sharpness of the kept frame
+    float clippedPct;                        // Black or blown-out blocks of the kept frame
+} burst_stats_t;
 
 /**
  * CameraCapture - Camera warm-up and capture utilities
@@ -24,18 +54,123 @@
 class CameraCapture {
 public:
     /**
-     * Warm up camera sensor by capturing and discarding dummy frames.
-     * This allows AWB/AEC/AGC to adapt to current light conditions.
+     * Warm up camera sensor by capturing and discarding dummy frames until
+     * AWB/AEC/AGC have settled on the current light conditions.
      * 
-     * Default timing: 3 frames with 200ms delays + 500ms settling = ~900ms total
+     * Frames are taken back to back; warm-up stops as soon as two consecutive
+     * frames agree on JPEG size, mean Y/Cb/Cr (from the DC coefficients, see
+     * JpegDc) and, on the OV2640, the AEC/AGC register readback. In daylight
+     * this takes 2 frames instead of the former fixed ~900ms. Dim scenes keep
+     * going until the frame or time cap is reached.
      * 
      * IMPORTANT: Must be called with CameraMutex already locked!
      * 
-     * @param numFrames Number of dummy frames to capture (default: 3)
-     * @param frameDelay Delay between frames in ms (default: 200)
-     * @param settlingDelay Final settling delay in ms (default: 500)
+     * @param maxFrames Hard cap on dummy frames (default: 8)
+     * @param maxMs Hard cap on warm-up time in ms (default: 1500)
+     * @return true if the auto controls converged before the cap
+     */
+    static bool warmUpSensor(int maxFrames = 8, unsigned long maxMs = 1500);
+
+    /**
+     * Get the outcome of the last warm-up (frames to converge, duration)
+     * for telemetry.
+     * 
+     * @return Stats of the last warmUpSensor() call (zeroed before the first)
+     */
+    static const warmup_stats_t& getLastWarmUp();
+
+    /**
+     * Write OV2640 exposure and gain registers. With AEC/AGC enabled this
+     * only sets the starting point the control loops continue from.
+     * 
+     * IMPORTANT: Must be called with CameraMutex already locked (or before
+     * anything else can use the camera)!
+     * 
+     * @param aec Exposure (AEC[15:0])
+     * @param gain AGC gain register value
+     * @return false if the sensor is not an OV2640 or a write failed
+     */
+    static bool setExposure(uint16_t aec, uint8_t gain);
+
+    /**
+     * Set the frame size and JPEG quality of scheduled/preview captures.
+     * warmUpSensor() and captureFrame() switch the sensor to this profile
+     * if it is on a different one (a live stream, or the profile of another
+     * schedule slot), writing only the settings that differ.
+     * 
+     * @param frameSize Capture frame size, at most the one passed to
+     *                  esp_camera_init (it sized the frame buffers)
+     * @param quality Capture JPEG quality (0-63, lower means higher quality)
+     * @return true if the profile differs from the previous one
+     */
+    static bool setCaptureProfile(framesize_t frameSize, int quality);
+
+    /**
+     * Frame size of scheduled/preview captures (see setCaptureProfile)
+     */
+    static framesize_t getCaptureFrameSize();
+
+    /**
+     * JPEG quality of scheduled/preview captures (see setCaptureProfile)
+     */
+    static int getCaptureQuality();
+
+    /**
+     * Pixels of a capture-profile frame: the capture window if one is set,
+     * else the capture frame size
+     */
+    static uint32_t getCaptureOutputPixels();
+
+    /**
+     * Crop scheduled/preview captures to a region of interest in hardware.
+     * The OV2640 DSP window is set to the region at full resolution (UXGA
+     * sensor mode, no scaling), so the JPEG only covers the region and its
+     * size scales with the region's area. The window is re-applied whenever
+     * the sensor returns to the capture profile (e.g. after a live stream,
+     * which shows the full frame).
+     * 
+     * The capture profile's frame size should be coveringFrameSize() of the
+     * window: it sizes the driver's JPEG buffers.
+     * 
+     * IMPORTANT: Must be called with CameraMutex already locked (or before
+     * anything else can use the camera)!
+     * 
+     * @param window Region in full-frame pixels, width and height multiples
+     *               of 16 inside 1600x1200; width 0 restores the full frame
+     * @return false if the sensor is not an OV2640 or the window was rejected
+     */
+    static bool setCaptureWindow(const capture_window_t& window);
+
+    /**
+     * Smallest frame size (up to UXGA) whose width and height both cover
+     * the given size
      */
-    static void warmUpSensor(int numFrames = 3, int frameDelay = 200, int settlingDelay = 500);
+    static framesize_t coveringFrameSize(uint16_t width, uint16_t height);
+
+    /**
+     * Switch the sensor back to the capture profile.
+     * 
+     * IMPORTANT: Must be called with CameraMutex already locked!
+     * 
+     * @return true if the sensor was on a different frame size (the next
+     *         frame needs the auto controls to settle again); a quality-only
+     *         change returns false
+     */
+    static bool restoreCaptureProfile();
+
+    /**
+     * Capture a single frame with a different frame size and quality, e.g.
+     * for a live stream. The sensor stays on that profile until
+     * restoreCaptureProfile() or the next capture. No warm-up; after a
+     * profile switch one frame is discarded, it still has the old size.
+     * 
+     * IMPORTANT: Must be called with CameraMutex already locked!
+     * 
+     * @param frameSize Frame size for this frame
+     * @param quality JPEG quality for this frame
+     * @return Frame buffer pointer, or nullptr on failure
+     */
+    static camera_fb_t* captureWithProfile(framesize_t frameSize, int quality);
     
     /**
      * Capture a single frame with optional warm-up.
@@ -46,6 +181,40 @@ public:
      * @return Frame buffer pointer, or nullptr on failure
      */
     static camera_fb_t* captureFrame(bool withWarmup = true);
+
+    /**
+     * Capture a burst of frames back to back into the frame pool and keep
+     * the best one. No warm-up; call warmUpSensor() first.
+     * 
+     * Each frame is copied into a FramePool slot and the driver buffer is
+     * returned right away, so the sensor exposes the next frame while this
+     * one is scored. The score comes from one JPEG DC pass (see JpegDc):
+     * sharpness is the RMS luma AC energy relative to the mean luminance
+     * (blur and camera shake remove fine detail; dividing by the luminance
+     * keeps a merely brighter frame from winning), multiplied by the share
+     * of blocks that are neither black nor blown out. Only the best frame
+     * so far and the current one hold a slot, so N is not limited by the
+     * pool size.
+     * 
+     * The burst stops after maxFrames or before the next frame would
+     * exceed budgetMs (at the average frame time so far).
+     * 
+     * IMPORTANT: Must be called with CameraMutex already locked!
+     * 
+     * @param maxFrames Frames to capture (at least one is taken)
+     * @param budgetMs Time budget for the whole burst
+     * @return Best frame, or an empty handle if no frame could be captured
+     *         or no frame pool slot was free
+     */
+    static FrameRef captureBurst(int maxFrames, unsigned long budgetMs);
+
+    /**
+     * Get the outcome of the last burst (frames, kept frame, scores) for
+     * telemetry.
+     * 
+     * @return Stats of the last captureBurst() call (zeroed before the first)
+     */
+    static const burst_stats_t& getLastBurst();
     
     /**
      * Release a previously captured frame buffer.
@@ -64,6 +233,54 @@ public:
     static camera_fb_t* captureWithMutex(int timeoutMs = 5000);
     
 private:
+    static warmup_stats_t lastWarmUp;
+    static burst_stats_t lastBurst;
+    static framesize_t captureFrameSize;
+    static int captureQuality;
+    static capture_window_t captureWindow;
+
+    // esp32-camera's OV2640 set_res_raw() takes the sensor mode as startX
+    static const int OV2640_MODE_UXGA = 0;
+
+    // Convergence thresholds between consecutive warm-up frames
+    static const int MIN_WARMUP_FRAMES = 2;
+    static const int SIZE_TOLERANCE_PCT = 5;        // JPEG size change
+    static constexpr float LUMA_TOLERANCE = 2.0f;   // Mean Y change (AEC/AGC)
+    static constexpr float CHROMA_TOLERANCE = 2.0f; // Mean Cb/Cr change (AWB)
+    static const int AEC_TOLERANCE_PCT = 5;         // Exposure register change
+    static const int GAIN_TOLERANCE = 1;            // Gain register change
+
+    // Burst frame scoring: blocks at or beyond these levels count as clipped
+    static const uint8_t CLIP_DARK_LEVEL = 16;
+    static const uint8_t CLIP_BRIGHT_LEVEL = 250;
+    static constexpr float MIN_SCORE_LUMA = 16.0f;  // Floor of the sharpness divisor (night frames)
+
+    /**
+     * Score a JPEG for burst selection (higher is better)
+     * @param sharpness Receives the RMS AC energy relative to the mean luminance
+     * @param clippedPct Receives the share of black or blown-out blocks
+     * @return Score, 0 if the JPEG could not be decoded
+     */
+    static float scoreFrame(const uint8_t* jpeg, size_t len, float& sharpness, float& clippedPct);
+
+    /**
+     * Read back OV2640 exposure and gain registers
+     * @return false if the sensor is not an OV2640 or the read failed
+     */
+    static bool readExposure(uint16_t& aec, uint8_t& gain);
+
+    /**
+     * Reconfigure frame size and JPEG quality where the sensor is not on them
+     * @return true if the frame size was changed
+     */
+    static bool applyProfile(framesize_t frameSize, int quality);
+
+    /**
+     * Write the capture window to the OV2640 DSP window registers
+     * @return true if the window was set
+     */
+    static bool applyWindow();
+
     // Static utility class - no instances
     CameraCapture() = delete;
     ~CameraCapture() = delete;
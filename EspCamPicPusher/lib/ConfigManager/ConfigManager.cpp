@@ -1,5 +1,6 @@
 #include "ConfigManager.h"
 #include <ArduinoJson.h>
+#include "esp_camera.h"
 
 // Include main configuration with defaults
 #include "../../include/config.h"
@@ -20,6 +21,50 @@
     #define AUTH_TOKEN ""
 #endif
 
+// Names of the schedule slot profile settings in the JSON configuration
+struct ProfileName {
+    const char* name;
+    int value;
+};
+
+static const ProfileName FRAME_SIZE_NAMES[] = {
+    {"QVGA", FRAMESIZE_QVGA}, {"CIF", FRAMESIZE_CIF}, {"HVGA", FRAMESIZE_HVGA},
+    {"VGA", FRAMESIZE_VGA}, {"SVGA", FRAMESIZE_SVGA}, {"XGA", FRAMESIZE_XGA},
+    {"HD", FRAMESIZE_HD}, {"SXGA", FRAMESIZE_SXGA}, {"UXGA", FRAMESIZE_UXGA}
+};
+
+static const ProfileName WARM_UP_NAMES[] = {
+    {"quick", WARMUP_QUICK}, {"normal", WARMUP_NORMAL}, {"thorough", WARMUP_THOROUGH}
+};
+
+static const ProfileName PRIORITY_NAMES[] = {
+    {"low", PRIORITY_LOW}, {"normal", PRIORITY_NORMAL}, {"high", PRIORITY_HIGH}
+};
+
+template <size_t N>
+static const char* profileName(const ProfileName (&names)[N], int value) {
+    for (const ProfileName& entry : names) {
+        if (entry.value == value) {
+            return entry.name;
+        }
+    }
+    return "";
+}
+
+// -1 for unknown names (keeps the default)
+template <size_t N>
+static int profileValue(const ProfileName (&names)[N], const char* name) {
+    if (!name) {
+        return -1;
+    }
+    for (const ProfileName& entry : names) {
+        if (strcmp(entry.name, name) == 0) {
+            return entry.value;
+        }
+    }
+    return -1;
+}
+
 ConfigManager::ConfigManager() {
     loadDefaults();
 }
@@ -68,6 +113,12 @@ void ConfigManager::loadDefaults() {
     for (int i = 0; i < config.numCaptureTimes; i++) {
         config.captureTimes[i].hour = CAPTURE_TIMES[i].hour;
         config.captureTimes[i].minute = CAPTURE_TIMES[i].minute;
+        config.captureTimes[i].burstFrames = BURST_DEFAULT_FRAMES;
+        config.captureTimes[i].burstBudgetMs = BURST_DEFAULT_BUDGET_MS;
+        config.captureTimes[i].frameSize = CAMERA_FRAME_SIZE;
+        config.captureTimes[i].jpegQuality = CAMERA_JPEG_QUALITY;
+        config.captureTimes[i].warmUp = WARMUP_NORMAL;
+        config.captureTimes[i].priority = PRIORITY_NORMAL;
     }
     
     // Power management defaults
@@ -81,6 +132,12 @@ void ConfigManager::loadDefaults() {
     // Hostname default: empty = auto-generate from MAC at runtime
     config.hostname[0] = '\0';
     
+    // Region of interest default: full frame
+    config.roiX = 0;
+    config.roiY = 0;
+    config.roiWidth = 0;
+    config.roiHeight = 0;
+    
     config.isValid = true;
 }
 
@@ -111,12 +168,25 @@ bool ConfigManager::load() {
     
     // Load schedule
     for (int i = 0; i < config.numCaptureTimes; i++) {
-        char hourKey[16], minKey[16];
+        char hourKey[16], minKey[16], burstKey[16], budgetKey[16];
+        char sizeKey[16], qualityKey[16], warmKey[16], prioKey[16];
         snprintf(hourKey, sizeof(hourKey), "hour_%d", i);
         snprintf(minKey, sizeof(minKey), "min_%d", i);
+        snprintf(burstKey, sizeof(burstKey), "burst_%d", i);
+        snprintf(budgetKey, sizeof(budgetKey), "burstms_%d", i);
+        snprintf(sizeKey, sizeof(sizeKey), "fsize_%d", i);
+        snprintf(qualityKey, sizeof(qualityKey), "qual_%d", i);
+        snprintf(warmKey, sizeof(warmKey), "warm_%d", i);
+        snprintf(prioKey, sizeof(prioKey), "prio_%d", i);
         
         config.captureTimes[i].hour = prefs.getInt(hourKey, 0);
         config.captureTimes[i].minute = prefs.getInt(minKey, 0);
+        config.captureTimes[i].burstFrames = prefs.getInt(burstKey, BURST_DEFAULT_FRAMES);
+        config.captureTimes[i].burstBudgetMs = prefs.getInt(budgetKey, BURST_DEFAULT_BUDGET_MS);
+        config.captureTimes[i].frameSize = prefs.getInt(sizeKey, CAMERA_FRAME_SIZE);
+        config.captureTimes[i].jpegQuality = prefs.getInt(qualityKey, CAMERA_JPEG_QUALITY);
+        config.captureTimes[i].warmUp = prefs.getInt(warmKey, WARMUP_NORMAL);
+        config.captureTimes[i].priority = prefs.getInt(prioKey, PRIORITY_NORMAL);
     }
     
     config.webTimeoutMin = prefs.getInt("webTimeout", DEFAULT_WEB_TIMEOUT_MIN);
@@ -129,6 +199,12 @@ bool ConfigManager::load() {
     // Load network identity
     prefs.getString("hostname", config.hostname, MAX_HOSTNAME_LENGTH);
     
+    // Load region of interest
+    config.roiX = prefs.getInt("roiX", 0);
+    config.roiY = prefs.getInt("roiY", 0);
+    config.roiWidth = prefs.getInt("roiW", 0);
+    config.roiHeight = prefs.getInt("roiH", 0);
+    
     // Validate loaded configuration
     if (!validateConfig()) {
         Serial.println("Loaded config validation failed");
@@ -158,12 +234,25 @@ bool ConfigManager::save() {
     
     // Save schedule
     for (int i = 0; i < config.numCaptureTimes; i++) {
-        char hourKey[16], minKey[16];
+        char hourKey[16], minKey[16], burstKey[16], budgetKey[16];
+        char sizeKey[16], qualityKey[16], warmKey[16], prioKey[16];
         snprintf(hourKey, sizeof(hourKey), "hour_%d", i);
         snprintf(minKey, sizeof(minKey), "min_%d", i);
+        snprintf(burstKey, sizeof(burstKey), "burst_%d", i);
+        snprintf(budgetKey, sizeof(budgetKey), "burstms_%d", i);
+        snprintf(sizeKey, sizeof(sizeKey), "fsize_%d", i);
+        snprintf(qualityKey, sizeof(qualityKey), "qual_%d", i);
+        snprintf(warmKey, sizeof(warmKey), "warm_%d", i);
+        snprintf(prioKey, sizeof(prioKey), "prio_%d", i);
         
         prefs.putInt(hourKey, config.captureTimes[i].hour);
         prefs.putInt(minKey, config.captureTimes[i].minute);
+        prefs.putInt(burstKey, config.captureTimes[i].burstFrames);
+        prefs.putInt(budgetKey, config.captureTimes[i].burstBudgetMs);
+        prefs.putInt(sizeKey, config.captureTimes[i].frameSize);
+        prefs.putInt(qualityKey, config.captureTimes[i].jpegQuality);
+        prefs.putInt(warmKey, config.captureTimes[i].warmUp);
+        prefs.putInt(prioKey, config.captureTimes[i].priority);
     }
     
     prefs.putInt("webTimeout", config.webTimeoutMin);
@@ -176,6 +265,12 @@ bool ConfigManager::save() {
     // Save network identity
     prefs.putString("hostname", config.hostname);
     
+    // Save region of interest
+    prefs.putInt("roiX", config.roiX);
+    prefs.putInt("roiY", config.roiY);
+    prefs.putInt("roiW", config.roiWidth);
+    prefs.putInt("roiH", config.roiHeight);
+    
     Serial.println("Configuration saved to NVS");
     return true;
 }
@@ -228,6 +323,13 @@ bool ConfigManager::validateConfig() {
         return false;
     }
     
+    // Validate region of interest
+    if (!validateRoi(config.roiX, config.roiY, config.roiWidth, config.roiHeight)) {
+        Serial.printf("Validation failed: Invalid region of interest %dx%d+%d+%d\n",
+                      config.roiWidth, config.roiHeight, config.roiX, config.roiY);
+        return false;
+    }
+    
     config.isValid = true;
     return true;
 }
@@ -247,11 +349,42 @@ bool ConfigManager::validateSchedule() {
             Serial.printf("Validation failed: Invalid minute at index %d: %d\n", i, config.captureTimes[i].minute);
             return false;
         }
+        if (config.captureTimes[i].burstFrames < 1 || config.captureTimes[i].burstFrames > BURST_MAX_FRAMES) {
+            Serial.printf("Validation failed: Invalid burst frames at index %d: %d\n", i, config.captureTimes[i].burstFrames);
+            return false;
+        }
+        if (config.captureTimes[i].burstBudgetMs < 0 || config.captureTimes[i].burstBudgetMs > BURST_MAX_BUDGET_MS) {
+            Serial.printf("Validation failed: Invalid burst budget at index %d: %d\n", i, config.captureTimes[i].burstBudgetMs);
+            return false;
+        }
+        if (!validateProfile(config.captureTimes[i].frameSize, config.captureTimes[i].jpegQuality,
+                             config.captureTimes[i].warmUp, config.captureTimes[i].priority)) {
+            Serial.printf("Validation failed: Invalid capture profile at index %d\n", i);
+            return false;
+        }
     }
     
     return true;
 }
 
+bool ConfigManager::validateProfile(int frameSize, int jpegQuality, int warmUp, int priority) {
+    return frameSize >= CAMERA_MIN_FRAME_SIZE && frameSize <= FRAMESIZE_UXGA &&
+           jpegQuality >= 0 && jpegQuality <= 63 &&
+           warmUp >= WARMUP_QUICK && warmUp <= WARMUP_THOROUGH &&
+           priority >= PRIORITY_LOW && priority <= PRIORITY_HIGH;
+}
+
+bool ConfigManager::validateRoi(int x, int y, int width, int height) {
+    // Width 0 = full frame, the other fields are ignored
+    if (width == 0) {
+        return true;
+    }
+    
+    return x >= 0 && y >= 0 &&
+           width >= ROI_MIN_SIZE && height >= ROI_MIN_SIZE &&
+           x + width <= ROI_SENSOR_WIDTH && y + height <= ROI_SENSOR_HEIGHT;
+}
+
 void ConfigManager::setWifiSsid(const char* ssid) {
     strncpy(config.wifiSsid, ssid, MAX_SSID_LENGTH - 1);
     config.wifiSsid[MAX_SSID_LENGTH - 1] = '\0';
@@ -293,11 +426,25 @@ void ConfigManager::setHostname(const char* name) {
     config.hostname[MAX_HOSTNAME_LENGTH - 1] = '\0';
 }
 
+bool ConfigManager::setRoi(int x, int y, int width, int height) {
+    if (!validateRoi(x, y, width, height)) {
+        Serial.println("Cannot set region of interest: outside the sensor frame or too small");
+        return false;
+    }
+    
+    config.roiX = width ? x : 0;
+    config.roiY = width ? y : 0;
+    config.roiWidth = width;
+    config.roiHeight = width ? height : 0;
+    
+    return true;
+}
+
 void ConfigManager::clearSchedule() {
     config.numCaptureTimes = 0;
 }
 
-bool ConfigManager::addCaptureTime(int hour, int minute) {
+bool ConfigManager::addCaptureTime(int hour, int minute, int burstFrames, int burstBudgetMs) {
     if (config.numCaptureTimes >= MAX_CAPTURE_TIMES) {
         Serial.println("Cannot add capture time: schedule full");
         return false;
@@ -310,8 +457,16 @@ bool ConfigManager::addCaptureTime(int hour, int minute) {
     
     config.captureTimes[config.numCaptureTimes].hour = hour;
     config.captureTimes[config.numCaptureTimes].minute = minute;
+    config.captureTimes[config.numCaptureTimes].burstFrames = BURST_DEFAULT_FRAMES;
+    config.captureTimes[config.numCaptureTimes].burstBudgetMs = BURST_DEFAULT_BUDGET_MS;
+    config.captureTimes[config.numCaptureTimes].frameSize = CAMERA_FRAME_SIZE;
+    config.captureTimes[config.numCaptureTimes].jpegQuality = CAMERA_JPEG_QUALITY;
+    config.captureTimes[config.numCaptureTimes].warmUp = WARMUP_NORMAL;
+    config.captureTimes[config.numCaptureTimes].priority = PRIORITY_NORMAL;
     config.numCaptureTimes++;
     
+    // Out-of-range burst settings keep the defaults
+    setCaptureBurst(config.numCaptureTimes - 1, burstFrames, burstBudgetMs);
     return true;
 }
 
@@ -330,8 +485,70 @@ bool ConfigManager::setCaptureTime(int index, int hour, int minute) {
     return true;
 }
 
+bool ConfigManager::setCaptureBurst(int index, int burstFrames, int burstBudgetMs) {
+    if (index < 0 || index >= config.numCaptureTimes) {
+        return false;
+    }
+    
+    if (burstFrames < 1 || burstFrames > BURST_MAX_FRAMES ||
+        burstBudgetMs < 0 || burstBudgetMs > BURST_MAX_BUDGET_MS) {
+        return false;
+    }
+    
+    config.captureTimes[index].burstFrames = burstFrames;
+    config.captureTimes[index].burstBudgetMs = burstBudgetMs;
+    
+    return true;
+}
+
+bool ConfigManager::setCaptureProfile(int index, int frameSize, int jpegQuality, int warmUp, int priority) {
+    if (index < 0 || index >= config.numCaptureTimes) {
+        return false;
+    }
+    
+    if (!validateProfile(frameSize, jpegQuality, warmUp, priority)) {
+        return false;
+    }
+    
+    config.captureTimes[index].frameSize = frameSize;
+    config.captureTimes[index].jpegQuality = jpegQuality;
+    config.captureTimes[index].warmUp = warmUp;
+    config.captureTimes[index].priority = priority;
+    
+    return true;
+}
+
+int ConfigManager::getMaxCaptureFrameSize() {
+    int frameSize = CAMERA_FRAME_SIZE;
+    for (int i = 0; i < config.numCaptureTimes; i++) {
+        if (config.captureTimes[i].frameSize > frameSize) {
+            frameSize = config.captureTimes[i].frameSize;
+        }
+    }
+    return frameSize;
+}
+
+int ConfigManager::findCaptureSlot(int hour, int minute) {
+    // Timer wakes come sleepMarginSec early and captures may run a bit late,
+    // so take the slot closest to the given time (across midnight)
+    int slot = -1;
+    int bestDistance = 24 * 60;
+    for (int i = 0; i < config.numCaptureTimes; i++) {
+        int distance = abs((config.captureTimes[i].hour * 60 + config.captureTimes[i].minute) - (hour * 60 + minute));
+        if (distance > 12 * 60) {
+            distance = 24 * 60 - distance;
+        }
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            slot = i;
+        }
+    }
+    
+    return slot;
+}
+
 bool ConfigManager::loadFromJson(const char* jsonStr) {
-    StaticJsonDocument<2048> doc;
+    DynamicJsonDocument doc(CONFIG_JSON_CAPACITY);
     DeserializationError error = deserializeJson(doc, jsonStr);
     
     if (error) {
@@ -379,7 +596,20 @@ bool ConfigManager::loadFromJson(const char* jsonStr) {
         for (JsonObject item : schedule) {
             int hour = item["hour"];
             int minute = item["minute"];
-            addCaptureTime(hour, minute);
+            if (!addCaptureTime(hour, minute, item["burstFrames"] | -1, item["burstBudgetMs"] | -1)) {
+                continue;
+            }
+            
+            // Missing or unknown profile settings keep the defaults
+            int index = config.numCaptureTimes - 1;
+            int frameSize = profileValue(FRAME_SIZE_NAMES, item["frameSize"] | (const char*)nullptr);
+            int warmUp = profileValue(WARM_UP_NAMES, item["warmUp"] | (const char*)nullptr);
+            int priority = profileValue(PRIORITY_NAMES, item["priority"] | (const char*)nullptr);
+            setCaptureProfile(index,
+                              frameSize >= 0 ? frameSize : config.captureTimes[index].frameSize,
+                              item["quality"] | config.captureTimes[index].jpegQuality,
+                              warmUp >= 0 ? warmUp : config.captureTimes[index].warmUp,
+                              priority >= 0 ? priority : config.captureTimes[index].priority);
         }
     }
     
@@ -411,11 +641,19 @@ bool ConfigManager::loadFromJson(const char* jsonStr) {
         setHostname(doc["hostname"]);
     }
     
+    // Load region of interest (width 0 = full frame)
+    if (doc.containsKey("roi")) {
+        JsonObject roi = doc["roi"].as<JsonObject>();
+        if (!setRoi(roi["x"] | 0, roi["y"] | 0, roi["width"] | 0, roi["height"] | 0)) {
+            return false;
+        }
+    }
+    
     return validateConfig();
 }
 
 String ConfigManager::toJson() {
-    StaticJsonDocument<2048> doc;
+    DynamicJsonDocument doc(CONFIG_JSON_CAPACITY);
     
     doc["wifiSsid"] = config.wifiSsid;
     // Don't include password in JSON export for security
@@ -433,6 +671,12 @@ String ConfigManager::toJson() {
         JsonObject item = schedule.createNestedObject();
         item["hour"] = config.captureTimes[i].hour;
         item["minute"] = config.captureTimes[i].minute;
+        item["burstFrames"] = config.captureTimes[i].burstFrames;
+        item["burstBudgetMs"] = config.captureTimes[i].burstBudgetMs;
+        item["frameSize"] = profileName(FRAME_SIZE_NAMES, config.captureTimes[i].frameSize);
+        item["quality"] = config.captureTimes[i].jpegQuality;
+        item["warmUp"] = profileName(WARM_UP_NAMES, config.captureTimes[i].warmUp);
+        item["priority"] = profileName(PRIORITY_NAMES, config.captureTimes[i].priority);
     }
     
     doc["webTimeoutMin"] = config.webTimeoutMin;
@@ -444,6 +688,12 @@ String ConfigManager::toJson() {
     
     doc["hostname"] = config.hostname;
     
+    JsonObject roi = doc.createNestedObject("roi");
+    roi["x"] = config.roiX;
+    roi["y"] = config.roiY;
+    roi["width"] = config.roiWidth;
+    roi["height"] = config.roiHeight;
+    
     String output;
     serializeJson(doc, output);
     return output;
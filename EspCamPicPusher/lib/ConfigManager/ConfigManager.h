@@ -13,6 +13,23 @@
 #define MAX_USERNAME_LENGTH 32
 #define MAX_HOSTNAME_LENGTH 32
 
+// JSON document size of the configuration (full schedule with capture profiles)
+#define CONFIG_JSON_CAPACITY 8192
+
+// Sensor warm-up of a schedule slot (frame/time caps in config.h)
+enum WarmUpPolicy {
+    WARMUP_QUICK = 0,       // Few frames, for frequent captures of a steady scene
+    WARMUP_NORMAL = 1,      // Default caps of CameraCapture::warmUpSensor
+    WARMUP_THOROUGH = 2     // More time for dim scenes
+};
+
+// What a schedule slot's image is worth when uploads are gated or fail
+enum UploadPriority {
+    PRIORITY_LOW = 0,       // Gated, dropped if the upload fails
+    PRIORITY_NORMAL = 1,    // Gated, queued if the upload fails
+    PRIORITY_HIGH = 2       // Never gated, queued if the upload fails
+};
+
 // Configuration structure
 struct AppConfig {
     // WiFi settings
@@ -32,6 +49,12 @@ struct AppConfig {
     struct {
         int hour;
         int minute;
+        int burstFrames;        // Frames captured, the best one is uploaded
+        int burstBudgetMs;      // Time budget of the burst
+        int frameSize;          // Sensor frame size (framesize_t)
+        int jpegQuality;        // JPEG quality (0-63, lower means higher quality)
+        int warmUp;             // WarmUpPolicy
+        int priority;           // UploadPriority
     } captureTimes[MAX_CAPTURE_TIMES];
     
     // Power management
@@ -45,6 +68,12 @@ struct AppConfig {
     // Network identity
     char hostname[MAX_HOSTNAME_LENGTH];
     
+    // Region of interest in full-frame sensor pixels (roiWidth 0 = full frame)
+    int roiX;
+    int roiY;
+    int roiWidth;
+    int roiHeight;
+    
     // Validation flag
     bool isValid;
 };
@@ -79,11 +108,21 @@ public:
     int getNumCaptureTimes() { return config.numCaptureTimes; }
     int getCaptureHour(int index) { return config.captureTimes[index].hour; }
     int getCaptureMinute(int index) { return config.captureTimes[index].minute; }
+    int getBurstFrames(int index) { return config.captureTimes[index].burstFrames; }
+    int getBurstBudgetMs(int index) { return config.captureTimes[index].burstBudgetMs; }
+    int getCaptureFrameSize(int index) { return config.captureTimes[index].frameSize; }
+    int getCaptureQuality(int index) { return config.captureTimes[index].jpegQuality; }
+    WarmUpPolicy getWarmUpPolicy(int index) { return (WarmUpPolicy)config.captureTimes[index].warmUp; }
+    UploadPriority getUploadPriority(int index) { return (UploadPriority)config.captureTimes[index].priority; }
     int getWebTimeoutMin() { return config.webTimeoutMin; }
     int getSleepMarginSec() { return config.sleepMarginSec; }
     const char* getWebUsername() { return config.webUsername; }
     const char* getWebPassword() { return config.webPassword; }
     const char* getHostname() { return config.hostname; }
+    int getRoiX() { return config.roiX; }
+    int getRoiY() { return config.roiY; }
+    int getRoiWidth() { return config.roiWidth; }
+    int getRoiHeight() { return config.roiHeight; }
     
     // Get entire config structure
     AppConfig& getConfig() { return config; }
@@ -100,11 +139,20 @@ public:
     void setWebUsername(const char* username);
     void setWebPassword(const char* password);
     void setHostname(const char* name);
+    bool setRoi(int x, int y, int width, int height);
     
     // Schedule management
     void clearSchedule();
-    bool addCaptureTime(int hour, int minute);
+    bool addCaptureTime(int hour, int minute, int burstFrames = -1, int burstBudgetMs = -1);
     bool setCaptureTime(int index, int hour, int minute);
+    bool setCaptureBurst(int index, int burstFrames, int burstBudgetMs);
+    bool setCaptureProfile(int index, int frameSize, int jpegQuality, int warmUp, int priority);
+    
+    // Largest frame size of all schedule slots (sizes the camera buffers)
+    int getMaxCaptureFrameSize();
+    
+    // Schedule slot a capture at this time belongs to (nearest slot), -1 if none
+    int findCaptureSlot(int hour, int minute);
     
     // Configuration from JSON
     bool loadFromJson(const char* jsonStr);
@@ -117,6 +165,8 @@ private:
     void loadDefaults();
     bool validateConfig();
     bool validateSchedule();
+    bool validateRoi(int x, int y, int width, int height);
+    bool validateProfile(int frameSize, int jpegQuality, int warmUp, int priority);
 };
 
 #endif // CONFIG_MANAGER_H
@@ -0,0 +1,132 @@
+#include "FramePool.h"
+
+FramePool::Slot FramePool::_slots[FramePool::MAX_SLOTS];
+uint8_t FramePool::_slotCount = 0;
+size_t FramePool::_slotBytes = 0;
+
+// ============================================================================
+// FrameRef
+// ============================================================================
+
+FrameRef::FrameRef(const FrameRef& other) : _slot(other._slot) {
+    if (_slot >= 0) {
+        FramePool::retain(_slot);
+    }
+}
+
+FrameRef::FrameRef(FrameRef&& other) noexcept : _slot(other._slot) {
+    other._slot = -1;
+}
+
+FrameRef& FrameRef::operator=(const FrameRef& other) {
+    if (this != &other) {
+        if (other._slot >= 0) {
+            FramePool::retain(other._slot);
+        }
+        reset();
+        _slot = other._slot;
+    }
+    return *this;
+}
+
+FrameRef& FrameRef::operator=(FrameRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        _slot = other._slot;
+        other._slot = -1;
+    }
+    return *this;
+}
+
+void FrameRef::reset() {
+    if (_slot >= 0) {
+        FramePool::release(_slot);
+        _slot = -1;
+    }
+}
+
+const uint8_t* FrameRef::data() const {
+    return _slot >= 0 ? FramePool::_slots[_slot].buf : nullptr;
+}
+
+size_t FrameRef::length() const {
+    return _slot >= 0 ? FramePool::_slots[_slot].len : 0;
+}
+
+uint16_t FrameRef::width() const {
+    return _slot >= 0 ? FramePool::_slots[_slot].width : 0;
+}
+
+uint16_t FrameRef::height() const {
+    return _slot >= 0 ? FramePool::_slots[_slot].height : 0;
+}
+
+struct timeval FrameRef::timestamp() const {
+    struct timeval none = {};
+    return _slot >= 0 ? FramePool::_slots[_slot].timestamp : none;
+}
+
+// ============================================================================
+// FramePool
+// ============================================================================
+
+void FramePool::begin(uint8_t slotCount, size_t slotBytes) {
+    _slotCount = slotCount > MAX_SLOTS ? MAX_SLOTS : slotCount;
+    _slotBytes = slotBytes;
+    Serial.printf("Frame pool: %u slots of %u KB (PSRAM, allocated on first use)\n",
+                  _slotCount, (unsigned)(_slotBytes / 1024));
+}
+
+FrameRef FramePool::copy(const camera_fb_t* fb) {
+    if (!fb || !fb->buf || fb->len == 0) {
+        return FrameRef();
+    }
+
+    for (uint8_t i = 0; i < _slotCount; i++) {
+        Slot& slot = _slots[i];
+        int expected = 0;
+        if (!slot.refs.compare_exchange_strong(expected, 1)) {
+            continue;  // In use
+        }
+
+        // Slot is ours: (re)allocate if needed and copy
+        if (slot.capacity < fb->len) {
+            free(slot.buf);
+            slot.capacity = fb->len > _slotBytes ? fb->len : _slotBytes;
+            slot.buf = (uint8_t*)ps_malloc(slot.capacity);
+            if (!slot.buf) {
+                Serial.printf("ERROR: Frame pool slot allocation failed (%u bytes)\n", (unsigned)slot.capacity);
+                slot.capacity = 0;
+                slot.refs.store(0);
+                return FrameRef();
+            }
+        }
+        memcpy(slot.buf, fb->buf, fb->len);
+        slot.len = fb->len;
+        slot.width = (uint16_t)fb->width;
+        slot.height = (uint16_t)fb->height;
+        slot.timestamp = fb->timestamp;
+        return FrameRef((int8_t)i);
+    }
+
+    Serial.println("WARNING: Frame pool exhausted");
+    return FrameRef();
+}
+
+uint8_t FramePool::freeSlots() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < _slotCount; i++) {
+        if (_slots[i].refs.load() == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void FramePool::retain(int8_t slot) {
+    _slots[slot].refs.fetch_add(1);
+}
+
+void FramePool::release(int8_t slot) {
+    _slots[slot].refs.fetch_sub(1);
+}
@@ -0,0 +1,121 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "esp_camera.h"
+
+/**
+ * FrameRef - Refcounted handle to a JPEG in a FramePool slot
+ * 
+ * Copyable: every copy holds a reference, the slot is reused once the last
+ * copy is destroyed or reset(). Capture one in a lambda (e.g. an
+ * AsyncWebServer chunked response filler) to keep the frame alive exactly as
+ * long as the response. Frame data is read-only.
+ */
+class FrameRef {
+public:
+    FrameRef() : _slot(-1) {}
+    FrameRef(const FrameRef& other);
+    FrameRef(FrameRef&& other) noexcept;
+    FrameRef& operator=(const FrameRef& other);
+    FrameRef& operator=(FrameRef&& other) noexcept;
+    ~FrameRef() { reset(); }
+
+    /**
+     * Drop this reference
+     */
+    void reset();
+
+    explicit operator bool() const { return _slot >= 0; }
+
+    const uint8_t* data() const;
+    size_t length() const;
+    uint16_t width() const;
+    uint16_t height() const;
+
+    /**
+     * Capture time from the driver (esp_timer based)
+     */
+    struct timeval timestamp() const;
+
+private:
+    friend class FramePool;
+    explicit FrameRef(int8_t slot) : _slot(slot) {}
+
+    int8_t _slot;
+};
+
+/**
+ * FramePool - Fixed set of PSRAM frame slots shared by preview, upload and analysis
+ * 
+ * A captured frame is copied once out of the camera driver buffer into a
+ * free slot, so the driver buffer and CameraMutex can be released right
+ * away. Consumers then share the slot zero-copy through FrameRef handles:
+ * a scheduled capture can proceed while a preview is still streaming, and
+ * JPEGs never land on the internal heap.
+ * 
+ * Slot buffers are allocated in PSRAM on first use and kept for reuse
+ * (grown if a frame does not fit). acquire()/release are lock-free and may
+ * be called from any task.
+ * 
+ * Usage Pattern:
+ *   CameraMutex::lock(5000);
+ *   camera_fb_t* fb = CameraCapture::captureFrame();
+ *   FrameRef frame = FramePool::copy(fb);
+ *   CameraCapture::releaseFrame(fb);
+ *   CameraMutex::unlock();
+ *   // ... use frame.data() / frame.length() ...
+ */
+class FramePool {
+public:
+    /**
+     * Configure the pool (no allocation yet)
+     * @param slotCount Number of slots, at most MAX_SLOTS
+     * @param slotBytes Initial capacity of a slot (the driver's JPEG buffer size)
+     */
+    static void begin(uint8_t slotCount, size_t slotBytes);
+
+    /**
+     * Copy a frame into a free slot
+     * @param fb Driver frame buffer (still owned by the caller)
+     * @return Handle to the copy, or an empty handle if all slots are in use
+     *         or PSRAM is exhausted
+     */
+    static FrameRef copy(const camera_fb_t* fb);
+
+    /**
+     * Number of slots not referenced by any FrameRef
+     */
+    static uint8_t freeSlots();
+
+    static const uint8_t MAX_SLOTS = 4;
+
+private:
+    friend class FrameRef;
+
+    struct Slot {
+        std::atomic<int> refs;
+        uint8_t* buf;
+        size_t capacity;
+        size_t len;
+        uint16_t width;
+        uint16_t height;
+        struct timeval timestamp;
+    };
+
+    static Slot _slots[MAX_SLOTS];
+    static uint8_t _slotCount;
+    static size_t _slotBytes;
+
+    static void retain(int8_t slot);
+    static void release(int8_t slot);
+
+    // Static utility class - no instances
+    FramePool() = delete;
+    ~FramePool() = delete;
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+};
+
+#endif // FRAME_POOL_H
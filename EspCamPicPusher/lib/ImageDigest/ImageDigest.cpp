@@ -0,0 +1,69 @@
+#include "ImageDigest.h"
+#include "mbedtls/sha256.h"
+
+ImageDigest::ImageDigest()
+    : _data(nullptr),
+      _length(0),
+      _hashMs(0),
+      _done(nullptr),
+      _valid(false) {
+    memset(_digest, 0, sizeof(_digest));
+}
+
+ImageDigest::~ImageDigest() {
+    get();
+}
+
+void ImageDigest::compute(const uint8_t* data, size_t length, uint8_t digest[SIZE]) {
+    mbedtls_sha256_context sha256;
+    mbedtls_sha256_init(&sha256);
+    mbedtls_sha256_starts(&sha256, 0);  // 0 = SHA256 (not SHA224)
+    mbedtls_sha256_update(&sha256, data, length);
+    mbedtls_sha256_finish(&sha256, digest);
+    mbedtls_sha256_free(&sha256);
+}
+
+void ImageDigest::toHex(const uint8_t digest[SIZE], char hex[SIZE * 2 + 1]) {
+    for (size_t i = 0; i < SIZE; i++) {
+        sprintf(hex + i * 2, "%02x", digest[i]);
+    }
+}
+
+void ImageDigest::task(void* param) {
+    ImageDigest* self = static_cast<ImageDigest*>(param);
+    unsigned long start = millis();
+    compute(self->_data, self->_length, self->_digest);
+    self->_hashMs = millis() - start;
+    xSemaphoreGive(self->_done);
+    vTaskDelete(NULL);
+}
+
+void ImageDigest::start(const uint8_t* data, size_t length, int core) {
+    get();  // A previous hash is finished before its buffer is replaced
+    _data = data;
+    _length = length;
+    _valid = true;
+
+    _done = xSemaphoreCreateBinary();
+    if (_done && xTaskCreatePinnedToCore(task, "image_digest", TASK_STACK_SIZE, this, 1, nullptr, core) == pdPASS) {
+        return;
+    }
+
+    Serial.println("[ImageDigest] WARNING: Hash task not started, hashing inline");
+    if (_done) {
+        vSemaphoreDelete(_done);
+        _done = nullptr;
+    }
+    unsigned long start = millis();
+    compute(data, length, _digest);
+    _hashMs = millis() - start;
+}
+
+const uint8_t* ImageDigest::get() {
+    if (_done) {
+        xSemaphoreTake(_done, portMAX_DELAY);
+        vSemaphoreDelete(_done);
+        _done = nullptr;
+    }
+    return _valid ? _digest : nullptr;
+}
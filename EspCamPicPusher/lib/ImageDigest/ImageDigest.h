@@ -0,0 +1,80 @@
+#ifndef IMAGE_DIGEST_H
+#define IMAGE_DIGEST_H
+
+#include <Arduino.h>
+
+/**
+ * ImageDigest - SHA-256 of an image, computed on the other core
+ *
+ * Uploads send the digest in X-Content-SHA256: the server verifies the body
+ * against it (a truncated JPEG is refused, not stored) and recognizes an
+ * image it already has. The header goes out before the body, so the digest
+ * cannot be computed while the body is sent; start() instead hashes the
+ * frame in a task (mbedTLS, backed by the SHA peripheral on the ESP32-S3)
+ * while the caller makes the thumbnail and the pre-connect finishes its
+ * handshake, and get() joins it.
+ *
+ * The task reads the caller's buffer: it must stay valid until get() was
+ * called or the object was destroyed (the destructor joins the task).
+ *
+ * Usage Pattern:
+ *   ImageDigest digest;
+ *   digest.start(jpeg, jpegLen, 0);
+ *   ... other work on this core ...
+ *   const uint8_t* sha256 = digest.get();
+ */
+class ImageDigest {
+public:
+    static const size_t SIZE = 32;  // SHA-256 digest bytes
+
+    ImageDigest();
+    ~ImageDigest();
+
+    ImageDigest(const ImageDigest&) = delete;
+    ImageDigest& operator=(const ImageDigest&) = delete;
+
+    /**
+     * Start hashing in a task pinned to `core`; hashes right away if the
+     * task cannot be started
+     * @param data Image bytes
+     * @param length Image size in bytes
+     * @param core Core to pin the task to
+     */
+    void start(const uint8_t* data, size_t length, int core);
+
+    /**
+     * Wait for the task and return the digest
+     * @return SIZE digest bytes (valid while this object lives), nullptr if not started
+     */
+    const uint8_t* get();
+
+    /**
+     * Time the hash itself took in milliseconds (valid after get())
+     */
+    uint32_t getHashMs() const { return _hashMs; }
+
+    /**
+     * Hash a buffer on the calling core
+     */
+    static void compute(const uint8_t* data, size_t length, uint8_t digest[SIZE]);
+
+    /**
+     * Lower-case hex form of a digest
+     * @param hex Receives SIZE * 2 characters and the terminator
+     */
+    static void toHex(const uint8_t digest[SIZE], char hex[SIZE * 2 + 1]);
+
+private:
+    static const uint32_t TASK_STACK_SIZE = 4096;
+
+    const uint8_t* _data;
+    size_t _length;
+    uint8_t _digest[SIZE];
+    uint32_t _hashMs;
+    SemaphoreHandle_t _done;
+    bool _valid;
+
+    static void task(void* param);
+};
+
+#endif // IMAGE_DIGEST_H
@@ -0,0 +1,261 @@
+#include "ImageQueue.h"
+#include <LittleFS.h>
+#include "esp_rom_crc.h"
+
+#define QUEUE_DIR "/queue"
+
+// Static member initialization
+bool ImageQueue::_ready = false;
+uint32_t ImageQueue::_headSeq = 1;
+uint32_t ImageQueue::_tailSeq = 1;
+
+bool ImageQueue::begin() {
+    if (_ready) {
+        return true;
+    }
+
+    // Default partition label of LittleFS is "spiffs" (see partitions.csv)
+    if (!LittleFS.begin(true)) {
+        Serial.println("[Queue] LittleFS mount failed - image queue disabled");
+        return false;
+    }
+    LittleFS.mkdir(QUEUE_DIR);
+
+    // Recover head/tail from the directory; drop leftovers of interrupted writes
+    File dir = LittleFS.open(QUEUE_DIR);
+    if (!dir || !dir.isDirectory()) {
+        Serial.println("[Queue] Cannot open queue directory");
+        return false;
+    }
+
+    uint32_t minSeq = UINT32_MAX;
+    uint32_t maxSeq = 0;
+    String stale[8];
+    int numStale = 0;
+    for (File entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+        String name = entry.name();
+        entry.close();
+        uint32_t seq = strtoul(name.c_str(), nullptr, 10);
+        if (!name.endsWith(".img") || seq == 0) {
+            if (numStale < 8) {
+                stale[numStale++] = String(QUEUE_DIR) + "/" + name;
+            }
+            continue;
+        }
+        minSeq = min(minSeq, seq);
+        maxSeq = max(maxSeq, seq);
+    }
+    dir.close();
+
+    for (int i = 0; i < numStale; i++) {
+        Serial.printf("[Queue] Removing incomplete entry %s\n", stale[i].c_str());
+        LittleFS.remove(stale[i]);
+    }
+
+    _headSeq = maxSeq > 0 ? minSeq : 1;
+    _tailSeq = maxSeq + 1;
+    _ready = true;
+
+    Serial.printf("[Queue] Ready: %u queued, %u/%u KB used\n",
+                  count(), (unsigned)(LittleFS.usedBytes() / 1024),
+                  (unsigned)(LittleFS.totalBytes() / 1024));
+    return true;
+}
+
+bool ImageQueue::isReady() {
+    return _ready;
+}
+
+String ImageQueue::entryPath(uint32_t seq, const char* ext) {
+    return String(QUEUE_DIR) + "/" + String(seq) + "." + ext;
+}
+
+bool ImageQueue::hasRoomFor(size_t bytes) {
+    return LittleFS.usedBytes() + bytes + _reserveBytes <= LittleFS.totalBytes();
+}
+
+bool ImageQueue::push(const uint8_t* buf, size_t len, const String& timestamp, const String& firmware) {
+    if (!_ready || !buf || len == 0) {
+        return false;
+    }
+
+    size_t needed = sizeof(queued_image_header_t) + len;
+    if (needed + _reserveBytes > LittleFS.totalBytes()) {
+        Serial.printf("[Queue] Image too large for queue (%u bytes)\n", (unsigned)len);
+        return false;
+    }
+
+    // Ring: evict oldest entries until the new one fits
+    while (count() > 0 && (count() >= _maxImages || !hasRoomFor(needed))) {
+        Serial.printf("[Queue] Queue full, dropping oldest entry %u\n", _headSeq);
+        remove(_headSeq);
+    }
+
+    queued_image_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = _magic;
+    header.seq = _tailSeq;
+    header.length = len;
+    header.crc32 = esp_rom_crc32_le(0, buf, len);
+    header.capturedAt = time(nullptr);
+    header.retries = 0;
+    snprintf(header.timestamp, sizeof(header.timestamp), "%s", timestamp.c_str());
+    snprintf(header.firmware, sizeof(header.firmware), "%s", firmware.c_str());
+
+    String tmpPath = entryPath(header.seq, "tmp");
+    File file = LittleFS.open(tmpPath, FILE_WRITE);
+    if (!file) {
+        Serial.println("[Queue] Failed to create entry");
+        return false;
+    }
+    bool ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              file.write(buf, len) == len;
+    file.close();
+
+    // Publish the entry only once it is complete
+    if (!ok || !LittleFS.rename(tmpPath, entryPath(header.seq))) {
+        Serial.println("[Queue] Failed to write entry (flash full?)");
+        LittleFS.remove(tmpPath);
+        return false;
+    }
+
+    if (count() == 0) {
+        _headSeq = header.seq;
+    }
+    _tailSeq = header.seq + 1;
+    Serial.printf("[Queue] Queued image %u (%u bytes, %u in queue)\n", header.seq, (unsigned)len, count());
+    return true;
+}
+
+bool ImageQueue::readHeader(uint32_t seq, queued_image_header_t& header) {
+    File file = LittleFS.open(entryPath(seq), FILE_READ);
+    if (!file) {
+        return false;
+    }
+    bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == _magic && header.seq == seq &&
+              file.size() == sizeof(header) + header.length;
+    file.close();
+    return ok;
+}
+
+bool ImageQueue::peek(QueuedImage& image) {
+    if (!_ready) {
+        return false;
+    }
+
+    for (; _headSeq < _tailSeq; _headSeq++) {
+        String path = entryPath(_headSeq);
+        if (!LittleFS.exists(path)) {
+            continue;  // Gap left by a removed entry
+        }
+
+        if (!readHeader(_headSeq, image.header)) {
+            Serial.printf("[Queue] Dropping corrupt entry %u (bad header)\n", _headSeq);
+            LittleFS.remove(path);
+            continue;
+        }
+
+        image.data = (uint8_t*)ps_malloc(image.header.length);
+        if (!image.data) {
+            Serial.printf("[Queue] Out of memory loading entry %u\n", _headSeq);
+            return false;
+        }
+
+        File file = LittleFS.open(path, FILE_READ);
+        bool ok = file && file.seek(sizeof(queued_image_header_t)) &&
+                  file.read(image.data, image.header.length) == image.header.length;
+        file.close();
+
+        if (!ok || esp_rom_crc32_le(0, image.data, image.header.length) != image.header.crc32) {
+            Serial.printf("[Queue] Dropping corrupt entry %u (CRC mismatch)\n", _headSeq);
+            release(image);
+            LittleFS.remove(path);
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+uint32_t ImageQueue::list(queued_image_header_t* headers, uint32_t maxEntries) {
+    if (!_ready || !headers) {
+        return 0;
+    }
+
+    uint32_t n = 0;
+    for (uint32_t seq = _headSeq; seq < _tailSeq && n < maxEntries; seq++) {
+        String path = entryPath(seq);
+        if (!LittleFS.exists(path)) {
+            continue;
+        }
+        if (!readHeader(seq, headers[n])) {
+            Serial.printf("[Queue] Dropping corrupt entry %u (bad header)\n", seq);
+            LittleFS.remove(path);
+            continue;
+        }
+        n++;
+    }
+    return n;
+}
+
+File ImageQueue::openImage(uint32_t seq) {
+    if (!_ready) {
+        return File();
+    }
+    File file = LittleFS.open(entryPath(seq), FILE_READ);
+    if (file && !file.seek(sizeof(queued_image_header_t))) {
+        file.close();
+    }
+    return file;
+}
+
+bool ImageQueue::remove(uint32_t seq) {
+    if (!_ready) {
+        return false;
+    }
+    bool removed = LittleFS.remove(entryPath(seq));
+
+    // Advance head past removed entries
+    while (_headSeq < _tailSeq && !LittleFS.exists(entryPath(_headSeq))) {
+        _headSeq++;
+    }
+    return removed;
+}
+
+uint32_t ImageQueue::incrementRetries(uint32_t seq) {
+    queued_image_header_t header;
+    if (!_ready || !readHeader(seq, header)) {
+        return 0;
+    }
+    header.retries++;
+
+    // Rewrite the header in place; LittleFS commits the change atomically on close
+    File file = LittleFS.open(entryPath(seq), "r+");
+    if (!file) {
+        return 0;
+    }
+    bool ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header);
+    file.close();
+    return ok ? header.retries : 0;
+}
+
+void ImageQueue::release(QueuedImage& image) {
+    if (image.data) {
+        free(image.data);
+        image.data = nullptr;
+    }
+}
+
+uint32_t ImageQueue::count() {
+    if (!_ready) {
+        return 0;
+    }
+    uint32_t n = 0;
+    for (uint32_t seq = _headSeq; seq < _tailSeq; seq++) {
+        if (LittleFS.exists(entryPath(seq))) {
+            n++;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,134 @@
+#ifndef IMAGE_QUEUE_H
+#define IMAGE_QUEUE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <time.h>
+
+// On-flash entry header, followed by `length` JPEG bytes
+typedef struct {
+    uint32_t magic;                          // Magic number to validate the entry
+    uint32_t seq;                            // Queue sequence number (also the file name)
+    uint32_t length;                         // JPEG size in bytes
+    uint32_t crc32;                          // CRC-32 of the JPEG bytes
+    int64_t capturedAt;                      // Epoch time of the capture (0 = unknown)
+    uint32_t retries;                        // Failed delivery attempts so far
+    char timestamp[24];                      // X-Timestamp at capture time
+    char firmware[16];                       // Firmware version that captured the image
+} queued_image_header_t;
+
+/**
+ * Image loaded from the queue for delivery. Owns `data` (PSRAM) until
+ * ImageQueue::release() is called.
+ */
+struct QueuedImage {
+    queued_image_header_t header;
+    uint8_t* data = nullptr;
+};
+
+/**
+ * ImageQueue - Store-and-forward ring queue of JPEGs on the LittleFS partition
+ *
+ * Images that could not be uploaded are appended as one file per entry
+ * (/queue/<seq>.img) and drained oldest-first on the next good connection.
+ *
+ * CRASH SAFETY:
+ * - Entries are written to <seq>.tmp and renamed once complete; LittleFS
+ *   renames are atomic, so a reset mid-write only leaves a .tmp behind,
+ *   which begin() deletes
+ * - Each entry carries a CRC-32; corrupt entries are dropped on read
+ * - Header updates (retry count) rely on LittleFS copy-on-write commit at close
+ *
+ * RING BEHAVIOUR: when the partition or the entry limit (16) is full, the
+ * oldest entries are evicted to make room for the new image.
+ */
+class ImageQueue {
+public:
+    /**
+     * Mount LittleFS (formatting it on first use) and recover the queue
+     * @return true if the queue is usable
+     */
+    static bool begin();
+
+    /**
+     * Check if the queue is mounted and usable
+     */
+    static bool isReady();
+
+    /**
+     * Append an image to the queue, evicting the oldest entries if needed
+     * @param buf JPEG data
+     * @param len JPEG size in bytes
+     * @param timestamp Capture timestamp as sent in X-Timestamp
+     * @param firmware Firmware version that captured the image
+     * @return true if the image was stored
+     */
+    static bool push(const uint8_t* buf, size_t len, const String& timestamp, const String& firmware);
+
+    /**
+     * Load the oldest valid entry (corrupt entries are removed on the way)
+     * @param image Receives header and data; call release() when done
+     * @return true if an entry was loaded, false if the queue is empty
+     */
+    static bool peek(QueuedImage& image);
+
+    /**
+     * Read the headers of the oldest valid entries without loading the images
+     * (entries with a bad header are removed on the way)
+     * @param headers Output array
+     * @param maxEntries Capacity of `headers`
+     * @return Number of headers filled in, oldest first
+     */
+    static uint32_t list(queued_image_header_t* headers, uint32_t maxEntries);
+
+    /**
+     * Open an entry for streaming its JPEG data
+     * @param seq Sequence number from the entry header
+     * @return Open file positioned at the JPEG data (offset sizeof(queued_image_header_t)),
+     *         or an invalid File
+     */
+    static File openImage(uint32_t seq);
+
+    /**
+     * Remove an entry after successful delivery (or when giving up on it)
+     * @param seq Sequence number from the entry header
+     */
+    static bool remove(uint32_t seq);
+
+    /**
+     * Record a failed delivery attempt in the entry header
+     * @param seq Sequence number from the entry header
+     * @return Updated retry count, 0 on error
+     */
+    static uint32_t incrementRetries(uint32_t seq);
+
+    /**
+     * Free the data buffer of an image returned by peek()
+     */
+    static void release(QueuedImage& image);
+
+    /**
+     * Number of entries currently queued
+     */
+    static uint32_t count();
+
+private:
+    static bool _ready;
+    static uint32_t _headSeq;   // Oldest entry that may still exist
+    static uint32_t _tailSeq;   // Next sequence number to assign
+    static const uint32_t _magic = 0x51474D49;        // "IMGQ"
+    static const uint32_t _maxImages = 16;
+    static const size_t _reserveBytes = 16 * 1024;    // Spare blocks for LittleFS copy-on-write
+
+    static String entryPath(uint32_t seq, const char* ext = "img");
+    static bool readHeader(uint32_t seq, queued_image_header_t& header);
+    static bool hasRoomFor(size_t bytes);
+
+    // Static utility class - no instances
+    ImageQueue() = delete;
+    ~ImageQueue() = delete;
+    ImageQueue(const ImageQueue&) = delete;
+    ImageQueue& operator=(const ImageQueue&) = delete;
+};
+
+#endif // IMAGE_QUEUE_H
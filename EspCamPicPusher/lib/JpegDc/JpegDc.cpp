@@ -0,0 +1,615 @@
+#include "JpegDc.h"
+
+namespace {
+
+const int LOOKUP_BITS = 9;
+const int MAX_COMPONENTS = 4;
+
+struct HuffTable {
+    bool defined;
+    uint16_t lookup[1 << LOOKUP_BITS];       // (length << 8) | symbol for codes <= LOOKUP_BITS, 0 = longer
+    int32_t maxCode[17];                     // Largest code of each length, -1 if none
+    int32_t valPtr[17];                      // Symbol index = code + valPtr[length]
+    uint8_t symbols[256];
+};
+
+struct Component {
+    uint8_t id;
+    uint8_t h;                               // Sampling factors
+    uint8_t v;
+    uint8_t tq;                              // Quantization table
+    uint8_t td;                              // DC Huffman table
+    uint8_t ta;                              // AC Huffman table
+    int32_t pred;                            // DC predictor
+};
+
+// Heap-allocated: ~15 KB is too much for the loop/AsyncTCP task stacks
+struct Decoder {
+    HuffTable dc[4];
+    HuffTable ac[4];
+    uint16_t acSkip[4][1 << LOOKUP_BITS];    // (coefficients << 8) | bits for AC code + value <= LOOKUP_BITS, 0 = slow path
+    uint8_t acSize[4][1 << LOOKUP_BITS];     // Magnitude category of the coefficient an acSkip entry consumes (0 = EOB/ZRL)
+    uint16_t quantDc[4];                     // First (DC) entry of each quantization table
+    Component comps[MAX_COMPONENTS];
+    uint8_t numComps;
+    uint16_t width;
+    uint16_t height;
+    uint16_t restartInterval;
+    size_t scanStart;
+};
+
+// 64-bit buffer: refills happen about once per 6 bytes instead of per symbol
+struct BitReader {
+    const uint8_t* data;
+    size_t len;
+    size_t pos;
+    uint64_t buffer;
+    int bits;
+    bool atMarker;                           // Hit a marker: feed zeros until restart()
+
+    void fill() {
+        if (bits > 32) {
+            return;
+        }
+        while (bits <= 56) {
+            uint64_t byte = 0;
+            if (!atMarker && pos < len) {
+                byte = data[pos];
+                if (byte == 0xFF) {
+                    uint8_t next = pos + 1 < len ? data[pos + 1] : 0;
+                    if (next == 0x00) {
+                        pos += 2;            // Stuffed 0xFF
+                    } else {
+                        atMarker = true;
+                        byte = 0;
+                    }
+                } else {
+                    pos++;
+                }
+            }
+            buffer |= byte << (56 - bits);
+            bits += 8;
+        }
+    }
+
+    uint32_t peek(int n) {
+        fill();
+        return (uint32_t)(buffer >> (64 - n));
+    }
+
+    void skip(int n) {
+        buffer <<= n;
+        bits -= n;
+    }
+
+    uint32_t get(int n) {
+        if (n == 0) {
+            return 0;
+        }
+        uint32_t value = peek(n);
+        skip(n);
+        return value;
+    }
+
+    // Drop buffered bits and step over the RSTn marker
+    bool restart() {
+        buffer = 0;
+        bits = 0;
+        atMarker = false;
+        while (pos + 1 < len && data[pos] == 0xFF && data[pos + 1] == 0xFF) {
+            pos++;                           // Fill bytes
+        }
+        if (pos + 1 < len && data[pos] == 0xFF && (data[pos + 1] & 0xF8) == 0xD0) {
+            pos += 2;
+            return true;
+        }
+        return false;
+    }
+};
+
+uint16_t readBe16(const uint8_t* p) {
+    return ((uint16_t)p[0] << 8) | p[1];
+}
+
+bool buildTable(HuffTable& table, const uint8_t* counts, const uint8_t* symbols, int numSymbols) {
+    if (numSymbols > 256) {
+        return false;
+    }
+    memcpy(table.symbols, symbols, numSymbols);
+    memset(table.lookup, 0, sizeof(table.lookup));
+
+    int32_t code = 0;
+    int k = 0;
+    for (int length = 1; length <= 16; length++) {
+        // The codes of each length must fit in it, all-ones excluded (as in
+        // libjpeg's jdhuff); too many would also write past table.lookup
+        if (code + counts[length - 1] >= (1 << length)) {
+            table.defined = false;
+            return false;
+        }
+        table.valPtr[length] = k - code;
+        for (int i = 0; i < counts[length - 1]; i++) {
+            if (length <= LOOKUP_BITS) {
+                int shift = LOOKUP_BITS - length;
+                for (int fill = 0; fill < (1 << shift); fill++) {
+                    table.lookup[(code << shift) | fill] = (uint16_t)((length << 8) | symbols[k]);
+                }
+            }
+            code++;
+            k++;
+        }
+        table.maxCode[length] = counts[length - 1] ? code - 1 : -1;
+        code <<= 1;
+    }
+    table.defined = true;
+    return true;
+}
+
+// Skipping an AC coefficient needs only the bit count of code + value and
+// how far it advances in the block, so short code/value pairs (most of them)
+// are consumed with one lookup instead of a symbol decode plus a value read
+void buildAcSkip(uint16_t* skip, uint8_t* sizes, const HuffTable& table) {
+    for (int i = 0; i < (1 << LOOKUP_BITS); i++) {
+        uint16_t entry = table.lookup[i];
+        skip[i] = 0;
+        sizes[i] = 0;
+        if (!entry) {
+            continue;
+        }
+        int length = entry >> 8;
+        int rs = entry & 0xFF;
+        int run = rs >> 4;
+        int bits = rs & 0x0F;
+        int advance;
+        if (bits == 0) {
+            advance = run == 15 ? 16 : 64;   // ZRL, or end of block
+        } else {
+            advance = run + 1;
+            length += bits;
+        }
+        if (length <= LOOKUP_BITS) {
+            skip[i] = (uint16_t)((advance << 8) | length);
+            sizes[i] = (uint8_t)bits;
+        }
+    }
+}
+
+int decodeSymbol(BitReader& reader, const HuffTable& table) {
+    uint16_t entry = table.lookup[reader.peek(LOOKUP_BITS)];
+    if (entry) {
+        reader.skip(entry >> 8);
+        return entry & 0xFF;
+    }
+    uint32_t code = reader.peek(16);
+    for (int length = LOOKUP_BITS + 1; length <= 16; length++) {
+        int32_t prefix = (int32_t)(code >> (16 - length));
+        if (prefix <= table.maxCode[length]) {
+            reader.skip(length);
+            return table.symbols[prefix + table.valPtr[length]];
+        }
+    }
+    return -1;  // Invalid code
+}
+
+// Energy estimate of a quantized AC coefficient from its magnitude category:
+// the square of the smallest magnitude in the category, 2^(size-1)
+inline uint32_t acEnergy(int size) {
+    return size ? 1u << (2 * size - 2) : 0;
+}
+
+// Value of a `size`-bit magnitude category (size 0 = difference 0, no bits)
+int32_t extend(uint32_t value, int size) {
+    if (size == 0) {
+        return 0;
+    }
+    return value < (1u << (size - 1)) ? (int32_t)value - (1 << size) + 1 : (int32_t)value;
+}
+
+/**
+ * Parse markers up to the start of scan. With headerOnly, stop at the frame header.
+ */
+bool parseHeaders(const uint8_t* jpeg, size_t len, Decoder& dec, bool headerOnly) {
+    if (len < 4 || jpeg[0] != 0xFF || jpeg[1] != 0xD8) {
+        return false;
+    }
+
+    bool haveFrame = false;
+    size_t pos = 2;
+    while (pos + 4 <= len) {
+        if (jpeg[pos] != 0xFF) {
+            return false;
+        }
+        uint8_t marker = jpeg[pos + 1];
+        if (marker == 0xFF) {
+            pos++;
+            continue;
+        }
+        if (marker == 0xD9) {
+            return false;  // EOI before scan
+        }
+
+        size_t segLen = readBe16(jpeg + pos + 2);
+        if (segLen < 2 || pos + 2 + segLen > len) {
+            return false;
+        }
+        const uint8_t* seg = jpeg + pos + 4;
+        size_t segBytes = segLen - 2;
+
+        switch (marker) {
+            case 0xDB: {  // DQT
+                size_t p = 0;
+                while (p < segBytes) {
+                    uint8_t pq = seg[p] >> 4;
+                    uint8_t tq = seg[p] & 0x0F;
+                    if (tq > 3 || p + 1 + (pq ? 128 : 64) > segBytes) {
+                        return false;
+                    }
+                    dec.quantDc[tq] = pq ? readBe16(seg + p + 1) : seg[p + 1];
+                    p += 1 + (pq ? 128 : 64);
+                }
+                break;
+            }
+
+            case 0xC0:    // SOF0 baseline
+            case 0xC1: {  // SOF1 extended sequential (Huffman)
+                if (segBytes < 6 || seg[0] != 8) {
+                    return false;
+                }
+                dec.height = readBe16(seg + 1);
+                dec.width = readBe16(seg + 3);
+                dec.numComps = seg[5];
+                if (dec.numComps == 0 || dec.numComps > MAX_COMPONENTS || segBytes < 6 + 3u * dec.numComps ||
+                    dec.width == 0 || dec.height == 0) {
+                    return false;
+                }
+                for (int i = 0; i < dec.numComps; i++) {
+                    Component& c = dec.comps[i];
+                    c.id = seg[6 + 3 * i];
+                    c.h = seg[7 + 3 * i] >> 4;
+                    c.v = seg[7 + 3 * i] & 0x0F;
+                    c.tq = seg[8 + 3 * i] & 0x03;
+                    if (c.h == 0 || c.v == 0 || c.h > 4 || c.v > 4) {
+                        return false;
+                    }
+                }
+                haveFrame = true;
+                if (headerOnly) {
+                    return true;
+                }
+                break;
+            }
+
+            case 0xC2: case 0xC3: case 0xC5: case 0xC6: case 0xC7:
+            case 0xC9: case 0xCA: case 0xCB: case 0xCD: case 0xCE: case 0xCF:
+                return false;  // Progressive, lossless or arithmetic coding
+
+            case 0xC4: {  // DHT
+                size_t p = 0;
+                while (p + 17 <= segBytes) {
+                    uint8_t tc = seg[p] >> 4;
+                    uint8_t th = seg[p] & 0x0F;
+                    const uint8_t* counts = seg + p + 1;
+                    int total = 0;
+                    for (int i = 0; i < 16; i++) {
+                        total += counts[i];
+                    }
+                    if (th > 3 || tc > 1 || p + 17 + total > segBytes) {
+                        return false;
+                    }
+                    HuffTable& table = tc ? dec.ac[th] : dec.dc[th];
+                    if (!buildTable(table, counts, seg + p + 17, total)) {
+                        return false;
+                    }
+                    if (tc) {
+                        buildAcSkip(dec.acSkip[th], dec.acSize[th], table);
+                    }
+                    p += 17 + total;
+                }
+                break;
+            }
+
+            case 0xDD:  // DRI
+                if (segBytes < 2) {
+                    return false;
+                }
+                dec.restartInterval = readBe16(seg);
+                break;
+
+            case 0xDA: {  // SOS
+                if (!haveFrame || segBytes < 1) {
+                    return false;
+                }
+                uint8_t ns = seg[0];
+                // Camera JPEGs carry all components in one interleaved scan
+                if (ns != dec.numComps || segBytes < 1 + 2u * ns) {
+                    return false;
+                }
+                for (int i = 0; i < ns; i++) {
+                    uint8_t id = seg[1 + 2 * i];
+                    uint8_t tables = seg[2 + 2 * i];
+                    Component* comp = nullptr;
+                    for (int j = 0; j < dec.numComps; j++) {
+                        if (dec.comps[j].id == id) {
+                            comp = &dec.comps[j];
+                        }
+                    }
+                    if (!comp || (tables >> 4) > 3 || (tables & 0x0F) > 3 ||
+                        !dec.dc[tables >> 4].defined || !dec.ac[tables & 0x0F].defined) {
+                        return false;
+                    }
+                    comp->td = tables >> 4;
+                    comp->ta = tables & 0x0F;
+                    comp->pred = 0;
+                }
+                dec.scanStart = pos + 2 + segLen;
+                return true;
+            }
+
+            default:  // APPn, COM, ...
+                break;
+        }
+        pos += 2 + segLen;
+    }
+    return false;
+}
+
+// Optional outputs of a DC pass
+struct DcOutput {
+    uint8_t* lumaBlocks;                     // Mean per luma block, stats.blocksX per row
+    size_t maxBlocks;
+    uint32_t* histogram;
+    bool acEnergy;                           // Sum up luma AC energy (stats.acEnergy)
+    bool chroma;                             // Allocate and fill the chroma planes below
+    uint8_t* chromaBlocks[2];                // Mean per Cb / Cr block (caller frees)
+    uint16_t chromaX[2];                     // Chroma block grid
+    uint16_t chromaY[2];
+};
+
+bool dcPass(const uint8_t* jpeg, size_t len, jpeg_dc_stats_t& stats, DcOutput& out) {
+    memset(&stats, 0, sizeof(stats));
+    if (out.histogram) {
+        memset(out.histogram, 0, JPEG_DC_HISTOGRAM_BINS * sizeof(uint32_t));
+    }
+    if (!jpeg) {
+        return false;
+    }
+
+    Decoder* dec = (Decoder*)calloc(1, sizeof(Decoder));
+    if (!dec) {
+        return false;
+    }
+    if (!parseHeaders(jpeg, len, *dec, false)) {
+        free(dec);
+        return false;
+    }
+
+    uint8_t hMax = 1;
+    uint8_t vMax = 1;
+    for (int i = 0; i < dec->numComps; i++) {
+        if (dec->comps[i].h > hMax) {
+            hMax = dec->comps[i].h;
+        }
+        if (dec->comps[i].v > vMax) {
+            vMax = dec->comps[i].v;
+        }
+    }
+    uint32_t mcusX = (dec->width + 8 * hMax - 1) / (8 * hMax);
+    uint32_t mcusY = (dec->height + 8 * vMax - 1) / (8 * vMax);
+
+    const Component& luma = dec->comps[0];
+    stats.width = dec->width;
+    stats.height = dec->height;
+    stats.blocksX = (uint16_t)(mcusX * luma.h);
+    stats.blocksY = (uint16_t)(mcusY * luma.v);
+    if (out.lumaBlocks && out.maxBlocks < (size_t)stats.blocksX * stats.blocksY) {
+        free(dec);
+        return false;
+    }
+    for (int i = 0; out.chroma && i < 2 && i + 1 < dec->numComps; i++) {
+        const Component& c = dec->comps[i + 1];
+        out.chromaX[i] = (uint16_t)(mcusX * c.h);
+        out.chromaY[i] = (uint16_t)(mcusY * c.v);
+        out.chromaBlocks[i] = (uint8_t*)ps_malloc((size_t)out.chromaX[i] * out.chromaY[i]);
+        if (!out.chromaBlocks[i]) {
+            free(dec);
+            return false;
+        }
+    }
+
+    BitReader reader = { jpeg, len, dec->scanStart, 0, 0, false };
+    int64_t sums[MAX_COMPONENTS] = { 0 };
+    uint64_t energy = 0;
+    uint32_t counts[MAX_COMPONENTS] = { 0 };
+    bool ok = true;
+
+    for (uint32_t mcu = 0; ok && mcu < mcusX * mcusY; mcu++) {
+        if (dec->restartInterval && mcu > 0 && mcu % dec->restartInterval == 0) {
+            reader.restart();
+            for (int i = 0; i < dec->numComps; i++) {
+                dec->comps[i].pred = 0;
+            }
+        }
+        uint32_t mcuX = mcu % mcusX;
+        uint32_t mcuY = mcu / mcusX;
+
+        for (int ci = 0; ok && ci < dec->numComps; ci++) {
+            Component& c = dec->comps[ci];
+            const HuffTable& dcTable = dec->dc[c.td];
+            const HuffTable& acTable = dec->ac[c.ta];
+            const uint16_t* acSkip = dec->acSkip[c.ta];
+            const uint8_t* acSize = ci == 0 && out.acEnergy ? dec->acSize[c.ta] : nullptr;
+
+            for (int by = 0; ok && by < c.v; by++) {
+                for (int bx = 0; bx < c.h; bx++) {
+                    int size = decodeSymbol(reader, dcTable);
+                    if (size < 0 || size > 11) {
+                        ok = false;
+                        break;
+                    }
+                    c.pred += extend(reader.get(size), size);
+
+                    // Skip the AC coefficients (luma: summing up their energy if asked to)
+                    for (int k = 1; k < 64;) {
+                        uint32_t lookup = reader.peek(LOOKUP_BITS);
+                        uint16_t fast = acSkip[lookup];
+                        if (fast) {
+                            if (acSize) {
+                                energy += acEnergy(acSize[lookup]);
+                            }
+                            reader.skip(fast & 0xFF);
+                            k += fast >> 8;
+                            continue;
+                        }
+                        int rs = decodeSymbol(reader, acTable);
+                        if (rs < 0) {
+                            ok = false;
+                            break;
+                        }
+                        int run = rs >> 4;
+                        int bits = rs & 0x0F;
+                        if (bits == 0) {
+                            if (run != 15) {
+                                break;  // End of block
+                            }
+                            k += 16;
+                            continue;
+                        }
+                        k += run;
+                        reader.get(bits);
+                        if (acSize) {
+                            energy += acEnergy(bits);
+                        }
+                        k++;
+                    }
+                    if (!ok) {
+                        break;
+                    }
+
+                    // Dequantized DC / 8 = block mean around 0
+                    int32_t mean = c.pred * dec->quantDc[c.tq] / 8;
+                    sums[ci] += mean;
+                    counts[ci]++;
+                    if (ci == 0 && (out.lumaBlocks || out.histogram)) {
+                        int32_t level = mean + 128;
+                        uint8_t clamped = (uint8_t)(level < 0 ? 0 : (level > 255 ? 255 : level));
+                        if (out.lumaBlocks) {
+                            uint32_t x = mcuX * c.h + bx;
+                            uint32_t y = mcuY * c.v + by;
+                            out.lumaBlocks[y * stats.blocksX + x] = clamped;
+                        }
+                        if (out.histogram) {
+                            out.histogram[clamped]++;
+                        }
+                    } else if (ci > 0 && ci < 3 && out.chromaBlocks[ci - 1]) {
+                        int32_t level = mean + 128;
+                        uint32_t x = mcuX * c.h + bx;
+                        uint32_t y = mcuY * c.v + by;
+                        out.chromaBlocks[ci - 1][y * out.chromaX[ci - 1] + x] =
+                            (uint8_t)(level < 0 ? 0 : (level > 255 ? 255 : level));
+                    }
+                }
+            }
+        }
+    }
+
+    if (ok) {
+        stats.meanY = counts[0] ? (float)sums[0] / counts[0] + 128.0f : 0.0f;
+        stats.meanCb = dec->numComps > 1 && counts[1] ? (float)sums[1] / counts[1] + 128.0f : 128.0f;
+        stats.meanCr = dec->numComps > 2 && counts[2] ? (float)sums[2] / counts[2] + 128.0f : 128.0f;
+        stats.acEnergy = out.acEnergy && counts[0] ? (float)energy / counts[0] : 0.0f;
+    }
+    free(dec);
+    return ok;
+}
+
+} // namespace
+
+bool JpegDc::dimensions(const uint8_t* jpeg, size_t len, uint16_t& width, uint16_t& height) {
+    Decoder* dec = (Decoder*)calloc(1, sizeof(Decoder));
+    if (!dec) {
+        return false;
+    }
+    bool ok = parseHeaders(jpeg, len, *dec, true);
+    width = dec->width;
+    height = dec->height;
+    free(dec);
+    return ok;
+}
+
+bool JpegDc::analyze(const uint8_t* jpeg, size_t len, jpeg_dc_stats_t& stats,
+                     uint8_t* lumaBlocks, size_t maxBlocks, uint32_t* histogram, bool acEnergy) {
+    DcOutput out = {};
+    out.lumaBlocks = lumaBlocks;
+    out.maxBlocks = maxBlocks;
+    out.histogram = histogram;
+    out.acEnergy = acEnergy;
+    return dcPass(jpeg, len, stats, out);
+}
+
+bool JpegDc::dcImage(const uint8_t* jpeg, size_t len, uint8_t* bgr, size_t maxBytes,
+                     uint16_t& width, uint16_t& height) {
+    width = 0;
+    height = 0;
+    uint16_t imageWidth = 0;
+    uint16_t imageHeight = 0;
+    if (!dimensions(jpeg, len, imageWidth, imageHeight)) {
+        return false;
+    }
+
+    // Grid of any sampling is at most two blocks per 16 pixels
+    size_t maxBlocks = (size_t)((imageWidth + 15) / 16 * 2) * ((imageHeight + 15) / 16 * 2);
+    DcOutput out = {};
+    out.lumaBlocks = (uint8_t*)ps_malloc(maxBlocks);
+    out.maxBlocks = maxBlocks;
+    out.chroma = true;
+    if (!out.lumaBlocks) {
+        return false;
+    }
+
+    jpeg_dc_stats_t stats;
+    bool ok = dcPass(jpeg, len, stats, out);
+
+    // One pixel per luma block inside the image (the grid is padded to whole MCUs)
+    uint16_t outWidth = (uint16_t)((stats.width + 7) / 8);
+    uint16_t outHeight = (uint16_t)((stats.height + 7) / 8);
+    if (ok && (size_t)outWidth * outHeight * 3 > maxBytes) {
+        ok = false;
+    }
+
+    for (uint32_t y = 0; ok && y < outHeight; y++) {
+        const uint8_t* lumaRow = out.lumaBlocks + y * stats.blocksX;
+        uint8_t* dst = bgr + (size_t)y * outWidth * 3;
+        for (uint32_t x = 0; x < outWidth; x++) {
+            int32_t luma = lumaRow[x];
+            int32_t cb = 0;
+            int32_t cr = 0;
+            if (out.chromaBlocks[0] && out.chromaBlocks[1]) {
+                // Nearest chroma block for subsampled chroma
+                uint32_t cx = x * out.chromaX[0] / stats.blocksX;
+                uint32_t cy = y * out.chromaY[0] / stats.blocksY;
+                cb = out.chromaBlocks[0][cy * out.chromaX[0] + cx] - 128;
+                cx = x * out.chromaX[1] / stats.blocksX;
+                cy = y * out.chromaY[1] / stats.blocksY;
+                cr = out.chromaBlocks[1][cy * out.chromaX[1] + cx] - 128;
+            }
+
+            // JFIF YCbCr -> RGB, 16.16 fixed point
+            int32_t r = luma + ((91881 * cr) >> 16);
+            int32_t g = luma - ((22554 * cb + 46802 * cr) >> 16);
+            int32_t b = luma + ((116130 * cb) >> 16);
+            dst[0] = (uint8_t)(b < 0 ? 0 : (b > 255 ? 255 : b));
+            dst[1] = (uint8_t)(g < 0 ? 0 : (g > 255 ? 255 : g));
+            dst[2] = (uint8_t)(r < 0 ? 0 : (r > 255 ? 255 : r));
+            dst += 3;
+        }
+    }
+
+    if (ok) {
+        width = outWidth;
+        height = outHeight;
+    }
+    free(out.lumaBlocks);
+    free(out.chromaBlocks[0]);
+    free(out.chromaBlocks[1]);
+    return ok;
+}
@@ -0,0 +1,89 @@
+#ifndef JPEG_DC_H
+#define JPEG_DC_H
+
+#include <Arduino.h>
+
+// Histogram of 8x8 luma block means, one bin per level (see JpegDc::analyze)
+#define JPEG_DC_HISTOGRAM_BINS 256
+
+// Result of a DC-only pass over a JPEG
+typedef struct {
+    uint16_t width;                          // Image size from SOF0
+    uint16_t height;
+    uint16_t blocksX;                        // Luma 8x8 block grid (covers whole MCUs)
+    uint16_t blocksY;
+    float meanY;                             // Mean luminance 0..255
+    float meanCb;                            // Mean chroma 0..255 (128 = neutral)
+    float meanCr;
+    float acEnergy;                          // Mean luma AC energy per block (0 unless requested)
+} jpeg_dc_stats_t;
+
+/**
+ * JpegDc - DC-only decoder for baseline JPEGs from the camera
+ *
+ * Walks the Huffman-coded scan but only reconstructs the DC coefficient of
+ * each 8x8 block (AC coefficients are decoded just far enough to be skipped,
+ * no IDCT). A DC coefficient is the block's mean, so this yields a 1/8-scale
+ * luminance image, its histogram, a 1/8-scale color thumbnail and the mean
+ * Y/Cb/Cr of the frame at a fraction of the cost of a full decode.
+ * 
+ * The skipped AC coefficients still reveal their magnitude category, so the
+ * pass can also sum up an estimate of the luma AC energy: a measure of fine
+ * detail that drops when a frame is blurred (see CameraCapture::captureBurst).
+ *
+ * Supported: baseline (SOF0/SOF1) 8-bit, interleaved single scan, any
+ * sampling factors, restart intervals. Progressive JPEGs are rejected.
+ */
+class JpegDc {
+public:
+    /**
+     * Decode the DC coefficients of a JPEG
+     * @param jpeg JPEG data
+     * @param len JPEG size in bytes
+     * @param stats Receives size, block grid and mean Y/Cb/Cr
+     * @param lumaBlocks Optional output: mean luminance per 8x8 luma block,
+     *                   row-major, blocksX * blocksY bytes
+     * @param maxBlocks Capacity of lumaBlocks; decoding fails if too small
+     * @param histogram Optional output: JPEG_DC_HISTOGRAM_BINS counts of luma
+     *                  blocks per mean level (sums to blocksX * blocksY)
+     * @param acEnergy Also fill stats.acEnergy: sum of 4^(size-1) over the
+     *                 luma AC coefficients (size = magnitude category, i.e.
+     *                 the squared lower bound of each quantized coefficient)
+     *                 divided by the number of luma blocks. Only comparable
+     *                 between frames with the same quantization tables.
+     * @return true on success
+     */
+    static bool analyze(const uint8_t* jpeg, size_t len, jpeg_dc_stats_t& stats,
+                        uint8_t* lumaBlocks = nullptr, size_t maxBlocks = 0,
+                        uint32_t* histogram = nullptr, bool acEnergy = false);
+
+    /**
+     * Decode a 1/8-scale color image from the DC coefficients: one pixel per
+     * 8x8 luma block (the block mean, i.e. a box-filtered downscale), chroma
+     * from the nearest chroma block. Output is packed B, G, R per pixel, the
+     * layout esp32-camera's fmt2jpg() expects for PIXFORMAT_RGB888.
+     * Working buffers are taken from PSRAM.
+     * @param bgr Output, width * height * 3 bytes
+     * @param maxBytes Capacity of bgr; decoding fails if too small
+     * @param width Receives the image width, (JPEG width + 7) / 8
+     * @param height Receives the image height, (JPEG height + 7) / 8
+     * @return true on success
+     */
+    static bool dcImage(const uint8_t* jpeg, size_t len, uint8_t* bgr, size_t maxBytes,
+                        uint16_t& width, uint16_t& height);
+
+    /**
+     * Read the image size from the frame header without decoding the scan
+     * @return true if a baseline frame header was found
+     */
+    static bool dimensions(const uint8_t* jpeg, size_t len, uint16_t& width, uint16_t& height);
+
+private:
+    // Static utility class - no instances
+    JpegDc() = delete;
+    ~JpegDc() = delete;
+    JpegDc(const JpegDc&) = delete;
+    JpegDc& operator=(const JpegDc&) = delete;
+};
+
+#endif // JPEG_DC_H
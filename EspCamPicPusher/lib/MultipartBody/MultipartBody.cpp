@@ -0,0 +1,148 @@
+#include "MultipartBody.h"
+#include "esp_system.h"
+
+MultipartBody::MultipartBody() {
+    char boundary[40];
+    snprintf(boundary, sizeof(boundary), "----EspCamBoundary%08x%08x", (unsigned)esp_random(), (unsigned)esp_random());
+    _boundary = boundary;
+}
+
+void MultipartBody::addText(const String& text) {
+    // Merge adjacent text so boundaries and part headers share one segment
+    if (!_segments.empty() && !_segments.back().file && !_segments.back().data) {
+        _segments.back().text += text;
+        _segments.back().length = _segments.back().text.length();
+    } else {
+        Segment segment;
+        segment.text = text;
+        segment.length = text.length();
+        _segments.push_back(segment);
+    }
+    _length += text.length();
+}
+
+void MultipartBody::addField(const String& name, const String& value, const char* contentType) {
+    if (_finished) {
+        return;
+    }
+    String part = "--" + _boundary + "\r\n";
+    part += "Content-Disposition: form-data; name=\"" + name + "\"\r\n";
+    if (contentType && *contentType) {
+        part += String("Content-Type: ") + contentType + "\r\n";
+    }
+    part += "\r\n" + value + "\r\n";
+    addText(part);
+}
+
+void MultipartBody::addPartHeader(const String& name, const String& filename, const char* contentType) {
+    String header = "--" + _boundary + "\r\n";
+    header += "Content-Disposition: form-data; name=\"" + name + "\"; filename=\"" + filename + "\"\r\n";
+    header += String("Content-Type: ") + contentType + "\r\n\r\n";
+    addText(header);
+}
+
+void MultipartBody::addFile(const String& name, const String& filename, File file, size_t offset,
+                            size_t length, const char* contentType) {
+    if (_finished || !file) {
+        return;
+    }
+    addPartHeader(name, filename, contentType);
+
+    Segment segment;
+    segment.file = file;
+    segment.offset = offset;
+    segment.length = length;
+    _segments.push_back(segment);
+    _length += length;
+
+    addText("\r\n");
+}
+
+void MultipartBody::addData(const String& name, const String& filename, const uint8_t* data, size_t length,
+                            const char* contentType) {
+    if (_finished || !data) {
+        return;
+    }
+    addPartHeader(name, filename, contentType);
+
+    Segment segment;
+    segment.data = data;
+    segment.length = length;
+    _segments.push_back(segment);
+    _length += length;
+
+    addText("\r\n");
+}
+
+void MultipartBody::finish() {
+    if (!_finished) {
+        addText("--" + _boundary + "--\r\n");
+        _finished = true;
+    }
+}
+
+String MultipartBody::contentType() const {
+    return "multipart/form-data; boundary=" + _boundary;
+}
+
+int MultipartBody::available() {
+    return (int)(_length - _consumed);
+}
+
+int MultipartBody::read() {
+    char c;
+    return readBytes(&c, 1) == 1 ? (uint8_t)c : -1;
+}
+
+int MultipartBody::peek() {
+    if (_segment >= _segments.size()) {
+        return -1;
+    }
+    Segment& segment = _segments[_segment];
+    if (segment.data) {
+        return segment.data[_segmentPos];
+    }
+    if (!segment.file) {
+        return (uint8_t)segment.text[_segmentPos];
+    }
+    segment.file.seek(segment.offset + _segmentPos);
+    return segment.file.peek();
+}
+
+size_t MultipartBody::readBytes(char* buffer, size_t length) {
+    size_t total = 0;
+    while (total < length && _segment < _segments.size()) {
+        Segment& segment = _segments[_segment];
+        size_t chunk = min(length - total, segment.length - _segmentPos);
+
+        if (segment.data) {
+            memcpy(buffer + total, segment.data + _segmentPos, chunk);
+        } else if (!segment.file) {
+            memcpy(buffer + total, segment.text.c_str() + _segmentPos, chunk);
+        } else {
+            if (_segmentPos == 0) {
+                segment.file.seek(segment.offset);
+            }
+            size_t got = segment.file.read((uint8_t*)buffer + total, chunk);
+            if (got != chunk) {
+                Serial.printf("[Multipart] Short read from %s\n", segment.file.name());
+                total += got;
+                _consumed += got;
+                _segmentPos += got;
+                break;  // Caller sees fewer bytes than Content-Length and aborts
+            }
+        }
+
+        total += chunk;
+        _consumed += chunk;
+        _segmentPos += chunk;
+        if (_segmentPos >= segment.length) {
+            if (segment.file) {
+                segment.file.close();
+            }
+            _segment++;
+            _segmentPos = 0;
+        }
+    }
+    return total;
+}
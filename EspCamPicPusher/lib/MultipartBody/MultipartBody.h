@@ -0,0 +1,100 @@
+#ifndef MULTIPART_BODY_H
+#define MULTIPART_BODY_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <vector>
+
+/**
+ * MultipartBody - multipart/form-data request body streamed from flash
+ *
+ * Text fields are kept in RAM; file parts reference a byte range of an open
+ * File and are read on demand, so a batch of several JPEGs can be posted with
+ * HTTPClient::sendRequest("POST", &body, body.length()) without loading the
+ * images into memory. Data parts reference a buffer (e.g. a frame in PSRAM)
+ * without copying it.
+ *
+ * Usage Pattern:
+ *   MultipartBody body;
+ *   body.addField("meta[0]", json, "application/json");
+ *   body.addFile("image[0]", "1.jpg", file, offset, length);
+ *   body.finish();
+ *   http.addHeader("Content-Type", body.contentType());
+ *   http.sendRequest("POST", &body, body.length());
+ */
+class MultipartBody : public Stream {
+public:
+    MultipartBody();
+
+    /**
+     * Append a text part
+     * @param name Form field name
+     * @param value Field content
+     * @param contentType Optional part Content-Type (empty = none)
+     */
+    void addField(const String& name, const String& value, const char* contentType = "");
+
+    /**
+     * Append a file part read from `file` starting at `offset`
+     * @param name Form field name
+     * @param filename File name reported to the server
+     * @param file Open file (kept open until the body is destroyed)
+     * @param offset Start of the part data in the file
+     * @param length Number of bytes to send
+     * @param contentType Part Content-Type
+     */
+    void addFile(const String& name, const String& filename, File file, size_t offset, size_t length,
+                 const char* contentType = "image/jpeg");
+
+    /**
+     * Append a file part read from memory
+     * @param data Part data, must stay valid until the body has been sent
+     * @param length Number of bytes to send
+     */
+    void addData(const String& name, const String& filename, const uint8_t* data, size_t length,
+                 const char* contentType = "image/jpeg");
+
+    /**
+     * Append the closing boundary; no parts can be added afterwards
+     */
+    void finish();
+
+    /**
+     * Total body size in bytes (valid after finish())
+     */
+    size_t length() const { return _length; }
+
+    /**
+     * Value for the request Content-Type header
+     */
+    String contentType() const;
+
+    // Stream interface (read side only)
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+    size_t write(uint8_t c) override { (void)c; return 0; }
+
+private:
+    struct Segment {
+        String text;        // In-memory bytes, used when neither `file` nor `data` is set
+        File file;
+        const uint8_t* data = nullptr;
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    String _boundary;
+    std::vector<Segment> _segments;
+    size_t _length = 0;
+    size_t _consumed = 0;
+    size_t _segment = 0;    // Current segment index
+    size_t _segmentPos = 0; // Read position inside the current segment
+    bool _finished = false;
+
+    void addText(const String& text);
+    void addPartHeader(const String& name, const String& filename, const char* contentType);
+};
+
+#endif // MULTIPART_BODY_H
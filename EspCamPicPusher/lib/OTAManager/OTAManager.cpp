@@ -76,48 +76,6 @@ bool OTAManager::confirmUpdate() {
     return true;
 }
 
-OtaUpdateInfo OTAManager::parseOtaInfo(const String& jsonResponse) {
-    OtaUpdateInfo info;
-    info.available = false;
-    
-    DynamicJsonDocument doc(2048);
-    DeserializationError error = deserializeJson(doc, jsonResponse);
-    
-    if (error) {
-        Serial.printf("[OTA] JSON parse error: %s\n", error.c_str());
-        return info;
-    }
-    
-    if (!doc.containsKey("ota")) {
-        return info;
-    }
-    
-    JsonObject ota = doc["ota"];
-    info.available = ota["available"] | false;
-    
-    if (info.available) {
-        info.firmwareFile = ota["firmware_file"] | "";
-        info.firmwareVersion = ota["firmware_version"] | "";
-        info.downloadUrl = ota["download_url"] | "";
-        info.size = ota["size"] | 0;
-        info.sha256 = ota["sha256"] | "";
-        info.mandatory = ota["mandatory"] | false;
-        
-        Serial.println("\n[OTA] Update available!");
-        Serial.printf("  Firmware: %s\n", info.firmwareFile.c_str());
-        Serial.printf("  Version: %s\n", info.firmwareVersion.c_str());
-        Serial.printf("  Size: %d bytes\n", info.size);
-        Serial.printf("  SHA256: %s\n", info.sha256.c_str());
-    }
-    
-    return info;
-}
-
-bool OTAManager::isOtaAvailable(const String& jsonResponse) {
-    OtaUpdateInfo info = parseOtaInfo(jsonResponse);
-    return info.available;
-}
-
 OtaResult OTAManager::performUpdate(const OtaUpdateInfo& info, const String& authToken, 
                                     const String& deviceId, const String& serverUrl) {
     Serial.println("\n======================================");
@@ -60,20 +60,6 @@ public:
      */
     bool begin();
     
-    /**
-     * Parse OTA info from upload JSON response
-     * @param jsonResponse JSON response string from server
-     * @return OtaUpdateInfo structure
-     */
-    OtaUpdateInfo parseOtaInfo(const String& jsonResponse);
-    
-    /**
-     * Check if OTA update is available in response
-     * @param jsonResponse JSON response from server
-     * @return true if OTA available
-     */
-    bool isOtaAvailable(const String& jsonResponse);
-    
     /**
      * Perform OTA update (download, flash, validate, reboot)
      * Blocking operation that takes 30-60 seconds
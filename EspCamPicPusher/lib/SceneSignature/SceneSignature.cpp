@@ -0,0 +1,57 @@
+#include "SceneSignature.h"
+
+bool SceneSignature::build(const jpeg_dc_stats_t& stats, const uint8_t* lumaBlocks, uint8_t* cells) {
+    // Only the blocks inside the image; the grid is padded to whole MCUs
+    uint32_t usedX = (stats.width + 7) / 8;
+    uint32_t usedY = (stats.height + 7) / 8;
+    if (usedX > stats.blocksX) usedX = stats.blocksX;
+    if (usedY > stats.blocksY) usedY = stats.blocksY;
+    if (usedX < SCENE_SIGNATURE_WIDTH || usedY < SCENE_SIGNATURE_HEIGHT) {
+        return false;
+    }
+
+    // Box filter: every block lands in exactly one cell
+    for (uint32_t cy = 0; cy < SCENE_SIGNATURE_HEIGHT; cy++) {
+        uint32_t y0 = cy * usedY / SCENE_SIGNATURE_HEIGHT;
+        uint32_t y1 = (cy + 1) * usedY / SCENE_SIGNATURE_HEIGHT;
+        for (uint32_t cx = 0; cx < SCENE_SIGNATURE_WIDTH; cx++) {
+            uint32_t x0 = cx * usedX / SCENE_SIGNATURE_WIDTH;
+            uint32_t x1 = (cx + 1) * usedX / SCENE_SIGNATURE_WIDTH;
+            uint32_t sum = 0;
+            for (uint32_t y = y0; y < y1; y++) {
+                const uint8_t* row = lumaBlocks + y * stats.blocksX;
+                for (uint32_t x = x0; x < x1; x++) {
+                    sum += row[x];
+                }
+            }
+            uint32_t count = (y1 - y0) * (x1 - x0);
+            cells[cy * SCENE_SIGNATURE_WIDTH + cx] = (uint8_t)((sum + count / 2) / count);
+        }
+    }
+    return true;
+}
+
+scene_distance_t SceneSignature::compare(const uint8_t* a, const uint8_t* b, uint8_t cellDelta) {
+    uint32_t changed = 0;
+    for (size_t i = 0; i < SCENE_SIGNATURE_CELLS; i++) {
+        int diff = (int)a[i] - (int)b[i];
+        if (diff > cellDelta || -diff > cellDelta) {
+            changed++;
+        }
+    }
+
+    scene_distance_t distance;
+    distance.meanDiff = (float)sad(a, b, SCENE_SIGNATURE_CELLS) / SCENE_SIGNATURE_CELLS;
+    distance.changedCells = (uint16_t)changed;
+    return distance;
+}
+
+uint32_t SceneSignature::sad(const uint8_t* a, const uint8_t* b, size_t len) {
+    // Plain loop: 1200 cells are a few microseconds next to the DC pass
+    uint32_t sum = 0;
+    for (size_t i = 0; i < len; i++) {
+        int diff = (int)a[i] - (int)b[i];
+        sum += diff < 0 ? -diff : diff;
+    }
+    return sum;
+}
@@ -0,0 +1,53 @@
+#ifndef SCENE_SIGNATURE_H
+#define SCENE_SIGNATURE_H
+
+#include <Arduino.h>
+#include "JpegDc.h"
+#include "SleepManager.h"
+
+// Difference between two scene signatures
+typedef struct {
+    float meanDiff;                          // Mean absolute luminance difference per cell (0..255)
+    uint16_t changedCells;                   // Cells that differ by more than the cell delta
+} scene_distance_t;
+
+/**
+ * SceneSignature - Tiny grayscale thumbnail of a frame for change detection
+ *
+ * Averages the 1/8-scale luminance map of a JPEG DC pass (see JpegDc) down
+ * to SCENE_SIGNATURE_WIDTH x SCENE_SIGNATURE_HEIGHT cells. Two signatures are
+ * compared by their sum of absolute differences (global change: light,
+ * weather) and by the number of cells that changed noticeably (local change:
+ * a car, a person), so a small object is not averaged away.
+ */
+class SceneSignature {
+public:
+    /**
+     * Build a signature from the luma blocks of JpegDc::analyze()
+     * @param stats Stats of the same DC pass (image size, block grid)
+     * @param lumaBlocks Mean luminance per 8x8 block, stats.blocksX per row
+     * @param cells Receives SCENE_SIGNATURE_CELLS bytes
+     * @return false if the image has fewer blocks than the signature has cells
+     */
+    static bool build(const jpeg_dc_stats_t& stats, const uint8_t* lumaBlocks, uint8_t* cells);
+
+    /**
+     * Compare two signatures
+     * @param cellDelta Difference above which a cell counts as changed
+     */
+    static scene_distance_t compare(const uint8_t* a, const uint8_t* b, uint8_t cellDelta);
+
+    /**
+     * Sum of absolute differences of two byte arrays
+     */
+    static uint32_t sad(const uint8_t* a, const uint8_t* b, size_t len);
+
+private:
+    // Static utility class - no instances
+    SceneSignature() = delete;
+    ~SceneSignature() = delete;
+    SceneSignature(const SceneSignature&) = delete;
+    SceneSignature& operator=(const SceneSignature&) = delete;
+};
+
+#endif // SCENE_SIGNATURE_H
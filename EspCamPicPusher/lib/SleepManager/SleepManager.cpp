@@ -1,8 +1,17 @@
 #include "SleepManager.h"
 #include <WiFi.h>
+#include "esp_timer.h"
 
 // Declare RTC data in slow RTC memory (survives deep sleep)
 RTC_DATA_ATTR static rtc_data_t rtc_data;
+RTC_DATA_ATTR static rtc_tls_session_t rtc_tls_session;
+RTC_DATA_ATTR static rtc_wifi_cache_t rtc_wifi_cache;
+RTC_DATA_ATTR static rtc_sensor_state_t rtc_sensor_state;
+RTC_DATA_ATTR static rtc_stage_timing_t rtc_stage_timing;
+RTC_DATA_ATTR static rtc_upload_gate_t rtc_upload_gate;
+RTC_DATA_ATTR static rtc_scene_signature_t rtc_scene_signature;
+RTC_DATA_ATTR static rtc_adaptive_quality_t rtc_adaptive_quality;
+RTC_DATA_ATTR static rtc_resumable_upload_t rtc_resumable_upload;
 
 SleepManager::SleepManager() {
     wakeReason = WAKE_UNKNOWN;
@@ -56,6 +65,16 @@ void SleepManager::loadRtcData() {
         Serial.println("RTC data invalid, initializing...");
         initRtcData();
         saveRtcData();
+
+        // RTC memory content is undefined after power-on
+        memset(&rtc_tls_session, 0, sizeof(rtc_tls_session_t));
+        memset(&rtc_wifi_cache, 0, sizeof(rtc_wifi_cache_t));
+        memset(&rtc_sensor_state, 0, sizeof(rtc_sensor_state_t));
+        memset(&rtc_stage_timing, 0, sizeof(rtc_stage_timing_t));
+        memset(&rtc_upload_gate, 0, sizeof(rtc_upload_gate_t));
+        memset(&rtc_scene_signature, 0, sizeof(rtc_scene_signature_t));
+        memset(&rtc_adaptive_quality, 0, sizeof(rtc_adaptive_quality_t));
+        memset(&rtc_resumable_upload, 0, sizeof(rtc_resumable_upload_t));
     }
 }
 
@@ -162,7 +181,40 @@ void SleepManager::resetWifiRetryCount() {
     saveRtcData();
 }
 
+rtc_tls_session_t* SleepManager::getTlsSessionCache() {
+    return &rtc_tls_session;
+}
+
+rtc_wifi_cache_t* SleepManager::getWifiCache() {
+    return &rtc_wifi_cache;
+}
+
+rtc_sensor_state_t* SleepManager::getSensorStateCache() {
+    return &rtc_sensor_state;
+}
+
+rtc_stage_timing_t* SleepManager::getStageTimingCache() {
+    return &rtc_stage_timing;
+}
+
+rtc_upload_gate_t* SleepManager::getUploadGateCache() {
+    return &rtc_upload_gate;
+}
+
+rtc_scene_signature_t* SleepManager::getSceneSignatureCache() {
+    return &rtc_scene_signature;
+}
+
+rtc_adaptive_quality_t* SleepManager::getAdaptiveQualityCache() {
+    return &rtc_adaptive_quality;
+}
+
+rtc_resumable_upload_t* SleepManager::getResumableUploadCache() {
+    return &rtc_resumable_upload;
+}
+
 void SleepManager::enterDeepSleep(uint64_t seconds) {
+    int64_t entryUs = esp_timer_get_time();
     Serial.printf("\n=== Entering Deep Sleep for %llu seconds ===\n", seconds);
     Serial.println("Next wake time will be approximately:");
     
@@ -181,6 +233,11 @@ void SleepManager::enterDeepSleep(uint64_t seconds) {
     // Configure timer wakeup
     uint64_t sleepDuration = seconds * 1000000ULL; // Convert to microseconds
     esp_sleep_enable_timer_wakeup(sleepDuration);
+
+    // Reported by the next wake (StageTimer "prev")
+    int64_t nowUs = esp_timer_get_time();
+    rtc_stage_timing.sleepEntryMs = (uint32_t)((nowUs - entryUs) / 1000);
+    rtc_stage_timing.awakeMs = (uint32_t)(nowUs / 1000);
     
     // Enter deep sleep
     esp_deep_sleep_start();
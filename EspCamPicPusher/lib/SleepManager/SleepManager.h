@@ -15,6 +15,124 @@ typedef struct {
     uint32_t wifiRetryCount;  // WiFi retry attempts during timer wake
 } rtc_data_t;
 
+// Last good WiFi association and IP lease, used by the timer-wake fast
+// connect to skip the channel scan and DHCP (see setupWiFiFastConnect())
+typedef struct {
+    uint32_t magic;                          // Magic number, cleared to invalidate the cache
+    uint32_t credentialsHash;                // Hash of SSID + password the cache belongs to
+    uint8_t bssid[6];                        // Access point BSSID
+    uint8_t channel;                         // Primary channel
+    uint32_t localIp;                        // IP lease (network byte order as in IPAddress)
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns1;
+    uint32_t dns2;
+    time_t savedAt;                          // Epoch time the lease was obtained via DHCP
+} rtc_wifi_cache_t;
+
+// TLS session kept in RTC memory so the next wake can do an abbreviated
+// handshake (session ID or ticket + master secret, see TlsSessionClient)
+#define TLS_SESSION_ID_MAX      32
+#define TLS_SESSION_MASTER_LEN  48
+#define TLS_SESSION_TICKET_MAX  256
+
+typedef struct {
+    uint32_t magic;                          // Magic number, cleared to invalidate the session
+    uint32_t hostHash;                       // Hash of "host:port" the session belongs to
+    int32_t ciphersuite;                     // Negotiated ciphersuite ID
+    time_t savedAt;                          // Epoch time the session was stored
+    uint32_t ticketLifetime;                 // Ticket lifetime hint in seconds (0 = none)
+    uint8_t idLen;
+    uint8_t id[TLS_SESSION_ID_MAX];
+    uint8_t master[TLS_SESSION_MASTER_LEN];
+    uint16_t ticketLen;
+    uint8_t ticket[TLS_SESSION_TICKET_MAX];
+    uint32_t resumedCount;                   // Abbreviated handshakes since power-on
+    uint32_t fullCount;                      // Full handshakes since power-on
+    uint32_t fullHandshakeMs;                // Running average of full handshake duration
+    uint32_t savedMsTotal;                   // Handshake time saved by resumption since power-on
+} rtc_tls_session_t;
+
+// Converged sensor exposure per hour of day, used to seed AEC/AGC on the
+// next wake so warm-up starts close to where it ended at that time yesterday
+#define SENSOR_STATE_SLOTS 24
+
+typedef struct {
+    time_t savedAt;                          // Epoch time of the snapshot (0 = empty)
+    uint16_t aec;                            // OV2640 exposure (AEC[15:0])
+    uint8_t gain;                            // OV2640 AGC gain register
+    uint8_t luma;                            // Mean luminance of the converged frame
+} rtc_sensor_slot_t;
+
+typedef struct {
+    uint32_t magic;                          // Magic number, cleared to invalidate the slots
+    rtc_sensor_slot_t slots[SENSOR_STATE_SLOTS];  // Indexed by UTC hour of day
+    uint32_t seededCount;                    // Wakes seeded from a slot since power-on
+} rtc_sensor_state_t;
+
+// Wake-cycle stage durations (see StageTimer), kept so the next wake can
+// report the stages that ran after its predecessor's upload
+#define WAKE_STAGE_SLOTS 16
+
+typedef struct {
+    uint32_t magic;                          // Magic number, set by StageTimer
+    uint32_t recorded;                       // Bitmask of recorded stages
+    uint32_t stageMs[WAKE_STAGE_SLOTS];      // Duration per WakeStage
+    uint32_t sleepEntryMs;                   // enterDeepSleep() to esp_deep_sleep_start()
+    uint32_t awakeMs;                        // Time since boot at esp_deep_sleep_start()
+} rtc_stage_timing_t;
+
+// Upload gating of scheduled captures (see gateExposure), so skipped black
+// or blown-out frames still leave a low-rate keep-alive upload
+typedef struct {
+    uint32_t magic;                          // Magic number, cleared to invalidate the state
+    time_t lastUploadAt;                     // Epoch time of the last successful upload
+    uint32_t skippedCount;                   // Frames skipped since the last upload
+    uint32_t skippedTotal;                   // Frames skipped since power-on
+} rtc_upload_gate_t;
+
+// Tiny grayscale thumbnail of the last uploaded frame (see SceneSignature),
+// compared against the next scheduled capture to skip unchanged scenes
+#define SCENE_SIGNATURE_WIDTH   40
+#define SCENE_SIGNATURE_HEIGHT  30
+#define SCENE_SIGNATURE_CELLS   (SCENE_SIGNATURE_WIDTH * SCENE_SIGNATURE_HEIGHT)
+
+typedef struct {
+    uint32_t magic;                          // Magic number, cleared to invalidate the signature
+    uint16_t width;                          // Image size the signature was taken from
+    uint16_t height;
+    time_t savedAt;                          // Epoch time of the uploaded frame
+    uint32_t unchangedCount;                 // Heartbeats sent instead of images since then
+    uint32_t unchangedTotal;                 // Heartbeats since power-on
+    uint8_t cells[SCENE_SIGNATURE_CELLS];    // Mean luminance per cell, row-major
+} rtc_scene_signature_t;
+
+// Upload throughput and JPEG size-vs-quality curve (see AdaptiveQuality),
+// used to pick the JPEG quality that fits the next upload into a byte budget
+typedef struct {
+    uint32_t magic;                          // Magic number, set by AdaptiveQuality
+    float throughput;                        // Smoothed upload throughput in bytes/s (0 = no sample)
+    int8_t rssi;                             // Smoothed RSSI the throughput was measured at (dBm)
+    float curveA;                            // Size curve: ln(bytes per pixel) = curveA - curveB * ln(quality)
+    float curveB;
+    uint8_t lastQuality;                     // Quality of the last recorded frame (0 = none)
+    float lastLogBpp;                        // ln(bytes per pixel) of that frame
+    uint32_t uploadCount;                    // Uploads measured since power-on
+    uint32_t failedCount;                    // Uploads that broke off after connecting since power-on
+} rtc_adaptive_quality_t;
+
+// Resumable upload session of the last image whose upload broke off (see
+// "Resumable Upload" in upload.cpp); the image itself waits in the ImageQueue
+typedef struct {
+    uint32_t magic;                          // Magic number, cleared to invalidate the state
+    char session[40];                        // Session ID from upload-resumable.php ("" = none)
+    uint8_t sha256[32];                      // SHA-256 of the JPEG
+    uint32_t length;                         // JPEG size in bytes
+    uint32_t committed;                      // Bytes the server had stored at its last answer
+    char timestamp[24];                      // X-Timestamp of the image, identifies the queue entry
+    int16_t rejectedStatus;                  // 401/403/413 of the last upload (0 = none): the next one opens a session first
+} rtc_resumable_upload_t;
+
 enum WakeReason {
     WAKE_POWER_ON,      // Fresh boot/power cycle
     WAKE_TIMER,         // Woken by timer for scheduled capture
@@ -121,7 +239,57 @@ public:
      * Reset WiFi retry counter
      */
     void resetWifiRetryCount();
-    
+
+    /**
+     * Get the TLS session cache in RTC memory
+     * Owned by SleepManager so it is reset together with rtc_data_t on power-on
+     * @return Pointer to the RTC-resident session cache
+     */
+    rtc_tls_session_t* getTlsSessionCache();
+
+    /**
+     * Get the WiFi fast-connect cache in RTC memory
+     * @return Pointer to the RTC-resident BSSID/channel/lease cache
+     */
+    rtc_wifi_cache_t* getWifiCache();
+
+    /**
+     * Get the sensor exposure snapshots in RTC memory
+     * @return Pointer to the RTC-resident time-of-day exposure slots
+     */
+    rtc_sensor_state_t* getSensorStateCache();
+
+    /**
+     * Get the wake-cycle stage timing in RTC memory
+     * enterDeepSleep() adds the sleep entry and total awake time
+     * @return Pointer to the RTC-resident stage timing
+     */
+    rtc_stage_timing_t* getStageTimingCache();
+
+    /**
+     * Get the upload gating state in RTC memory
+     * @return Pointer to the RTC-resident last-upload time and skip counters
+     */
+    rtc_upload_gate_t* getUploadGateCache();
+
+    /**
+     * Get the scene signature of the last uploaded frame in RTC memory
+     * @return Pointer to the RTC-resident signature and heartbeat counters
+     */
+    rtc_scene_signature_t* getSceneSignatureCache();
+
+    /**
+     * Get the adaptive JPEG quality state in RTC memory
+     * @return Pointer to the RTC-resident throughput and size curve
+     */
+    rtc_adaptive_quality_t* getAdaptiveQualityCache();
+
+    /**
+     * Get the open resumable upload session in RTC memory
+     * @return Pointer to the RTC-resident session of the last broken-off upload
+     */
+    rtc_resumable_upload_t* getResumableUploadCache();
+
 private:
     rtc_data_t rtcData;
     WakeReason wakeReason;
@@ -0,0 +1,116 @@
+#include "StageTimer.h"
+#include "esp_timer.h"
+
+#define STAGE_TIMING_MAGIC 0x53544733  // "STG3", bumped when the stage list changes
+
+int64_t StageTimer::_startUs[STAGE_COUNT] = {};
+uint32_t StageTimer::_durationMs[STAGE_COUNT] = {};
+uint32_t StageTimer::_recorded = 0;
+rtc_stage_timing_t* StageTimer::_cache = nullptr;
+rtc_stage_timing_t StageTimer::_previous = {};
+
+// Keys used in the header, the log context and by tools/wake_timing_report.py
+const char* const StageTimer::_names[STAGE_COUNT] = {
+    "boot", "rtc", "cfg", "wifi", "ntp", "cam", "warm", "cap", "gate", "thumb", "tls", "send", "resp"
+};
+
+static_assert(STAGE_COUNT <= WAKE_STAGE_SLOTS, "rtc_stage_timing_t too small for all stages");
+
+void StageTimer::begin(rtc_stage_timing_t* cache) {
+    _cache = cache;
+    if (!_cache) {
+        return;
+    }
+
+    // Sleep entry and awake time are written by SleepManager::enterDeepSleep()
+    memcpy(&_previous, _cache, sizeof(rtc_stage_timing_t));
+    if (_previous.magic != STAGE_TIMING_MAGIC) {
+        _previous.recorded = 0;
+    }
+
+    memset(_cache, 0, sizeof(rtc_stage_timing_t));
+    _cache->magic = STAGE_TIMING_MAGIC;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        mirror((WakeStage)i);
+    }
+}
+
+void StageTimer::start(WakeStage stage) {
+    _startUs[stage] = esp_timer_get_time();
+}
+
+void StageTimer::stop(WakeStage stage) {
+    int64_t elapsedUs = esp_timer_get_time() - _startUs[stage];
+    add(stage, (uint32_t)((elapsedUs + 500) / 1000));
+}
+
+void StageTimer::add(WakeStage stage, uint32_t ms) {
+    _durationMs[stage] += ms;
+    _recorded |= (1u << stage);
+    mirror(stage);
+}
+
+uint32_t StageTimer::getMs(WakeStage stage) {
+    return _durationMs[stage];
+}
+
+void StageTimer::mirror(WakeStage stage) {
+    if (!_cache || !(_recorded & (1u << stage))) {
+        return;
+    }
+    _cache->stageMs[stage] = _durationMs[stage];
+    _cache->recorded |= (1u << stage);
+}
+
+String StageTimer::header() {
+    String out;
+    out.reserve(192);
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if (_recorded & (1u << i)) {
+            out += _names[i];
+            out += '=';
+            out += String(_durationMs[i]);
+            out += ',';
+        }
+    }
+    out += "total=" + String((uint32_t)(esp_timer_get_time() / 1000));
+
+    String prev;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if ((_previous.recorded & (1u << i)) && !(_recorded & (1u << i))) {
+            prev += _names[i];
+            prev += '=';
+            prev += String(_previous.stageMs[i]);
+            prev += ',';
+        }
+    }
+    if (_previous.awakeMs > 0) {
+        prev += "sleep=" + String(_previous.sleepEntryMs) + ",awake=" + String(_previous.awakeMs) + ",";
+    }
+    if (prev.length() > 0) {
+        out += ";prev:" + prev.substring(0, prev.length() - 1);
+    }
+    return out;
+}
+
+void StageTimer::addTo(JsonObject context) {
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if (_recorded & (1u << i)) {
+            context[_names[i]] = _durationMs[i];
+        }
+    }
+    context["total_ms"] = (uint32_t)(esp_timer_get_time() / 1000);
+
+    if (_previous.recorded || _previous.awakeMs > 0) {
+        JsonObject prev = context.createNestedObject("prev");
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            if (_previous.recorded & (1u << i)) {
+                prev[_names[i]] = _previous.stageMs[i];
+            }
+        }
+        if (_previous.awakeMs > 0) {
+            prev["sleep"] = _previous.sleepEntryMs;
+            prev["awake"] = _previous.awakeMs;
+        }
+    }
+}
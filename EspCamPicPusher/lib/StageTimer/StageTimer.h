@@ -0,0 +1,104 @@
+#ifndef STAGE_TIMER_H
+#define STAGE_TIMER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "SleepManager.h"
+
+// Stages of a wake cycle, in the order they usually start
+enum WakeStage {
+    STAGE_BOOT,            // App start through serial setup (until SleepManager::begin)
+    STAGE_RTC,             // SleepManager::begin (RTC data, wake reason)
+    STAGE_CONFIG,          // ConfigManager::begin (NVS)
+    STAGE_WIFI,            // Association + DHCP
+    STAGE_NTP,             // NTP sync (only when due)
+    STAGE_CAMERA_INIT,     // Camera driver init + sensor settings
+    STAGE_WARMUP,          // Sensor warm-up
+    STAGE_CAPTURE,         // Frame capture
+    STAGE_ANALYZE,         // Exposure gating and scene change (JPEG DC pass)
+    STAGE_THUMBNAIL,       // Thumbnail (JPEG DC pass + encoding)
+    STAGE_TLS,             // TCP connect + TLS handshake of the image upload (pre-connected: wait for it)
+    STAGE_SEND,            // Request headers + JPEG body
+    STAGE_RESPONSE,        // Waiting for the server response
+    STAGE_COUNT
+};
+
+/**
+ * StageTimer - Monotonic per-stage timing of a wake cycle
+ * 
+ * Stamps stages with esp_timer_get_time() (microseconds since boot, not
+ * affected by NTP) and reports them in milliseconds. A stage that runs more
+ * than once accumulates. Stages may overlap (camera init runs in parallel
+ * with WiFi on timer wake).
+ * 
+ * Durations are mirrored into RTC memory, so the next wake can report what
+ * happened after its predecessor's upload left (upload stages, deep-sleep
+ * entry, total awake time) as "prev" values.
+ * 
+ * start()/stop() may be called from any task, but one stage must not be
+ * timed from two tasks at once.
+ */
+class StageTimer {
+public:
+    /**
+     * Pick up the previous cycle's timing from RTC memory and start mirroring
+     * this cycle's. Call right after SleepManager::begin() (RTC data validated).
+     * @param cache Cache from SleepManager::getStageTimingCache()
+     */
+    static void begin(rtc_stage_timing_t* cache);
+
+    /**
+     * Mark the start of a stage
+     */
+    static void start(WakeStage stage);
+
+    /**
+     * Mark the end of a stage started with start()
+     */
+    static void stop(WakeStage stage);
+
+    /**
+     * Add a duration measured elsewhere
+     * @param stage Stage to add to
+     * @param ms Duration in milliseconds
+     */
+    static void add(WakeStage stage, uint32_t ms);
+
+    /**
+     * Get accumulated duration of a stage
+     * @return Milliseconds, 0 if the stage was not recorded
+     */
+    static uint32_t getMs(WakeStage stage);
+
+    /**
+     * Compact breakdown for an HTTP header, e.g.
+     * "boot=1210,rtc=2,cfg=14,wifi=301,cam=449,warm=199,cap=66,total=2150;prev:tls=251,send=40,resp=95,sleep=203,awake=2890"
+     * Only recorded stages are listed; "prev" holds the previous cycle's
+     * stages not (yet) recorded in this one plus its sleep entry and awake time.
+     */
+    static String header();
+
+    /**
+     * Add the breakdown to a JSON object (stage names as keys, "total_ms",
+     * and a nested "prev" object)
+     */
+    static void addTo(JsonObject context);
+
+private:
+    static int64_t _startUs[STAGE_COUNT];
+    static uint32_t _durationMs[STAGE_COUNT];
+    static uint32_t _recorded;                   // Bitmask of recorded stages
+    static rtc_stage_timing_t* _cache;
+    static rtc_stage_timing_t _previous;         // Previous cycle (magic = 0 if unavailable)
+    static const char* const _names[STAGE_COUNT];
+
+    static void mirror(WakeStage stage);
+
+    // Static utility class - no instances
+    StageTimer() = delete;
+    ~StageTimer() = delete;
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+};
+
+#endif // STAGE_TIMER_H
@@ -0,0 +1,70 @@
+#include "Thumbnail.h"
+#include "JpegDc.h"
+#include "img_converters.h"
+
+namespace {
+
+struct JpegSink {
+    uint8_t* data;
+    size_t capacity;
+    size_t length;
+};
+
+size_t appendJpeg(void* arg, size_t index, const void* data, size_t len) {
+    JpegSink* sink = (JpegSink*)arg;
+    if (index != sink->length || sink->length + len > sink->capacity) {
+        return 0;  // Aborts the encoder
+    }
+    memcpy(sink->data + sink->length, data, len);
+    sink->length += len;
+    return len;
+}
+
+} // namespace
+
+bool Thumbnail::create(const uint8_t* jpeg, size_t len, uint8_t quality, size_t maxBytes,
+                       thumbnail_t& thumbnail) {
+    memset(&thumbnail, 0, sizeof(thumbnail));
+
+    uint16_t width = 0;
+    uint16_t height = 0;
+    if (!JpegDc::dimensions(jpeg, len, width, height)) {
+        return false;
+    }
+
+    unsigned long start = millis();
+    size_t bgrLen = (size_t)((width + 7) / 8) * ((height + 7) / 8) * 3;
+    uint8_t* bgr = (uint8_t*)ps_malloc(bgrLen);
+    if (!bgr) {
+        Serial.println("[Thumbnail] Out of PSRAM");
+        return false;
+    }
+    if (!JpegDc::dcImage(jpeg, len, bgr, bgrLen, thumbnail.width, thumbnail.height)) {
+        free(bgr);
+        return false;
+    }
+    thumbnail.decodeMs = millis() - start;
+
+    start = millis();
+    JpegSink sink = { (uint8_t*)ps_malloc(maxBytes), maxBytes, 0 };
+    bool encoded = sink.data &&
+                   fmt2jpg_cb(bgr, bgrLen, thumbnail.width, thumbnail.height, PIXFORMAT_RGB888,
+                              quality, appendJpeg, &sink);
+    free(bgr);
+    thumbnail.encodeMs = millis() - start;
+
+    if (!encoded) {
+        Serial.printf("[Thumbnail] Encoding failed (limit %u bytes)\n", (unsigned)maxBytes);
+        free(sink.data);
+        return false;
+    }
+    thumbnail.data = sink.data;
+    thumbnail.length = sink.length;
+    return true;
+}
+
+void Thumbnail::release(thumbnail_t& thumbnail) {
+    free(thumbnail.data);
+    thumbnail.data = nullptr;
+    thumbnail.length = 0;
+}
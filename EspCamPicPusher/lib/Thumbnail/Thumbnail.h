@@ -0,0 +1,52 @@
+#ifndef THUMBNAIL_H
+#define THUMBNAIL_H
+
+#include <Arduino.h>
+
+// JPEG thumbnail of a frame, in PSRAM (see Thumbnail::create)
+typedef struct {
+    uint8_t* data;                           // JPEG data, nullptr if none
+    size_t length;
+    uint16_t width;
+    uint16_t height;
+    uint32_t decodeMs;                       // DC pass + color conversion
+    uint32_t encodeMs;                       // JPEG encoding
+} thumbnail_t;
+
+/**
+ * Thumbnail - Small JPEG of a camera frame, made on the device
+ *
+ * The frame is decoded at 1/8 scale from its DC coefficients only (see
+ * JpegDc::dcImage, e.g. 200x150 for UXGA) and re-encoded with the
+ * esp32-camera software JPEG encoder. The cost is one DC pass over the
+ * frame plus encoding a fixed, small number of pixels. All buffers are in
+ * PSRAM; the source frame is not copied.
+ */
+class Thumbnail {
+public:
+    /**
+     * Create a thumbnail of a JPEG frame
+     * @param jpeg Source frame
+     * @param len Source frame size in bytes
+     * @param quality JPEG quality of the thumbnail, 1..100 (higher is better)
+     * @param maxBytes Upper limit for the thumbnail JPEG; larger fails
+     * @param thumbnail Receives the thumbnail; free with release()
+     * @return true on success
+     */
+    static bool create(const uint8_t* jpeg, size_t len, uint8_t quality, size_t maxBytes,
+                       thumbnail_t& thumbnail);
+
+    /**
+     * Free the thumbnail data
+     */
+    static void release(thumbnail_t& thumbnail);
+
+private:
+    // Static utility class - no instances
+    Thumbnail() = delete;
+    ~Thumbnail() = delete;
+    Thumbnail(const Thumbnail&) = delete;
+    Thumbnail& operator=(const Thumbnail&) = delete;
+};
+
+#endif // THUMBNAIL_H
@@ -0,0 +1,498 @@
+#include "TlsSessionClient.h"
+#include <WiFi.h>
+
+#ifndef NATIVE_BUILD
+#include "mbedtls/error.h"
+#include "mbedtls/platform.h"
+#endif
+
+#define TLS_SESSION_MAGIC 0x544C5331  // "TLS1"
+
+static const uint32_t DEFAULT_HANDSHAKE_TIMEOUT_MS = 10000;
+static const int32_t DEFAULT_CONNECT_TIMEOUT_MS = 3000;
+
+#ifdef NATIVE_BUILD
+// Host model of the ESP32-S3 handshake cost (ECDHE full vs. abbreviated)
+static const uint32_t NATIVE_FULL_HANDSHAKE_MS = 1200;
+static const uint32_t NATIVE_RESUMED_HANDSHAKE_MS = 250;
+#endif
+
+TlsSessionClient::TlsSessionClient()
+    : _cache(nullptr),
+      _handshakeTimeoutMs(DEFAULT_HANDSHAKE_TIMEOUT_MS),
+      _handshakeMs(0),
+      _connectedAtMs(0),
+      _lastWriteAtMs(0),
+      _resumed(false),
+      _tlsActive(false),
+      _peeked(-1) {
+}
+
+TlsSessionClient::~TlsSessionClient() {
+    stop();
+}
+
+void TlsSessionClient::setSessionCache(rtc_tls_session_t* cache) {
+    _cache = cache;
+}
+
+uint32_t TlsSessionClient::hashHost(const char* host, uint16_t port) {
+    // FNV-1a over "host:port"
+    uint32_t hash = 2166136261u;
+    for (const char* p = host; *p; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash = (hash ^ ':') * 16777619u;
+    hash = (hash ^ (port & 0xFF)) * 16777619u;
+    hash = (hash ^ (port >> 8)) * 16777619u;
+    return hash;
+}
+
+bool TlsSessionClient::cacheMatches(uint32_t hostHash) const {
+    if (!_cache || _cache->magic != TLS_SESSION_MAGIC || _cache->hostHash != hostHash) {
+        return false;
+    }
+
+    // Respect the ticket lifetime hint when the clock is valid
+    time_t now = time(nullptr);
+    if (_cache->ticketLen > 0 && _cache->ticketLifetime > 0 && now > 1600000000 &&
+        now - _cache->savedAt > (time_t)_cache->ticketLifetime) {
+        Serial.println("[TLS] Cached session ticket expired");
+        return false;
+    }
+
+    return true;
+}
+
+uint32_t TlsSessionClient::getSavedMs() const {
+    if (!_resumed || !_cache || _cache->fullHandshakeMs <= _handshakeMs) {
+        return 0;
+    }
+    return _cache->fullHandshakeMs - _handshakeMs;
+}
+
+void TlsSessionClient::recordHandshake() {
+    if (_resumed) {
+        Serial.printf("[TLS] Session resumed, handshake %u ms\n", _handshakeMs);
+    } else {
+        Serial.printf("[TLS] Full handshake %u ms\n", _handshakeMs);
+    }
+
+    if (!_cache) {
+        return;
+    }
+
+    if (_resumed) {
+        _cache->resumedCount++;
+        _cache->savedMsTotal += getSavedMs();
+    } else {
+        _cache->fullCount++;
+        // Running average so the saved-time estimate follows network conditions
+        if (_cache->fullHandshakeMs == 0) {
+            _cache->fullHandshakeMs = _handshakeMs;
+        } else {
+            _cache->fullHandshakeMs = (_cache->fullHandshakeMs * 3 + _handshakeMs) / 4;
+        }
+    }
+}
+
+int TlsSessionClient::connect(IPAddress ip, uint16_t port) {
+    return connect(ip.toString().c_str(), port, 0);
+}
+
+int TlsSessionClient::connect(IPAddress ip, uint16_t port, int32_t timeout) {
+    return connect(ip.toString().c_str(), port, timeout);
+}
+
+int TlsSessionClient::connect(const char* host, uint16_t port) {
+    return connect(host, port, 0);
+}
+
+int TlsSessionClient::connect(const char* host, uint16_t port, int32_t timeout) {
+    stop();
+    _resumed = false;
+    _handshakeMs = 0;
+    _connectedAtMs = 0;
+    _lastWriteAtMs = 0;
+
+    uint32_t hostHash = hashHost(host, port);
+    bool offerSession = cacheMatches(hostHash);
+
+    int result = connectOnce(host, port, timeout, offerSession);
+    if (!result && offerSession && _cache) {
+        // Some servers abort instead of falling back when a ticket is stale
+        Serial.println("[TLS] Handshake with cached session failed, retrying with full handshake");
+        _cache->magic = 0;
+        result = connectOnce(host, port, timeout, false);
+    }
+
+    if (result) {
+        _connectedAtMs = millis();
+        recordHandshake();
+    }
+    return result;
+}
+
+#ifndef NATIVE_BUILD
+
+// ============================================================================
+// mbedTLS implementation (device)
+// ============================================================================
+
+int TlsSessionClient::connectOnce(const char* host, uint16_t port, int32_t timeout, bool offerSession) {
+    IPAddress ip;
+    if (!WiFi.hostByName(host, ip)) {
+        Serial.printf("[TLS] DNS lookup for %s failed\n", host);
+        return 0;
+    }
+
+    // Qualified call: WiFiClient::connect(host, ...) dispatches back into this class
+    if (!WiFiClient::connect(ip, port, timeout > 0 ? timeout : DEFAULT_CONNECT_TIMEOUT_MS)) {
+        Serial.printf("[TLS] TCP connect to %s:%u failed\n", host, port);
+        return 0;
+    }
+
+    mbedtls_ssl_init(&_ssl);
+    mbedtls_ssl_config_init(&_conf);
+    mbedtls_entropy_init(&_entropy);
+    mbedtls_ctr_drbg_init(&_drbg);
+    mbedtls_net_init(&_net);
+    _tlsActive = true;
+
+    int ret = mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy, nullptr, 0);
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) {
+        mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_NONE);
+        mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_drbg);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+        mbedtls_ssl_conf_session_tickets(&_conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+        ret = mbedtls_ssl_setup(&_ssl, &_conf);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ssl_set_hostname(&_ssl, host);
+    }
+    if (ret != 0) {
+        Serial.printf("[TLS] Setup failed: -0x%04x\n", -ret);
+        stop();
+        return 0;
+    }
+
+    // Drive the WiFiClient socket directly, non-blocking like ssl_client.cpp
+    _net.fd = fd();
+    mbedtls_net_set_nonblock(&_net);
+    mbedtls_ssl_set_bio(&_ssl, &_net, mbedtls_net_send, mbedtls_net_recv, nullptr);
+
+    bool offered = offerSession && offerCachedSession();
+
+    uint32_t start = millis();
+    while ((ret = mbedtls_ssl_handshake(&_ssl)) != 0) {
+        if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+            char error[100];
+            mbedtls_strerror(ret, error, sizeof(error));
+            Serial.printf("[TLS] Handshake failed: -0x%04x %s\n", -ret, error);
+            stop();
+            return 0;
+        }
+        if (millis() - start > _handshakeTimeoutMs) {
+            Serial.println("[TLS] Handshake timeout");
+            stop();
+            return 0;
+        }
+        delay(2);
+    }
+    _handshakeMs = millis() - start;
+
+    // A resumed handshake keeps the master secret of the offered session
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_get_session(&_ssl, &session) == 0) {
+        _resumed = offered && memcmp(session.master, _cache->master, TLS_SESSION_MASTER_LEN) == 0;
+        storeSession(&session, hashHost(host, port));
+    }
+    mbedtls_ssl_session_free(&session);
+
+    return 1;
+}
+
+bool TlsSessionClient::offerCachedSession() {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+
+    session.ciphersuite = _cache->ciphersuite;
+    session.id_len = _cache->idLen;
+    memcpy(session.id, _cache->id, _cache->idLen);
+    memcpy(session.master, _cache->master, TLS_SESSION_MASTER_LEN);
+#if defined(MBEDTLS_HAVE_TIME)
+    session.start = _cache->savedAt;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    if (_cache->ticketLen > 0) {
+        session.ticket = (unsigned char*)mbedtls_calloc(1, _cache->ticketLen);
+        if (session.ticket) {
+            memcpy(session.ticket, _cache->ticket, _cache->ticketLen);
+            session.ticket_len = _cache->ticketLen;
+            session.ticket_lifetime = _cache->ticketLifetime;
+        }
+    }
+#endif
+
+    // mbedtls_ssl_set_session() takes a deep copy
+    int ret = mbedtls_ssl_set_session(&_ssl, &session);
+    mbedtls_ssl_session_free(&session);
+
+    if (ret != 0) {
+        Serial.printf("[TLS] Failed to offer cached session: -0x%04x\n", -ret);
+        return false;
+    }
+    return true;
+}
+
+void TlsSessionClient::storeSession(const mbedtls_ssl_session* session, uint32_t hostHash) {
+    if (!_cache) {
+        return;
+    }
+
+    size_t ticketLen = 0;
+    uint32_t ticketLifetime = 0;
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    ticketLen = session->ticket_len;
+    ticketLifetime = session->ticket_lifetime;
+#endif
+
+    if (ticketLen > TLS_SESSION_TICKET_MAX || (ticketLen == 0 && session->id_len == 0)) {
+        Serial.printf("[TLS] Session not cacheable (ticket %u bytes, id %u bytes)\n",
+                      (unsigned)ticketLen, (unsigned)session->id_len);
+        _cache->magic = 0;
+        return;
+    }
+
+    // Keep the original timestamp when the server resumed without issuing a new ticket
+    bool sameTicket = _resumed && ticketLen == _cache->ticketLen &&
+                      memcmp(_cache->ticket, session->ticket, ticketLen) == 0;
+
+    _cache->hostHash = hostHash;
+    _cache->ciphersuite = session->ciphersuite;
+    _cache->idLen = session->id_len;
+    memcpy(_cache->id, session->id, session->id_len);
+    memcpy(_cache->master, session->master, TLS_SESSION_MASTER_LEN);
+    _cache->ticketLen = ticketLen;
+    if (ticketLen > 0) {
+        memcpy(_cache->ticket, session->ticket, ticketLen);
+    }
+    _cache->ticketLifetime = ticketLifetime;
+    if (!sameTicket) {
+        _cache->savedAt = time(nullptr);
+    }
+    _cache->magic = TLS_SESSION_MAGIC;
+}
+
+void TlsSessionClient::freeTls() {
+    mbedtls_ssl_free(&_ssl);
+    mbedtls_ssl_config_free(&_conf);
+    mbedtls_ctr_drbg_free(&_drbg);
+    mbedtls_entropy_free(&_entropy);
+    // _net.fd belongs to WiFiClient, which closes it in stop()
+    _tlsActive = false;
+}
+
+size_t TlsSessionClient::write(uint8_t data) {
+    return write(&data, 1);
+}
+
+size_t TlsSessionClient::write(const uint8_t* buf, size_t size) {
+    if (!_tlsActive) {
+        return 0;
+    }
+
+    size_t sent = 0;
+    uint32_t lastProgress = millis();
+    while (sent < size) {
+        int ret = mbedtls_ssl_write(&_ssl, buf + sent, size - sent);
+        if (ret > 0) {
+            sent += ret;
+            lastProgress = millis();
+            continue;
+        }
+        if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+            Serial.printf("[TLS] Write failed: -0x%04x\n", -ret);
+            stop();
+            break;
+        }
+        if (millis() - lastProgress > _handshakeTimeoutMs) {
+            Serial.println("[TLS] Write timeout");
+            break;
+        }
+        delay(1);
+    }
+    if (sent > 0) {
+        _lastWriteAtMs = millis();
+    }
+    return sent;
+}
+
+int TlsSessionClient::available() {
+    int peeked = _peeked >= 0 ? 1 : 0;
+    if (!_tlsActive) {
+        return peeked;
+    }
+
+    // Zero-length read processes pending records without consuming data
+    int ret = mbedtls_ssl_read(&_ssl, nullptr, 0);
+    if (ret < 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+        if (ret != MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
+            Serial.printf("[TLS] Read failed: -0x%04x\n", -ret);
+        }
+        if (!peeked) {
+            stop();
+        }
+        return peeked;
+    }
+    return peeked + mbedtls_ssl_get_bytes_avail(&_ssl);
+}
+
+int TlsSessionClient::read() {
+    uint8_t data;
+    return read(&data, 1) == 1 ? data : -1;
+}
+
+int TlsSessionClient::read(uint8_t* buf, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+
+    int count = 0;
+    if (_peeked >= 0) {
+        buf[0] = (uint8_t)_peeked;
+        _peeked = -1;
+        count = 1;
+        if (size == 1) {
+            return 1;
+        }
+    }
+
+    if (!_tlsActive) {
+        return count > 0 ? count : -1;
+    }
+
+    int ret = mbedtls_ssl_read(&_ssl, buf + count, size - count);
+    if (ret > 0) {
+        return count + ret;
+    }
+    if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+        // Peer closed (0 / close notify) or fatal error
+        stop();
+    }
+    return count > 0 ? count : -1;
+}
+
+int TlsSessionClient::peek() {
+    if (_peeked >= 0 || !_tlsActive) {
+        return _peeked;
+    }
+
+    uint8_t data;
+    if (mbedtls_ssl_read(&_ssl, &data, 1) == 1) {
+        _peeked = data;
+    }
+    return _peeked;
+}
+
+void TlsSessionClient::flush() {
+    // mbedtls_ssl_write() does not buffer application data
+}
+
+void TlsSessionClient::stop() {
+    if (_tlsActive) {
+        mbedtls_ssl_close_notify(&_ssl);
+        freeTls();
+    }
+    _peeked = -1;
+    WiFiClient::stop();
+}
+
+uint8_t TlsSessionClient::connected() {
+    if (_peeked >= 0 || (_tlsActive && mbedtls_ssl_get_bytes_avail(&_ssl) > 0)) {
+        return 1;
+    }
+    return _tlsActive && WiFiClient::connected();
+}
+
+#else
+
+// ============================================================================
+// Host model (native build): plain TCP, handshake cost simulated with delay()
+// ============================================================================
+
+int TlsSessionClient::connectOnce(const char* host, uint16_t port, int32_t timeout, bool offerSession) {
+    if (!WiFiClient::connect(host, port, timeout > 0 ? timeout : DEFAULT_CONNECT_TIMEOUT_MS)) {
+        Serial.printf("[TLS] TCP connect to %s:%u failed\n", host, port);
+        return 0;
+    }
+    _tlsActive = true;
+
+    // The stand-in server accepts every matching session
+    uint32_t start = millis();
+    _resumed = offerSession;
+    delay(_resumed ? NATIVE_RESUMED_HANDSHAKE_MS : NATIVE_FULL_HANDSHAKE_MS);
+    _handshakeMs = millis() - start;
+
+    if (_cache && !_resumed) {
+        _cache->hostHash = hashHost(host, port);
+        _cache->ciphersuite = 0xC02F;  // ECDHE-RSA-AES128-GCM-SHA256
+        _cache->idLen = TLS_SESSION_ID_MAX;
+        esp_fill_random(_cache->id, TLS_SESSION_ID_MAX);
+        esp_fill_random(_cache->master, TLS_SESSION_MASTER_LEN);
+        _cache->ticketLen = 0;
+        _cache->ticketLifetime = 0;
+        _cache->savedAt = time(nullptr);
+        _cache->magic = TLS_SESSION_MAGIC;
+    }
+    return 1;
+}
+
+size_t TlsSessionClient::write(uint8_t data) {
+    return WiFiClient::write(data);
+}
+
+size_t TlsSessionClient::write(const uint8_t* buf, size_t size) {
+    size_t sent = WiFiClient::write(buf, size);
+    if (sent > 0) {
+        _lastWriteAtMs = millis();
+    }
+    return sent;
+}
+
+int TlsSessionClient::available() {
+    return WiFiClient::available();
+}
+
+int TlsSessionClient::read() {
+    return WiFiClient::read();
+}
+
+int TlsSessionClient::read(uint8_t* buf, size_t size) {
+    return WiFiClient::read(buf, size);
+}
+
+int TlsSessionClient::peek() {
+    return WiFiClient::peek();
+}
+
+void TlsSessionClient::flush() {
+}
+
+void TlsSessionClient::stop() {
+    _tlsActive = false;
+    _peeked = -1;
+    WiFiClient::stop();
+}
+
+uint8_t TlsSessionClient::connected() {
+    return WiFiClient::connected();
+}
+
+#endif // NATIVE_BUILD
@@ -0,0 +1,145 @@
+#ifndef TLS_SESSION_CLIENT_H
+#define TLS_SESSION_CLIENT_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include "SleepManager.h"
+
+#ifndef NATIVE_BUILD
+#include "mbedtls/ssl.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#endif
+
+/**
+ * TlsSessionClient - TLS client with session resumption across deep sleep
+ *
+ * Drop-in replacement for WiFiClientSecure (insecure mode) for HTTPClient.
+ * WiFiClientSecure has no hook between mbedtls_ssl_setup() and the handshake,
+ * so this class runs mbedTLS itself on top of the WiFiClient socket and can
+ * offer a cached session before the handshake.
+ *
+ * The session (ticket or session ID + master secret) is kept in the RTC
+ * memory provided by SleepManager. If the server does not accept it, mbedTLS
+ * falls back to a full handshake; if the handshake fails while offering a
+ * session, the cache is dropped and the connection is retried once without it.
+ *
+ * Native builds talk plain TCP and model the handshake time with delay().
+ */
+class TlsSessionClient : public WiFiClient {
+public:
+    TlsSessionClient();
+    ~TlsSessionClient();
+
+    /**
+     * Set the RTC-resident session cache
+     * @param cache Cache from SleepManager::getTlsSessionCache() (nullptr = no resumption)
+     */
+    void setSessionCache(rtc_tls_session_t* cache);
+
+    /**
+     * Skip certificate validation (the only mode used by this firmware)
+     */
+    void setInsecure() {}
+
+    /**
+     * Set handshake timeout
+     * @param timeoutMs Timeout in milliseconds
+     */
+    void setHandshakeTimeout(uint32_t timeoutMs) { _handshakeTimeoutMs = timeoutMs; }
+
+    int connect(IPAddress ip, uint16_t port);
+    int connect(IPAddress ip, uint16_t port, int32_t timeout);
+    int connect(const char* host, uint16_t port);
+    int connect(const char* host, uint16_t port, int32_t timeout);
+
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* buf, size_t size);
+    int available();
+    int read();
+    int read(uint8_t* buf, size_t size);
+    int peek();
+    void flush();
+    void stop();
+    uint8_t connected();
+    operator bool() { return connected(); }
+
+    /**
+     * Check whether the last handshake resumed the cached session
+     */
+    bool sessionResumed() const { return _resumed; }
+
+    /**
+     * Get duration of the last handshake in milliseconds
+     */
+    uint32_t getHandshakeMs() const { return _handshakeMs; }
+
+    /**
+     * Estimated handshake time saved by the last connection (0 if not resumed)
+     */
+    uint32_t getSavedMs() const;
+
+    /**
+     * millis() when the last connect() completed its handshake (0 = not connected)
+     */
+    uint32_t getConnectedAtMs() const { return _connectedAtMs; }
+
+    /**
+     * millis() when the last write() returned (0 = nothing written since connect)
+     * Together with getConnectedAtMs() this splits a request into send and wait time
+     */
+    uint32_t getLastWriteAtMs() const { return _lastWriteAtMs; }
+
+private:
+    rtc_tls_session_t* _cache;
+    uint32_t _handshakeTimeoutMs;
+    uint32_t _handshakeMs;
+    uint32_t _connectedAtMs;
+    uint32_t _lastWriteAtMs;
+    bool _resumed;
+    bool _tlsActive;
+    int _peeked;
+
+#ifndef NATIVE_BUILD
+    mbedtls_ssl_context _ssl;
+    mbedtls_ssl_config _conf;
+    mbedtls_entropy_context _entropy;
+    mbedtls_ctr_drbg_context _drbg;
+    mbedtls_net_context _net;
+
+    /**
+     * Offer the cached session to the next handshake
+     * @return True if a session was offered
+     */
+    bool offerCachedSession();
+
+    /**
+     * Copy the negotiated session into the RTC cache
+     */
+    void storeSession(const mbedtls_ssl_session* session, uint32_t hostHash);
+
+    void freeTls();
+#endif
+
+    /**
+     * TCP connect + TLS handshake for one attempt
+     * @param offerSession Offer the cached session if it matches the host
+     * @return 1 on success, 0 on failure
+     */
+    int connectOnce(const char* host, uint16_t port, int32_t timeout, bool offerSession);
+
+    /**
+     * Check the cache holds a usable session for the given host
+     */
+    bool cacheMatches(uint32_t hostHash) const;
+
+    /**
+     * Update handshake statistics in the RTC cache
+     */
+    void recordHandshake();
+
+    static uint32_t hashHost(const char* host, uint16_t port);
+};
+
+#endif // TLS_SESSION_CLIENT_H
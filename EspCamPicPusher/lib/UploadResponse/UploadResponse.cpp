@@ -0,0 +1,56 @@
+#include "UploadResponse.h"
+
+void UploadResponseParser::buildFilter(JsonDocument& filter) {
+    filter["success"] = true;
+    filter["server_time"] = true;
+    filter["duplicate"] = true;
+    JsonObject ota = filter.createNestedObject("ota");
+    ota["available"] = true;
+    ota["firmware_file"] = true;
+    ota["firmware_version"] = true;
+    ota["download_url"] = true;
+    ota["size"] = true;
+    ota["sha256"] = true;
+    ota["mandatory"] = true;
+}
+
+bool UploadResponseParser::parse(Stream& stream, UploadResponse& response) {
+    StaticJsonDocument<FILTER_CAPACITY> filter;
+    buildFilter(filter);
+    StaticJsonDocument<DOCUMENT_CAPACITY> doc;
+    DeserializationError error = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+    return extract(error, doc, response);
+}
+
+bool UploadResponseParser::parse(const String& body, UploadResponse& response) {
+    StaticJsonDocument<FILTER_CAPACITY> filter;
+    buildFilter(filter);
+    StaticJsonDocument<DOCUMENT_CAPACITY> doc;
+    DeserializationError error = deserializeJson(doc, body, DeserializationOption::Filter(filter));
+    return extract(error, doc, response);
+}
+
+bool UploadResponseParser::extract(DeserializationError error, JsonDocument& doc, UploadResponse& response) {
+    response = UploadResponse();
+    if (error) {
+        Serial.printf("[Upload] Response parse error: %s\n", error.c_str());
+        return false;
+    }
+
+    response.parsed = true;
+    response.success = doc["success"] | false;
+    response.serverTime = (time_t)(doc["server_time"] | 0L);
+    response.duplicate = doc["duplicate"] | false;
+
+    JsonObject ota = doc["ota"];
+    response.ota.available = ota["available"] | false;
+    if (response.ota.available) {
+        response.ota.firmwareFile = ota["firmware_file"] | "";
+        response.ota.firmwareVersion = ota["firmware_version"] | "";
+        response.ota.downloadUrl = ota["download_url"] | "";
+        response.ota.size = ota["size"] | 0;
+        response.ota.sha256 = ota["sha256"] | "";
+        response.ota.mandatory = ota["mandatory"] | false;
+    }
+    return true;
+}
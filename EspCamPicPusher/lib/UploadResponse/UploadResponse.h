@@ -0,0 +1,58 @@
+#ifndef UPLOAD_RESPONSE_H
+#define UPLOAD_RESPONSE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <time.h>
+#include "OTAManager.h"
+
+/**
+ * Fields of an upload.php response the firmware acts on
+ */
+struct UploadResponse {
+    bool parsed = false;        // Body was valid JSON
+    bool success = false;       // "success"
+    time_t serverTime = 0;      // "server_time", Unix time when the server answered (0 = not sent)
+    bool duplicate = false;     // "duplicate", the server already had the image (X-Content-SHA256)
+    OtaUpdateInfo ota = {};     // "ota" block (ota.available = false if none)
+};
+
+/**
+ * UploadResponseParser - single-pass parse of the upload response
+ *
+ * Deserializes straight from the HTTP stream with an ArduinoJson filter that
+ * keeps only the fields of UploadResponse, into a fixed-size document on the
+ * stack. Echoed fields (device_id, filename, size, ...) are skipped while
+ * reading, so a response without OTA offer costs no heap allocation. Strings
+ * are only copied out when an update is offered.
+ */
+class UploadResponseParser {
+public:
+    /**
+     * Parse a response body from a stream (Content-Length bodies)
+     * @param stream Body stream, read up to the end of the JSON value
+     * @param response Receives the fields
+     * @return True if the body was valid JSON
+     */
+    static bool parse(Stream& stream, UploadResponse& response);
+
+    /**
+     * Parse a response body that was read into a string (chunked bodies)
+     */
+    static bool parse(const String& body, UploadResponse& response);
+
+private:
+    static const size_t FILTER_CAPACITY = 384;
+    static const size_t DOCUMENT_CAPACITY = 768;  // OTA block with download URL and SHA-256
+
+    static void buildFilter(JsonDocument& filter);
+    static bool extract(DeserializationError error, JsonDocument& doc, UploadResponse& response);
+
+    // Static utility class - no instances
+    UploadResponseParser() = delete;
+    ~UploadResponseParser() = delete;
+    UploadResponseParser(const UploadResponseParser&) = delete;
+    UploadResponseParser& operator=(const UploadResponseParser&) = delete;
+};
+
+#endif // UPLOAD_RESPONSE_H
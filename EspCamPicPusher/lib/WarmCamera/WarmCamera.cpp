@@ -0,0 +1,122 @@
+#include "WarmCamera.h"
+#include "CameraMutex.h"
+#include "CameraCapture.h"
+
+SemaphoreHandle_t WarmCamera::lock = nullptr;
+SemaphoreHandle_t WarmCamera::taskDone = nullptr;
+volatile bool WarmCamera::running = false;
+volatile bool WarmCamera::stopRequested = false;
+uint32_t WarmCamera::interval = 0;
+FrameRef WarmCamera::cached;
+unsigned long WarmCamera::cachedAtMs = 0;
+uint32_t WarmCamera::grabs = 0;
+
+bool WarmCamera::start(uint32_t intervalMs, int core) {
+    if (running) {
+        return true;
+    }
+    if (!lock) {
+        lock = xSemaphoreCreateMutex();
+        taskDone = xSemaphoreCreateBinary();
+        if (!lock || !taskDone) {
+            Serial.println("[WarmCamera] ERROR: Failed to create semaphores");
+            return false;
+        }
+    }
+
+    interval = intervalMs > 0 ? intervalMs : 1;
+    grabs = 0;
+    stopRequested = false;
+    running = true;
+    if (xTaskCreatePinnedToCore(task, "warm_camera", TASK_STACK_SIZE, nullptr, 1, nullptr, core) != pdPASS) {
+        Serial.println("[WarmCamera] ERROR: Failed to start task");
+        running = false;
+        return false;
+    }
+    Serial.printf("[WarmCamera] Started (grab every %u ms on core %d)\n", interval, core);
+    return true;
+}
+
+void WarmCamera::stop() {
+    if (!running) {
+        return;
+    }
+
+    stopRequested = true;
+    // A grab in progress may be waiting for the camera mutex or warming up
+    if (xSemaphoreTake(taskDone, pdMS_TO_TICKS(interval + 10000)) != pdTRUE) {
+        Serial.println("[WarmCamera] WARNING: Task did not stop");
+        return;
+    }
+    setCached(FrameRef());
+    Serial.printf("[WarmCamera] Stopped after %u frames\n", grabs);
+}
+
+bool WarmCamera::isRunning() {
+    return running;
+}
+
+FrameRef WarmCamera::latest(uint32_t* ageMs) {
+    FrameRef frame;
+    if (!lock) {
+        return frame;
+    }
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    unsigned long age = millis() - cachedAtMs;
+    if (cached && age <= 2 * interval + STALE_SLACK_MS) {
+        frame = cached;
+        if (ageMs) {
+            *ageMs = age;
+        }
+    }
+    xSemaphoreGive(lock);
+    return frame;
+}
+
+void WarmCamera::setCached(FrameRef frame) {
+    xSemaphoreTake(lock, portMAX_DELAY);
+    cached = std::move(frame);
+    cachedAtMs = millis();
+    xSemaphoreGive(lock);
+}
+
+void WarmCamera::grab(bool& warm) {
+    // Short timeout: previews and captures have priority, skip this grab
+    if (!CameraMutex::lock(interval)) {
+        return;
+    }
+
+    // Warm up once, and again after another user switched the sensor profile
+    if (CameraCapture::restoreCaptureProfile() || !warm) {
+        setCached(FrameRef());
+        CameraCapture::warmUpSensor();
+        warm = true;
+    }
+
+    camera_fb_t* fb = esp_camera_fb_get();
+    if (fb) {
+        // Keep the previous frame if the pool is exhausted (it only gets older)
+        FrameRef frame = FramePool::copy(fb);
+        esp_camera_fb_return(fb);
+        if (frame) {
+            setCached(std::move(frame));
+            grabs++;
+        }
+    }
+    CameraMutex::unlock();
+}
+
+void WarmCamera::task(void* param) {
+    bool warm = false;
+    while (!stopRequested) {
+        unsigned long start = millis();
+        grab(warm);
+        unsigned long elapsed = millis() - start;
+        vTaskDelay(pdMS_TO_TICKS(elapsed < interval ? interval - elapsed : 1));
+    }
+
+    running = false;
+    xSemaphoreGive(taskDone);
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,79 @@
+#ifndef WARM_CAMERA_H
+#define WARM_CAMERA_H
+
+#include <Arduino.h>
+#include "FramePool.h"
+
+/**
+ * WarmCamera - Background task that keeps the sensor settled and caches the newest frame
+ * 
+ * Meant for config mode, where previews and manual captures would otherwise
+ * each pay a cold warm-up. The task warms the sensor up once, then grabs a
+ * frame every intervalMs (with fb_count 2 and CAMERA_GRAB_LATEST the driver
+ * keeps the sensor streaming in between, so AEC/AGC/AWB follow the scene)
+ * and keeps the newest one in a FramePool slot. Consumers take a FrameRef of
+ * it without touching the camera.
+ * 
+ * The interval is the duty cycle: each grab holds CameraMutex for one frame
+ * plus a PSRAM copy, the rest of the time the task sleeps. The cached frame
+ * always uses the capture profile; if something else (e.g. the MJPEG stream)
+ * switched the sensor, the task warms up again before caching.
+ * 
+ * Usage Pattern:
+ *   WarmCamera::start(500, 1);
+ *   FrameRef frame = WarmCamera::latest();
+ *   if (!frame) { ... capture the usual way ... }
+ *   WarmCamera::stop();
+ */
+class WarmCamera {
+public:
+    /**
+     * Start the grab task (no-op if already running)
+     * @param intervalMs Time between frame grabs
+     * @param core Core to pin the task to
+     * @return true if the task is running
+     */
+    static bool start(uint32_t intervalMs, int core);
+
+    /**
+     * Stop the grab task, wait for it to exit and drop the cached frame
+     */
+    static void stop();
+
+    /**
+     * @return true while the grab task runs
+     */
+    static bool isRunning();
+
+    /**
+     * Get the cached frame if it is recent (taken within two intervals)
+     * @param ageMs Optional, set to the frame age in ms
+     * @return Reference to the newest frame, empty if none or stale
+     */
+    static FrameRef latest(uint32_t* ageMs = nullptr);
+
+private:
+    static const uint32_t TASK_STACK_SIZE = 4096;
+    static const uint32_t STALE_SLACK_MS = 1000;    // Grace for a grab delayed by another camera user
+
+    static SemaphoreHandle_t lock;                  // Guards cached, cachedAtMs
+    static SemaphoreHandle_t taskDone;
+    static volatile bool running;
+    static volatile bool stopRequested;
+    static uint32_t interval;
+    static FrameRef cached;
+    static unsigned long cachedAtMs;
+    static uint32_t grabs;
+
+    static void task(void* param);
+    static void grab(bool& warm);
+    static void setCached(FrameRef frame);
+
+    // Static utility class - no instances
+    WarmCamera() = delete;
+    ~WarmCamera() = delete;
+    WarmCamera(const WarmCamera&) = delete;
+    WarmCamera& operator=(const WarmCamera&) = delete;
+};
+
+#endif // WARM_CAMERA_H
@@ -1,10 +1,14 @@
 #include "WebConfigServer.h"
 #include "CameraMutex.h"
 #include "CameraCapture.h"
+#include "FramePool.h"
+#include "WarmCamera.h"
 #include "ScheduleManager.h"
+#include "esp_system.h"
 #include <WiFi.h>
 #include <ArduinoJson.h>
 #include <base64.h>
+#include <memory>
 
 // Forward declaration — the 30KB PROGMEM definition is at the bottom of this file.
 extern const char HTML_PAGE[];
@@ -22,10 +26,31 @@ WebConfigServer::WebConfigServer(ConfigManager* configMgr, int port) {
     captureResult = -1;
     wifiTestState = -1;
     wifiTestResultRssi = 0;
+    previewLock = xSemaphoreCreateMutex();
+    previewInFlight = false;
+    previewTasks = 0;
+    previewClaimCount = 0;
+    previewGen = 0;
+    previewDoneGen = 0;
+    previewStatus = 0;
+    streamFrameSize = FRAMESIZE_VGA;
+    streamQuality = 15;
+    streamMaxFps = 10;
+    streamClients = 0;
+    streamStopping = false;
+    streamTaskRunning = false;
+    streamLock = xSemaphoreCreateMutex();
+    streamSeq = 0;
 }
 
 WebConfigServer::~WebConfigServer() {
     stop();
+    if (streamLock) {
+        vSemaphoreDelete(streamLock);
+    }
+    if (previewLock) {
+        vSemaphoreDelete(previewLock);
+    }
 }
 
 bool WebConfigServer::begin() {
@@ -38,6 +63,7 @@ bool WebConfigServer::begin() {
     timeoutMillis = configManager->getWebTimeoutMin() * 60UL * 1000UL;
     
     // Initialize server
+    streamStopping = false;
     server = new AsyncWebServer(serverPort);
     
     // Setup routes
@@ -59,6 +85,23 @@ bool WebConfigServer::begin() {
 
 void WebConfigServer::stop() {
     if (server) {
+        // Let open streams finish their response, then wait for the producer
+        // and preview capture tasks so they do not outlive this object
+        streamStopping = true;
+        unsigned long start = millis();
+        while (millis() - start < 8000) {
+            xSemaphoreTake(streamLock, portMAX_DELAY);
+            bool running = streamTaskRunning;
+            xSemaphoreGive(streamLock);
+            xSemaphoreTake(previewLock, portMAX_DELAY);
+            running = running || previewTasks > 0;
+            xSemaphoreGive(previewLock);
+            if (!running) {
+                break;
+            }
+            delay(10);
+        }
+
         server->end();
         delete server;
         server = nullptr;
@@ -133,6 +176,13 @@ void WebConfigServer::setupRoutes() {
         this->handlePreview(request);
     });
     
+    // MJPEG live stream (low-resolution stream profile)
+    server->on("/stream", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->logRequest(request);
+        this->resetActivityTimer();
+        this->handleStream(request);
+    });
+    
     // Device status
     server->on("/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
         this->logRequest(request);
@@ -190,7 +240,7 @@ void WebConfigServer::handlePostConfig(AsyncWebServerRequest* request, uint8_t*
     Serial.println(body);
     
     // Parse JSON to check for WiFi credential changes
-    DynamicJsonDocument doc(2048);
+    DynamicJsonDocument doc(CONFIG_JSON_CAPACITY);
     DeserializationError error = deserializeJson(doc, body);
     
     bool wifiChanged = false;
@@ -404,57 +454,419 @@ void WebConfigServer::handlePreview(AsyncWebServerRequest* request) {
         return;
     }
     
-    // Acquire camera mutex to prevent concurrent access
-    if (!CameraMutex::lock(5000)) {
-        request->send(503, "text/plain", "Camera busy, try again");
+    if (request->hasParam("capture")) {
+        uint32_t ticket = request->hasParam("ticket") ?
+            strtoul(request->getParam("ticket")->value().c_str(), nullptr, 10) : 0;
+        sendPreviewResult(request, (uint32_t)request->getParam("capture")->value().toInt(), ticket);
         return;
     }
     
-    // Capture preview image with sensor warm-up for proper auto-adjustment
-    camera_fb_t* fb = CameraCapture::captureFrame(true);
-    if (!fb) {
-        CameraMutex::unlock();
-        request->send(500, "text/plain", "Camera capture failed");
+    // Newest frame of the warm camera task if it runs, no camera access needed
+    uint32_t ageMs = 0;
+    FrameRef frame = WarmCamera::latest(&ageMs);
+    if (frame) {
+        Serial.printf("Preview from warm camera (%u ms old)\n", ageMs);
+        sendPreviewFrame(request, frame);
         return;
     }
     
-    // Copy JPEG data to heap buffer (async response needs it after we return the frame buffer)
-    uint8_t* jpegCopy = (uint8_t*)malloc(fb->len);
-    if (!jpegCopy) {
-        esp_camera_fb_return(fb);
-        CameraMutex::unlock();
-        request->send(500, "text/plain", "Out of memory");
+    // Attach to the capture in flight, or start one. Concurrent previews
+    // (several browsers, retries) then share one warm-up, capture and pool
+    // slot instead of queueing on the camera mutex one after another.
+    xSemaphoreTake(previewLock, portMAX_DELAY);
+    if (previewClaimCount >= PREVIEW_MAX_CLAIMS) {
+        xSemaphoreGive(previewLock);
+        request->send(503, "text/plain", "Too many preview requests");
         return;
     }
+    if (!previewInFlight) {
+        previewInFlight = xTaskCreatePinnedToCore(previewTask, "preview_capture", PREVIEW_TASK_STACK_SIZE,
+                                                  this, 1, nullptr, 0) == pdPASS;
+        if (!previewInFlight) {
+            xSemaphoreGive(previewLock);
+            request->send(500, "text/plain", "Preview task not started");
+            return;
+        }
+        previewTasks++;
+        previewGen++;
+    } else {
+        Serial.printf("Preview attached to capture #%u in flight\n", previewGen);
+    }
+    uint32_t gen = previewGen;
+    uint32_t ticket = esp_random() | 1;  // Never 0 (= no ticket given)
+    previewClaims[previewClaimCount++] = { gen, ticket };
+    xSemaphoreGive(previewLock);
     
-    memcpy(jpegCopy, fb->buf, fb->len);
-    size_t jpegLen = fb->len;
-    
-    // Return frame buffer immediately (we have a copy)
-    CameraCapture::releaseFrame(fb);
-    CameraMutex::unlock();
-    
-    // Send image as JPEG using the copied data
-    // The buffer will be freed by the chunked response callback after sending
+    // Fire-and-poll like /capture: the status of a response is fixed when it
+    // starts, and a response waiting with RESPONSE_TRY_AGAIN is only called
+    // again on AsyncTCP's 500 ms poll
+    request->send(202, "application/json",
+        "{\"capture\":" + String(gen) + ",\"ticket\":" + String(ticket) + "}");
+}
+
+void WebConfigServer::sendPreviewResult(AsyncWebServerRequest* request, uint32_t gen, uint32_t ticket) {
+    xSemaphoreTake(previewLock, portMAX_DELAY);
+    if (gen == 0 || gen > previewGen) {
+        xSemaphoreGive(previewLock);
+        request->send(404, "text/plain", "Unknown preview capture");
+        return;
+    }
+    // Only requests answered 202 for this capture hold a claim, each fetches
+    // the result once; claims of replaced or released results are gone
+    int claim = -1;
+    for (int i = 0; i < previewClaimCount; i++) {
+        if (previewClaims[i].gen == gen && previewClaims[i].ticket == ticket) {
+            claim = i;
+            break;
+        }
+    }
+    if (claim < 0) {
+        xSemaphoreGive(previewLock);
+        request->send(410, "text/plain", "Preview expired or already fetched");
+        return;
+    }
+    if (gen > previewDoneGen) {
+        xSemaphoreGive(previewLock);
+        request->send(202, "application/json",
+            "{\"capture\":" + String(gen) + ",\"ticket\":" + String(ticket) + "}");
+        return;
+    }
+    int status = previewStatus;
+    FrameRef frame = previewFrame;
+    previewClaims[claim] = previewClaims[--previewClaimCount];
+    // Last request hands the slot back to the pool
+    if (countPreviewClaims(gen) == 0) {
+        previewFrame.reset();
+        previewStatus = 0;
+    }
+    xSemaphoreGive(previewLock);
+
+    if (status == 200) {
+        sendPreviewFrame(request, frame, gen);
+    } else if (status == 503) {
+        request->send(503, "text/plain", "Camera busy, try again");
+    } else {
+        request->send(status, "text/plain", "Camera capture failed");
+    }
+}
+
+void WebConfigServer::dropPreviewClaims(uint32_t upToGen) {
+    for (int i = 0; i < previewClaimCount;) {
+        if (previewClaims[i].gen <= upToGen) {
+            previewClaims[i] = previewClaims[--previewClaimCount];
+        } else {
+            i++;
+        }
+    }
+}
+
+uint8_t WebConfigServer::countPreviewClaims(uint32_t gen) const {
+    uint8_t count = 0;
+    for (int i = 0; i < previewClaimCount; i++) {
+        count += previewClaims[i].gen == gen ? 1 : 0;
+    }
+    return count;
+}
+
+void WebConfigServer::sendPreviewFrame(AsyncWebServerRequest* request, const FrameRef& frame, uint32_t gen) {
+    // The filler lambda holds a reference to the slot; it is released when the
+    // response is destroyed, also if the client disconnects mid-transfer
     AsyncWebServerResponse* response = request->beginChunkedResponse("image/jpeg", 
-        [jpegCopy, jpegLen](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
-            // Calculate how many bytes to send in this chunk
-            size_t remaining = jpegLen - index;
-            if (remaining == 0) {
-                // All data sent, free the buffer
-                free((void*)jpegCopy);
-                return 0; // Signal end of data
-            }
-            
+        [frame](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+            size_t remaining = frame.length() - index;
             size_t toSend = (remaining < maxLen) ? remaining : maxLen;
-            memcpy(buffer, jpegCopy + index, toSend);
-            return toSend;
+            memcpy(buffer, frame.data() + index, toSend);
+            return toSend; // 0 signals end of data
         }
     );
+    if (gen != 0) {
+        response->addHeader("X-Preview-Capture", String(gen));
+    }
     
     request->send(response);
 }
 
+void WebConfigServer::previewTask(void* param) {
+    static_cast<WebConfigServer*>(param)->runPreviewCapture();
+    vTaskDelete(NULL);
+}
+
+void WebConfigServer::runPreviewCapture() {
+    FrameRef frame;
+    int status = 500;
+    if (CameraMutex::lock(5000)) {
+        // Capture preview image with sensor warm-up for proper auto-adjustment
+        camera_fb_t* fb = CameraCapture::captureFrame(true);
+        if (fb) {
+            // Copy into a PSRAM pool slot so the frame buffer and mutex can be
+            // released right away (a scheduled capture may run while previews send)
+            frame = FramePool::copy(fb);
+            if (frame) {
+                status = 200;
+            } else {
+                Serial.println("Preview: no free frame pool slot");
+                status = 503;
+            }
+        } else {
+            Serial.println("Preview: capture failed");
+        }
+        CameraCapture::releaseFrame(fb);
+        CameraMutex::unlock();
+    } else {
+        Serial.println("Preview: camera busy");
+        status = 503;
+    }
+
+    // Publish the result; one still held for an older capture is replaced
+    xSemaphoreTake(previewLock, portMAX_DELAY);
+    uint32_t gen = previewGen;
+    dropPreviewClaims(gen - 1);
+    bool claimed = countPreviewClaims(gen) > 0;
+    previewFrame = claimed ? frame : FrameRef();
+    previewStatus = claimed ? status : 0;
+    previewDoneGen = gen;
+    previewInFlight = false;
+    xSemaphoreGive(previewLock);
+    frame.reset();
+
+    // Hold it until every request fetched it or a later capture replaced it;
+    // released early if requests do not come back (closed page) or on stop()
+    unsigned long doneMs = millis();
+    while (true) {
+        xSemaphoreTake(previewLock, portMAX_DELAY);
+        bool held = previewDoneGen == gen && previewStatus != 0;
+        if (held && (streamStopping || millis() - doneMs >= PREVIEW_RESULT_HOLD_MS)) {
+            Serial.printf("Preview #%u released, %u requests did not fetch it\n", gen, countPreviewClaims(gen));
+            dropPreviewClaims(gen);
+            previewFrame.reset();
+            previewStatus = 0;
+            held = false;
+        }
+        if (!held) {
+            previewTasks--;
+            xSemaphoreGive(previewLock);
+            return;
+        }
+        xSemaphoreGive(previewLock);
+        delay(20);
+    }
+}
+
+void WebConfigServer::setStreamProfile(framesize_t frameSize, int quality, uint8_t maxFps) {
+    streamFrameSize = frameSize;
+    streamQuality = quality;
+    streamMaxFps = maxFps > 0 ? maxFps : 1;
+}
+
+namespace {
+
+// Per-connection state of a /stream response, owned by its filler lambda
+struct StreamClient {
+    FrameRef frame;                // Part being sent (empty = waiting for the next frame)
+    uint32_t seq = 0;              // Sequence number of the last frame taken
+    size_t offset = 0;             // Bytes of the current part already sent
+    char header[96];
+    size_t headerLen = 0;
+    bool opened = false;           // Boundary and Content-Type of the next part are sent
+    uint8_t paddingLines = 0;      // Padding header lines sent while waiting for the next frame
+    unsigned long intervalMs = 0;  // Client frame-rate cap (?fps=)
+    unsigned long nextPartMs = 0;  // Schedule of the cap, so late filler calls do not add up
+};
+
+#define STREAM_BOUNDARY "frame"
+
+// Ends a part's JPEG and opens the next part right away, so the browser shows
+// the frame without waiting for the next one (the first part skips the CRLF)
+const char STREAM_PART_OPEN[] = "\r\n--" STREAM_BOUNDARY "\r\nContent-Type: image/jpeg\r\n";
+
+// Header line written while the next part waits for its frame. AsyncTCP calls
+// the filler again on the ACK of written data, but after RESPONSE_TRY_AGAIN
+// with nothing in flight only on its 500 ms poll, which would cap the stream
+// at 2 fps. Receivers ignore unknown part headers.
+const char STREAM_PADDING[] = "X-Wait: 1\r\n";
+const uint8_t STREAM_MAX_PADDING_LINES = 64;  // Then fall back to the poll (e.g. producer stalled)
+
+} // namespace
+
+bool WebConfigServer::takeStreamFrame(uint32_t lastSeq, FrameRef& frame, uint32_t& seq) {
+    bool newer = false;
+    xSemaphoreTake(streamLock, portMAX_DELAY);
+    if (streamFrame && streamSeq != lastSeq) {
+        frame = streamFrame;
+        seq = streamSeq;
+        newer = true;
+    }
+    xSemaphoreGive(streamLock);
+    return newer;
+}
+
+void WebConfigServer::streamTask(void* param) {
+    static_cast<WebConfigServer*>(param)->runStream();
+    vTaskDelete(NULL);
+}
+
+void WebConfigServer::runStream() {
+    Serial.printf("Stream started (%ux%u, quality %d, max %u fps)\n",
+                  resolution[streamFrameSize].width, resolution[streamFrameSize].height,
+                  streamQuality, streamMaxFps);
+    unsigned long intervalMs = 1000 / streamMaxFps;
+    uint32_t frames = 0;
+    uint32_t dropped = 0;
+
+    while (true) {
+        xSemaphoreTake(streamLock, portMAX_DELAY);
+        if (streamClients == 0 || streamStopping) {
+            streamTaskRunning = false;
+            streamFrame.reset();
+            xSemaphoreGive(streamLock);
+            break;
+        }
+        xSemaphoreGive(streamLock);
+
+        unsigned long start = millis();
+        // Short timeout: a scheduled or manual capture has priority, the
+        // stream just skips frames while it runs
+        if (CameraMutex::lock(1000)) {
+            camera_fb_t* fb = CameraCapture::captureWithProfile(streamFrameSize, streamQuality);
+            FrameRef frame = fb ? FramePool::copy(fb) : FrameRef();
+            CameraCapture::releaseFrame(fb);
+            CameraMutex::unlock();
+
+            if (frame) {
+                xSemaphoreTake(streamLock, portMAX_DELAY);
+                streamFrame = std::move(frame);
+                streamSeq++;
+                xSemaphoreGive(streamLock);
+                frames++;
+            } else {
+                dropped++;  // Capture failed or all pool slots still held by clients
+            }
+        }
+
+        unsigned long elapsed = millis() - start;
+        vTaskDelay(pdMS_TO_TICKS(elapsed < intervalMs ? intervalMs - elapsed : 1));
+    }
+
+    // Leave the sensor on the capture profile for whatever comes next
+    if (CameraMutex::lock(5000)) {
+        CameraCapture::restoreCaptureProfile();
+        CameraMutex::unlock();
+    }
+    Serial.printf("Stream stopped (%u frames, %u dropped)\n", frames, dropped);
+}
+
+void WebConfigServer::handleStream(AsyncWebServerRequest* request) {
+    if (!cameraReady) {
+        request->send(503, "text/plain", "Camera not ready");
+        return;
+    }
+
+    int fps = streamMaxFps;
+    if (request->hasParam("fps")) {
+        int requested = request->getParam("fps")->value().toInt();
+        if (requested > 0 && requested < fps) {
+            fps = requested;
+        }
+    }
+
+    xSemaphoreTake(streamLock, portMAX_DELAY);
+    if (streamStopping || streamClients >= MAX_STREAM_CLIENTS) {
+        xSemaphoreGive(streamLock);
+        request->send(503, "text/plain", "Too many stream clients");
+        return;
+    }
+    streamClients++;
+    if (!streamTaskRunning) {
+        streamTaskRunning = xTaskCreatePinnedToCore(streamTask, "mjpeg_stream", STREAM_TASK_STACK_SIZE,
+                                                    this, 1, nullptr, 0) == pdPASS;
+        if (!streamTaskRunning) {
+            streamClients--;
+            xSemaphoreGive(streamLock);
+            request->send(500, "text/plain", "Stream task not started");
+            return;
+        }
+    }
+    xSemaphoreGive(streamLock);
+
+    // Released with the response (also on disconnect); the last client
+    // leaving ends the producer task
+    std::shared_ptr<StreamClient> client(new StreamClient(), [this](StreamClient* c) {
+        delete c;
+        streamClients--;
+    });
+    client->intervalMs = 1000 / fps;
+    client->nextPartMs = millis();
+
+    // The filler is called whenever the connection can take more data, so a
+    // slow client simply skips to the newest frame instead of queueing old
+    // ones. While the next frame is not due or not there yet it keeps the ACK
+    // clock going with STREAM_PADDING rather than RESPONSE_TRY_AGAIN.
+    AsyncWebServerResponse* response = request->beginChunkedResponse(
+        "multipart/x-mixed-replace; boundary=" STREAM_BOUNDARY,
+        [this, client](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            if (streamStopping) {
+                return 0;
+            }
+            StreamClient& c = *client;
+            if (!c.frame) {
+                unsigned long now = millis();
+                bool due = (long)(now - c.nextPartMs) >= 0;
+                if (!due || !takeStreamFrame(c.seq, c.frame, c.seq)) {
+                    const char* wait = c.opened ? STREAM_PADDING : STREAM_PART_OPEN + 2;
+                    size_t waitLen = strlen(wait);
+                    if (c.paddingLines >= STREAM_MAX_PADDING_LINES || waitLen > maxLen) {
+                        return RESPONSE_TRY_AGAIN;
+                    }
+                    memcpy(buffer, wait, waitLen);
+                    if (c.opened) {
+                        c.paddingLines++;
+                    }
+                    c.opened = true;
+                    return waitLen;
+                }
+                c.headerLen = snprintf(c.header, sizeof(c.header), "%sContent-Length: %u\r\n\r\n",
+                                       c.opened ? "" : STREAM_PART_OPEN + 2, (unsigned)c.frame.length());
+                c.offset = 0;
+                c.paddingLines = 0;
+                c.nextPartMs += c.intervalMs;
+                if ((long)(now - c.nextPartMs) >= 0) {
+                    c.nextPartMs = now + c.intervalMs;  // More than a frame behind: restart the schedule
+                }
+            }
+
+            // Part = (rest of the) header, JPEG, STREAM_PART_OPEN of the next part
+            size_t jpegEnd = c.headerLen + c.frame.length();
+            size_t partLen = jpegEnd + sizeof(STREAM_PART_OPEN) - 1;
+            size_t written = 0;
+            while (written < maxLen && c.offset < partLen) {
+                const uint8_t* src;
+                size_t avail;
+                if (c.offset < c.headerLen) {
+                    src = (const uint8_t*)c.header + c.offset;
+                    avail = c.headerLen - c.offset;
+                } else if (c.offset < jpegEnd) {
+                    src = c.frame.data() + (c.offset - c.headerLen);
+                    avail = jpegEnd - c.offset;
+                } else {
+                    src = (const uint8_t*)STREAM_PART_OPEN + (c.offset - jpegEnd);
+                    avail = partLen - c.offset;
+                }
+                size_t n = avail < maxLen - written ? avail : maxLen - written;
+                memcpy(buffer + written, src, n);
+                written += n;
+                c.offset += n;
+            }
+            if (c.offset == partLen) {
+                c.frame.reset();  // Hand the slot back before waiting for the next frame
+                c.opened = true;
+            }
+            return written;
+        }
+    );
+    response->addHeader("Cache-Control", "no-cache, no-store");
+    request->send(response);
+}
+
 void WebConfigServer::handleStatus(AsyncWebServerRequest* request) {
     StaticJsonDocument<512> doc;
     
@@ -465,6 +877,9 @@ void WebConfigServer::handleStatus(AsyncWebServerRequest* request) {
     doc["remainingTimeout"] = getRemainingSeconds();
     doc["freeHeap"] = ESP.getFreeHeap();
     doc["cameraReady"] = cameraReady;
+    doc["framePoolFree"] = FramePool::freeSlots();
+    doc["streamClients"] = streamClients.load();
+    doc["warmCamera"] = WarmCamera::isRunning();
     
     // AP mode information
     doc["apMode"] = isApMode;
@@ -603,6 +1018,7 @@ const char HTML_PAGE[] PROGMEM = R"=====(
         }
         .schedule-item {
             display: flex;
+            flex-wrap: wrap;
             gap: 10px;
             margin-bottom: 10px;
             align-items: center;
@@ -610,6 +1026,12 @@ const char HTML_PAGE[] PROGMEM = R"=====(
         .schedule-item input {
             width: 80px;
         }
+        .schedule-item select {
+            padding: 8px;
+            border: 2px solid #ddd;
+            border-radius: 5px;
+            font-size: 14px;
+        }
         .btn {
             padding: 10px 20px;
             border: none;
@@ -791,6 +1213,18 @@ const char HTML_PAGE[] PROGMEM = R"=====(
                 <button class="btn btn-secondary btn-small" onclick="addScheduleItem()">+ Add Time</button>
             </div>
 
+            <!-- Region of Interest -->
+            <div class="section">
+                <h2>🔲 Region of Interest</h2>
+                <p style="font-size: 12px; color: #666; margin-bottom: 10px;">Part of the 1600x1200 frame to capture, cropped by the sensor. Width 0 = full frame. Sizes are rounded down to multiples of 16; takes effect at the next camera start (timer wake or reboot).</p>
+                <div class="schedule-item">
+                    <span>X</span><input type="number" id="roiX" min="0" max="1599" placeholder="0">
+                    <span>Y</span><input type="number" id="roiY" min="0" max="1199" placeholder="0">
+                    <span>W</span><input type="number" id="roiWidth" min="0" max="1600" placeholder="0">
+                    <span>H</span><input type="number" id="roiHeight" min="0" max="1200" placeholder="0">
+                </div>
+            </div>
+
             <!-- Timezone Configuration -->
             <div class="section">
                 <h2>🌍 Timezone</h2>
@@ -842,6 +1276,7 @@ const char HTML_PAGE[] PROGMEM = R"=====(
                 <h2>📸 Manual Capture</h2>
                 <button class="btn btn-success" onclick="capturePreview()">📷 Capture & Preview</button>
                 <button class="btn btn-primary" onclick="captureAndPush(this)" style="margin-left: 10px;">📤 Capture & Push to Server</button>
+                <button class="btn btn-secondary" id="liveBtn" onclick="toggleLiveView()" style="margin-left: 10px;">🎥 Live View</button>
                 <div class="preview-container" id="previewContainer"></div>
             </div>
 
@@ -932,6 +1367,13 @@ const char HTML_PAGE[] PROGMEM = R"=====(
                     document.getElementById('webTimeoutMin').value = config.webTimeoutMin || 15;
                     document.getElementById('sleepMarginSec').value = config.sleepMarginSec || 60;
                     
+                    // Load region of interest
+                    const roi = config.roi || {};
+                    document.getElementById('roiX').value = roi.x || 0;
+                    document.getElementById('roiY').value = roi.y || 0;
+                    document.getElementById('roiWidth').value = roi.width || 0;
+                    document.getElementById('roiHeight').value = roi.height || 0;
+                    
                     // Load web authentication
                     document.getElementById('webUsername').value = config.webUsername || '';
                     const pwdSet = config.webPassword === '********';
@@ -1112,6 +1554,12 @@ const char HTML_PAGE[] PROGMEM = R"=====(
                 schedule: schedule,
                 webTimeoutMin: parseInt(document.getElementById('webTimeoutMin').value),
                 sleepMarginSec: parseInt(document.getElementById('sleepMarginSec').value),
+                roi: {
+                    x: parseInt(document.getElementById('roiX').value) || 0,
+                    y: parseInt(document.getElementById('roiY').value) || 0,
+                    width: parseInt(document.getElementById('roiWidth').value) || 0,
+                    height: parseInt(document.getElementById('roiHeight').value) || 0
+                },
                 webUsername: document.getElementById('webUsername').value,
                 webPassword: document.getElementById('webPassword').value
             };
@@ -1195,14 +1643,48 @@ const char HTML_PAGE[] PROGMEM = R"=====(
                     <span>:</span>
                     <input type="number" min="0" max="59" value="${item.minute}" 
                            onchange="updateScheduleItem(${index}, 'minute', this.value)" placeholder="MM">
+                    <span title="Burst: frames captured, the sharpest one is uploaded">📸</span>
+                    <input type="number" min="1" max="8" value="${item.burstFrames ?? ''}" 
+                           onchange="updateScheduleItem(${index}, 'burstFrames', this.value)" placeholder="frames"
+                           title="Burst frames (1 = single frame)">
+                    <input type="number" min="0" max="5000" step="100" value="${item.burstBudgetMs ?? ''}" 
+                           onchange="updateScheduleItem(${index}, 'burstBudgetMs', this.value)" placeholder="ms"
+                           title="Burst time budget (ms)">
+                    <span>ms</span>
+                    <span title="Capture profile of this slot">🎞️</span>
+                    <select onchange="updateScheduleProfile(${index}, 'frameSize', this.value)" title="Frame size">
+                        ${profileOptions(FRAME_SIZES, item.frameSize)}
+                    </select>
+                    <input type="number" min="0" max="63" value="${item.quality ?? ''}" 
+                           onchange="updateScheduleItem(${index}, 'quality', this.value)" placeholder="quality"
+                           title="JPEG quality (0-63, lower means higher quality)">
+                    <select onchange="updateScheduleProfile(${index}, 'warmUp', this.value)" title="Sensor warm-up">
+                        ${profileOptions(WARM_UPS, item.warmUp)}
+                    </select>
+                    <select onchange="updateScheduleProfile(${index}, 'priority', this.value)"
+                            title="Upload priority: high is never skipped, low is not queued when the upload fails">
+                        ${profileOptions(PRIORITIES, item.priority)}
+                    </select>
                     <button class="btn btn-danger btn-small" onclick="removeScheduleItem(${index})">✕</button>
                 `;
                 container.appendChild(div);
             });
         }
 
+        const FRAME_SIZES = ['QVGA', 'CIF', 'HVGA', 'VGA', 'SVGA', 'XGA', 'HD', 'SXGA', 'UXGA'];
+        const WARM_UPS = ['quick', 'normal', 'thorough'];
+        const PRIORITIES = ['low', 'normal', 'high'];
+
+        function profileOptions(values, current) {
+            return values.map(v => `<option value="${v}"${v === current ? ' selected' : ''}>${v}</option>`).join('');
+        }
+
         function addScheduleItem() {
-            schedule.push({ hour: 12, minute: 0 });
+            // New slots inherit the burst and profile settings of the last one (device defaults if none)
+            const last = schedule[schedule.length - 1] || {};
+            schedule.push({ hour: 12, minute: 0, burstFrames: last.burstFrames, burstBudgetMs: last.burstBudgetMs,
+                            frameSize: last.frameSize, quality: last.quality, warmUp: last.warmUp,
+                            priority: last.priority });
             renderSchedule();
         }
 
@@ -1216,12 +1698,44 @@ const char HTML_PAGE[] PROGMEM = R"=====(
             renderSchedule(); // Re-render to maintain sorted order
         }
 
+        function updateScheduleProfile(index, field, value) {
+            schedule[index][field] = value;
+        }
+
+        function toggleLiveView() {
+            // Removing the <img> closes the connection, which ends the stream on the device
+            const container = document.getElementById('previewContainer');
+            const btn = document.getElementById('liveBtn');
+            if (container.querySelector('img.live')) {
+                container.innerHTML = '';
+                btn.textContent = '\ud83c\udfa5 Live View';
+                return;
+            }
+            container.innerHTML = '<img class="live" src="/stream" alt="Live view">';
+            btn.textContent = '\u23f9 Stop Live View';
+        }
+
         function capturePreview() {
             const container = document.getElementById('previewContainer');
+            document.getElementById('liveBtn').textContent = '\ud83c\udfa5 Live View';
             container.innerHTML = '<p>Capturing...</p>';
             
-            fetch('/preview')
-                .then(r => r.blob())
+            // 200 with the warm camera's frame, else 202 with the number of the
+            // capture (shared with other clients) and a ticket to poll it with
+            let attempts = 0;
+            function fetchPreview(url) {
+                return fetch(url).then(r => {
+                    if (r.status === 202) {
+                        if (attempts++ > 150) throw new Error('timed out');
+                        return r.json().then(d => new Promise(resolve => setTimeout(resolve, 100))
+                            .then(() => fetchPreview(`/preview?capture=${d.capture}&ticket=${d.ticket}`)));
+                    }
+                    if (!r.ok) return r.text().then(t => { throw new Error(t || 'HTTP ' + r.status); });
+                    return r.blob();
+                });
+            }
+
+            fetchPreview('/preview')
                 .then(blob => {
                     const url = URL.createObjectURL(blob);
                     container.innerHTML = `<img src="${url}" alt="Preview">`;
@@ -1229,7 +1743,7 @@ const char HTML_PAGE[] PROGMEM = R"=====(
                 })
                 .catch(err => {
                     container.innerHTML = '';
-                    showMessage('Capture failed: ' + err, true);
+                    showMessage('Capture failed: ' + err.message, true);
                 });
         }
         
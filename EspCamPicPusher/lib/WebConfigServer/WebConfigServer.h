@@ -3,7 +3,9 @@
 
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
+#include <atomic>
 #include "ConfigManager.h"
+#include "FramePool.h"
 #include "esp_camera.h"
 
 // Callback function type for capture trigger
@@ -66,6 +68,19 @@ public:
      */
     void setApMode(bool apMode);
 
+    /**
+     * Set the sensor profile and frame-rate cap of the /stream endpoint.
+     * While a stream runs the sensor is switched to this profile per frame;
+     * captures switch it back (see CameraCapture::restoreCaptureProfile).
+     * @param frameSize Stream frame size (must not exceed the init size)
+     * @param quality Stream JPEG quality (0-63, lower means higher quality)
+     * @param maxFps Upper limit for the frame rate (?fps= can only lower it)
+     */
+    void setStreamProfile(framesize_t frameSize, int quality, uint8_t maxFps);
+
+    /** Returns true while at least one /stream client is connected. */
+    bool isStreaming() const { return streamClients > 0; }
+
     // --- Decoupled-capture helpers (called from the main loop) ---
 
     /** Returns true if the web UI has queued a capture-and-push operation. */
@@ -117,6 +132,72 @@ private:
     String        wifiTestResultIp;
     int           wifiTestResultRssi;
 
+    // Coalesced /preview: requests arriving while a capture is in flight
+    // attach to it and are all served the same result (one pool slot). They
+    // are answered 202 with the capture number and a ticket and fetch the
+    // result once from /preview?capture=N&ticket=T, so its status tells
+    // whether the capture worked
+    static const uint32_t PREVIEW_TASK_STACK_SIZE = 8192;
+    static const uint32_t PREVIEW_RESULT_HOLD_MS = 5000;  // Result released if not fetched by then
+    static const uint8_t  PREVIEW_MAX_CLAIMS = 16;        // Requests attached at a time, more get 503
+    struct PreviewClaim {
+        uint32_t gen;                         // Capture the request attached to
+        uint32_t ticket;                      // Random, handed out with the 202
+    };
+    SemaphoreHandle_t previewLock;            // Guards the preview fields below
+    bool              previewInFlight;
+    uint8_t           previewTasks;           // Capture tasks running (they hold their result until fetched)
+    PreviewClaim      previewClaims[PREVIEW_MAX_CLAIMS];  // Requests that have not fetched their result yet
+    uint8_t           previewClaimCount;
+    uint32_t          previewGen;             // Latest capture started
+    uint32_t          previewDoneGen;         // Latest capture finished
+    FrameRef          previewFrame;           // Result of previewDoneGen
+    int               previewStatus;          // HTTP status of that result (0 = released)
+
+    static void previewTask(void* param);
+    void runPreviewCapture();
+
+    /**
+     * Answer /preview?capture=N&ticket=T: 202 while capture N runs, then its
+     * result once per ticket (the JPEG, or 503/500 if the capture failed);
+     * 410 for a released, replaced or already fetched result
+     */
+    void sendPreviewResult(AsyncWebServerRequest* request, uint32_t gen, uint32_t ticket);
+
+    /**
+     * Remove the claims of captures up to gen (previewLock held)
+     */
+    void dropPreviewClaims(uint32_t upToGen);
+
+    /**
+     * Number of requests that have not fetched the result of gen (previewLock held)
+     */
+    uint8_t countPreviewClaims(uint32_t gen) const;
+
+    // MJPEG stream: one producer task captures while clients are connected
+    // and publishes the newest frame; every client sends whatever is newest
+    // when its connection can take more data (older frames are dropped)
+    static const int MAX_STREAM_CLIENTS = 2;
+    static const uint32_t STREAM_TASK_STACK_SIZE = 4096;
+    framesize_t       streamFrameSize;
+    int               streamQuality;
+    uint8_t           streamMaxFps;
+    std::atomic<int>  streamClients;
+    volatile bool     streamStopping;         // Set by stop(), ends all streams
+    bool              streamTaskRunning;      // Guarded by streamLock
+    SemaphoreHandle_t streamLock;             // Guards streamFrame, streamSeq, streamTaskRunning
+    FrameRef          streamFrame;
+    uint32_t          streamSeq;
+
+    static void streamTask(void* param);
+    void runStream();
+
+    /**
+     * Get the newest stream frame if it is newer than lastSeq
+     * @return true and frame/seq set if there is a newer frame
+     */
+    bool takeStreamFrame(uint32_t lastSeq, FrameRef& frame, uint32_t& seq);
+
     // Setup HTTP endpoints
     void setupRoutes();
     
@@ -129,6 +210,8 @@ private:
     void handleCapture(AsyncWebServerRequest* request);
     void handleCaptureResult(AsyncWebServerRequest* request);
     void handlePreview(AsyncWebServerRequest* request);
+    void sendPreviewFrame(AsyncWebServerRequest* request, const FrameRef& frame, uint32_t gen = 0);
+    void handleStream(AsyncWebServerRequest* request);
     void handleStatus(AsyncWebServerRequest* request);
     void handleAuthCheck(AsyncWebServerRequest* request);
     void handleReset(AsyncWebServerRequest* request);
@@ -0,0 +1,77 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+/**
+ * Host shim for the ESP32 Arduino core (native env only).
+ * Mirrors what <Arduino.h> pulls in on the board: FreeRTOS, String,
+ * Serial, ESP, timing and heap helpers.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+
+using std::max;
+using std::min;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+#define PROGMEM
+#define PGM_P const char*
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const unsigned char*)(addr))
+
+#define RTC_DATA_ATTR __attribute__((section("rtc_data"), used))
+#define RTC_NOINIT_ATTR RTC_DATA_ATTR
+#define IRAM_ATTR
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+bool psramFound();
+void* ps_malloc(size_t size);
+void* ps_calloc(size_t n, size_t size);
+
+// Time (esp32-hal-time.c)
+void configTime(long gmtOffset_sec, int daylightOffset_sec,
+                const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+// Provided by the firmware
+void setup();
+void loop();
+
+#endif // NATIVE_ARDUINO_H
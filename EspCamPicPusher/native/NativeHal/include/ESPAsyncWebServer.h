@@ -0,0 +1,214 @@
+#ifndef NATIVE_ESP_ASYNC_WEB_SERVER_H
+#define NATIVE_ESP_ASYNC_WEB_SERVER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Arduino.h"
+
+/**
+ * ESPAsyncWebServer on a loopback socket (port NATIVE_WEB_PORT instead of the
+ * firmware's port 80). Each connection runs on its own thread, but handlers
+ * and response fillers run under one global lock, reproducing the single
+ * async_tcp task of the ESP32: a handler that blocks stalls every client.
+ * Connections are closed after one response.
+ */
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+
+typedef uint8_t WebRequestMethodComposite;
+
+// Returned by a response filler when no data is ready yet; it is polled again later
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+struct NativeServerState;
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, const String& filename, size_t index,
+                           uint8_t* data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index,
+                           size_t total)> ArBodyHandlerFunction;
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<void(void)> ArDisconnectHandler;
+
+/** Remote end of a request (only what handlers inspect). */
+class AsyncClient {
+public:
+    IPAddress remoteIP() const { return _remoteIP; }
+    uint16_t remotePort() const { return _remotePort; }
+    bool connected() const { return _connected; }
+
+private:
+    friend struct NativeServerState;
+    IPAddress _remoteIP;
+    uint16_t _remotePort = 0;
+    volatile bool _connected = true;
+};
+
+class AsyncWebParameter {
+public:
+    AsyncWebParameter(const String& name, const String& value, bool form = false)
+        : _name(name), _value(value), _isForm(form) {}
+    const String& name() const { return _name; }
+    const String& value() const { return _value; }
+    bool isPost() const { return _isForm; }
+    bool isFile() const { return false; }
+
+private:
+    String _name;
+    String _value;
+    bool _isForm;
+};
+
+class AsyncWebHeader {
+public:
+    AsyncWebHeader(const String& name, const String& value) : _name(name), _value(value) {}
+    const String& name() const { return _name; }
+    const String& value() const { return _value; }
+    String toString() const { return _name + ": " + _value + "\r\n"; }
+
+private:
+    String _name;
+    String _value;
+};
+
+class AsyncWebServerResponse {
+public:
+    AsyncWebServerResponse(int code, const String& contentType) : _code(code), _contentType(contentType) {}
+    virtual ~AsyncWebServerResponse() {}
+
+    void setCode(int code) { _code = code; }
+    void setContentLength(size_t len) { _contentLength = (long)len; }
+    void setContentType(const String& type) { _contentType = type; }
+    void addHeader(const String& name, const String& value) { _headers.emplace_back(name, value); }
+
+    int code() const { return _code; }
+    const String& contentType() const { return _contentType; }
+    long contentLength() const { return _contentLength; }
+    const std::vector<AsyncWebHeader>& headers() const { return _headers; }
+    bool isChunked() const { return _chunked; }
+
+    /** Produce the next body bytes; 0 = done, RESPONSE_TRY_AGAIN = nothing yet. */
+    virtual size_t fill(uint8_t* buffer, size_t maxLen, size_t index) = 0;
+
+protected:
+    int _code;
+    String _contentType;
+    long _contentLength = -1;
+    bool _chunked = false;
+    std::vector<AsyncWebHeader> _headers;
+};
+
+/** Print-able response that buffers its content (beginResponseStream). */
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+public:
+    AsyncResponseStream(const String& contentType, size_t bufferSize)
+        : AsyncWebServerResponse(200, contentType) { _content.reserve(bufferSize); }
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t len) override {
+        _content.append((const char*)data, len);
+        _contentLength = (long)_content.size();
+        return len;
+    }
+    using Print::write;
+    size_t fill(uint8_t* buffer, size_t maxLen, size_t index) override;
+
+private:
+    std::string _content;
+};
+
+class AsyncWebServerRequest {
+public:
+    ~AsyncWebServerRequest();
+
+    AsyncClient* client() { return &_client; }
+    WebRequestMethodComposite method() const { return _method; }
+    const char* methodToString() const;
+    const String& url() const { return _url; }
+    const String& host() const { return _host; }
+    const String& contentType() const { return _contentType; }
+    size_t contentLength() const { return _contentLength; }
+
+    bool hasHeader(const String& name) const;
+    const String& header(const char* name) const;
+    const String& header(size_t i) const;
+    const String& headerName(size_t i) const;
+    size_t headers() const { return _headers.size(); }
+    AsyncWebHeader* getHeader(const String& name) const;
+
+    bool hasParam(const String& name, bool post = false, bool file = false) const;
+    AsyncWebParameter* getParam(const String& name, bool post = false, bool file = false) const;
+    size_t params() const { return _params.size(); }
+    AsyncWebParameter* getParam(size_t num) const;
+    bool hasArg(const char* name) const;
+    const String& arg(const String& name) const;
+
+    void onDisconnect(ArDisconnectHandler fn) { _onDisconnect = fn; }
+
+    void send(AsyncWebServerResponse* response);
+    void send(int code, const String& contentType = String(), const String& content = String());
+    void send_P(int code, const String& contentType, const uint8_t* content, size_t len);
+    void send_P(int code, const String& contentType, PGM_P content);
+    void send(const String& contentType, size_t len, AwsResponseFiller callback);
+    void sendChunked(const String& contentType, AwsResponseFiller callback);
+
+    AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(),
+                                          const String& content = String());
+    AsyncWebServerResponse* beginResponse_P(int code, const String& contentType, const uint8_t* content,
+                                            size_t len);
+    AsyncWebServerResponse* beginResponse_P(int code, const String& contentType, PGM_P content);
+    AsyncWebServerResponse* beginResponse(const String& contentType, size_t len, AwsResponseFiller callback);
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller callback);
+    AsyncResponseStream* beginResponseStream(const String& contentType, size_t bufferSize = 1460);
+
+    void* _tempObject = nullptr;
+
+private:
+    friend struct NativeServerState;
+    AsyncClient _client;
+    WebRequestMethodComposite _method = HTTP_GET;
+    String _url;
+    String _host;
+    String _contentType;
+    size_t _contentLength = 0;
+    std::vector<std::unique_ptr<AsyncWebHeader>> _headers;
+    std::vector<std::unique_ptr<AsyncWebParameter>> _params;
+    AsyncWebServerResponse* _response = nullptr;
+    ArDisconnectHandler _onDisconnect;
+};
+
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port);
+    ~AsyncWebServer();
+
+    void begin();
+    void end();
+    void reset();
+
+    void on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+    void on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+            ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody = nullptr);
+    void onNotFound(ArRequestHandlerFunction fn);
+
+private:
+    uint16_t _port;
+    // Routes and listener live in shared state so connection threads never outlive them
+    std::shared_ptr<NativeServerState> _state;
+};
+
+#endif // NATIVE_ESP_ASYNC_WEB_SERVER_H
@@ -0,0 +1,19 @@
+#ifndef NATIVE_ESPMDNS_H
+#define NATIVE_ESPMDNS_H
+
+#include <stdint.h>
+
+/** mDNS is not emulated on the host; calls only succeed. */
+class MDNSResponder {
+public:
+    bool begin(const char* hostName) { (void)hostName; return true; }
+    void end() {}
+    bool addService(const char* service, const char* proto, uint16_t port) {
+        (void)service; (void)proto; (void)port;
+        return true;
+    }
+};
+
+extern MDNSResponder MDNS;
+
+#endif // NATIVE_ESPMDNS_H
@@ -0,0 +1,23 @@
+#ifndef NATIVE_ESP_H
+#define NATIVE_ESP_H
+
+#include <stdint.h>
+
+/** ESP object: heap figures come from the shim allocator counters. */
+class EspClass {
+public:
+    [[noreturn]] void restart();
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getPsramSize();
+    uint32_t getFreePsram();
+    uint64_t getEfuseMac();
+    const char* getSdkVersion() { return "native"; }
+    uint8_t getChipCores() { return 2; }
+};
+
+extern EspClass ESP;
+
+#endif // NATIVE_ESP_H
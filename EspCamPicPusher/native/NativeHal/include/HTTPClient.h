@@ -0,0 +1,127 @@
+#ifndef NATIVE_HTTP_CLIENT_H
+#define NATIVE_HTTP_CLIENT_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_STREAM (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM (-8)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+#define HTTPCLIENT_DEFAULT_TCP_TIMEOUT (5000)
+
+typedef enum {
+    HTTP_CODE_CONTINUE = 100,
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_CREATED = 201,
+    HTTP_CODE_ACCEPTED = 202,
+    HTTP_CODE_NO_CONTENT = 204,
+    HTTP_CODE_PARTIAL_CONTENT = 206,
+    HTTP_CODE_MOVED_PERMANENTLY = 301,
+    HTTP_CODE_FOUND = 302,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_UNAUTHORIZED = 401,
+    HTTP_CODE_FORBIDDEN = 403,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_CONFLICT = 409,
+    HTTP_CODE_LENGTH_REQUIRED = 411,
+    HTTP_CODE_PAYLOAD_TOO_LARGE = 413,
+    HTTP_CODE_UNPROCESSABLE_ENTITY = 422,
+    HTTP_CODE_TOO_MANY_REQUESTS = 429,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+    HTTP_CODE_SERVICE_UNAVAILABLE = 503,
+} t_http_codes;
+
+typedef enum {
+    HTTPC_TE_IDENTITY,
+    HTTPC_TE_CHUNKED,
+} transferEncoding_t;
+
+/**
+ * Subset of the ESP32 core HTTPClient: one request per begin()/end(),
+ * Content-Length and chunked responses, header collection. "https://" URLs
+ * are accepted and sent over the (plain) client passed to begin().
+ */
+class HTTPClient {
+public:
+    HTTPClient();
+    ~HTTPClient();
+
+    bool begin(WiFiClient& client, const String& url);
+    bool begin(WiFiClient& client, const String& host, uint16_t port, const String& uri = "/", bool https = false);
+    bool begin(const String& url);
+    void end();
+
+    void setTimeout(uint16_t timeout) { _timeout = timeout; }
+    void setConnectTimeout(int32_t connectTimeout) { _connectTimeout = connectTimeout; }
+    void setReuse(bool reuse) { _reuse = reuse; }
+    void useHTTP10(bool usehttp10 = true) { _useHTTP10 = usehttp10; }
+    void setUserAgent(const String& userAgent) { _userAgent = userAgent; }
+
+    void addHeader(const String& name, const String& value, bool first = false, bool replace = true);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+    bool hasHeader(const char* name);
+
+    int GET();
+    int POST(uint8_t* payload, size_t size);
+    int POST(const String& payload);
+    int PUT(uint8_t* payload, size_t size);
+    int PUT(const String& payload);
+    int sendRequest(const char* type, const String& payload);
+    int sendRequest(const char* type, uint8_t* payload = nullptr, size_t size = 0);
+    int sendRequest(const char* type, Stream* stream, size_t size = 0);
+
+    int getSize() const { return _size; }
+    const String& getLocation() const { return _location; }
+    WiFiClient& getStream();
+    WiFiClient* getStreamPtr();
+    int writeToStream(Stream* stream);
+    String getString();
+    bool connected();
+
+    static String errorToString(int error);
+
+private:
+    WiFiClient* _client = nullptr;
+    std::unique_ptr<WiFiClient> _ownedClient;
+    String _host;
+    uint16_t _port = 80;
+    String _uri;
+    String _headers;
+    String _userAgent = "ESP32HTTPClient";
+    uint16_t _timeout = HTTPCLIENT_DEFAULT_TCP_TIMEOUT;
+    int32_t _connectTimeout = -1;
+    bool _reuse = true;
+    bool _useHTTP10 = false;
+    std::vector<std::pair<std::string, std::string>> _collected;  // key -> value
+    int _returnCode = 0;
+    int _size = -1;
+    String _location;
+    transferEncoding_t _transferEncoding = HTTPC_TE_IDENTITY;
+    bool _canReuse = false;
+    bool _bodyConsumed = false;
+
+    bool parseUrl(const String& url);
+    bool connect();
+    bool sendHeader(const char* type, size_t contentLength);
+    int handleHeaderResponse();
+    bool readLine(String& line);
+    int readBody(Stream* out);
+    int returnError(int error);
+};
+
+#endif // NATIVE_HTTP_CLIENT_H
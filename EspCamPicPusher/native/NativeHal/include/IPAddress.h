@@ -0,0 +1,29 @@
+#ifndef NATIVE_IPADDRESS_H
+#define NATIVE_IPADDRESS_H
+
+#include <stdint.h>
+#include "WString.h"
+
+class IPAddress {
+public:
+    IPAddress() : _address(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : _address((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t address) : _address(address) {}
+
+    operator uint32_t() const { return _address; }
+    bool operator==(const IPAddress& other) const { return _address == other._address; }
+    bool operator!=(const IPAddress& other) const { return _address != other._address; }
+    uint8_t operator[](int index) const { return (uint8_t)(_address >> (index * 8)); }
+
+    bool fromString(const char* address);
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+    String toString() const;
+
+private:
+    uint32_t _address;  // Network byte order, as in the ESP32 core
+};
+
+extern const IPAddress INADDR_NONE;
+
+#endif // NATIVE_IPADDRESS_H
@@ -0,0 +1,29 @@
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+
+/**
+ * LittleFS on the "spiffs" data partition, backed by NATIVE_DATA_DIR/littlefs/.
+ * totalBytes() reports the partition size (NATIVE_LITTLEFS_KB, default 960);
+ * usedBytes() sums the files rounded up to 4 KB blocks. Writes beyond the
+ * partition size fail like a full flash.
+ */
+class LittleFSFS : public FS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    bool format();
+    size_t totalBytes();
+    size_t usedBytes();
+    void end();
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+using fs::LittleFSFS;
+
+#endif // NATIVE_LITTLEFS_H
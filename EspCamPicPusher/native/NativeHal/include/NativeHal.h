@@ -0,0 +1,75 @@
+#ifndef NATIVE_HAL_H
+#define NATIVE_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+/**
+ * NativeHal - Host-side control surface for the `native` PlatformIO env
+ *
+ * The shim headers in this library (Arduino.h, WiFi.h, esp_camera.h, ...)
+ * implement just enough of the ESP32 Arduino core for the firmware sources to
+ * build and run on Linux. This header exposes the knobs that have no ESP32
+ * counterpart: the virtual clock, the data directory backing NVS/RTC/OTA, and
+ * the process exit codes used to emulate deep sleep and restarts.
+ *
+ * Runtime configuration (environment variables):
+ *   NATIVE_DATA_DIR          Directory for NVS, RTC, OTA and LittleFS files (default: .native)
+ *   NATIVE_REALTIME          1 = delay() really sleeps (needed for the web UI)
+ *   NATIVE_CAMERA_DIR        Directory of *.jpg frames returned by esp_camera_fb_get()
+ *   NATIVE_CAMERA_FRAME_MS   Simulated sensor frame time (default: 66)
+ *   NATIVE_CAMERA_CONVERGE_FRAMES  Frames AEC/AGC registers keep moving after init (default: 1)
+ *   NATIVE_WIFI_ASSOC_MS     Simulated scan + association + DHCP time (default: 1500)
+ *   NATIVE_WIFI_FAIL         1 = WiFi never connects
+ *   NATIVE_WIFI_RSSI         Reported signal strength in dBm (default: -60)
+ *   NATIVE_LITTLEFS_KB       Size of the LittleFS partition in NATIVE_DATA_DIR/littlefs (default: 960)
+ *   NATIVE_WEB_PORT          Loopback port for AsyncWebServer (default: 8080)
+ *   NATIVE_TCP_ACK_MS        Modelled delayed ACK of a short response segment (default: 40)
+ *   NATIVE_HOST_OVERRIDE     host[:port] that replaces the host of every outgoing URL
+ */
+namespace NativeHal {
+
+// Process exit codes (see native/run-wake-cycles.sh)
+static const int EXIT_DEEP_SLEEP = 0;
+static const int EXIT_RESTART = 3;
+
+/** Directory backing all persistent state (created on first use). */
+const std::string& dataDir();
+
+/** Path of a file inside dataDir(). */
+std::string dataPath(const char* name);
+
+/** Read an integer environment variable with a default. */
+long envLong(const char* name, long defaultValue);
+
+/** True when delay() should block for real instead of advancing the virtual clock. */
+bool realtime();
+
+/**
+ * Virtual clock. micros() = real elapsed time since start + accumulated skew.
+ * delay() adds to the skew instead of sleeping unless realtime() is set, so
+ * modelled waits (WiFi association, sensor frames) show up in timings without
+ * slowing down perf/valgrind runs.
+ */
+uint64_t clockMicros();
+void advanceClock(uint64_t us);
+
+/** Wait for `ms` on the virtual clock (the implementation behind delay()). */
+void sleepMs(uint32_t ms);
+
+/** Persist RTC_DATA_ATTR memory and terminate with the given exit code. */
+[[noreturn]] void powerDown(int exitCode, int wakeCause);
+
+/** Restore RTC_DATA_ATTR memory saved by a previous powerDown(). Returns the wake cause. */
+int restoreRtcMemory();
+
+/** Wake cause determined at startup (esp_sleep_wakeup_cause_t value). */
+int wakeCause();
+
+/** Replace scheme-less host[:port] of outgoing connections if NATIVE_HOST_OVERRIDE is set. */
+bool hostOverride(std::string& host, uint16_t& port);
+
+} // namespace NativeHal
+
+#endif // NATIVE_HAL_H
@@ -0,0 +1,79 @@
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+#include <map>
+#include <string>
+#include <string.h>
+#include "WString.h"
+
+/**
+ * NVS Preferences backed by one file per namespace in NATIVE_DATA_DIR/nvs/.
+ * Every put*() rewrites the file (write to temp + rename), so a killed process
+ * never leaves a half-written namespace behind.
+ */
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+    size_t freeEntries() { return 256; }
+
+    size_t putBool(const char* key, bool value) { return putValue(key, &value, sizeof(value)); }
+    size_t putChar(const char* key, int8_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putUChar(const char* key, uint8_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putShort(const char* key, int16_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putUShort(const char* key, uint16_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putInt(const char* key, int32_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putUInt(const char* key, uint32_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putLong(const char* key, int32_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putULong(const char* key, uint32_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putLong64(const char* key, int64_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putULong64(const char* key, uint64_t value) { return putValue(key, &value, sizeof(value)); }
+    size_t putFloat(const char* key, float value) { return putValue(key, &value, sizeof(value)); }
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+    size_t putBytes(const char* key, const void* value, size_t len) { return putValue(key, value, len); }
+
+    bool getBool(const char* key, bool defaultValue = false) { return getValue(key, defaultValue); }
+    int8_t getChar(const char* key, int8_t defaultValue = 0) { return getValue(key, defaultValue); }
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) { return getValue(key, defaultValue); }
+    int16_t getShort(const char* key, int16_t defaultValue = 0) { return getValue(key, defaultValue); }
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0) { return getValue(key, defaultValue); }
+    int32_t getInt(const char* key, int32_t defaultValue = 0) { return getValue(key, defaultValue); }
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) { return getValue(key, defaultValue); }
+    int32_t getLong(const char* key, int32_t defaultValue = 0) { return getValue(key, defaultValue); }
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) { return getValue(key, defaultValue); }
+    int64_t getLong64(const char* key, int64_t defaultValue = 0) { return getValue(key, defaultValue); }
+    uint64_t getULong64(const char* key, uint64_t defaultValue = 0) { return getValue(key, defaultValue); }
+    float getFloat(const char* key, float defaultValue = 0) { return getValue(key, defaultValue); }
+    String getString(const char* key, const String& defaultValue = String());
+    size_t getString(const char* key, char* value, size_t maxLen);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+private:
+    std::string _name;
+    std::map<std::string, std::string> _entries;
+    bool _started = false;
+    bool _readOnly = false;
+
+    size_t putValue(const char* key, const void* value, size_t len);
+    bool load();
+    bool save();
+
+    template <typename T>
+    T getValue(const char* key, T defaultValue) {
+        auto it = _started && key ? _entries.find(key) : _entries.end();
+        if (it == _entries.end() || it->second.size() != sizeof(T)) {
+            return defaultValue;
+        }
+        T value;
+        memcpy(&value, it->second.data(), sizeof(T));
+        return value;
+    }
+};
+
+#endif // NATIVE_PREFERENCES_H
@@ -0,0 +1,59 @@
+#ifndef NATIVE_PRINT_H
+#define NATIVE_PRINT_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+/**
+ * Minimal Arduino Print: subclasses implement write(uint8_t) and optionally
+ * the buffered write(); print/println/printf are built on top.
+ */
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            if (write(*buffer++)) {
+                n++;
+            } else {
+                break;
+            }
+        }
+        return n;
+    }
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual void flush() {}
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned int n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(long long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long long n, int base = DEC) { return print(String(n, (unsigned char)base)); }
+    size_t print(double n, int digits = 2) { return print(String(n, (unsigned int)digits)); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+#endif // NATIVE_PRINT_H
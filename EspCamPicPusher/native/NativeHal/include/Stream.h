@@ -0,0 +1,30 @@
+#ifndef NATIVE_STREAM_H
+#define NATIVE_STREAM_H
+
+#include "Print.h"
+
+/**
+ * Minimal Arduino Stream. readBytes()/readString() honour setTimeout() on the
+ * virtual clock, like the ESP32 core.
+ */
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+
+    virtual size_t readBytes(char* buffer, size_t length);
+    virtual size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    String readString();
+    String readStringUntil(char terminator);
+
+protected:
+    unsigned long _timeout = 1000;
+
+    int timedRead();
+};
+
+#endif // NATIVE_STREAM_H
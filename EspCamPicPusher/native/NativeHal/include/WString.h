@@ -0,0 +1,114 @@
+#ifndef NATIVE_WSTRING_H
+#define NATIVE_WSTRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+/**
+ * Arduino String backed by std::string.
+ * Covers the subset of the arduino-esp32 API used by the firmware and by
+ * ArduinoJson's ARDUINOJSON_ENABLE_ARDUINO_STRING adapter.
+ */
+class String {
+public:
+    String() {}
+    String(const char* cstr) : s(cstr ? cstr : "") {}
+    String(const char* cstr, size_t len) : s(cstr ? std::string(cstr, len) : std::string()) {}
+    String(const std::string& str) : s(str) {}
+    String(const String& other) = default;
+    String(String&& other) = default;
+    explicit String(char c) : s(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(int value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned int value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(long long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    explicit String(float value, unsigned int decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+    explicit String(double value, unsigned int decimalPlaces = 2) { fromDouble(value, decimalPlaces); }
+
+    String& operator=(const String& rhs) = default;
+    String& operator=(String&& rhs) = default;
+    String& operator=(const char* cstr) { s = cstr ? cstr : ""; return *this; }
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.size(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+    const std::string& str() const { return s; }
+
+    bool concat(const String& str) { s += str.s; return true; }
+    bool concat(const char* cstr) { if (!cstr) return false; s += cstr; return true; }
+    bool concat(const char* cstr, unsigned int len) { if (!cstr) return false; s.append(cstr, len); return true; }
+    bool concat(char c) { s += c; return true; }
+    bool concat(int num) { return concat(String(num)); }
+    bool concat(unsigned int num) { return concat(String(num)); }
+    bool concat(long num) { return concat(String(num)); }
+    bool concat(unsigned long num) { return concat(String(num)); }
+    bool concat(double num) { return concat(String(num)); }
+
+    template <typename T>
+    String& operator+=(const T& rhs) { concat(rhs); return *this; }
+
+    bool equals(const String& other) const { return s == other.s; }
+    bool equals(const char* cstr) const { return s == (cstr ? cstr : ""); }
+    bool equalsIgnoreCase(const String& other) const;
+    bool operator==(const String& rhs) const { return s == rhs.s; }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& rhs) const { return s != rhs.s; }
+    bool operator!=(const char* cstr) const { return !equals(cstr); }
+    bool operator<(const String& rhs) const { return s < rhs.s; }
+    int compareTo(const String& other) const { return s.compare(other.s); }
+
+    bool startsWith(const String& prefix) const { return s.compare(0, prefix.s.size(), prefix.s) == 0; }
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+
+    char charAt(unsigned int index) const { return index < s.size() ? s[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < s.size()) s[index] = c; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return s[index]; }
+
+    int indexOf(char ch, unsigned int fromIndex = 0) const;
+    int indexOf(const String& str, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(const String& str) const;
+
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+private:
+    std::string s;
+
+    void fromSigned(long long value, unsigned char base);
+    void fromUnsigned(unsigned long long value, unsigned char base);
+    void fromDouble(double value, unsigned int decimalPlaces);
+};
+
+inline String operator+(const String& lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const String& lhs, const char* rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const char* lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const String& lhs, char rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const String& lhs, int rhs) { return lhs + String(rhs); }
+inline String operator+(const String& lhs, unsigned int rhs) { return lhs + String(rhs); }
+inline String operator+(const String& lhs, long rhs) { return lhs + String(rhs); }
+inline String operator+(const String& lhs, unsigned long rhs) { return lhs + String(rhs); }
+inline String operator+(const String& lhs, double rhs) { return lhs + String(rhs); }
+inline bool operator==(const char* lhs, const String& rhs) { return rhs == lhs; }
+inline bool operator!=(const char* lhs, const String& rhs) { return rhs != lhs; }
+
+#endif // NATIVE_WSTRING_H
@@ -0,0 +1,148 @@
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+#include <atomic>
+#include <functional>
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+#include "WiFiClientSecure.h"
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum {
+    WIFI_MODE_NULL = 0,
+    WIFI_MODE_STA,
+    WIFI_MODE_AP,
+    WIFI_MODE_APSTA,
+} wifi_mode_t;
+
+#define WIFI_OFF WIFI_MODE_NULL
+#define WIFI_STA WIFI_MODE_STA
+#define WIFI_AP WIFI_MODE_AP
+#define WIFI_AP_STA WIFI_MODE_APSTA
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_STOP,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_AUTHMODE_CHANGE,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP6,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP,
+    ARDUINO_EVENT_MAX = 64,
+} arduino_event_id_t;
+
+typedef struct {
+    uint32_t addr;
+} native_ip4_addr_t;
+
+/** Subset of the ESP-IDF event payloads carried by arduino_event_info_t. */
+typedef union {
+    struct {
+        uint8_t ssid[33];
+        uint8_t ssid_len;
+        uint8_t bssid[6];
+        uint8_t channel;
+    } wifi_sta_connected;
+    struct {
+        uint8_t ssid[33];
+        uint8_t ssid_len;
+        uint8_t bssid[6];
+        uint8_t reason;
+    } wifi_sta_disconnected;
+    struct {
+        struct {
+            native_ip4_addr_t ip;
+            native_ip4_addr_t netmask;
+            native_ip4_addr_t gw;
+        } ip_info;
+    } got_ip;
+} arduino_event_info_t;
+
+typedef int wifi_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+
+/**
+ * Simulated station/AP. begin() "associates" on the virtual clock:
+ * NATIVE_WIFI_ASSOC_MS is split into scan (40%), association (20%) and
+ * DHCP (40%). Passing channel + BSSID to begin() skips the scan share and a
+ * static config() skips the DHCP share, mirroring the real fast-connect gains.
+ * Events are delivered from a separate thread, like the ESP32 event task.
+ */
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t mode);
+    wifi_mode_t getMode() const { return _mode; }
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet,
+                IPAddress dns1 = (uint32_t)0, IPAddress dns2 = (uint32_t)0);
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+    bool reconnect();
+    wl_status_t status();
+    bool isConnected() { return status() == WL_CONNECTED; }
+
+    bool setHostname(const char* hostname);
+    const char* getHostname() const { return _hostname.c_str(); }
+    bool setAutoReconnect(bool autoReconnect) { (void)autoReconnect; return true; }
+    void persistent(bool persistent) { (void)persistent; }
+    bool setSleep(bool enabled) { (void)enabled; return true; }
+
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t dnsNo = 0);
+    String macAddress();
+    uint8_t* macAddress(uint8_t* mac);
+    int8_t RSSI();
+    String SSID();
+    uint8_t* BSSID();
+    String BSSIDstr();
+    int32_t channel();
+
+    bool softAP(const char* ssid, const char* passphrase = nullptr, int channel = 1,
+                int ssidHidden = 0, int maxConnection = 4);
+    bool softAPdisconnect(bool wifiOff = false);
+    IPAddress softAPIP();
+    String softAPSSID() const { return String(_apSsid); }
+
+    int hostByName(const char* hostname, IPAddress& result);
+
+    wifi_event_id_t onEvent(WiFiEventFuncCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+    void removeEvent(wifi_event_id_t id);
+
+private:
+    wifi_mode_t _mode = WIFI_MODE_NULL;
+    std::string _hostname = "esp32s3";
+    std::string _ssid;
+    std::string _apSsid;
+    bool _apStarted = false;
+    bool _staticIp = false;
+    IPAddress _ip, _gateway, _subnet, _dns;
+    std::atomic<uint64_t> _connectAtUs{ 0 };
+    std::atomic<bool> _connecting{ false };
+    std::atomic<uint32_t> _generation{ 0 };
+    uint8_t _bssid[6] = { 0x02, 0x00, 0x00, 0xAB, 0xCD, 0x01 };
+    int32_t _channel = 6;
+
+    void dispatch(arduino_event_id_t event, arduino_event_info_t info);
+};
+
+extern WiFiClass WiFi;
+
+#endif // NATIVE_WIFI_H
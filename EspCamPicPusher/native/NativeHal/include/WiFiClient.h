@@ -0,0 +1,44 @@
+#ifndef NATIVE_WIFI_CLIENT_H
+#define NATIVE_WIFI_CLIENT_H
+
+#include <memory>
+#include "Client.h"
+#include "IPAddress.h"
+
+struct NativeSocket;
+
+/**
+ * TCP client over POSIX sockets. Copies share the same connection, like the
+ * ESP32 core's WiFiClient. NATIVE_HOST_OVERRIDE redirects every connect().
+ */
+class WiFiClient : public Client {
+public:
+    WiFiClient();
+    ~WiFiClient() override;
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    virtual int connect(const char* host, uint16_t port, int32_t timeoutMs);
+
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t* buf, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size) override;
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override { return connected(); }
+
+    int setNoDelay(bool nodelay);
+    int fd() const;
+    IPAddress remoteIP() const;
+    uint16_t remotePort() const;
+
+protected:
+    std::shared_ptr<NativeSocket> _socket;
+};
+
+#endif // NATIVE_WIFI_CLIENT_H
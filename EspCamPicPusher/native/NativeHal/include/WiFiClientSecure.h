@@ -0,0 +1,19 @@
+#ifndef NATIVE_WIFI_CLIENT_SECURE_H
+#define NATIVE_WIFI_CLIENT_SECURE_H
+
+#include "WiFi.h"
+#include "WiFiClient.h"
+
+/**
+ * WiFiClientSecure without TLS: the native env talks plain HTTP to a local
+ * stand-in server (see NATIVE_HOST_OVERRIDE), so certificate options are
+ * accepted and ignored.
+ */
+class WiFiClientSecure : public WiFiClient {
+public:
+    void setInsecure() {}
+    void setCACert(const char* rootCA) { (void)rootCA; }
+    void setHandshakeTimeout(unsigned long handshakeTimeoutSec) { (void)handshakeTimeoutSec; }
+};
+
+#endif // NATIVE_WIFI_CLIENT_SECURE_H
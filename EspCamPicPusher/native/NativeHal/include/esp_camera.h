@@ -0,0 +1,84 @@
+#ifndef NATIVE_ESP_CAMERA_H
+#define NATIVE_ESP_CAMERA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include "esp_err.h"
+#include "sensor.h"
+
+// driver/ledc.h (only the values used by camera_config_t)
+typedef enum { LEDC_CHANNEL_0 = 0, LEDC_CHANNEL_1, LEDC_CHANNEL_MAX } ledc_channel_t;
+typedef enum { LEDC_TIMER_0 = 0, LEDC_TIMER_1, LEDC_TIMER_MAX } ledc_timer_t;
+
+typedef enum {
+    CAMERA_GRAB_WHEN_EMPTY,
+    CAMERA_GRAB_LATEST,
+} camera_grab_mode_t;
+
+typedef enum {
+    CAMERA_FB_IN_PSRAM,
+    CAMERA_FB_IN_DRAM,
+} camera_fb_location_t;
+
+typedef struct {
+    int pin_pwdn;
+    int pin_reset;
+    int pin_xclk;
+    union {
+        int pin_sccb_sda;
+        int pin_sscb_sda;
+    };
+    union {
+        int pin_sccb_scl;
+        int pin_sscb_scl;
+    };
+    int pin_d7;
+    int pin_d6;
+    int pin_d5;
+    int pin_d4;
+    int pin_d3;
+    int pin_d2;
+    int pin_d1;
+    int pin_d0;
+    int pin_vsync;
+    int pin_href;
+    int pin_pclk;
+
+    int xclk_freq_hz;
+    ledc_timer_t ledc_timer;
+    ledc_channel_t ledc_channel;
+
+    pixformat_t pixel_format;
+    framesize_t frame_size;
+    int jpeg_quality;
+    size_t fb_count;
+    camera_fb_location_t fb_location;
+    camera_grab_mode_t grab_mode;
+    int sccb_i2c_port;
+} camera_config_t;
+
+typedef struct {
+    uint8_t* buf;
+    size_t len;
+    size_t width;
+    size_t height;
+    pixformat_t format;
+    struct timeval timestamp;
+} camera_fb_t;
+
+/**
+ * Simulated OV2640. Frames are the *.jpg files of NATIVE_CAMERA_DIR in name
+ * order (looping), or a built-in test pattern. esp_camera_fb_get() takes
+ * NATIVE_CAMERA_FRAME_MS on the virtual clock per frame, like a free-running
+ * sensor with fb_count = 1. The AEC/AGC registers ramp from their value at
+ * the first frame (as seeded by the firmware) to fixed final values over the
+ * first NATIVE_CAMERA_CONVERGE_FRAMES frames after init, then hold.
+ */
+esp_err_t esp_camera_init(const camera_config_t* config);
+esp_err_t esp_camera_deinit();
+camera_fb_t* esp_camera_fb_get();
+void esp_camera_fb_return(camera_fb_t* fb);
+sensor_t* esp_camera_sensor_get();
+
+#endif // NATIVE_ESP_CAMERA_H
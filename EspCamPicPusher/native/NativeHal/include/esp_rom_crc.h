@@ -0,0 +1,9 @@
+#ifndef NATIVE_ESP_ROM_CRC_H
+#define NATIVE_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+/** CRC-32 (IEEE 802.3) as in the ESP32 ROM: crc = 0 starts a new checksum. */
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
+
+#endif // NATIVE_ESP_ROM_CRC_H
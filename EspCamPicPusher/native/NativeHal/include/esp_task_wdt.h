@@ -0,0 +1,8 @@
+#ifndef NATIVE_ESP_TASK_WDT_H
+#define NATIVE_ESP_TASK_WDT_H
+
+#include "esp_err.h"
+
+inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
+
+#endif // NATIVE_ESP_TASK_WDT_H
@@ -0,0 +1,28 @@
+#ifndef NATIVE_FREERTOS_H
+#define NATIVE_FREERTOS_H
+
+#include <stdint.h>
+
+/**
+ * FreeRTOS shim on std::thread. One tick is one millisecond, as with the
+ * ESP32 Arduino core (configTICK_RATE_HZ = 1000). Blocking calls wait in
+ * real time but propagate the signalling task's virtual clock to the
+ * waiter, so concurrent stages overlap on the virtual timeline.
+ */
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(xTimeInMs))
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define configMAX_PRIORITIES 25
+
+#endif // NATIVE_FREERTOS_H
@@ -0,0 +1,22 @@
+#ifndef NATIVE_IMG_CONVERTERS_H
+#define NATIVE_IMG_CONVERTERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sensor.h"
+
+// esp32-camera img_converters.h (JPEG encoder subset). As on the device,
+// PIXFORMAT_RGB888 input is stored B, G, R per pixel.
+
+typedef size_t (*jpg_out_cb)(void* arg, size_t index, const void* data, size_t len);
+
+/**
+ * Encode an image to a baseline JPEG, streaming the output to `cb`
+ * Supports PIXFORMAT_RGB888 and PIXFORMAT_GRAYSCALE.
+ * @param quality 1..100 (higher is better, unlike the sensor setting)
+ * @return false if the format is not supported or `cb` took fewer bytes than offered
+ */
+bool fmt2jpg_cb(uint8_t* src, size_t src_len, uint16_t width, uint16_t height, pixformat_t format,
+                uint8_t quality, jpg_out_cb cb, void* arg);
+
+#endif // NATIVE_IMG_CONVERTERS_H
@@ -0,0 +1,374 @@
+#include <Arduino.h>
+#include <ESPmDNS.h>
+#include <base64.h>
+#include "esp_rom_crc.h"
+#include "esp_sleep.h"
+#include "esp_system.h"
+#include "NativeHal.h"
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+MDNSResponder MDNS;
+const IPAddress INADDR_NONE(0, 0, 0, 0);
+
+// Nominal ESP32-S3 + 8 MB PSRAM figures reported by ESP.*() and heap_caps_*()
+static const uint32_t HEAP_SIZE = 320 * 1024;
+static const uint32_t PSRAM_SIZE = 8 * 1024 * 1024;
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+unsigned long millis() {
+    return (unsigned long)(NativeHal::clockMicros() / 1000ULL);
+}
+
+unsigned long micros() {
+    return (unsigned long)NativeHal::clockMicros();
+}
+
+int64_t esp_timer_get_time() {
+    return (int64_t)NativeHal::clockMicros();
+}
+
+void delay(uint32_t ms) {
+    NativeHal::sleepMs(ms);
+}
+
+void delayMicroseconds(uint32_t us) {
+    NativeHal::advanceClock(us);
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+// ============================================================================
+// GPIO, random, CRC, PSRAM
+// ============================================================================
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    (void)pin;
+    (void)val;
+}
+
+int digitalRead(uint8_t pin) {
+    (void)pin;
+    return LOW;
+}
+
+static std::mt19937& rng() {
+    static std::mt19937 engine(12345);
+    return engine;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) {
+        return 0;
+    }
+    return (long)(rng()() % (unsigned long)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) {
+        return howsmall;
+    }
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        rng().seed((uint32_t)seed);
+    }
+}
+
+uint32_t esp_random() {
+    return (uint32_t)rng()();
+}
+
+void esp_fill_random(void* buf, size_t len) {
+    uint8_t* out = (uint8_t*)buf;
+    for (size_t i = 0; i < len; i++) {
+        out[i] = (uint8_t)rng()();
+    }
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+bool psramFound() {
+    return true;
+}
+
+void* ps_malloc(size_t size) {
+    return malloc(size);
+}
+
+void* ps_calloc(size_t n, size_t size) {
+    return calloc(n, size);
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    (void)caps;
+    return calloc(n, size);
+}
+
+void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? PSRAM_SIZE : HEAP_SIZE;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return heap_caps_get_free_size(caps) / 2;
+}
+
+// ============================================================================
+// Serial, ESP, system
+// ============================================================================
+
+static std::mutex& serialLock() {
+    static std::mutex lock;
+    return lock;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    std::lock_guard<std::mutex> guard(serialLock());
+    return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    std::lock_guard<std::mutex> guard(serialLock());
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+void EspClass::restart() {
+    NativeHal::powerDown(NativeHal::EXIT_RESTART, ESP_SLEEP_WAKEUP_UNDEFINED);
+}
+
+uint32_t EspClass::getHeapSize() {
+    return HEAP_SIZE;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return HEAP_SIZE * 3 / 4;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    return HEAP_SIZE / 2;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return HEAP_SIZE / 4;
+}
+
+uint32_t EspClass::getPsramSize() {
+    return PSRAM_SIZE;
+}
+
+uint32_t EspClass::getFreePsram() {
+    return PSRAM_SIZE - 512 * 1024;
+}
+
+uint64_t EspClass::getEfuseMac() {
+    // 02:00:00:EC:AA:01 (locally administered), little-endian as on the chip
+    return 0x01AAEC000002ULL;
+}
+
+void esp_restart() {
+    ESP.restart();
+}
+
+esp_reset_reason_t esp_reset_reason() {
+    return NativeHal::wakeCause() == ESP_SLEEP_WAKEUP_TIMER ? ESP_RST_DEEPSLEEP : ESP_RST_POWERON;
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_OTA_VALIDATE_FAILED: return "ESP_ERR_OTA_VALIDATE_FAILED";
+        default: return "UNKNOWN ERROR";
+    }
+}
+
+// ============================================================================
+// Deep sleep
+// ============================================================================
+
+static uint64_t sleepTimerUs = 0;
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+    return (esp_sleep_wakeup_cause_t)NativeHal::wakeCause();
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us) {
+    sleepTimerUs = time_in_us;
+    return ESP_OK;
+}
+
+void esp_deep_sleep_start() {
+    printf("[NativeHal] Deep sleep for %.1f s\n", sleepTimerUs / 1e6);
+    NativeHal::powerDown(NativeHal::EXIT_DEEP_SLEEP,
+                         sleepTimerUs > 0 ? ESP_SLEEP_WAKEUP_TIMER : ESP_SLEEP_WAKEUP_UNDEFINED);
+}
+
+// ============================================================================
+// Time (SNTP is not emulated: the host clock is already synchronised)
+// ============================================================================
+
+void configTime(long gmtOffset_sec, int daylightOffset_sec,
+                const char* server1, const char* server2, const char* server3) {
+    (void)server1;
+    (void)server2;
+    (void)server3;
+    // POSIX TZ offsets are west-positive: UTC+1 is "UTC-1"
+    long offset = gmtOffset_sec + daylightOffset_sec;
+    char tz[32];
+    snprintf(tz, sizeof(tz), "UTC%c%ld:%02ld", offset > 0 ? '-' : '+',
+             labs(offset) / 3600, (labs(offset) % 3600) / 60);
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+    (void)ms;
+    time_t now = time(nullptr);
+    localtime_r(&now, info);
+    return info->tm_year > (2016 - 1900);
+}
+
+// ============================================================================
+// Print / Stream / IPAddress / base64
+// ============================================================================
+
+size_t Print::printf(const char* format, ...) {
+    char small[256];
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(small, sizeof(small), format, copy);
+    va_end(copy);
+    if (len < 0) {
+        va_end(args);
+        return 0;
+    }
+    if ((size_t)len < sizeof(small)) {
+        va_end(args);
+        return write((const uint8_t*)small, (size_t)len);
+    }
+    std::string big((size_t)len + 1, '\0');
+    vsnprintf(&big[0], big.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), (size_t)len);
+}
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) {
+            return c;
+        }
+        usleep(100);
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) {
+            break;
+        }
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+String Stream::readString() {
+    std::string result;
+    int c;
+    while ((c = timedRead()) >= 0) {
+        result += (char)c;
+    }
+    return String(result);
+}
+
+String Stream::readStringUntil(char terminator) {
+    std::string result;
+    int c;
+    while ((c = timedRead()) >= 0 && c != terminator) {
+        result += (char)c;
+    }
+    return String(result);
+}
+
+bool IPAddress::fromString(const char* address) {
+    unsigned a, b, c, d;
+    char tail;
+    if (!address || sscanf(address, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 ||
+        a > 255 || b > 255 || c > 255 || d > 255) {
+        return false;
+    }
+    *this = IPAddress((uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d);
+    return true;
+}
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(buf);
+}
+
+String base64::encode(const uint8_t* data, size_t length) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((length + 2) / 3 * 4);
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t chunk = (uint32_t)data[i] << 16;
+        if (i + 1 < length) chunk |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < length) chunk |= data[i + 2];
+        out += alphabet[(chunk >> 18) & 0x3F];
+        out += alphabet[(chunk >> 12) & 0x3F];
+        out += i + 1 < length ? alphabet[(chunk >> 6) & 0x3F] : '=';
+        out += i + 2 < length ? alphabet[chunk & 0x3F] : '=';
+    }
+    return String(out);
+}
@@ -0,0 +1,676 @@
+#include <ESPAsyncWebServer.h>
+#include "NativeHal.h"
+#include "NativeHalInternal.h"
+#include <atomic>
+#include <errno.h>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace {
+
+const size_t TCP_SEGMENT = 1460;
+const unsigned long REQUEST_TIMEOUT_MS = 10000;
+const unsigned long DEFERRED_RESPONSE_TIMEOUT_MS = 60000;
+// AsyncTCP calls a response filler again when written data is ACKed, or on
+// the lwIP poll timer (tcp_poll interval 1 = 500 ms) when nothing is in flight
+const unsigned long TCP_POLL_INTERVAL_MS = 500;
+const String EMPTY_STRING;
+
+class BasicResponse : public AsyncWebServerResponse {
+public:
+    BasicResponse(int code, const String& contentType, const String& content)
+        : AsyncWebServerResponse(code, contentType), _content(content.str()) {
+        _contentLength = (long)_content.size();
+    }
+    size_t fill(uint8_t* buffer, size_t maxLen, size_t index) override {
+        size_t n = index < _content.size() ? std::min(maxLen, _content.size() - index) : 0;
+        memcpy(buffer, _content.data() + index, n);
+        return n;
+    }
+
+private:
+    std::string _content;
+};
+
+class ProgmemResponse : public AsyncWebServerResponse {
+public:
+    ProgmemResponse(int code, const String& contentType, const uint8_t* content, size_t len)
+        : AsyncWebServerResponse(code, contentType), _content(content) {
+        _contentLength = (long)len;
+    }
+    size_t fill(uint8_t* buffer, size_t maxLen, size_t index) override {
+        size_t len = (size_t)_contentLength;
+        size_t n = index < len ? std::min(maxLen, len - index) : 0;
+        memcpy(buffer, _content + index, n);
+        return n;
+    }
+
+private:
+    const uint8_t* _content;
+};
+
+class CallbackResponse : public AsyncWebServerResponse {
+public:
+    CallbackResponse(const String& contentType, long len, AwsResponseFiller callback, bool chunked)
+        : AsyncWebServerResponse(200, contentType), _callback(callback) {
+        _contentLength = len;
+        _chunked = chunked;
+    }
+    size_t fill(uint8_t* buffer, size_t maxLen, size_t index) override {
+        return _callback ? _callback(buffer, maxLen, index) : 0;
+    }
+
+private:
+    AwsResponseFiller _callback;
+};
+
+const char* reasonPhrase(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+WebRequestMethodComposite parseMethod(const std::string& method) {
+    if (method == "GET") return HTTP_GET;
+    if (method == "POST") return HTTP_POST;
+    if (method == "DELETE") return HTTP_DELETE;
+    if (method == "PUT") return HTTP_PUT;
+    if (method == "PATCH") return HTTP_PATCH;
+    if (method == "HEAD") return HTTP_HEAD;
+    if (method == "OPTIONS") return HTTP_OPTIONS;
+    return 0;
+}
+
+std::string urlDecode(const std::string& in) {
+    std::string out;
+    for (size_t i = 0; i < in.size(); i++) {
+        if (in[i] == '%' && i + 2 < in.size()) {
+            out += (char)strtol(in.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        } else if (in[i] == '+') {
+            out += ' ';
+        } else {
+            out += in[i];
+        }
+    }
+    return out;
+}
+
+bool sendAll(int fd, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+// Peer closed (or reset) the connection?
+bool peerClosed(int fd) {
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 0) <= 0) {
+        return false;
+    }
+    if (pfd.revents & (POLLHUP | POLLERR)) {
+        return true;
+    }
+    char c;
+    return recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 0;
+}
+
+// Wait until millis() reaches `until`; false if the peer closed meanwhile
+bool waitUntil(int fd, unsigned long until) {
+    while ((long)(until - millis()) > 0) {
+        if (peerClosed(fd)) {
+            return false;
+        }
+        usleep(1000);
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Shared server state and connection handling
+// ============================================================================
+
+struct NativeServerState {
+    struct Route {
+        std::string uri;
+        WebRequestMethodComposite method;
+        ArRequestHandlerFunction onRequest;
+        ArBodyHandlerFunction onBody;
+    };
+
+    std::vector<Route> routes;
+    ArRequestHandlerFunction notFound;
+    int listenFd = -1;
+    std::atomic<bool> running{ false };
+    std::thread acceptThread;
+
+    const Route* findRoute(const String& url, WebRequestMethodComposite method) const {
+        for (const Route& route : routes) {
+            if (!(route.method & method)) {
+                continue;
+            }
+            const std::string& path = url.str();
+            if (path == route.uri) {
+                return &route;
+            }
+            if (!route.uri.empty() && route.uri.back() == '*' &&
+                path.compare(0, route.uri.size() - 1, route.uri, 0, route.uri.size() - 1) == 0) {
+                return &route;
+            }
+            if (path.size() > route.uri.size() && path.compare(0, route.uri.size(), route.uri) == 0 &&
+                path[route.uri.size()] == '/') {
+                return &route;
+            }
+        }
+        return nullptr;
+    }
+
+    static void acceptLoop(std::shared_ptr<NativeServerState> state) {
+        while (state->running) {
+            struct pollfd pfd = { state->listenFd, POLLIN, 0 };
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            struct sockaddr_in addr;
+            socklen_t len = sizeof(addr);
+            int fd = accept(state->listenFd, (struct sockaddr*)&addr, &len);
+            if (fd < 0) {
+                continue;
+            }
+            uint32_t remoteAddr = addr.sin_addr.s_addr;
+            uint16_t remotePort = ntohs(addr.sin_port);
+            std::thread([state, fd, remoteAddr, remotePort]() {
+                handleConnection(state, fd, remoteAddr, remotePort);
+                close(fd);
+            }).detach();
+        }
+    }
+
+    static bool readRequest(int fd, std::string& head, std::string& body) {
+        std::string data;
+        char buf[4096];
+        unsigned long start = millis();
+        size_t headerEnd;
+        while ((headerEnd = data.find("\r\n\r\n")) == std::string::npos) {
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            if (millis() - start > REQUEST_TIMEOUT_MS) {
+                return false;
+            }
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                return false;
+            }
+            data.append(buf, (size_t)n);
+        }
+        head = data.substr(0, headerEnd);
+        body = data.substr(headerEnd + 4);
+
+        size_t contentLength = 0;
+        std::string lower(head);
+        for (char& c : lower) {
+            c = (char)tolower((unsigned char)c);
+        }
+        size_t pos = lower.find("\r\ncontent-length:");
+        if (pos != std::string::npos) {
+            contentLength = (size_t)strtoul(head.c_str() + pos + 17, nullptr, 10);
+        }
+        while (body.size() < contentLength) {
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            if (millis() - start > REQUEST_TIMEOUT_MS) {
+                return false;
+            }
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                return false;
+            }
+            body.append(buf, (size_t)n);
+        }
+        body.resize(contentLength);
+        return true;
+    }
+
+    static void parseParams(AsyncWebServerRequest* request, const std::string& query, bool form) {
+        size_t start = 0;
+        while (start < query.size()) {
+            size_t end = query.find('&', start);
+            if (end == std::string::npos) {
+                end = query.size();
+            }
+            std::string pair = query.substr(start, end - start);
+            size_t eq = pair.find('=');
+            std::string name = urlDecode(pair.substr(0, eq));
+            std::string value = eq == std::string::npos ? "" : urlDecode(pair.substr(eq + 1));
+            if (!name.empty()) {
+                request->_params.emplace_back(new AsyncWebParameter(String(name), String(value), form));
+            }
+            start = end + 1;
+        }
+    }
+
+    static void handleConnection(std::shared_ptr<NativeServerState> state, int fd, uint32_t remoteAddr,
+                                 uint16_t remotePort) {
+        std::string head, body;
+        if (!readRequest(fd, head, body)) {
+            return;
+        }
+
+        std::unique_ptr<AsyncWebServerRequest> request(new AsyncWebServerRequest());
+        request->_client._remoteIP = IPAddress(remoteAddr);
+        request->_client._remotePort = remotePort;
+
+        size_t lineEnd = head.find("\r\n");
+        std::string requestLine = head.substr(0, lineEnd);
+        size_t sp1 = requestLine.find(' ');
+        size_t sp2 = requestLine.find(' ', sp1 + 1);
+        if (sp1 == std::string::npos || sp2 == std::string::npos) {
+            return;
+        }
+        request->_method = parseMethod(requestLine.substr(0, sp1));
+        std::string target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+        size_t q = target.find('?');
+        request->_url = String(urlDecode(target.substr(0, q)));
+        if (q != std::string::npos) {
+            parseParams(request.get(), target.substr(q + 1), false);
+        }
+
+        size_t pos = lineEnd;
+        while (pos != std::string::npos && pos < head.size()) {
+            size_t next = head.find("\r\n", pos + 2);
+            std::string line = head.substr(pos + 2, next == std::string::npos ? std::string::npos : next - pos - 2);
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                std::string name = line.substr(0, colon);
+                size_t valueStart = line.find_first_not_of(' ', colon + 1);
+                std::string value = valueStart == std::string::npos ? "" : line.substr(valueStart);
+                request->_headers.emplace_back(new AsyncWebHeader(String(name), String(value)));
+                if (strcasecmp(name.c_str(), "Host") == 0) {
+                    request->_host = String(value);
+                } else if (strcasecmp(name.c_str(), "Content-Type") == 0) {
+                    request->_contentType = String(value);
+                }
+            }
+            pos = next;
+        }
+        request->_contentLength = body.size();
+        bool formBody = request->_contentType.startsWith("application/x-www-form-urlencoded");
+        if (formBody) {
+            parseParams(request.get(), body, true);
+        }
+
+        {
+            std::lock_guard<std::recursive_mutex> guard(NativeHal::asyncTcpLock());
+            const Route* route = state->findRoute(request->_url, request->_method);
+            if (route) {
+                if (route->onBody && !body.empty() && !formBody) {
+                    route->onBody(request.get(), (uint8_t*)&body[0], body.size(), 0, body.size());
+                }
+                if (route->onRequest) {
+                    route->onRequest(request.get());
+                }
+            } else if (state->notFound) {
+                state->notFound(request.get());
+            } else {
+                request->send(404);
+            }
+        }
+
+        // Handlers may keep the request and send() later from another task
+        unsigned long waitStart = millis();
+        while (true) {
+            {
+                std::lock_guard<std::recursive_mutex> guard(NativeHal::asyncTcpLock());
+                if (request->_response) {
+                    break;
+                }
+            }
+            if (peerClosed(fd) || millis() - waitStart > DEFERRED_RESPONSE_TIMEOUT_MS) {
+                break;
+            }
+            usleep(1000);
+        }
+
+        if (request->_response) {
+            sendResponse(fd, request.get(), request->_method == HTTP_HEAD);
+        }
+
+        request->_client._connected = false;
+        std::lock_guard<std::recursive_mutex> guard(NativeHal::asyncTcpLock());
+        if (request->_onDisconnect) {
+            request->_onDisconnect();
+        }
+        request.reset();
+    }
+
+    static void sendResponse(int fd, AsyncWebServerRequest* request, bool headOnly) {
+        AsyncWebServerResponse* response = request->_response;
+        bool chunked = response->isChunked();
+        String headers = "HTTP/1.1 " + String(response->code()) + " " + reasonPhrase(response->code()) + "\r\n";
+        headers += "Connection: close\r\nAccept-Ranges: none\r\n";
+        if (response->contentType().length() > 0) {
+            headers += "Content-Type: " + response->contentType() + "\r\n";
+        }
+        if (chunked) {
+            headers += "Transfer-Encoding: chunked\r\n";
+        } else if (response->contentLength() >= 0) {
+            headers += "Content-Length: " + String(response->contentLength()) + "\r\n";
+        }
+        for (const AsyncWebHeader& header : response->headers()) {
+            headers += header.toString();
+        }
+        headers += "\r\n";
+        if (!sendAll(fd, headers.c_str(), headers.length()) || headOnly) {
+            return;
+        }
+
+        // Filler calls are paced like AsyncTCP: full segments are ACKed right
+        // away, a short one after the client's delayed-ACK timeout, and after
+        // RESPONSE_TRY_AGAIN only the next poll tick calls the filler again
+        static const unsigned long ackDelayMs = (unsigned long)NativeHal::envLong("NATIVE_TCP_ACK_MS", 40);
+        unsigned long connectedAt = millis();
+        unsigned long ackAt = 0;
+        bool ackPending = false;
+
+        uint8_t buffer[TCP_SEGMENT];
+        size_t index = 0;
+        long limit = response->contentLength();
+        while (!chunked ? (limit < 0 || (long)index < limit) : true) {
+            size_t maxLen = chunked ? TCP_SEGMENT - 8 : TCP_SEGMENT;
+            if (!chunked && limit >= 0) {
+                maxLen = std::min(maxLen, (size_t)(limit - (long)index));
+            }
+            if (ackPending) {
+                if (!waitUntil(fd, ackAt)) {
+                    return;
+                }
+                ackPending = false;
+            }
+            size_t n;
+            {
+                std::lock_guard<std::recursive_mutex> guard(NativeHal::asyncTcpLock());
+                n = response->fill(buffer, maxLen, index);
+            }
+            if (n == RESPONSE_TRY_AGAIN) {
+                unsigned long ticks = (millis() - connectedAt) / TCP_POLL_INTERVAL_MS + 1;
+                if (!waitUntil(fd, connectedAt + ticks * TCP_POLL_INTERVAL_MS)) {
+                    return;
+                }
+                continue;
+            }
+            if (n == 0) {
+                break;
+            }
+            bool ok;
+            if (chunked) {
+                char size[16];
+                int len = snprintf(size, sizeof(size), "%zx\r\n", n);
+                ok = sendAll(fd, size, (size_t)len) && sendAll(fd, buffer, n) && sendAll(fd, "\r\n", 2);
+            } else {
+                ok = sendAll(fd, buffer, n);
+            }
+            if (!ok) {
+                return;
+            }
+            if (n < maxLen) {
+                ackPending = true;
+                ackAt = millis() + ackDelayMs;
+            }
+            index += n;
+        }
+        if (chunked) {
+            sendAll(fd, "0\r\n\r\n", 5);
+        }
+    }
+};
+
+// ============================================================================
+// AsyncWebServer
+// ============================================================================
+
+AsyncWebServer::AsyncWebServer(uint16_t port) : _port(port), _state(std::make_shared<NativeServerState>()) {}
+
+AsyncWebServer::~AsyncWebServer() {
+    end();
+}
+
+void AsyncWebServer::begin() {
+    if (_state->running) {
+        return;
+    }
+    uint16_t port = (uint16_t)NativeHal::envLong("NATIVE_WEB_PORT", 8080);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int yes = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        printf("[NativeHal] AsyncWebServer: cannot listen on 127.0.0.1:%u (%s)\n", port, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return;
+    }
+    printf("[NativeHal] AsyncWebServer (port %u) listening on http://127.0.0.1:%u/\n", _port, port);
+    _state->listenFd = fd;
+    _state->running = true;
+    _state->acceptThread = std::thread(NativeServerState::acceptLoop, _state);
+}
+
+void AsyncWebServer::end() {
+    if (!_state->running) {
+        return;
+    }
+    _state->running = false;
+    if (_state->acceptThread.joinable()) {
+        _state->acceptThread.join();
+    }
+    close(_state->listenFd);
+    _state->listenFd = -1;
+}
+
+void AsyncWebServer::reset() {
+    _state->routes.clear();
+    _state->notFound = nullptr;
+}
+
+void AsyncWebServer::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) {
+    _state->routes.push_back({ uri, method, onRequest, nullptr });
+}
+
+void AsyncWebServer::on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                        ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody) {
+    (void)onUpload;
+    _state->routes.push_back({ uri, method, onRequest, onBody });
+}
+
+void AsyncWebServer::onNotFound(ArRequestHandlerFunction fn) {
+    _state->notFound = fn;
+}
+
+// ============================================================================
+// AsyncWebServerRequest
+// ============================================================================
+
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+    delete _response;
+}
+
+const char* AsyncWebServerRequest::methodToString() const {
+    switch (_method) {
+        case HTTP_GET: return "GET";
+        case HTTP_POST: return "POST";
+        case HTTP_DELETE: return "DELETE";
+        case HTTP_PUT: return "PUT";
+        case HTTP_PATCH: return "PATCH";
+        case HTTP_HEAD: return "HEAD";
+        case HTTP_OPTIONS: return "OPTIONS";
+        default: return "UNKNOWN";
+    }
+}
+
+AsyncWebHeader* AsyncWebServerRequest::getHeader(const String& name) const {
+    for (const auto& header : _headers) {
+        if (header->name().equalsIgnoreCase(name)) {
+            return header.get();
+        }
+    }
+    return nullptr;
+}
+
+bool AsyncWebServerRequest::hasHeader(const String& name) const {
+    return getHeader(name) != nullptr;
+}
+
+const String& AsyncWebServerRequest::header(const char* name) const {
+    AsyncWebHeader* h = getHeader(String(name));
+    return h ? h->value() : EMPTY_STRING;
+}
+
+const String& AsyncWebServerRequest::header(size_t i) const {
+    return i < _headers.size() ? _headers[i]->value() : EMPTY_STRING;
+}
+
+const String& AsyncWebServerRequest::headerName(size_t i) const {
+    return i < _headers.size() ? _headers[i]->name() : EMPTY_STRING;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(const String& name, bool post, bool file) const {
+    (void)file;
+    for (const auto& param : _params) {
+        if (param->name() == name && param->isPost() == post) {
+            return param.get();
+        }
+    }
+    return nullptr;
+}
+
+bool AsyncWebServerRequest::hasParam(const String& name, bool post, bool file) const {
+    return getParam(name, post, file) != nullptr;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(size_t num) const {
+    return num < _params.size() ? _params[num].get() : nullptr;
+}
+
+bool AsyncWebServerRequest::hasArg(const char* name) const {
+    for (const auto& param : _params) {
+        if (param->name() == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const String& AsyncWebServerRequest::arg(const String& name) const {
+    for (const auto& param : _params) {
+        if (param->name() == name) {
+            return param->value();
+        }
+    }
+    return EMPTY_STRING;
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response) {
+    std::lock_guard<std::recursive_mutex> guard(NativeHal::asyncTcpLock());
+    if (_response) {
+        delete response;  // Only the first response is sent
+        return;
+    }
+    _response = response;
+}
+
+void AsyncWebServerRequest::send(int code, const String& contentType, const String& content) {
+    send(beginResponse(code, contentType, content));
+}
+
+void AsyncWebServerRequest::send_P(int code, const String& contentType, const uint8_t* content, size_t len) {
+    send(beginResponse_P(code, contentType, content, len));
+}
+
+void AsyncWebServerRequest::send_P(int code, const String& contentType, PGM_P content) {
+    send(beginResponse_P(code, contentType, content));
+}
+
+void AsyncWebServerRequest::send(const String& contentType, size_t len, AwsResponseFiller callback) {
+    send(beginResponse(contentType, len, callback));
+}
+
+void AsyncWebServerRequest::sendChunked(const String& contentType, AwsResponseFiller callback) {
+    send(beginChunkedResponse(contentType, callback));
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const String& contentType,
+                                                             const String& content) {
+    return new BasicResponse(code, contentType, content);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const String& contentType,
+                                                               const uint8_t* content, size_t len) {
+    return new ProgmemResponse(code, contentType, content, len);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const String& contentType,
+                                                               PGM_P content) {
+    return new ProgmemResponse(code, contentType, (const uint8_t*)content, strlen(content));
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(const String& contentType, size_t len,
+                                                             AwsResponseFiller callback) {
+    return new CallbackResponse(contentType, (long)len, callback, false);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const String& contentType,
+                                                                    AwsResponseFiller callback) {
+    return new CallbackResponse(contentType, -1, callback, true);
+}
+
+AsyncResponseStream* AsyncWebServerRequest::beginResponseStream(const String& contentType, size_t bufferSize) {
+    return new AsyncResponseStream(contentType, bufferSize);
+}
+
+size_t AsyncResponseStream::fill(uint8_t* buffer, size_t maxLen, size_t index) {
+    size_t n = index < _content.size() ? std::min(maxLen, _content.size() - index) : 0;
+    memcpy(buffer, _content.data() + index, n);
+    return n;
+}
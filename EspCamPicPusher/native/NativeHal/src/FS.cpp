@@ -0,0 +1,308 @@
+#include <FS.h>
+#include <LittleFS.h>
+#include "NativeHal.h"
+#include "NativeHalInternal.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+fs::LittleFSFS LittleFS;
+
+static const size_t LITTLEFS_BLOCK_SIZE = 4096;
+static size_t fsCapacity = 0;
+
+static size_t roundToBlock(size_t size) {
+    return (size + LITTLEFS_BLOCK_SIZE - 1) / LITTLEFS_BLOCK_SIZE * LITTLEFS_BLOCK_SIZE;
+}
+
+static size_t directoryUsage(const std::string& dir) {
+    size_t used = LITTLEFS_BLOCK_SIZE;  // Directory metadata pair
+    DIR* d = opendir(dir.c_str());
+    if (!d) {
+        return 0;
+    }
+    while (struct dirent* entry = readdir(d)) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        std::string path = dir + "/" + entry->d_name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) {
+            continue;
+        }
+        used += S_ISDIR(st.st_mode) ? directoryUsage(path) : roundToBlock((size_t)st.st_size);
+    }
+    closedir(d);
+    return used;
+}
+
+namespace fs {
+
+struct FileImpl {
+    std::string path;       // Path inside the filesystem ("/q/1.img")
+    std::string hostPath;
+    std::string root;       // Host directory of the mounted filesystem
+    FILE* fp = nullptr;
+    DIR* dir = nullptr;
+    bool writable = false;
+
+    ~FileImpl() {
+        if (fp) fclose(fp);
+        if (dir) closedir(dir);
+    }
+
+    const char* name() const {
+        size_t slash = path.rfind('/');
+        return slash == std::string::npos ? path.c_str() : path.c_str() + slash + 1;
+    }
+};
+
+// ============================================================================
+// File
+// ============================================================================
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!_impl || !_impl->fp || !_impl->writable) {
+        return 0;
+    }
+    // Flash full: LittleFS fails the write once no free block is left
+    long pos = ftell(_impl->fp);
+    size_t fileSize = this->size();
+    size_t grow = pos >= 0 && (size_t)pos + size > fileSize ? (size_t)pos + size - fileSize : 0;
+    if (grow > 0 && roundToBlock(fileSize + grow) > roundToBlock(fileSize) &&
+        directoryUsage(_impl->root) + roundToBlock(fileSize + grow) - roundToBlock(fileSize) > fsCapacity) {
+        return 0;
+    }
+    return fwrite(buf, 1, size, _impl->fp);
+}
+
+int File::available() {
+    if (!_impl || !_impl->fp) {
+        return 0;
+    }
+    return (int)(size() - position());
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+    if (!_impl || !_impl->fp) {
+        return -1;
+    }
+    int c = fgetc(_impl->fp);
+    if (c != EOF) {
+        ungetc(c, _impl->fp);
+    }
+    return c == EOF ? -1 : c;
+}
+
+void File::flush() {
+    if (_impl && _impl->fp) {
+        fflush(_impl->fp);
+    }
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!_impl || !_impl->fp) {
+        return 0;
+    }
+    return fread(buf, 1, size, _impl->fp);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!_impl || !_impl->fp) {
+        return false;
+    }
+    int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+    return fseek(_impl->fp, (long)pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!_impl || !_impl->fp) {
+        return 0;
+    }
+    long pos = ftell(_impl->fp);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    if (!_impl || !_impl->fp) {
+        return 0;
+    }
+    fflush(_impl->fp);
+    struct stat st;
+    return fstat(fileno(_impl->fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() {
+    _impl.reset();
+}
+
+File::operator bool() const {
+    return _impl && (_impl->fp || _impl->dir);
+}
+
+const char* File::path() const {
+    return _impl ? _impl->path.c_str() : nullptr;
+}
+
+const char* File::name() const {
+    return _impl ? _impl->name() : nullptr;
+}
+
+bool File::isDirectory() {
+    return _impl && _impl->dir;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!_impl || !_impl->dir) {
+        return File();
+    }
+    while (struct dirent* entry = readdir(_impl->dir)) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        std::string base = _impl->path == "/" ? "" : _impl->path;
+        std::string childPath = base + "/" + entry->d_name;
+        auto child = std::make_shared<FileImpl>();
+        child->path = childPath;
+        child->hostPath = _impl->hostPath + "/" + entry->d_name;
+        child->root = _impl->root;
+        struct stat st;
+        if (stat(child->hostPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+            child->dir = opendir(child->hostPath.c_str());
+        } else {
+            child->fp = fopen(child->hostPath.c_str(), strcmp(mode, FILE_READ) == 0 ? "rb" : "r+b");
+            child->writable = strcmp(mode, FILE_READ) != 0;
+        }
+        return File(child);
+    }
+    return File();
+}
+
+void File::rewindDirectory() {
+    if (_impl && _impl->dir) {
+        rewinddir(_impl->dir);
+    }
+}
+
+// ============================================================================
+// FS
+// ============================================================================
+
+std::string FS::hostPath(const char* path) const {
+    if (_root.empty() || !path || path[0] != '/' || strstr(path, "..")) {
+        return std::string();
+    }
+    return _root + path;
+}
+
+File FS::open(const char* path, const char* mode, const bool create) {
+    std::string host = hostPath(path);
+    if (host.empty() || !mode) {
+        return File();
+    }
+
+    auto impl = std::make_shared<FileImpl>();
+    impl->path = path;
+    impl->hostPath = host;
+    impl->root = _root;
+
+    struct stat st;
+    bool found = stat(host.c_str(), &st) == 0;
+    if (found && S_ISDIR(st.st_mode)) {
+        impl->dir = opendir(host.c_str());
+        return File(impl);
+    }
+    if (strchr(mode, 'r') && !strchr(mode, '+') && !found) {
+        return File();
+    }
+    if (create) {
+        NativeHal::ensureParentDir(host.c_str());
+    }
+
+    // "r+" keeps the content, "w" truncates, "a" appends (binary on the host)
+    std::string hostMode = std::string(mode) + "b";
+    impl->fp = fopen(host.c_str(), hostMode.c_str());
+    impl->writable = strcmp(mode, FILE_READ) != 0;
+    return impl->fp ? File(impl) : File();
+}
+
+bool FS::exists(const char* path) {
+    std::string host = hostPath(path);
+    struct stat st;
+    return !host.empty() && stat(host.c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+    std::string host = hostPath(path);
+    return !host.empty() && unlink(host.c_str()) == 0;
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+    std::string from = hostPath(pathFrom);
+    std::string to = hostPath(pathTo);
+    return !from.empty() && !to.empty() && ::rename(from.c_str(), to.c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    std::string host = hostPath(path);
+    return !host.empty() && (::mkdir(host.c_str(), 0755) == 0 || errno == EEXIST);
+}
+
+bool FS::rmdir(const char* path) {
+    std::string host = hostPath(path);
+    return !host.empty() && ::rmdir(host.c_str()) == 0;
+}
+
+// ============================================================================
+// LittleFS
+// ============================================================================
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles,
+                       const char* partitionLabel) {
+    (void)formatOnFail;
+    (void)basePath;
+    (void)maxOpenFiles;
+    (void)partitionLabel;
+    std::string root = NativeHal::dataPath("littlefs");
+    NativeHal::ensureParentDir((root + "/.").c_str());
+    struct stat st;
+    if (stat(root.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return false;
+    }
+    _root = root;
+    fsCapacity = (size_t)NativeHal::envLong("NATIVE_LITTLEFS_KB", 960) * 1024;
+    return true;
+}
+
+bool LittleFSFS::format() {
+    if (_root.empty()) {
+        return false;
+    }
+    std::string command = "rm -rf '" + _root + "'/*";
+    return system(command.c_str()) == 0;
+}
+
+size_t LittleFSFS::totalBytes() {
+    return _root.empty() ? 0 : fsCapacity;
+}
+
+size_t LittleFSFS::usedBytes() {
+    return _root.empty() ? 0 : directoryUsage(_root);
+}
+
+void LittleFSFS::end() {
+    _root.clear();
+}
+
+} // namespace fs
@@ -0,0 +1,436 @@
+#include <HTTPClient.h>
+#include "NativeHal.h"
+#include <unistd.h>
+
+HTTPClient::HTTPClient() {}
+
+HTTPClient::~HTTPClient() {
+    if (_ownedClient) {
+        _ownedClient->stop();
+    }
+}
+
+bool HTTPClient::parseUrl(const String& url) {
+    String rest = url;
+    bool https = false;
+    int schemeEnd = rest.indexOf("://");
+    if (schemeEnd >= 0) {
+        String scheme = rest.substring(0, schemeEnd);
+        if (scheme != "http" && scheme != "https") {
+            return false;
+        }
+        https = scheme == "https";
+        rest = rest.substring(schemeEnd + 3);
+    }
+    int pathStart = rest.indexOf('/');
+    String hostPort = pathStart >= 0 ? rest.substring(0, pathStart) : rest;
+    _uri = pathStart >= 0 ? rest.substring(pathStart) : String("/");
+    int colon = hostPort.indexOf(':');
+    if (colon >= 0) {
+        _host = hostPort.substring(0, colon);
+        _port = (uint16_t)hostPort.substring(colon + 1).toInt();
+    } else {
+        _host = hostPort;
+        _port = https ? 443 : 80;
+    }
+    return _host.length() > 0;
+}
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+    _client = &client;
+    _headers = "";
+    _collected.clear();
+    _returnCode = 0;
+    _size = -1;
+    return parseUrl(url);
+}
+
+bool HTTPClient::begin(WiFiClient& client, const String& host, uint16_t port, const String& uri, bool https) {
+    (void)https;
+    _client = &client;
+    _headers = "";
+    _collected.clear();
+    _returnCode = 0;
+    _size = -1;
+    _host = host;
+    _port = port;
+    _uri = uri;
+    return true;
+}
+
+bool HTTPClient::begin(const String& url) {
+    if (!_ownedClient) {
+        _ownedClient.reset(new WiFiClient());
+    }
+    return begin(*_ownedClient, url);
+}
+
+void HTTPClient::end() {
+    if (_client && !(_reuse && _canReuse && _bodyConsumed)) {
+        _client->stop();
+    }
+    _headers = "";
+    _returnCode = 0;
+    _size = -1;
+}
+
+void HTTPClient::addHeader(const String& name, const String& value, bool first, bool replace) {
+    // Headers generated by the client itself cannot be overridden, as in the ESP32 core
+    if (name.equalsIgnoreCase("Connection") || name.equalsIgnoreCase("User-Agent") ||
+        name.equalsIgnoreCase("Host")) {
+        return;
+    }
+    String headerLine = name + ": " + value + "\r\n";
+    if (replace) {
+        int start = _headers.indexOf(name + ":");
+        if (start >= 0) {
+            int end = _headers.indexOf('\n', start);
+            _headers.remove(start, end - start + 1);
+        }
+    }
+    if (first) {
+        _headers = headerLine + _headers;
+    } else {
+        _headers += headerLine;
+    }
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    _collected.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) {
+        _collected.emplace_back(headerKeys[i], "");
+    }
+}
+
+String HTTPClient::header(const char* name) {
+    for (const auto& entry : _collected) {
+        if (String(entry.first).equalsIgnoreCase(name)) {
+            return String(entry.second);
+        }
+    }
+    return String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+    return header(name).length() > 0;
+}
+
+int HTTPClient::GET() {
+    return sendRequest("GET");
+}
+
+int HTTPClient::POST(uint8_t* payload, size_t size) {
+    return sendRequest("POST", payload, size);
+}
+
+int HTTPClient::POST(const String& payload) {
+    return POST((uint8_t*)payload.c_str(), payload.length());
+}
+
+int HTTPClient::PUT(uint8_t* payload, size_t size) {
+    return sendRequest("PUT", payload, size);
+}
+
+int HTTPClient::PUT(const String& payload) {
+    return PUT((uint8_t*)payload.c_str(), payload.length());
+}
+
+int HTTPClient::sendRequest(const char* type, const String& payload) {
+    return sendRequest(type, (uint8_t*)payload.c_str(), payload.length());
+}
+
+bool HTTPClient::connect() {
+    if (!_client) {
+        return false;
+    }
+    if (_reuse && _client->connected()) {
+        // Drain anything left from a previous response before reusing the socket
+        while (_client->available() > 0) {
+            _client->read();
+        }
+        return true;
+    }
+    if (!_client->connect(_host.c_str(), _port, _connectTimeout)) {
+        return false;
+    }
+    _client->setTimeout(_timeout);
+    return true;
+}
+
+bool HTTPClient::sendHeader(const char* type, size_t contentLength) {
+    String request = String(type) + " " + _uri + (_useHTTP10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n");
+    request += "Host: " + _host;
+    if (_port != 80 && _port != 443) {
+        request += ":" + String((unsigned int)_port);
+    }
+    request += "\r\nUser-Agent: " + _userAgent + "\r\nConnection: ";
+    request += (_reuse && !_useHTTP10) ? "keep-alive\r\n" : "close\r\n";
+    if (!_useHTTP10) {
+        request += "Accept-Encoding: identity;q=1,chunked;q=0.1,*;q=0\r\n";
+    }
+    if (contentLength > 0) {
+        request += "Content-Length: " + String((unsigned long)contentLength) + "\r\n";
+    }
+    request += _headers + "\r\n";
+    return _client->write((const uint8_t*)request.c_str(), request.length()) == request.length();
+}
+
+int HTTPClient::sendRequest(const char* type, uint8_t* payload, size_t size) {
+    if (!connect()) {
+        return returnError(HTTPC_ERROR_CONNECTION_REFUSED);
+    }
+    if (!sendHeader(type, payload ? size : 0)) {
+        return returnError(HTTPC_ERROR_SEND_HEADER_FAILED);
+    }
+    if (payload && size > 0 && _client->write(payload, size) != size) {
+        return returnError(HTTPC_ERROR_SEND_PAYLOAD_FAILED);
+    }
+    return returnError(handleHeaderResponse());
+}
+
+int HTTPClient::sendRequest(const char* type, Stream* stream, size_t size) {
+    if (!stream) {
+        return returnError(HTTPC_ERROR_NO_STREAM);
+    }
+    if (!connect()) {
+        return returnError(HTTPC_ERROR_CONNECTION_REFUSED);
+    }
+    if (!sendHeader(type, size)) {
+        return returnError(HTTPC_ERROR_SEND_HEADER_FAILED);
+    }
+    uint8_t buffer[1460];
+    size_t sent = 0;
+    unsigned long lastData = millis();
+    while (size == 0 || sent < size) {
+        size_t want = size == 0 ? sizeof(buffer) : std::min(sizeof(buffer), size - sent);
+        size_t got = stream->readBytes(buffer, want);
+        if (got == 0) {
+            // The ESP32 core also stops sending once the connection is gone
+            if (size == 0 || !_client->connected() || millis() - lastData > _timeout) {
+                break;
+            }
+            continue;
+        }
+        lastData = millis();
+        if (_client->write(buffer, got) != got) {
+            return returnError(HTTPC_ERROR_SEND_PAYLOAD_FAILED);
+        }
+        sent += got;
+    }
+    if (size > 0 && sent != size) {
+        return returnError(HTTPC_ERROR_SEND_PAYLOAD_FAILED);
+    }
+    return returnError(handleHeaderResponse());
+}
+
+bool HTTPClient::readLine(String& line) {
+    std::string buffer;
+    unsigned long start = millis();
+    while (true) {
+        int c = _client->read();
+        if (c < 0) {
+            if (!_client->connected() || millis() - start > _timeout) {
+                return false;
+            }
+            usleep(200);
+            continue;
+        }
+        if (c == '\n') {
+            break;
+        }
+        if (c != '\r') {
+            buffer += (char)c;
+        }
+    }
+    line = String(buffer);
+    return true;
+}
+
+int HTTPClient::handleHeaderResponse() {
+    _returnCode = 0;
+    _size = -1;
+    _transferEncoding = HTTPC_TE_IDENTITY;
+    _canReuse = _reuse && !_useHTTP10;
+    _bodyConsumed = false;
+    for (auto& entry : _collected) {
+        entry.second.clear();
+    }
+
+    String line;
+    while (true) {
+        if (!readLine(line)) {
+            return HTTPC_ERROR_READ_TIMEOUT;
+        }
+        if (line.startsWith("HTTP/1.")) {
+            if (line.startsWith("HTTP/1.0")) {
+                _canReuse = false;
+            }
+            _returnCode = line.substring(9, 12).toInt();
+            continue;
+        }
+        if (line.length() == 0) {
+            if (_returnCode >= 100 && _returnCode < 200) {
+                _returnCode = 0;  // Interim response (100 Continue): wait for the final one
+                continue;
+            }
+            break;
+        }
+        int colon = line.indexOf(':');
+        if (colon <= 0) {
+            continue;
+        }
+        String name = line.substring(0, colon);
+        String value = line.substring(colon + 1);
+        value.trim();
+        if (name.equalsIgnoreCase("Content-Length")) {
+            _size = (int)value.toInt();
+        } else if (name.equalsIgnoreCase("Transfer-Encoding") && value.equalsIgnoreCase("chunked")) {
+            _transferEncoding = HTTPC_TE_CHUNKED;
+        } else if (name.equalsIgnoreCase("Connection") && value.equalsIgnoreCase("close")) {
+            _canReuse = false;
+        } else if (name.equalsIgnoreCase("Location")) {
+            _location = value;
+        }
+        for (auto& entry : _collected) {
+            if (name.equalsIgnoreCase(entry.first.c_str())) {
+                entry.second = value.c_str();
+            }
+        }
+    }
+    if (_returnCode <= 0) {
+        return HTTPC_ERROR_NO_HTTP_SERVER;
+    }
+    if (_size == 0 || _returnCode == 204 || _returnCode == 304) {
+        _bodyConsumed = true;
+    }
+    return _returnCode;
+}
+
+int HTTPClient::readBody(Stream* out) {
+    int total = 0;
+    uint8_t buffer[1024];
+    if (_transferEncoding == HTTPC_TE_CHUNKED) {
+        String line;
+        while (readLine(line)) {
+            long chunk = strtol(line.c_str(), nullptr, 16);
+            if (chunk <= 0) {
+                readLine(line);  // Trailer terminator
+                _bodyConsumed = true;
+                return total;
+            }
+            long remaining = chunk;
+            unsigned long start = millis();
+            while (remaining > 0) {
+                int n = _client->read(buffer, (size_t)std::min<long>(remaining, sizeof(buffer)));
+                if (n <= 0) {
+                    if (!_client->connected() || millis() - start > _timeout) {
+                        return HTTPC_ERROR_READ_TIMEOUT;
+                    }
+                    usleep(200);
+                    continue;
+                }
+                start = millis();
+                out->write(buffer, (size_t)n);
+                remaining -= n;
+                total += n;
+            }
+            readLine(line);  // CRLF after chunk data
+        }
+        return HTTPC_ERROR_READ_TIMEOUT;
+    }
+
+    unsigned long start = millis();
+    while (_size < 0 || total < _size) {
+        size_t want = _size < 0 ? sizeof(buffer) : std::min(sizeof(buffer), (size_t)(_size - total));
+        int n = _client->read(buffer, want);
+        if (n <= 0) {
+            if (!_client->connected()) {
+                break;
+            }
+            if (millis() - start > _timeout) {
+                return HTTPC_ERROR_READ_TIMEOUT;
+            }
+            usleep(200);
+            continue;
+        }
+        start = millis();
+        out->write(buffer, (size_t)n);
+        total += n;
+    }
+    _bodyConsumed = _size < 0 || total == _size;
+    return total;
+}
+
+namespace {
+// Print sink that appends to a std::string (getString)
+class StringSink : public Stream {
+public:
+    std::string data;
+    size_t write(uint8_t c) override { data += (char)c; return 1; }
+    size_t write(const uint8_t* buffer, size_t size) override { data.append((const char*)buffer, size); return size; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+} // namespace
+
+String HTTPClient::getString() {
+    if (!_client || _returnCode <= 0) {
+        return String();
+    }
+    StringSink sink;
+    if (_size > 0) {
+        sink.data.reserve((size_t)_size);
+    }
+    readBody(&sink);
+    return String(sink.data);
+}
+
+int HTTPClient::writeToStream(Stream* stream) {
+    if (!stream) {
+        return returnError(HTTPC_ERROR_NO_STREAM);
+    }
+    if (!_client || _returnCode <= 0) {
+        return returnError(HTTPC_ERROR_NOT_CONNECTED);
+    }
+    return returnError(readBody(stream));
+}
+
+WiFiClient& HTTPClient::getStream() {
+    return *_client;
+}
+
+WiFiClient* HTTPClient::getStreamPtr() {
+    return connected() ? _client : nullptr;
+}
+
+bool HTTPClient::connected() {
+    return _client && (_client->available() > 0 || _client->connected());
+}
+
+int HTTPClient::returnError(int error) {
+    if (error < 0) {
+        if (_client) {
+            _client->stop();
+        }
+        _canReuse = false;
+    }
+    return error;
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_REFUSED: return "connection refused";
+        case HTTPC_ERROR_SEND_HEADER_FAILED: return "send header failed";
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return "send payload failed";
+        case HTTPC_ERROR_NOT_CONNECTED: return "not connected";
+        case HTTPC_ERROR_CONNECTION_LOST: return "connection lost";
+        case HTTPC_ERROR_NO_STREAM: return "no stream";
+        case HTTPC_ERROR_NO_HTTP_SERVER: return "no HTTP server";
+        case HTTPC_ERROR_TOO_LESS_RAM: return "too less ram";
+        case HTTPC_ERROR_ENCODING: return "Transfer-Encoding not supported";
+        case HTTPC_ERROR_STREAM_WRITE: return "Stream write error";
+        case HTTPC_ERROR_READ_TIMEOUT: return "read Timeout";
+        default: return String();
+    }
+}
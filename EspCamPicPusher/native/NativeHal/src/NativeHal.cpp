@@ -0,0 +1,173 @@
+#include "NativeHal.h"
+#include "NativeHalInternal.h"
+#include "esp_sleep.h"
+#include <Arduino.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Linker-provided bounds of the RTC_DATA_ATTR section (weak: absent when unused)
+extern "C" char __start_rtc_data[] __attribute__((weak));
+extern "C" char __stop_rtc_data[] __attribute__((weak));
+
+namespace NativeHal {
+
+static const uint32_t RTC_FILE_MAGIC = 0x52544331;  // "RTC1"
+
+struct RtcFileHeader {
+    uint32_t magic;
+    uint32_t wakeCause;
+    uint32_t size;
+};
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+static thread_local uint64_t skewUs = 0;
+static int startupWakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+
+const std::string& dataDir() {
+    static std::string dir;
+    if (dir.empty()) {
+        const char* env = getenv("NATIVE_DATA_DIR");
+        dir = (env && *env) ? env : ".native";
+        mkdir(dir.c_str(), 0755);
+    }
+    return dir;
+}
+
+std::string dataPath(const char* name) {
+    return dataDir() + "/" + name;
+}
+
+void ensureParentDir(const char* path) {
+    std::string p(path);
+    for (size_t pos = p.find('/', 1); pos != std::string::npos; pos = p.find('/', pos + 1)) {
+        mkdir(p.substr(0, pos).c_str(), 0755);
+    }
+}
+
+long envLong(const char* name, long defaultValue) {
+    const char* env = getenv(name);
+    if (!env || !*env) {
+        return defaultValue;
+    }
+    return strtol(env, nullptr, 10);
+}
+
+bool realtime() {
+    static const bool enabled = envLong("NATIVE_REALTIME", 0) != 0;
+    return enabled;
+}
+
+uint64_t clockMicros() {
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + skewUs;
+}
+
+void advanceClock(uint64_t us) {
+    skewUs += us;
+}
+
+uint64_t threadSkew() {
+    return skewUs;
+}
+
+void setThreadSkew(uint64_t skew) {
+    skewUs = skew;
+}
+
+void syncClockTo(uint64_t stampUs) {
+    uint64_t now = clockMicros();
+    if (stampUs > now) {
+        skewUs += stampUs - now;
+    }
+}
+
+void sleepMs(uint32_t ms) {
+    if (realtime()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    } else {
+        advanceClock((uint64_t)ms * 1000ULL);
+        std::this_thread::yield();
+    }
+}
+
+std::recursive_mutex& asyncTcpLock() {
+    static std::recursive_mutex lock;
+    return lock;
+}
+
+void powerDown(int exitCode, int wakeCause) {
+    fflush(stdout);
+    size_t size = (size_t)(__stop_rtc_data - __start_rtc_data);
+    std::string path = dataPath("rtc.bin");
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f) {
+        RtcFileHeader header = { RTC_FILE_MAGIC, (uint32_t)wakeCause, (uint32_t)size };
+        fwrite(&header, sizeof(header), 1, f);
+        if (size > 0) {
+            fwrite(__start_rtc_data, 1, size, f);
+        }
+        fclose(f);
+    }
+    printf("[NativeHal] Power down (exit %d) after %.3f s virtual uptime\n",
+           exitCode, clockMicros() / 1e6);
+    fflush(stdout);
+    _exit(exitCode);
+}
+
+int restoreRtcMemory() {
+    startupWakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    std::string path = dataPath("rtc.bin");
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return startupWakeCause;
+    }
+    RtcFileHeader header;
+    size_t size = (size_t)(__stop_rtc_data - __start_rtc_data);
+    if (fread(&header, sizeof(header), 1, f) == 1 && header.magic == RTC_FILE_MAGIC && header.size == size) {
+        if (size == 0 || fread(__start_rtc_data, 1, size, f) == size) {
+            startupWakeCause = (int)header.wakeCause;
+        }
+    } else {
+        printf("[NativeHal] RTC image does not match this build, cold boot\n");
+    }
+    fclose(f);
+    // RTC memory only survives a controlled power-down; a crash is a cold boot.
+    unlink(path.c_str());
+    return startupWakeCause;
+}
+
+int wakeCause() {
+    return startupWakeCause;
+}
+
+bool hostOverride(std::string& host, uint16_t& port) {
+    const char* env = getenv("NATIVE_HOST_OVERRIDE");
+    if (!env || !*env) {
+        return false;
+    }
+    std::string value(env);
+    size_t colon = value.rfind(':');
+    if (colon != std::string::npos) {
+        host = value.substr(0, colon);
+        port = (uint16_t)atoi(value.c_str() + colon + 1);
+    } else {
+        host = value;
+    }
+    return true;
+}
+
+} // namespace NativeHal
+
+#ifndef NATIVE_NO_ARDUINO_MAIN
+int main() {
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    NativeHal::restoreRtcMemory();
+    setup();
+    for (;;) {
+        loop();
+    }
+}
+#endif
@@ -0,0 +1,24 @@
+#ifndef NATIVE_HAL_INTERNAL_H
+#define NATIVE_HAL_INTERNAL_H
+
+#include <stdint.h>
+#include <mutex>
+
+namespace NativeHal {
+
+/** Virtual skew of the calling thread (inherited by tasks it creates). */
+uint64_t threadSkew();
+void setThreadSkew(uint64_t skewUs);
+
+/** Raise the calling thread's virtual clock to at least `stampUs` (happens-before edge). */
+void syncClockTo(uint64_t stampUs);
+
+/** Global lock emulating the single async_tcp task of AsyncWebServer. */
+std::recursive_mutex& asyncTcpLock();
+
+/** Create parent directories of `path` (mkdir -p on the dirname). */
+void ensureParentDir(const char* path);
+
+} // namespace NativeHal
+
+#endif // NATIVE_HAL_INTERNAL_H
@@ -0,0 +1,134 @@
+#include <Preferences.h>
+#include "NativeHal.h"
+#include "NativeHalInternal.h"
+#include <stdio.h>
+
+// File layout: repeated { u16 keyLen, key, u32 valueLen, value }
+
+static std::string namespacePath(const std::string& name) {
+    return NativeHal::dataPath(("nvs/" + name).c_str());
+}
+
+bool Preferences::begin(const char* name, bool readOnly) {
+    if (_started || !name || !*name || strlen(name) > 15) {
+        return false;
+    }
+    _name = name;
+    _readOnly = readOnly;
+    _started = true;
+    return load();
+}
+
+void Preferences::end() {
+    _started = false;
+    _entries.clear();
+}
+
+bool Preferences::clear() {
+    if (!_started || _readOnly) {
+        return false;
+    }
+    _entries.clear();
+    return save();
+}
+
+bool Preferences::remove(const char* key) {
+    if (!_started || _readOnly || !key || _entries.erase(key) == 0) {
+        return false;
+    }
+    return save();
+}
+
+bool Preferences::isKey(const char* key) {
+    return _started && key && _entries.count(key) > 0;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    if (!value) {
+        return 0;
+    }
+    // NVS stores strings with their terminator; getBytesLength() reports it too
+    return putValue(key, value, strlen(value) + 1) ? strlen(value) : 0;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    auto it = _started && key ? _entries.find(key) : _entries.end();
+    if (it == _entries.end() || it->second.empty()) {
+        return defaultValue;
+    }
+    return String(it->second.c_str());
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLen) {
+    auto it = _started && key ? _entries.find(key) : _entries.end();
+    if (it == _entries.end() || !value || it->second.size() > maxLen) {
+        return 0;
+    }
+    memcpy(value, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    auto it = _started && key ? _entries.find(key) : _entries.end();
+    return it == _entries.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    auto it = _started && key ? _entries.find(key) : _entries.end();
+    if (it == _entries.end() || !buf || it->second.size() > maxLen) {
+        return 0;
+    }
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+size_t Preferences::putValue(const char* key, const void* value, size_t len) {
+    if (!_started || _readOnly || !key || !*key || strlen(key) > 15) {
+        return 0;
+    }
+    _entries[key] = std::string((const char*)value, len);
+    return save() ? len : 0;
+}
+
+bool Preferences::load() {
+    _entries.clear();
+    FILE* f = fopen(namespacePath(_name).c_str(), "rb");
+    if (!f) {
+        return true;  // Namespace does not exist yet
+    }
+    uint16_t keyLen;
+    while (fread(&keyLen, sizeof(keyLen), 1, f) == 1) {
+        std::string key(keyLen, '\0');
+        uint32_t valueLen;
+        if (fread(&key[0], 1, keyLen, f) != keyLen || fread(&valueLen, sizeof(valueLen), 1, f) != 1) {
+            break;
+        }
+        std::string value(valueLen, '\0');
+        if (valueLen > 0 && fread(&value[0], 1, valueLen, f) != valueLen) {
+            break;
+        }
+        _entries[key] = value;
+    }
+    fclose(f);
+    return true;
+}
+
+bool Preferences::save() {
+    std::string path = namespacePath(_name);
+    std::string tmpPath = path + ".tmp";
+    NativeHal::ensureParentDir(path.c_str());
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    for (const auto& entry : _entries) {
+        uint16_t keyLen = (uint16_t)entry.first.size();
+        uint32_t valueLen = (uint32_t)entry.second.size();
+        fwrite(&keyLen, sizeof(keyLen), 1, f);
+        fwrite(entry.first.data(), 1, keyLen, f);
+        fwrite(&valueLen, sizeof(valueLen), 1, f);
+        fwrite(entry.second.data(), 1, valueLen, f);
+    }
+    bool ok = fclose(f) == 0;
+    return ok && rename(tmpPath.c_str(), path.c_str()) == 0;
+}
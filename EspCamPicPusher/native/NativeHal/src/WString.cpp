@@ -0,0 +1,167 @@
+#include "WString.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+static std::string formatInteger(unsigned long long value, unsigned char base) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+    if (value == 0) {
+        return "0";
+    }
+    std::string digits;
+    while (value > 0) {
+        unsigned d = (unsigned)(value % base);
+        digits += (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        value /= base;
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+void String::fromSigned(long long value, unsigned char base) {
+    if (value < 0 && base == 10) {
+        s = "-" + formatInteger((unsigned long long)(-(value + 1)) + 1, base);
+    } else {
+        s = formatInteger((unsigned long long)value, base);
+    }
+}
+
+void String::fromUnsigned(unsigned long long value, unsigned char base) {
+    s = formatInteger(value, base);
+}
+
+void String::fromDouble(double value, unsigned int decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    s = buf;
+}
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (s.size() != other.s.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < s.size(); i++) {
+        if (tolower((unsigned char)s[i]) != tolower((unsigned char)other.s[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > s.size()) {
+        return false;
+    }
+    return s.compare(offset, prefix.s.size(), prefix.s) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.s.size() > s.size()) {
+        return false;
+    }
+    return s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    size_t pos = s.find(ch, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    size_t pos = s.find(str.s, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char ch) const {
+    size_t pos = s.rfind(ch);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(const String& str) const {
+    size_t pos = s.rfind(str.s);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const {
+    if (beginIndex >= s.size()) {
+        return String();
+    }
+    return String(s.substr(beginIndex));
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) {
+        std::swap(beginIndex, endIndex);
+    }
+    if (beginIndex >= s.size()) {
+        return String();
+    }
+    if (endIndex > s.size()) {
+        endIndex = (unsigned int)s.size();
+    }
+    return String(s.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::replace(char find, char replaceWith) {
+    std::replace(s.begin(), s.end(), find, replaceWith);
+}
+
+void String::replace(const String& find, const String& replaceWith) {
+    if (find.s.empty()) {
+        return;
+    }
+    size_t pos = 0;
+    while ((pos = s.find(find.s, pos)) != std::string::npos) {
+        s.replace(pos, find.s.size(), replaceWith.s);
+        pos += replaceWith.s.size();
+    }
+}
+
+void String::remove(unsigned int index) {
+    if (index < s.size()) {
+        s.erase(index);
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < s.size()) {
+        s.erase(index, count);
+    }
+}
+
+void String::toLowerCase() {
+    for (char& c : s) {
+        c = (char)tolower((unsigned char)c);
+    }
+}
+
+void String::toUpperCase() {
+    for (char& c : s) {
+        c = (char)toupper((unsigned char)c);
+    }
+}
+
+void String::trim() {
+    size_t begin = s.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        s.clear();
+        return;
+    }
+    size_t end = s.find_last_not_of(" \t\r\n");
+    s = s.substr(begin, end - begin + 1);
+}
+
+long String::toInt() const {
+    return strtol(s.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+    return strtof(s.c_str(), nullptr);
+}
+
+double String::toDouble() const {
+    return strtod(s.c_str(), nullptr);
+}
@@ -0,0 +1,278 @@
+#include <WiFi.h>
+#include "NativeHal.h"
+#include "NativeHalInternal.h"
+#include <mutex>
+#include <netdb.h>
+#include <thread>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+WiFiClass WiFi;
+
+namespace {
+
+struct EventHandler {
+    wifi_event_id_t id;
+    WiFiEventFuncCb callback;
+    arduino_event_id_t event;
+};
+
+std::mutex eventLock;
+std::vector<EventHandler> eventHandlers;
+wifi_event_id_t nextEventId = 1;
+
+const uint8_t MAC[6] = { 0x02, 0x00, 0x00, 0xEC, 0xAA, 0x01 };
+
+// Split of NATIVE_WIFI_ASSOC_MS into the phases a fast reconnect can skip
+const uint32_t SCAN_SHARE_PCT = 40;
+const uint32_t ASSOC_SHARE_PCT = 20;
+const uint32_t DHCP_SHARE_PCT = 40;
+
+} // namespace
+
+bool WiFiClass::mode(wifi_mode_t mode) {
+    _mode = mode;
+    if (mode == WIFI_MODE_NULL) {
+        disconnect();
+    }
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel, const uint8_t* bssid,
+                             bool connect) {
+    (void)passphrase;
+    if (!ssid || !*ssid) {
+        return WL_CONNECT_FAILED;
+    }
+    if (_mode == WIFI_MODE_NULL || _mode == WIFI_MODE_AP) {
+        _mode = _mode == WIFI_MODE_AP ? WIFI_MODE_APSTA : WIFI_MODE_STA;
+    }
+    _ssid = ssid;
+    if (!connect) {
+        return WL_DISCONNECTED;
+    }
+
+    uint32_t totalMs = (uint32_t)NativeHal::envLong("NATIVE_WIFI_ASSOC_MS", 1500);
+    uint32_t scanMs = (channel > 0 && bssid) ? 0 : totalMs * SCAN_SHARE_PCT / 100;
+    uint32_t assocMs = totalMs * ASSOC_SHARE_PCT / 100;
+    uint32_t dhcpMs = _staticIp ? 0 : totalMs * DHCP_SHARE_PCT / 100;
+    bool fail = NativeHal::envLong("NATIVE_WIFI_FAIL", 0) != 0;
+
+    uint32_t generation = ++_generation;
+    _connecting = !fail;
+    _connectAtUs = NativeHal::clockMicros() + (uint64_t)(scanMs + assocMs + dhcpMs) * 1000ULL;
+    if (!_staticIp) {
+        _ip = IPAddress(192, 168, 1, 123);
+        _gateway = IPAddress(192, 168, 1, 1);
+        _subnet = IPAddress(255, 255, 255, 0);
+        _dns = IPAddress(192, 168, 1, 1);
+    }
+
+    // Event task: deliver the same sequence as the ESP-IDF WiFi/netif stack
+    uint64_t skew = NativeHal::threadSkew();
+    std::thread([this, generation, scanMs, assocMs, dhcpMs, fail, skew]() {
+        NativeHal::setThreadSkew(skew);
+        arduino_event_info_t info;
+        memset(&info, 0, sizeof(info));
+        NativeHal::sleepMs(scanMs + assocMs);
+        if (generation != _generation) {
+            return;
+        }
+        if (fail) {
+            info.wifi_sta_disconnected.reason = 201;  // WIFI_REASON_NO_AP_FOUND
+            dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+            return;
+        }
+        memcpy(info.wifi_sta_connected.bssid, _bssid, sizeof(_bssid));
+        info.wifi_sta_connected.channel = (uint8_t)_channel;
+        dispatch(ARDUINO_EVENT_WIFI_STA_CONNECTED, info);
+        NativeHal::sleepMs(dhcpMs);
+        if (generation != _generation) {
+            return;
+        }
+        memset(&info, 0, sizeof(info));
+        info.got_ip.ip_info.ip.addr = (uint32_t)_ip;
+        info.got_ip.ip_info.netmask.addr = (uint32_t)_subnet;
+        info.got_ip.ip_info.gw.addr = (uint32_t)_gateway;
+        dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP, info);
+    }).detach();
+
+    return WL_DISCONNECTED;
+}
+
+bool WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    (void)dns2;
+    // All-zero address switches back to DHCP, as in the ESP32 core
+    _staticIp = (uint32_t)localIP != 0;
+    if (_staticIp) {
+        _ip = localIP;
+        _gateway = gateway;
+        _subnet = subnet;
+        _dns = (uint32_t)dns1 != 0 ? dns1 : gateway;
+    }
+    return true;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+    (void)eraseAp;
+    bool wasConnected = status() == WL_CONNECTED;
+    _generation++;
+    _connecting = false;
+    if (wifiOff) {
+        _mode = WIFI_MODE_NULL;
+    }
+    if (wasConnected) {
+        arduino_event_info_t info;
+        memset(&info, 0, sizeof(info));
+        info.wifi_sta_disconnected.reason = 8;  // WIFI_REASON_ASSOC_LEAVE
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, info);
+    }
+    return true;
+}
+
+bool WiFiClass::reconnect() {
+    return !_ssid.empty() && begin(_ssid.c_str()) != WL_CONNECT_FAILED;
+}
+
+wl_status_t WiFiClass::status() {
+    if (_ssid.empty() || _mode == WIFI_MODE_NULL || _mode == WIFI_MODE_AP) {
+        return WL_IDLE_STATUS;
+    }
+    if (!_connecting) {
+        return NativeHal::envLong("NATIVE_WIFI_FAIL", 0) ? WL_NO_SSID_AVAIL : WL_DISCONNECTED;
+    }
+    return NativeHal::clockMicros() >= _connectAtUs ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+bool WiFiClass::setHostname(const char* hostname) {
+    if (!hostname) {
+        return false;
+    }
+    _hostname = hostname;
+    return true;
+}
+
+IPAddress WiFiClass::localIP() {
+    return status() == WL_CONNECTED ? _ip : IPAddress();
+}
+
+IPAddress WiFiClass::gatewayIP() {
+    return status() == WL_CONNECTED ? _gateway : IPAddress();
+}
+
+IPAddress WiFiClass::subnetMask() {
+    return status() == WL_CONNECTED ? _subnet : IPAddress();
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t dnsNo) {
+    return status() == WL_CONNECTED && dnsNo == 0 ? _dns : IPAddress();
+}
+
+String WiFiClass::macAddress() {
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", MAC[0], MAC[1], MAC[2], MAC[3], MAC[4], MAC[5]);
+    return String(buf);
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+    memcpy(mac, MAC, sizeof(MAC));
+    return mac;
+}
+
+int8_t WiFiClass::RSSI() {
+    return status() == WL_CONNECTED ? (int8_t)NativeHal::envLong("NATIVE_WIFI_RSSI", -60) : 0;
+}
+
+String WiFiClass::SSID() {
+    return String(_ssid);
+}
+
+uint8_t* WiFiClass::BSSID() {
+    return status() == WL_CONNECTED ? _bssid : nullptr;
+}
+
+String WiFiClass::BSSIDstr() {
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
+             _bssid[0], _bssid[1], _bssid[2], _bssid[3], _bssid[4], _bssid[5]);
+    return String(buf);
+}
+
+int32_t WiFiClass::channel() {
+    return _channel;
+}
+
+bool WiFiClass::softAP(const char* ssid, const char* passphrase, int channel, int ssidHidden, int maxConnection) {
+    (void)passphrase;
+    (void)channel;
+    (void)ssidHidden;
+    (void)maxConnection;
+    if (!ssid || !*ssid) {
+        return false;
+    }
+    _apSsid = ssid;
+    _apStarted = true;
+    if (_mode == WIFI_MODE_NULL || _mode == WIFI_MODE_STA) {
+        _mode = _mode == WIFI_MODE_STA ? WIFI_MODE_APSTA : WIFI_MODE_AP;
+    }
+    return true;
+}
+
+bool WiFiClass::softAPdisconnect(bool wifiOff) {
+    _apStarted = false;
+    _apSsid.clear();
+    if (wifiOff) {
+        _mode = WIFI_MODE_NULL;
+    }
+    return true;
+}
+
+IPAddress WiFiClass::softAPIP() {
+    return _apStarted ? IPAddress(192, 168, 4, 1) : IPAddress();
+}
+
+int WiFiClass::hostByName(const char* hostname, IPAddress& result) {
+    std::string host(hostname ? hostname : "");
+    uint16_t port = 0;
+    NativeHal::hostOverride(host, port);
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    struct addrinfo* res = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &res) != 0 || !res) {
+        return 0;
+    }
+    result = IPAddress((uint32_t)((struct sockaddr_in*)res->ai_addr)->sin_addr.s_addr);
+    freeaddrinfo(res);
+    return 1;
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventFuncCb callback, arduino_event_id_t event) {
+    std::lock_guard<std::mutex> guard(eventLock);
+    wifi_event_id_t id = nextEventId++;
+    eventHandlers.push_back({ id, callback, event });
+    return id;
+}
+
+void WiFiClass::removeEvent(wifi_event_id_t id) {
+    std::lock_guard<std::mutex> guard(eventLock);
+    for (auto it = eventHandlers.begin(); it != eventHandlers.end(); ++it) {
+        if (it->id == id) {
+            eventHandlers.erase(it);
+            return;
+        }
+    }
+}
+
+void WiFiClass::dispatch(arduino_event_id_t event, arduino_event_info_t info) {
+    std::vector<EventHandler> handlers;
+    {
+        std::lock_guard<std::mutex> guard(eventLock);
+        handlers = eventHandlers;
+    }
+    for (const EventHandler& handler : handlers) {
+        if (handler.event == ARDUINO_EVENT_MAX || handler.event == event) {
+            handler.callback(event, info);
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include <WiFiClient.h>
+#include "NativeHal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <string>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+struct NativeSocket {
+    int fd = -1;
+    std::string rx;      // Received, not yet consumed bytes
+    size_t rxPos = 0;
+    uint32_t remoteAddr = 0;
+    uint16_t remotePort = 0;
+
+    ~NativeSocket() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    size_t buffered() const { return rx.size() - rxPos; }
+
+    // Pull whatever the kernel has without blocking; false once the peer closed
+    bool fill() {
+        if (fd < 0) {
+            return false;
+        }
+        if (rxPos == rx.size()) {
+            rx.clear();
+            rxPos = 0;
+        }
+        char buf[4096];
+        ssize_t n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n > 0) {
+            rx.append(buf, (size_t)n);
+            return true;
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            close(fd);
+            fd = -1;
+            return false;
+        }
+        return true;
+    }
+};
+
+WiFiClient::WiFiClient() {}
+
+WiFiClient::~WiFiClient() {}
+
+// Delegation is qualified so subclasses overriding connect() (TlsSessionClient)
+// can call back into the plain TCP implementation without recursing.
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    return WiFiClient::connect(ip.toString().c_str(), port, -1);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    return WiFiClient::connect(host, port, -1);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+    WiFiClient::stop();
+    std::string targetHost(host ? host : "");
+    uint16_t targetPort = port;
+    NativeHal::hostOverride(targetHost, targetPort);
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* res = nullptr;
+    if (getaddrinfo(targetHost.c_str(), nullptr, &hints, &res) != 0 || !res) {
+        return 0;
+    }
+    struct sockaddr_in addr = *(struct sockaddr_in*)res->ai_addr;
+    freeaddrinfo(res);
+    addr.sin_port = htons(targetPort);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int rc = ::connect(fd, (struct sockaddr*)&addr, sizeof(addr));
+    if (rc != 0 && errno == EINPROGRESS) {
+        struct pollfd pfd = { fd, POLLOUT, 0 };
+        rc = poll(&pfd, 1, timeoutMs > 0 ? timeoutMs : (int)_timeout * 3) == 1 ? 0 : -1;
+        int soError = 0;
+        socklen_t len = sizeof(soError);
+        if (rc == 0 && (getsockopt(fd, SOL_SOCKET, SO_ERROR, &soError, &len) != 0 || soError != 0)) {
+            rc = -1;
+        }
+    }
+    if (rc != 0) {
+        close(fd);
+        return 0;
+    }
+    fcntl(fd, F_SETFL, flags);
+
+    _socket = std::make_shared<NativeSocket>();
+    _socket->fd = fd;
+    _socket->remoteAddr = addr.sin_addr.s_addr;
+    _socket->remotePort = targetPort;
+    return 1;
+}
+
+size_t WiFiClient::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+    if (!_socket || _socket->fd < 0) {
+        return 0;
+    }
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(_socket->fd, buf + sent, size - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        sent += (size_t)n;
+    }
+    return sent;
+}
+
+int WiFiClient::available() {
+    if (!_socket) {
+        return 0;
+    }
+    if (_socket->buffered() == 0) {
+        _socket->fill();
+    }
+    return (int)_socket->buffered();
+}
+
+int WiFiClient::read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+    if (!_socket || available() == 0) {
+        return -1;
+    }
+    size_t n = std::min(size, _socket->buffered());
+    memcpy(buf, _socket->rx.data() + _socket->rxPos, n);
+    _socket->rxPos += n;
+    return (int)n;
+}
+
+int WiFiClient::peek() {
+    if (!_socket || available() == 0) {
+        return -1;
+    }
+    return (uint8_t)_socket->rx[_socket->rxPos];
+}
+
+void WiFiClient::stop() {
+    _socket.reset();
+}
+
+uint8_t WiFiClient::connected() {
+    if (!_socket) {
+        return 0;
+    }
+    if (_socket->buffered() > 0) {
+        return 1;
+    }
+    return _socket->fill() || _socket->buffered() > 0;
+}
+
+int WiFiClient::setNoDelay(bool nodelay) {
+    if (!_socket || _socket->fd < 0) {
+        return -1;
+    }
+    int flag = nodelay ? 1 : 0;
+    return setsockopt(_socket->fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+int WiFiClient::fd() const {
+    return _socket ? _socket->fd : -1;
+}
+
+IPAddress WiFiClient::remoteIP() const {
+    return _socket ? IPAddress(_socket->remoteAddr) : IPAddress();
+}
+
+uint16_t WiFiClient::remotePort() const {
+    return _socket ? _socket->remotePort : 0;
+}
@@ -0,0 +1,356 @@
+#include "esp_camera.h"
+#include "NativeHal.h"
+#include "test_pattern.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+const resolution_info_t resolution[FRAMESIZE_INVALID] = {
+    { 96, 96, 0 },     { 160, 120, 0 },   { 176, 144, 0 },   { 240, 176, 0 },   { 240, 240, 0 },
+    { 320, 240, 0 },   { 400, 296, 0 },   { 480, 320, 0 },   { 640, 480, 0 },   { 800, 600, 0 },
+    { 1024, 768, 0 },  { 1280, 720, 0 },  { 1280, 1024, 0 }, { 1600, 1200, 0 }, { 1920, 1080, 0 },
+    { 720, 1280, 0 },  { 864, 1536, 0 },  { 2048, 1536, 0 }, { 2560, 1440, 0 }, { 2560, 1600, 0 },
+    { 1080, 1920, 0 }, { 2560, 1920, 0 },
+};
+
+namespace {
+
+struct CameraState {
+    std::mutex lock;
+    bool initialized = false;
+    camera_config_t config;
+    sensor_t sensor;
+    std::map<int, int> registers;
+    std::vector<std::string> frames;
+    size_t nextFrame = 0;
+    long framesSinceInit = 0;
+    long startAec = 0;
+    long startGain = 0;
+};
+
+CameraState camera;
+
+// Width/height from the SOF0/SOF2 marker; false if the data is not a JPEG
+bool jpegDimensions(const uint8_t* data, size_t len, size_t* width, size_t* height) {
+    if (len < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+        return false;
+    }
+    size_t pos = 2;
+    while (pos + 9 < len) {
+        if (data[pos] != 0xFF) {
+            return false;
+        }
+        uint8_t marker = data[pos + 1];
+        size_t segLen = ((size_t)data[pos + 2] << 8) | data[pos + 3];
+        if (marker == 0xC0 || marker == 0xC1 || marker == 0xC2) {
+            *height = ((size_t)data[pos + 5] << 8) | data[pos + 6];
+            *width = ((size_t)data[pos + 7] << 8) | data[pos + 8];
+            return true;
+        }
+        pos += 2 + segLen;
+    }
+    return false;
+}
+
+void scanFrameDir() {
+    camera.frames.clear();
+    const char* dir = getenv("NATIVE_CAMERA_DIR");
+    if (!dir || !*dir) {
+        return;
+    }
+    DIR* d = opendir(dir);
+    if (!d) {
+        printf("[NativeHal] NATIVE_CAMERA_DIR %s not readable, using test pattern\n", dir);
+        return;
+    }
+    while (struct dirent* entry = readdir(d)) {
+        std::string name(entry->d_name);
+        if (name.size() > 4 && (name.compare(name.size() - 4, 4, ".jpg") == 0 ||
+                                name.compare(name.size() - 4, 4, ".JPG") == 0)) {
+            camera.frames.push_back(std::string(dir) + "/" + name);
+        }
+    }
+    closedir(d);
+    std::sort(camera.frames.begin(), camera.frames.end());
+    printf("[NativeHal] Camera replays %u frame(s) from %s\n", (unsigned)camera.frames.size(), dir);
+}
+
+bool loadFile(const std::string& path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data.resize(size > 0 ? (size_t)size : 0);
+    bool ok = size > 0 && fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+// ---- sensor_t callbacks: record the setting in status like the real drivers ----
+
+#define STATUS_SETTER(fn, field)                  \
+    int fn(sensor_t* s, int value) {              \
+        s->status.field = (decltype(s->status.field))value; \
+        return 0;                                 \
+    }
+
+STATUS_SETTER(setContrast, contrast)
+STATUS_SETTER(setBrightness, brightness)
+STATUS_SETTER(setSaturation, saturation)
+STATUS_SETTER(setSharpness, sharpness)
+STATUS_SETTER(setDenoise, denoise)
+STATUS_SETTER(setQuality, quality)
+STATUS_SETTER(setColorbar, colorbar)
+STATUS_SETTER(setWhitebal, awb)
+STATUS_SETTER(setGainCtrl, agc)
+STATUS_SETTER(setExposureCtrl, aec)
+STATUS_SETTER(setHmirror, hmirror)
+STATUS_SETTER(setVflip, vflip)
+STATUS_SETTER(setAec2, aec2)
+STATUS_SETTER(setAwbGain, awb_gain)
+STATUS_SETTER(setAgcGain, agc_gain)
+STATUS_SETTER(setAecValue, aec_value)
+STATUS_SETTER(setSpecialEffect, special_effect)
+STATUS_SETTER(setWbMode, wb_mode)
+STATUS_SETTER(setAeLevel, ae_level)
+STATUS_SETTER(setDcw, dcw)
+STATUS_SETTER(setBpc, bpc)
+STATUS_SETTER(setWpc, wpc)
+STATUS_SETTER(setRawGma, raw_gma)
+STATUS_SETTER(setLenc, lenc)
+
+#undef STATUS_SETTER
+
+int initStatus(sensor_t* s) {
+    (void)s;
+    return 0;
+}
+
+int resetSensor(sensor_t* s) {
+    (void)s;
+    return 0;
+}
+
+int setPixformat(sensor_t* s, pixformat_t pixformat) {
+    s->pixformat = pixformat;
+    return 0;
+}
+
+int setFramesize(sensor_t* s, framesize_t framesize) {
+    if (framesize >= FRAMESIZE_INVALID) {
+        return -1;
+    }
+    s->status.framesize = framesize;
+    return 0;
+}
+
+int setGainceiling(sensor_t* s, gainceiling_t gainceiling) {
+    s->status.gainceiling = (uint8_t)gainceiling;
+    return 0;
+}
+
+// OV2640 register access: reg = (bank << 8) | address, as in esp32-camera
+int getReg(sensor_t* s, int reg, int mask) {
+    (void)s;
+    std::lock_guard<std::mutex> guard(camera.lock);
+    auto it = camera.registers.find(reg);
+    return (it == camera.registers.end() ? 0 : it->second) & mask;
+}
+
+int setReg(sensor_t* s, int reg, int mask, int value) {
+    (void)s;
+    std::lock_guard<std::mutex> guard(camera.lock);
+    int& current = camera.registers[reg];
+    current = (current & ~mask) | (value & mask);
+    return 0;
+}
+
+int setResRaw(sensor_t* s, int startX, int startY, int endX, int endY, int offsetX, int offsetY,
+              int totalX, int totalY, int outputX, int outputY, bool scale, bool binning) {
+    (void)startY; (void)endX; (void)endY;
+    // Replayed frames are not cropped, the window is only logged
+    printf("[NativeHal] Sensor window: mode %d, %dx%d at %d,%d, output %dx%d\n",
+           startX, totalX, totalY, offsetX, offsetY, outputX, outputY);
+    s->status.scale = scale;
+    s->status.binning = binning;
+    return 0;
+}
+
+int setPll(sensor_t* s, int bypass, int mul, int sys, int root, int pre, int seld5, int pclken, int pclk) {
+    (void)s; (void)bypass; (void)mul; (void)sys; (void)root; (void)pre; (void)seld5; (void)pclken; (void)pclk;
+    return 0;
+}
+
+int setXclk(sensor_t* s, int timer, int xclk) {
+    (void)timer;
+    s->xclk_freq_hz = xclk * 1000000;
+    return 0;
+}
+
+// AEC/AGC run-in after init: exposure and gain move from their values at the
+// first frame (0, or whatever the firmware seeded) to their final values over
+// NATIVE_CAMERA_CONVERGE_FRAMES frames, then stay put (bank 1 registers
+// 0x45/0x10/0x04 = AEC, 0x00 = gain). Caller holds camera.lock.
+void simulateAutoExposure() {
+    const long targetAec = 0x180;
+    const long targetGain = 0x10;
+    long convergeFrames = NativeHal::envLong("NATIVE_CAMERA_CONVERGE_FRAMES", 1);
+    long frame = ++camera.framesSinceInit;
+    if (frame == 1) {
+        camera.startAec = ((long)camera.registers[0x145] << 10) | ((long)camera.registers[0x110] << 2) |
+                          (camera.registers[0x104] & 0x03);
+        camera.startGain = camera.registers[0x100];
+    }
+    long aec = targetAec;
+    long gain = targetGain;
+    if (frame <= convergeFrames) {
+        aec = camera.startAec + (targetAec - camera.startAec) * frame / (convergeFrames + 1);
+        gain = camera.startGain + (targetGain - camera.startGain) * frame / (convergeFrames + 1);
+    }
+    camera.registers[0x145] = (int)((aec >> 10) & 0x3F);
+    camera.registers[0x110] = (int)((aec >> 2) & 0xFF);
+    camera.registers[0x104] = (camera.registers[0x104] & ~0x03) | (int)(aec & 0x03);
+    camera.registers[0x100] = (int)gain;
+}
+
+void initSensor(const camera_config_t* config) {
+    sensor_t& s = camera.sensor;
+    memset(&s, 0, sizeof(s));
+    s.id.MIDH = 0x7F;
+    s.id.MIDL = 0xA2;
+    s.id.PID = OV2640_PID;
+    s.id.VER = 0x42;
+    s.slv_addr = 0x30;
+    s.pixformat = config->pixel_format;
+    s.xclk_freq_hz = config->xclk_freq_hz;
+    s.status.framesize = config->frame_size;
+    s.status.quality = (uint8_t)config->jpeg_quality;
+    s.status.awb = 1;
+    s.status.awb_gain = 1;
+    s.status.aec = 1;
+    s.status.agc = 1;
+    s.status.aec_value = 300;
+    s.status.wpc = 1;
+    s.status.raw_gma = 1;
+    s.status.lenc = 1;
+    s.status.dcw = 1;
+
+    s.init_status = initStatus;
+    s.reset = resetSensor;
+    s.set_pixformat = setPixformat;
+    s.set_framesize = setFramesize;
+    s.set_contrast = setContrast;
+    s.set_brightness = setBrightness;
+    s.set_saturation = setSaturation;
+    s.set_sharpness = setSharpness;
+    s.set_denoise = setDenoise;
+    s.set_gainceiling = setGainceiling;
+    s.set_quality = setQuality;
+    s.set_colorbar = setColorbar;
+    s.set_whitebal = setWhitebal;
+    s.set_gain_ctrl = setGainCtrl;
+    s.set_exposure_ctrl = setExposureCtrl;
+    s.set_hmirror = setHmirror;
+    s.set_vflip = setVflip;
+    s.set_aec2 = setAec2;
+    s.set_awb_gain = setAwbGain;
+    s.set_agc_gain = setAgcGain;
+    s.set_aec_value = setAecValue;
+    s.set_special_effect = setSpecialEffect;
+    s.set_wb_mode = setWbMode;
+    s.set_ae_level = setAeLevel;
+    s.set_dcw = setDcw;
+    s.set_bpc = setBpc;
+    s.set_wpc = setWpc;
+    s.set_raw_gma = setRawGma;
+    s.set_lenc = setLenc;
+    s.get_reg = getReg;
+    s.set_reg = setReg;
+    s.set_res_raw = setResRaw;
+    s.set_pll = setPll;
+    s.set_xclk = setXclk;
+}
+
+} // namespace
+
+esp_err_t esp_camera_init(const camera_config_t* config) {
+    if (!config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Sensor probe + register upload takes a few hundred ms on the board
+    NativeHal::sleepMs(250);
+    std::lock_guard<std::mutex> guard(camera.lock);
+    camera.config = *config;
+    camera.registers.clear();
+    camera.framesSinceInit = 0;
+    initSensor(config);
+    scanFrameDir();
+    camera.initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_deinit() {
+    std::lock_guard<std::mutex> guard(camera.lock);
+    camera.initialized = false;
+    return ESP_OK;
+}
+
+camera_fb_t* esp_camera_fb_get() {
+    if (!camera.initialized) {
+        return nullptr;
+    }
+    NativeHal::sleepMs((uint32_t)NativeHal::envLong("NATIVE_CAMERA_FRAME_MS", 66));
+
+    std::vector<uint8_t> data;
+    {
+        std::lock_guard<std::mutex> guard(camera.lock);
+        simulateAutoExposure();
+        if (!camera.frames.empty()) {
+            const std::string& path = camera.frames[camera.nextFrame++ % camera.frames.size()];
+            if (!loadFile(path, data)) {
+                printf("[NativeHal] Failed to read frame %s\n", path.c_str());
+                return nullptr;
+            }
+        } else {
+            data.assign(TEST_PATTERN_JPEG, TEST_PATTERN_JPEG + sizeof(TEST_PATTERN_JPEG));
+        }
+    }
+
+    camera_fb_t* fb = (camera_fb_t*)calloc(1, sizeof(camera_fb_t));
+    fb->buf = (uint8_t*)malloc(data.size());
+    if (!fb->buf) {
+        free(fb);
+        return nullptr;
+    }
+    memcpy(fb->buf, data.data(), data.size());
+    fb->len = data.size();
+    fb->format = PIXFORMAT_JPEG;
+    if (!jpegDimensions(fb->buf, fb->len, &fb->width, &fb->height)) {
+        fb->width = resolution[camera.sensor.status.framesize].width;
+        fb->height = resolution[camera.sensor.status.framesize].height;
+    }
+    uint64_t now = NativeHal::clockMicros();
+    fb->timestamp.tv_sec = (time_t)(now / 1000000ULL);
+    fb->timestamp.tv_usec = (suseconds_t)(now % 1000000ULL);
+    return fb;
+}
+
+void esp_camera_fb_return(camera_fb_t* fb) {
+    if (fb) {
+        free(fb->buf);
+        free(fb);
+    }
+}
+
+sensor_t* esp_camera_sensor_get() {
+    return camera.initialized ? &camera.sensor : nullptr;
+}
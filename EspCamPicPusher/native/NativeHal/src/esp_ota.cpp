@@ -0,0 +1,257 @@
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "NativeHal.h"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Mirrors partitions.csv
+static const esp_partition_t partitions[] = {
+    { nullptr, ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS, 0x9000, 0x5000, "nvs", false },
+    { nullptr, ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_OTA, 0xe000, 0x2000, "otadata", false },
+    { nullptr, ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, 0x10000, 0x180000, "app0", false },
+    { nullptr, ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, 0x190000, 0x180000, "app1", false },
+    { nullptr, ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0x310000, 0xF0000, "spiffs", false },
+};
+
+static const esp_partition_t* const APP0 = &partitions[2];
+static const esp_partition_t* const APP1 = &partitions[3];
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    for (const esp_partition_t& p : partitions) {
+        if (p.type != type && type != ESP_PARTITION_TYPE_ANY) {
+            continue;
+        }
+        if (p.subtype != subtype && subtype != ESP_PARTITION_SUBTYPE_ANY) {
+            continue;
+        }
+        if (label && strcmp(label, p.label) != 0) {
+            continue;
+        }
+        return &p;
+    }
+    return nullptr;
+}
+
+static std::string partitionPath(const esp_partition_t* partition) {
+    return NativeHal::dataPath((std::string(partition->label) + ".bin").c_str());
+}
+
+// Partition files are created lazily and read back as erased flash (0xFF)
+static FILE* openPartition(const esp_partition_t* partition) {
+    std::string path = partitionPath(partition);
+    FILE* f = fopen(path.c_str(), "r+b");
+    if (!f) {
+        f = fopen(path.c_str(), "w+b");
+        if (!f) {
+            return nullptr;
+        }
+        std::vector<uint8_t> erased(4096, 0xFF);
+        for (uint32_t written = 0; written < partition->size; written += (uint32_t)erased.size()) {
+            fwrite(erased.data(), 1, erased.size(), f);
+        }
+    }
+    return f;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t src_offset, void* dst, size_t size) {
+    if (!partition || src_offset + size > partition->size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    FILE* f = openPartition(partition);
+    if (!f) {
+        return ESP_FAIL;
+    }
+    fseek(f, (long)src_offset, SEEK_SET);
+    size_t n = fread(dst, 1, size, f);
+    fclose(f);
+    return n == size ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t dst_offset, const void* src, size_t size) {
+    if (!partition || dst_offset + size > partition->size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    FILE* f = openPartition(partition);
+    if (!f) {
+        return ESP_FAIL;
+    }
+    fseek(f, (long)dst_offset, SEEK_SET);
+    size_t n = fwrite(src, 1, size, f);
+    fclose(f);
+    return n == size ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size) {
+    if (!partition || offset + size > partition->size || offset % 4096 != 0 || size % 4096 != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::vector<uint8_t> erased(size, 0xFF);
+    return esp_partition_write(partition, offset, erased.data(), size);
+}
+
+// ============================================================================
+// OTA data: "<boot label> <state>" in NATIVE_DATA_DIR/otadata
+// ============================================================================
+
+struct OtaData {
+    const esp_partition_t* boot;
+    esp_ota_img_states_t state;
+};
+
+static OtaData loadOtaData() {
+    OtaData data = { APP0, ESP_OTA_IMG_VALID };
+    FILE* f = fopen(NativeHal::dataPath("otadata").c_str(), "r");
+    if (f) {
+        char label[17] = {};
+        unsigned state = 0;
+        if (fscanf(f, "%16s %u", label, &state) == 2) {
+            data.boot = strcmp(label, APP1->label) == 0 ? APP1 : APP0;
+            data.state = (esp_ota_img_states_t)state;
+        }
+        fclose(f);
+    }
+    return data;
+}
+
+static esp_err_t saveOtaData(const OtaData& data) {
+    FILE* f = fopen(NativeHal::dataPath("otadata").c_str(), "w");
+    if (!f) {
+        return ESP_FAIL;
+    }
+    fprintf(f, "%s %u\n", data.boot->label, (unsigned)data.state);
+    fclose(f);
+    return ESP_OK;
+}
+
+// The running slot is fixed at startup, like the bootloader's choice
+static const OtaData& runningOtaData() {
+    static const OtaData data = loadOtaData();
+    return data;
+}
+
+struct OtaWrite {
+    const esp_partition_t* partition = nullptr;
+    size_t offset = 0;
+    bool active = false;
+};
+
+static OtaWrite otaWrite;
+
+esp_err_t esp_ota_begin(const esp_partition_t* partition, size_t image_size, esp_ota_handle_t* out_handle) {
+    (void)image_size;
+    if (!partition || partition->type != ESP_PARTITION_TYPE_APP || !out_handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (partition == esp_ota_get_running_partition()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // Start from an empty image file
+    FILE* f = fopen(partitionPath(partition).c_str(), "wb");
+    if (!f) {
+        return ESP_FAIL;
+    }
+    fclose(f);
+    otaWrite.partition = partition;
+    otaWrite.offset = 0;
+    otaWrite.active = true;
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_write(esp_ota_handle_t handle, const void* data, size_t size) {
+    if (handle != 1 || !otaWrite.active) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (otaWrite.offset + size > otaWrite.partition->size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    FILE* f = fopen(partitionPath(otaWrite.partition).c_str(), "ab");
+    if (!f) {
+        return ESP_FAIL;
+    }
+    size_t n = fwrite(data, 1, size, f);
+    fclose(f);
+    otaWrite.offset += n;
+    return n == size ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_ota_end(esp_ota_handle_t handle) {
+    if (handle != 1 || !otaWrite.active) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    otaWrite.active = false;
+    // A real image starts with the 0xE9 magic byte; anything else fails validation
+    uint8_t magic = 0;
+    FILE* f = fopen(partitionPath(otaWrite.partition).c_str(), "rb");
+    if (f) {
+        if (fread(&magic, 1, 1, f) != 1) {
+            magic = 0;
+        }
+        fclose(f);
+    }
+    return magic == 0xE9 ? ESP_OK : ESP_ERR_OTA_VALIDATE_FAILED;
+}
+
+esp_err_t esp_ota_abort(esp_ota_handle_t handle) {
+    if (handle != 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    otaWrite.active = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* partition) {
+    if (!partition || partition->type != ESP_PARTITION_TYPE_APP) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    OtaData data = { partition, ESP_OTA_IMG_PENDING_VERIFY };
+    if (partition == esp_ota_get_running_partition()) {
+        data.state = runningOtaData().state;
+    }
+    return saveOtaData(data);
+}
+
+const esp_partition_t* esp_ota_get_boot_partition() {
+    return loadOtaData().boot;
+}
+
+const esp_partition_t* esp_ota_get_running_partition() {
+    return runningOtaData().boot;
+}
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* start_from) {
+    const esp_partition_t* from = start_from ? start_from : esp_ota_get_running_partition();
+    return from == APP0 ? APP1 : APP0;
+}
+
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* partition, esp_ota_img_states_t* ota_state) {
+    if (!partition || !ota_state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    OtaData data = loadOtaData();
+    if (partition != data.boot) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *ota_state = data.state;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_valid_cancel_rollback() {
+    OtaData data = loadOtaData();
+    if (data.boot == esp_ota_get_running_partition() && data.state == ESP_OTA_IMG_PENDING_VERIFY) {
+        data.state = ESP_OTA_IMG_VALID;
+        return saveOtaData(data);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot() {
+    OtaData data = loadOtaData();
+    data.boot = esp_ota_get_next_update_partition(esp_ota_get_running_partition());
+    data.state = ESP_OTA_IMG_VALID;
+    saveOtaData(data);
+    NativeHal::powerDown(NativeHal::EXIT_RESTART, 0);
+}
@@ -0,0 +1,216 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "NativeHal.h"
+#include "NativeHalInternal.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct NativeTask {
+    std::string name;
+    BaseType_t core;
+};
+
+namespace {
+
+// Thrown by vTaskDelete(NULL) to unwind the task thread
+struct TaskExit {};
+
+NativeTask loopTask = { "loopTask", 1 };
+thread_local NativeTask* currentTask = &loopTask;
+
+// Wait on `cv` until `ready()` or `ticks` ms elapse (portMAX_DELAY = forever)
+template <typename Predicate>
+bool waitTicks(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, TickType_t ticks,
+               Predicate ready) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, ready);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+void stampNow(uint64_t& stamp) {
+    uint64_t now = NativeHal::clockMicros();
+    if (now > stamp) {
+        stamp = now;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Tasks
+// ============================================================================
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char* pcName, uint32_t usStackDepth,
+                                   void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pvCreatedTask,
+                                   BaseType_t xCoreID) {
+    (void)usStackDepth;
+    (void)uxPriority;
+    NativeTask* task = new NativeTask{ pcName ? pcName : "task", xCoreID == tskNO_AFFINITY ? 0 : xCoreID };
+    uint64_t parentSkew = NativeHal::threadSkew();
+    std::thread([task, pvTaskCode, pvParameters, parentSkew]() {
+        NativeHal::setThreadSkew(parentSkew);
+        currentTask = task;
+        try {
+            pvTaskCode(pvParameters);
+            fprintf(stderr, "[NativeHal] Task %s returned without vTaskDelete()\n", task->name.c_str());
+        } catch (const TaskExit&) {
+        }
+    }).detach();
+    if (pvCreatedTask) {
+        *pvCreatedTask = task;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char* pcName, uint32_t usStackDepth,
+                       void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pvCreatedTask) {
+    return xTaskCreatePinnedToCore(pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pvCreatedTask,
+                                   tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    if (xTaskToDelete == nullptr || xTaskToDelete == currentTask) {
+        throw TaskExit();
+    }
+    fprintf(stderr, "[NativeHal] vTaskDelete(%s) from another task is not supported\n",
+            xTaskToDelete->name.c_str());
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    NativeHal::sleepMs(xTicksToDelay);
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)(NativeHal::clockMicros() / 1000ULL);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask;
+}
+
+BaseType_t xPortGetCoreID() {
+    return currentTask->core;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) {
+    (void)xTask;
+    return 1024;
+}
+
+// ============================================================================
+// Semaphores (mutex, binary, counting)
+// ============================================================================
+
+struct NativeSemaphore {
+    std::mutex lock;
+    std::condition_variable cv;
+    UBaseType_t count;
+    UBaseType_t maxCount;
+    uint64_t stamp = 0;  // Virtual time of the latest give
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new NativeSemaphore{ {}, {}, 1, 1 };
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return new NativeSemaphore{ {}, {}, 0, 1 };
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount) {
+    return new NativeSemaphore{ {}, {}, uxInitialCount, uxMaxCount };
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait) {
+    std::unique_lock<std::mutex> guard(xSemaphore->lock);
+    if (!waitTicks(xSemaphore->cv, guard, xTicksToWait, [xSemaphore]() { return xSemaphore->count > 0; })) {
+        return pdFALSE;
+    }
+    xSemaphore->count--;
+    NativeHal::syncClockTo(xSemaphore->stamp);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    std::lock_guard<std::mutex> guard(xSemaphore->lock);
+    if (xSemaphore->count >= xSemaphore->maxCount) {
+        return pdFALSE;
+    }
+    xSemaphore->count++;
+    stampNow(xSemaphore->stamp);
+    xSemaphore->cv.notify_one();
+    return pdTRUE;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore) {
+    std::lock_guard<std::mutex> guard(xSemaphore->lock);
+    return xSemaphore->count;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
+    delete xSemaphore;
+}
+
+// ============================================================================
+// Event groups
+// ============================================================================
+
+struct NativeEventGroup {
+    std::mutex lock;
+    std::condition_variable cv;
+    EventBits_t bits = 0;
+    uint64_t stamp = 0;  // Virtual time of the latest set
+};
+
+EventGroupHandle_t xEventGroupCreate() {
+    return new NativeEventGroup();
+}
+
+void vEventGroupDelete(EventGroupHandle_t xEventGroup) {
+    delete xEventGroup;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet) {
+    std::lock_guard<std::mutex> guard(xEventGroup->lock);
+    xEventGroup->bits |= uxBitsToSet;
+    stampNow(xEventGroup->stamp);
+    xEventGroup->cv.notify_all();
+    return xEventGroup->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToClear) {
+    std::lock_guard<std::mutex> guard(xEventGroup->lock);
+    EventBits_t previous = xEventGroup->bits;
+    xEventGroup->bits &= ~uxBitsToClear;
+    return previous;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t xEventGroup) {
+    std::lock_guard<std::mutex> guard(xEventGroup->lock);
+    return xEventGroup->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToWaitFor,
+                                BaseType_t xClearOnExit, BaseType_t xWaitForAllBits, TickType_t xTicksToWait) {
+    std::unique_lock<std::mutex> guard(xEventGroup->lock);
+    auto satisfied = [xEventGroup, uxBitsToWaitFor, xWaitForAllBits]() {
+        EventBits_t match = xEventGroup->bits & uxBitsToWaitFor;
+        return xWaitForAllBits ? match == uxBitsToWaitFor : match != 0;
+    };
+    bool ok = waitTicks(xEventGroup->cv, guard, xTicksToWait, satisfied);
+    EventBits_t result = xEventGroup->bits;
+    if (ok) {
+        NativeHal::syncClockTo(xEventGroup->stamp);
+        if (xClearOnExit) {
+            xEventGroup->bits &= ~uxBitsToWaitFor;
+        }
+    }
+    return result;
+}
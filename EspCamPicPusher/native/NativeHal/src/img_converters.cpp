@@ -0,0 +1,323 @@
+#include "img_converters.h"
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+// Minimal baseline encoder (4:4:4, standard Annex K tables, float DCT);
+// speed and size are not representative of the esp32-camera encoder
+
+namespace {
+
+const uint8_t ZIGZAG[64] = {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+const uint8_t QUANT_LUMA[64] = {
+    16, 11, 10, 16, 24, 40, 51, 61, 12, 12, 14, 19, 26, 58, 60, 55,
+    14, 13, 16, 24, 40, 57, 69, 56, 14, 17, 22, 29, 51, 87, 80, 62,
+    18, 22, 37, 56, 68, 109, 103, 77, 24, 35, 55, 64, 81, 104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99
+};
+
+const uint8_t QUANT_CHROMA[64] = {
+    17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99
+};
+
+const uint8_t DC_LUMA_BITS[16] = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+const uint8_t DC_CHROMA_BITS[16] = { 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 };
+const uint8_t DC_VALUES[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+const uint8_t AC_LUMA_BITS[16] = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d };
+const uint8_t AC_LUMA_VALUES[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+const uint8_t AC_CHROMA_BITS[16] = { 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77 };
+const uint8_t AC_CHROMA_VALUES[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+    0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+    0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+    0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+    0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+struct HuffCode {
+    uint16_t code[256];
+    uint8_t length[256];
+
+    void build(const uint8_t* bits, const uint8_t* values) {
+        memset(length, 0, sizeof(length));
+        uint16_t next = 0;
+        int k = 0;
+        for (int len = 1; len <= 16; len++) {
+            for (int i = 0; i < bits[len - 1]; i++) {
+                code[values[k]] = next++;
+                length[values[k]] = (uint8_t)len;
+                k++;
+            }
+            next <<= 1;
+        }
+    }
+};
+
+struct Writer {
+    jpg_out_cb cb;
+    void* arg;
+    size_t index;
+    bool ok;
+    std::vector<uint8_t> chunk;
+    uint32_t bitBuffer;
+    int bitCount;
+
+    void byte(uint8_t b) {
+        chunk.push_back(b);
+        if (chunk.size() >= 1024) {
+            flush();
+        }
+    }
+
+    void bytes(const uint8_t* data, size_t len) {
+        for (size_t i = 0; i < len; i++) {
+            byte(data[i]);
+        }
+    }
+
+    void be16(uint16_t v) {
+        byte(v >> 8);
+        byte(v & 0xFF);
+    }
+
+    void bits(uint32_t value, int count) {
+        for (int i = count - 1; i >= 0; i--) {
+            bitBuffer = (bitBuffer << 1) | ((value >> i) & 1);
+            if (++bitCount == 8) {
+                byte((uint8_t)bitBuffer);
+                if ((uint8_t)bitBuffer == 0xFF) {
+                    byte(0x00);  // Byte stuffing
+                }
+                bitBuffer = 0;
+                bitCount = 0;
+            }
+        }
+    }
+
+    void padBits() {
+        if (bitCount > 0) {
+            bits(0x7F, 8 - bitCount);
+        }
+    }
+
+    void flush() {
+        if (ok && !chunk.empty()) {
+            ok = cb(arg, index, chunk.data(), chunk.size()) == chunk.size();
+            index += chunk.size();
+        }
+        chunk.clear();
+    }
+};
+
+void writeDqt(Writer& w, uint8_t id, const uint8_t* table) {
+    w.be16(0xFFDB);
+    w.be16(67);
+    w.byte(id);
+    for (int i = 0; i < 64; i++) {
+        w.byte(table[ZIGZAG[i]]);
+    }
+}
+
+void writeDht(Writer& w, uint8_t classId, const uint8_t* bits, const uint8_t* values) {
+    int count = 0;
+    for (int i = 0; i < 16; i++) {
+        count += bits[i];
+    }
+    w.be16(0xFFC4);
+    w.be16((uint16_t)(19 + count));
+    w.byte(classId);
+    w.bytes(bits, 16);
+    w.bytes(values, count);
+}
+
+int magnitude(int value) {
+    int size = 0;
+    for (int v = value < 0 ? -value : value; v; v >>= 1) {
+        size++;
+    }
+    return size;
+}
+
+void encodeBlock(Writer& w, const float* block, const uint8_t* quant, const HuffCode& dc, const HuffCode& ac,
+                 int& pred) {
+    static float cosines[8][8];
+    static bool init = false;
+    if (!init) {
+        for (int x = 0; x < 8; x++) {
+            for (int u = 0; u < 8; u++) {
+                cosines[x][u] = cosf((2 * x + 1) * u * (float)M_PI / 16);
+            }
+        }
+        init = true;
+    }
+
+    int coeffs[64];
+    for (int v = 0; v < 8; v++) {
+        for (int u = 0; u < 8; u++) {
+            float sum = 0;
+            for (int y = 0; y < 8; y++) {
+                for (int x = 0; x < 8; x++) {
+                    sum += block[y * 8 + x] * cosines[x][u] * cosines[y][v];
+                }
+            }
+            float cu = u == 0 ? (float)M_SQRT1_2 : 1.0f;
+            float cv = v == 0 ? (float)M_SQRT1_2 : 1.0f;
+            coeffs[v * 8 + u] = (int)lroundf(sum * cu * cv / 4 / quant[v * 8 + u]);
+        }
+    }
+
+    int diff = coeffs[0] - pred;
+    pred = coeffs[0];
+    int size = magnitude(diff);
+    w.bits(dc.code[size], dc.length[size]);
+    if (size) {
+        w.bits(diff < 0 ? diff + (1 << size) - 1 : diff, size);
+    }
+
+    int run = 0;
+    for (int i = 1; i < 64; i++) {
+        int value = coeffs[ZIGZAG[i]];
+        if (value == 0) {
+            run++;
+            continue;
+        }
+        while (run > 15) {
+            w.bits(ac.code[0xF0], ac.length[0xF0]);
+            run -= 16;
+        }
+        size = magnitude(value);
+        int symbol = (run << 4) | size;
+        w.bits(ac.code[symbol], ac.length[symbol]);
+        w.bits(value < 0 ? value + (1 << size) - 1 : value, size);
+        run = 0;
+    }
+    if (run) {
+        w.bits(ac.code[0x00], ac.length[0x00]);
+    }
+}
+
+} // namespace
+
+bool fmt2jpg_cb(uint8_t* src, size_t src_len, uint16_t width, uint16_t height, pixformat_t format,
+                uint8_t quality, jpg_out_cb cb, void* arg) {
+    int channels = format == PIXFORMAT_RGB888 ? 3 : (format == PIXFORMAT_GRAYSCALE ? 1 : 0);
+    if (!channels || !src || !cb || width == 0 || height == 0 ||
+        src_len < (size_t)width * height * channels) {
+        return false;
+    }
+
+    // IJG quality scaling
+    if (quality < 1) quality = 1;
+    if (quality > 100) quality = 100;
+    int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+    uint8_t quant[2][64];
+    for (int i = 0; i < 64; i++) {
+        int luma = (QUANT_LUMA[i] * scale + 50) / 100;
+        int chroma = (QUANT_CHROMA[i] * scale + 50) / 100;
+        quant[0][i] = (uint8_t)(luma < 1 ? 1 : (luma > 255 ? 255 : luma));
+        quant[1][i] = (uint8_t)(chroma < 1 ? 1 : (chroma > 255 ? 255 : chroma));
+    }
+
+    HuffCode dcCodes[2], acCodes[2];
+    dcCodes[0].build(DC_LUMA_BITS, DC_VALUES);
+    dcCodes[1].build(DC_CHROMA_BITS, DC_VALUES);
+    acCodes[0].build(AC_LUMA_BITS, AC_LUMA_VALUES);
+    acCodes[1].build(AC_CHROMA_BITS, AC_CHROMA_VALUES);
+
+    Writer w = { cb, arg, 0, true, {}, 0, 0 };
+    w.be16(0xFFD8);
+    writeDqt(w, 0, quant[0]);
+    if (channels == 3) {
+        writeDqt(w, 1, quant[1]);
+    }
+
+    w.be16(0xFFC0);
+    w.be16((uint16_t)(8 + 3 * channels));
+    w.byte(8);
+    w.be16(height);
+    w.be16(width);
+    w.byte((uint8_t)channels);
+    for (int c = 0; c < channels; c++) {
+        w.byte((uint8_t)(c + 1));
+        w.byte(0x11);
+        w.byte(c == 0 ? 0 : 1);
+    }
+
+    writeDht(w, 0x00, DC_LUMA_BITS, DC_VALUES);
+    writeDht(w, 0x10, AC_LUMA_BITS, AC_LUMA_VALUES);
+    if (channels == 3) {
+        writeDht(w, 0x01, DC_CHROMA_BITS, DC_VALUES);
+        writeDht(w, 0x11, AC_CHROMA_BITS, AC_CHROMA_VALUES);
+    }
+
+    w.be16(0xFFDA);
+    w.be16((uint16_t)(6 + 2 * channels));
+    w.byte((uint8_t)channels);
+    for (int c = 0; c < channels; c++) {
+        w.byte((uint8_t)(c + 1));
+        w.byte(c == 0 ? 0x00 : 0x11);
+    }
+    w.byte(0);
+    w.byte(63);
+    w.byte(0);
+
+    int pred[3] = { 0, 0, 0 };
+    float blocks[3][64];
+    for (int by = 0; by < height; by += 8) {
+        for (int bx = 0; bx < width; bx += 8) {
+            for (int y = 0; y < 8; y++) {
+                for (int x = 0; x < 8; x++) {
+                    // Edge blocks repeat the last row/column
+                    int sx = bx + x < width ? bx + x : width - 1;
+                    int sy = by + y < height ? by + y : height - 1;
+                    const uint8_t* p = src + ((size_t)sy * width + sx) * channels;
+                    if (channels == 1) {
+                        blocks[0][y * 8 + x] = p[0] - 128.0f;
+                        continue;
+                    }
+                    float b = p[0], g = p[1], r = p[2];
+                    blocks[0][y * 8 + x] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+                    blocks[1][y * 8 + x] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+                    blocks[2][y * 8 + x] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+                }
+            }
+            for (int c = 0; c < channels; c++) {
+                int table = c == 0 ? 0 : 1;
+                encodeBlock(w, blocks[c], quant[table], dcCodes[table], acCodes[table], pred[c]);
+            }
+        }
+    }
+    w.padBits();
+    w.be16(0xFFD9);
+    w.flush();
+    return w.ok;
+}
@@ -0,0 +1,193 @@
+#ifndef NATIVE_TEST_PATTERN_H
+#define NATIVE_TEST_PATTERN_H
+
+#include <stdint.h>
+
+// 160x120 baseline JPEG (4:2:2, quality 75, standard Huffman tables) used
+// when NATIVE_CAMERA_DIR is not set. Regenerate with Pillow:
+//   gradient R = x, G = y, B = 128; light square (20,20)-(60,60);
+//   dark ellipse (90,40)-(140,100); save(quality=75, subsampling=1)
+static const uint8_t TEST_PATTERN_JPEG[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08,
+    0x07, 0x07, 0x07, 0x09, 0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20, 0x24, 0x2E, 0x27, 0x20,
+    0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29, 0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27,
+    0x39, 0x3D, 0x38, 0x32, 0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0xFF, 0xC0,
+    0x00, 0x11, 0x08, 0x00, 0x78, 0x00, 0xA0, 0x03, 0x01, 0x21, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+    0x01, 0xFF, 0xC4, 0x00, 0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00, 0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05,
+    0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23,
+    0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17,
+    0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A,
+    0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7,
+    0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5,
+    0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00, 0x1F, 0x01, 0x00, 0x03,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00,
+    0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13,
+    0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26, 0x27,
+    0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88,
+    0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6,
+    0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE2,
+    0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9,
+    0xFA, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1,
+    0x31, 0x1D, 0x48, 0xB1, 0xD7, 0xDA, 0xB6, 0x61, 0x09, 0x12, 0x08, 0xEA, 0x41, 0x1D, 0x66, 0xD9,
+    0xD9, 0x09, 0x12, 0x08, 0xE9, 0xE2, 0x3A, 0xCD, 0xB3, 0xAE, 0x12, 0x24, 0x58, 0xEA, 0x41, 0x1D,
+    0x43, 0x67, 0x5C, 0x24, 0x48, 0x23, 0xA9, 0x04, 0x75, 0x9B, 0x67, 0x64, 0x24, 0x48, 0x23, 0xA7,
+    0x88, 0xEB, 0x36, 0xCE, 0xB8, 0x48, 0x90, 0x47, 0x52, 0x2C, 0x75, 0x9B, 0x67, 0x64, 0x24, 0x48,
+    0x23, 0xA9, 0x04, 0x75, 0x9B, 0x67, 0x5C, 0x24, 0x48, 0x23, 0xA9, 0x04, 0x75, 0x9B, 0x67, 0x64,
+    0x24, 0x3C, 0x47, 0x52, 0x2C, 0x75, 0x0D, 0x9D, 0x70, 0x91, 0xC0, 0x08, 0xEA, 0x41, 0x1D, 0x7B,
+    0xAD, 0x9F, 0x89, 0x42, 0x44, 0x82, 0x3A, 0x90, 0x47, 0x59, 0xB6, 0x75, 0xC2, 0x44, 0x82, 0x3A,
+    0x90, 0x47, 0x59, 0xB6, 0x76, 0x42, 0x43, 0xD6, 0x3A, 0x90, 0x47, 0x50, 0xD9, 0xD7, 0x09, 0x12,
+    0x08, 0xEA, 0x41, 0x1D, 0x66, 0xD9, 0xD7, 0x09, 0x12, 0x08, 0xEA, 0x41, 0x1D, 0x66, 0xD9, 0xD9,
+    0x09, 0x0F, 0x58, 0xEA, 0x41, 0x1D, 0x66, 0xD9, 0xD7, 0x09, 0x12, 0x08, 0xEA, 0x41, 0x1D, 0x66,
+    0xD9, 0xD9, 0x09, 0x12, 0x08, 0xEA, 0x41, 0x1D, 0x66, 0xD9, 0xD7, 0x09, 0x0F, 0x58, 0xEA, 0x45,
+    0x8E, 0xB3, 0x6C, 0xEC, 0x84, 0x8E, 0x00, 0x47, 0x52, 0x08, 0xEB, 0xDE, 0x6C, 0xFC, 0x4A, 0x12,
+    0x3B, 0x3F, 0x02, 0xF8, 0x0B, 0xFE, 0x13, 0x3F, 0xB7, 0xFF, 0x00, 0xC4, 0xC7, 0xEC, 0x7F, 0x64,
+    0xF2, 0xFF, 0x00, 0xE5, 0x87, 0x99, 0xBF, 0x7E, 0xEF, 0xF6, 0x86, 0x31, 0xB7, 0xF5, 0xAE, 0xC8,
+    0x7C, 0x0B, 0x03, 0xFE, 0x66, 0x2F, 0xFC, 0x92, 0xFF, 0x00, 0xED, 0x95, 0xE6, 0xD7, 0xC7, 0x7B,
+    0x39, 0xB8, 0x72, 0xDE, 0xDE, 0x67, 0x75, 0x35, 0x75, 0x71, 0xC3, 0xE0, 0x70, 0x1F, 0xF3, 0x30,
+    0xFF, 0x00, 0xE4, 0x97, 0xFF, 0x00, 0x6C, 0xA7, 0x0F, 0x82, 0x00, 0x7F, 0xCC, 0xC3, 0xFF, 0x00,
+    0x92, 0x5F, 0xFD, 0xB2, 0xB0, 0x79, 0x8F, 0xF7, 0x7F, 0x1F, 0xF8, 0x06, 0xF1, 0x95, 0x85, 0x1F,
+    0x04, 0x80, 0xFF, 0x00, 0x99, 0x83, 0xFF, 0x00, 0x24, 0xBF, 0xFB, 0x65, 0x61, 0x78, 0xBB, 0xE1,
+    0xDF, 0xFC, 0x22, 0x9A, 0x4C, 0x57, 0xDF, 0xDA, 0x9F, 0x6A, 0xF3, 0x27, 0x10, 0xEC, 0xFB, 0x3E,
+    0xCC, 0x65, 0x58, 0xE7, 0x3B, 0x8F, 0xF7, 0x7F, 0x5A, 0x70, 0xC6, 0xF3, 0xC9, 0x47, 0x94, 0xE8,
+    0xA7, 0x5B, 0x54, 0xAC, 0x71, 0xA2, 0x3A, 0x90, 0x47, 0x5D, 0x2D, 0x9E, 0x84, 0x24, 0x48, 0x23,
+    0xA9, 0x04, 0x75, 0x9B, 0x67, 0x64, 0x24, 0x3C, 0x47, 0x52, 0x08, 0xEB, 0x36, 0xCE, 0xB8, 0x48,
+    0x91, 0x63, 0xA9, 0x04, 0x75, 0x9B, 0x67, 0x5C, 0x24, 0x48, 0x23, 0xA9, 0x04, 0x75, 0x9B, 0x67,
+    0x64, 0x24, 0x3C, 0x47, 0x52, 0x08, 0xEB, 0x36, 0xCE, 0xB8, 0x48, 0xE0, 0x04, 0x75, 0x22, 0xC7,
+    0x5E, 0xF3, 0x91, 0xF8, 0x94, 0x24, 0x7A, 0xFF, 0x00, 0xC1, 0x05, 0xDB, 0xFD, 0xBB, 0xFF, 0x00,
+    0x6E, 0xFF, 0x00, 0xFB, 0x52, 0xBD, 0x6E, 0xBC, 0x2C, 0x5F, 0xF1, 0xA5, 0xFD, 0x74, 0x3D, 0x5A,
+    0x3A, 0xC1, 0x05, 0x15, 0xCC, 0x6A, 0x15, 0xC1, 0x7C, 0x5A, 0x1B, 0xBC, 0x2B, 0x6A, 0x3F, 0xE9,
+    0xF9, 0x3F, 0xF4, 0x07, 0xAD, 0x68, 0xFF, 0x00, 0x11, 0x15, 0x0F, 0x89, 0x1E, 0x3A, 0x23, 0xA9,
+    0x04, 0x75, 0xE9, 0x39, 0x1E, 0x94, 0x24, 0x48, 0x23, 0xA9, 0x04, 0x75, 0x9B, 0x67, 0x5C, 0x24,
+    0x3C, 0x47, 0x52, 0x08, 0xEB, 0x36, 0xCE, 0xC8, 0x48, 0x90, 0x47, 0x52, 0x08, 0xEB, 0x37, 0x23,
+    0xAE, 0x12, 0x24, 0x11, 0xD4, 0x82, 0x3A, 0xCD, 0xB3, 0xAE, 0x12, 0x1E, 0x23, 0xA9, 0x16, 0x3A,
+    0xCD, 0xB3, 0xB2, 0x12, 0x38, 0x11, 0x1D, 0x3D, 0x63, 0xAF, 0x79, 0xB3, 0xF1, 0x28, 0x48, 0xF5,
+    0xAF, 0x82, 0xCB, 0xB7, 0xFB, 0x6F, 0xFE, 0xD8, 0x7F, 0xED, 0x4A, 0xF5, 0x6A, 0xF1, 0xB1, 0x5F,
+    0xC5, 0x7F, 0xD7, 0x43, 0xDA, 0xC3, 0xFF, 0x00, 0x0D, 0x05, 0x15, 0xCE, 0x6C, 0x15, 0xC3, 0x7C,
+    0x54, 0x1B, 0xBC, 0x31, 0x6C, 0x3F, 0xE9, 0xF5, 0x7F, 0xF4, 0x07, 0xAD, 0x29, 0x7C, 0x68, 0x71,
+    0xDC, 0xF2, 0x31, 0x1D, 0x48, 0x23, 0xAE, 0xD6, 0xCE, 0xC8, 0x48, 0x90, 0x47, 0x52, 0x08, 0xEA,
+    0x1B, 0x3B, 0x21, 0x22, 0x41, 0x1D, 0x3D, 0x63, 0xAC, 0xDB, 0x3A, 0xE1, 0x22, 0x41, 0x1D, 0x48,
+    0x23, 0xAC, 0xDB, 0x3B, 0x21, 0x22, 0x41, 0x1D, 0x48, 0x23, 0xAC, 0xDB, 0x3A, 0xE1, 0x22, 0x41,
+    0x1D, 0x3D, 0x63, 0xAC, 0xDB, 0x3A, 0xE1, 0x23, 0x81, 0x11, 0xD3, 0xC4, 0x75, 0xEF, 0x36, 0x7E,
+    0x25, 0x09, 0x1E, 0xAB, 0xF0, 0x75, 0x76, 0xFF, 0x00, 0x6D, 0x7F, 0xDB, 0x0F, 0xFD, 0xA9, 0x5E,
+    0xA3, 0x5E, 0x4E, 0x23, 0xF8, 0x8C, 0xF7, 0xF0, 0xBF, 0xC1, 0x5F, 0xD7, 0x50, 0xA2, 0xB1, 0x3A,
+    0x02, 0xB8, 0xAF, 0x89, 0xE3, 0x77, 0x86, 0xAD, 0x87, 0xFD, 0x3E, 0x2F, 0xFE, 0x80, 0xF5, 0x74,
+    0xFE, 0x24, 0x07, 0x94, 0x88, 0xEA, 0x41, 0x1D, 0x74, 0xB6, 0x6F, 0x09, 0x12, 0x08, 0xEA, 0x41,
+    0x1D, 0x43, 0x67, 0x5C, 0x24, 0x66, 0xEB, 0x3A, 0xDD, 0xBE, 0x8B, 0x12, 0xEE, 0x5F, 0x36, 0x77,
+    0xE5, 0x62, 0x0D, 0x83, 0x8F, 0x52, 0x7B, 0x0F, 0xE7, 0xF9, 0xE3, 0x88, 0xBF, 0xF1, 0x06, 0xA3,
+    0xA8, 0x12, 0x24, 0x9C, 0xC7, 0x19, 0x04, 0x79, 0x51, 0x12, 0xAB, 0x82, 0x30, 0x41, 0xEE, 0x7F,
+    0x1C, 0xD6, 0x32, 0x97, 0x43, 0x3C, 0x46, 0x22, 0x5F, 0x04, 0x4C, 0xBA, 0xDC, 0xD3, 0x7C, 0x57,
+    0xA9, 0xE9, 0xF2, 0x7C, 0xF2, 0x9B, 0xA8, 0x89, 0xCB, 0x24, 0xC4, 0x93, 0xDB, 0xA3, 0x75, 0x1D,
+    0x3D, 0xC7, 0x3D, 0x2A, 0x0E, 0x7A, 0x15, 0xE7, 0x46, 0x5C, 0xD1, 0x3D, 0x0B, 0x44, 0xD5, 0xAD,
+    0xB5, 0xBB, 0x21, 0x3C, 0x07, 0x6C, 0x8B, 0x81, 0x2C, 0x44, 0xF2, 0x87, 0xFA, 0x8F, 0x43, 0xDF,
+    0xF3, 0x15, 0xAC, 0x23, 0xA8, 0x6C, 0xFA, 0xBC, 0x3D, 0x65, 0x52, 0x0A, 0x6B, 0xA9, 0x22, 0xC7,
+    0x4F, 0x58, 0xEB, 0x36, 0xCE, 0xF8, 0x48, 0xE0, 0x44, 0x74, 0xF1, 0x1D, 0x7B, 0xCD, 0x9F, 0x89,
+    0x42, 0x47, 0xA8, 0x7C, 0x23, 0x5D, 0xBF, 0xDB, 0x1F, 0xF6, 0xC7, 0xFF, 0x00, 0x6A, 0x57, 0xA6,
+    0x57, 0x9B, 0x5F, 0xF8, 0x8C, 0xFA, 0x4C, 0x1F, 0xF0, 0x23, 0xFD, 0x75, 0x0A, 0x2B, 0x23, 0xA4,
+    0x2B, 0x8E, 0xF8, 0x92, 0x37, 0x78, 0x76, 0xDF, 0xFE, 0xBE, 0xD7, 0xFF, 0x00, 0x40, 0x7A, 0xA8,
+    0xEE, 0x27, 0xB1, 0xE5, 0xE2, 0x3A, 0x90, 0x47, 0x5A, 0xB6, 0x54, 0x24, 0x48, 0x23, 0xAA, 0xBA,
+    0xAD, 0xFC, 0x5A, 0x4E, 0x9D, 0x25, 0xDC, 0xA3, 0x76, 0xDC, 0x05, 0x4C, 0x80, 0x5D, 0x8F, 0x40,
+    0x3F, 0x9F, 0xD0, 0x1A, 0xCD, 0xB3, 0xAA, 0x33, 0xB2, 0xB9, 0xE5, 0x77, 0x17, 0x13, 0x5D, 0xDC,
+    0x3C, 0xF3, 0xC8, 0x64, 0x95, 0xCE, 0x59, 0x8F, 0x7A, 0x8A, 0xA0, 0xE4, 0x6E, 0xFA, 0x85, 0x14,
+    0x01, 0x77, 0x49, 0xD4, 0xE7, 0xD2, 0x35, 0x18, 0xAF, 0x20, 0x66, 0xF9, 0x08, 0xDE, 0x80, 0xE3,
+    0x7A, 0xE7, 0x95, 0x3F, 0x5F, 0xD3, 0xAF, 0x6A, 0xF6, 0x9D, 0x3E, 0xE6, 0x1D, 0x46, 0xC6, 0x0B,
+    0xCB, 0x73, 0x98, 0xA6, 0x40, 0xCB, 0xC8, 0xC8, 0xF6, 0x38, 0xEE, 0x3A, 0x1F, 0x71, 0x59, 0x54,
+    0xD3, 0x53, 0xDA, 0xCA, 0xAA, 0xEF, 0x4D, 0xFA, 0x97, 0x16, 0x3A, 0x91, 0x63, 0xAC, 0x1B, 0x3E,
+    0x82, 0x12, 0x38, 0x01, 0x1D, 0x48, 0x23, 0xAF, 0x79, 0xB3, 0xF1, 0x28, 0x48, 0xEC, 0x3C, 0x11,
+    0xE2, 0x4B, 0x2F, 0x0D, 0xFD, 0xBB, 0xED, 0x71, 0x5C, 0x3F, 0xDA, 0x3C, 0xBD, 0xBE, 0x4A, 0xA9,
+    0xC6, 0xDD, 0xD9, 0xCE, 0x48, 0xFE, 0xF0, 0xAE, 0xB8, 0x7C, 0x4B, 0xD1, 0x8F, 0xFC, 0xBA, 0xDF,
+    0xFF, 0x00, 0xDF, 0xB4, 0xFF, 0x00, 0xE2, 0xEB, 0x92, 0xA4, 0x1B, 0x95, 0xCF, 0x73, 0x0B, 0x8D,
+    0xA7, 0x4E, 0x92, 0x83, 0x4E, 0xE8, 0x70, 0xF8, 0x93, 0xA3, 0x9F, 0xF9, 0x75, 0xBF, 0xFF, 0x00,
+    0xBF, 0x69, 0xFF, 0x00, 0xC5, 0x52, 0x8F, 0x88, 0xFA, 0x41, 0xFF, 0x00, 0x97, 0x6B, 0xEF, 0xFB,
+    0xF6, 0x9F, 0xFC, 0x55, 0x67, 0xC8, 0xCE, 0xC5, 0x8D, 0xA6, 0xFA, 0x31, 0xC3, 0xE2, 0x2E, 0x90,
+    0x7F, 0xE5, 0xDA, 0xFB, 0xFE, 0xF8, 0x4F, 0xFE, 0x2A, 0xB0, 0xFC, 0x55, 0xE2, 0x8B, 0x1D, 0x7B,
+    0x4B, 0x8A, 0xD6, 0xDA, 0x1B, 0x94, 0x74, 0x98, 0x48, 0x4C, 0xAA, 0xA0, 0x60, 0x2B, 0x0E, 0xC4,
+    0xFA, 0xD2, 0xB5, 0x99, 0x5E, 0xDE, 0x32, 0x56, 0x47, 0x24, 0xB1, 0xD4, 0x82, 0x3A, 0x1B, 0x2E,
+    0x12, 0x24, 0x58, 0xEB, 0x84, 0xF8, 0x81, 0x74, 0xDF, 0x6B, 0xB4, 0xB2, 0x01, 0x82, 0x2C, 0x66,
+    0x53, 0xF3, 0x70, 0xC4, 0x92, 0x07, 0x1E, 0xDB, 0x4F, 0x3F, 0xED, 0x1A, 0x8B, 0x9D, 0x3C, 0xDE,
+    0xE9, 0xC6, 0xD1, 0x4C, 0x80, 0xA2, 0x80, 0x0A, 0xF4, 0xFF, 0x00, 0x86, 0x37, 0x8F, 0x3E, 0x99,
+    0x79, 0x64, 0xC1, 0x88, 0xB7, 0x91, 0x5D, 0x58, 0xB6, 0x70, 0x1C, 0x1F, 0x94, 0x0E, 0xDC, 0xA9,
+    0x3F, 0xF0, 0x23, 0x59, 0xD5, 0xF8, 0x4E, 0xDC, 0xBE, 0x5C, 0xB5, 0xD7, 0x99, 0xDE, 0x88, 0xEA,
+    0x45, 0x8E, 0xB8, 0x9B, 0x3E, 0x9A, 0x12, 0x38, 0x01, 0x1D, 0x48, 0xB1, 0xD7, 0xBC, 0xD9, 0xF8,
+    0x94, 0x24, 0x3C, 0x47, 0x52, 0x08, 0xEB, 0x36, 0xCE, 0xC8, 0x48, 0x90, 0x47, 0x52, 0x08, 0xEB,
+    0x36, 0xCE, 0xB8, 0x48, 0x90, 0x47, 0x52, 0x2C, 0x75, 0x9B, 0x67, 0x5C, 0x24, 0x3C, 0x47, 0x52,
+    0x08, 0xEB, 0x36, 0xCE, 0xC8, 0x48, 0x90, 0x47, 0x5E, 0x51, 0xE3, 0x66, 0x73, 0xE2, 0xBB, 0xB5,
+    0x66, 0x62, 0x10, 0x22, 0xA8, 0x27, 0x3B, 0x46, 0xC0, 0x70, 0x3D, 0x39, 0x24, 0xFE, 0x34, 0xA2,
+    0xEE, 0xCE, 0xA8, 0xBB, 0xA3, 0x9F, 0xA2, 0xB4, 0x28, 0x28, 0xA0, 0x02, 0xBB, 0x9F, 0x85, 0x8E,
+    0xFF, 0x00, 0xF0, 0x91, 0x5D, 0xC4, 0x1D, 0x84, 0x6D, 0x68, 0x59, 0x93, 0x3C, 0x12, 0x1D, 0x70,
+    0x48, 0xF5, 0x19, 0x3F, 0x99, 0xAC, 0xEA, 0xFC, 0x0C, 0xDF, 0x0A, 0xED, 0x5A, 0x27, 0xAE, 0xAC,
+    0x75, 0x22, 0xC7, 0x5E, 0x6B, 0x67, 0xD3, 0x42, 0x47, 0x00, 0x23, 0xA9, 0x16, 0x3A, 0xF7, 0x9B,
+    0x3F, 0x12, 0x84, 0x87, 0x88, 0xEA, 0x41, 0x1D, 0x66, 0xD9, 0xD7, 0x09, 0x12, 0x08, 0xEA, 0x41,
+    0x1D, 0x66, 0xD9, 0xD9, 0x09, 0x12, 0x2C, 0x75, 0x22, 0xC7, 0x59, 0xB6, 0x75, 0xC2, 0x44, 0x82,
+    0x3A, 0x78, 0x8E, 0xB3, 0x6C, 0xEB, 0x84, 0x89, 0x04, 0x75, 0xE4, 0xFF, 0x00, 0x10, 0x6D, 0x3E,
+    0xCD, 0xE2, 0x97, 0x93, 0x7E, 0xEF, 0xB4, 0x42, 0x92, 0xE3, 0x18, 0xDB, 0x8F, 0x93, 0x1E, 0xFF,
+    0x00, 0x73, 0x3F, 0x8D, 0x3A, 0x6F, 0xDE, 0x3B, 0x69, 0xB3, 0x96, 0xA2, 0xB7, 0x36, 0x0A, 0x28,
+    0x00, 0xAF, 0x45, 0xF8, 0x49, 0x65, 0xE6, 0xEA, 0x9A, 0x8D, 0xEE, 0xFC, 0x79, 0x30, 0xAC, 0x5B,
+    0x31, 0xD7, 0x7B, 0x67, 0x39, 0xF6, 0xF2, 0xFF, 0x00, 0x5F, 0x6A, 0xCA, 0xBB, 0xB5, 0x36, 0x6F,
+    0x86, 0xFE, 0x2A, 0x3D, 0x6D, 0x63, 0xA9, 0x16, 0x3A, 0xF2, 0x5B, 0x3E, 0x82, 0x12, 0x38, 0x05,
+    0x8E, 0xA4, 0x11, 0xD7, 0xBC, 0xD9, 0xF8, 0x8C, 0x24, 0x48, 0x23, 0xA7, 0x88, 0xEB, 0x37, 0x23,
+    0xB2, 0x12, 0x24, 0x11, 0xD4, 0x82, 0x3A, 0xCD, 0xB3, 0xAE, 0x12, 0x24, 0x58, 0xEA, 0x41, 0x1D,
+    0x66, 0xD9, 0xD9, 0x09, 0x12, 0x08, 0xE9, 0xE2, 0x3A, 0xCD, 0xC8, 0xEB, 0x84, 0x89, 0x04, 0x75,
+    0xC3, 0xFC, 0x4D, 0xD1, 0x9A, 0x6D, 0x32, 0xDF, 0x55, 0x89, 0x57, 0x36, 0xAD, 0xB2, 0x53, 0xB4,
+    0x64, 0xA3, 0x11, 0x83, 0x9E, 0xB8, 0x0D, 0xC6, 0x39, 0xFB, 0xE4, 0xFA, 0xD1, 0x4E, 0x56, 0x9A,
+    0x3B, 0x68, 0xCB, 0x53, 0xCB, 0x28, 0xAE, 0xD3, 0xB0, 0x28, 0xA0, 0x02, 0xBD, 0xDB, 0xE1, 0xA6,
+    0x84, 0xDA, 0x5F, 0x85, 0x63, 0xB8, 0x99, 0x54, 0x4F, 0x7C, 0xDF, 0x68, 0x24, 0x28, 0xC8, 0x42,
+    0x06, 0xC0, 0x48, 0x3C, 0x8C, 0x7C, 0xDE, 0xDB, 0xC8, 0xC7, 0x5A, 0xE5, 0xC6, 0x4A, 0xD4, 0xED,
+    0xDC, 0xE8, 0xC2, 0xAF, 0x7E, 0xE7, 0x68, 0xB1, 0xD4, 0x82, 0x3A, 0xF2, 0x5B, 0x3D, 0x88, 0x48,
+    0xE0, 0x04, 0x75, 0x20, 0x8E, 0xBD, 0xE6, 0xCF, 0xC4, 0xA1, 0x22, 0x45, 0x8E, 0x9E, 0x23, 0xAC,
+    0xDB, 0x3A, 0xE1, 0x22, 0x41, 0x1D, 0x48, 0x23, 0xAC, 0xDB, 0x3B, 0x21, 0x22, 0x45, 0x8E, 0xA4,
+    0x11, 0xD6, 0x6D, 0x9D, 0x70, 0x91, 0x20, 0x8E, 0x9E, 0x23, 0xAC, 0xDB, 0x3B, 0x21, 0x22, 0x41,
+    0x1D, 0x39, 0xED, 0xE3, 0x9A, 0x27, 0x8A, 0x54, 0x57, 0x8D, 0xD4, 0xAB, 0x23, 0x0C, 0x86, 0x07,
+    0xA8, 0x23, 0xB8, 0xAC, 0xDC, 0x8E, 0xB8, 0x48, 0xF0, 0xDF, 0x17, 0xF8, 0x3E, 0xE7, 0xC3, 0x17,
+    0x81, 0x86, 0xE9, 0xB4, 0xF9, 0x5B, 0x10, 0xCE, 0x47, 0x20, 0xFF, 0x00, 0x71, 0xBD, 0x1B, 0xF9,
+    0x8E, 0x47, 0x70, 0x39, 0xAA, 0xF4, 0xE9, 0xCD, 0x4E, 0x2A, 0x48, 0xF4, 0xA3, 0x2E, 0x65, 0x70,
+    0xA2, 0xAC, 0xA3, 0xBC, 0xF8, 0x7B, 0xE0, 0x59, 0xB5, 0xDB, 0xB8, 0xB5, 0x5B, 0xE4, 0xD9, 0xA5,
+    0xC3, 0x20, 0x65, 0x0C, 0xA0, 0xFD, 0xA5, 0x94, 0xFD, 0xD0, 0x0F, 0x1B, 0x32, 0x39, 0x3D, 0xFA,
+    0x0E, 0xE4, 0x7B, 0xA2, 0xC7, 0x5E, 0x46, 0x32, 0xAF, 0x34, 0xF9, 0x57, 0x43, 0xAE, 0x86, 0x88,
+    0x90, 0x47, 0x52, 0x2C, 0x75, 0xC2, 0xD9, 0xDF, 0x09, 0x1C, 0x00, 0x8E, 0xA4, 0x11, 0xD7, 0xBA,
+    0xD9, 0xF8, 0x94, 0x24, 0x48, 0x23, 0xA9, 0x04, 0x75, 0x0D, 0x9D, 0x70, 0x90, 0xF1, 0x1D, 0x48,
+    0x23, 0xAC, 0xDB, 0x3A, 0xE1, 0x22, 0x45, 0x8E, 0xA4, 0x11, 0xD6, 0x6D, 0x9D, 0x90, 0x91, 0x22,
+    0xC7, 0x52, 0x08, 0xEB, 0x36, 0xCE, 0xB8, 0x48, 0x7A, 0xC7, 0x52, 0x08, 0xEB, 0x36, 0xCE, 0xC8,
+    0x48, 0x49, 0xEC, 0xAD, 0xEF, 0x2D, 0xDA, 0x0B, 0xA8, 0x22, 0x9E, 0x17, 0xC6, 0xE8, 0xE5, 0x40,
+    0xCA, 0x70, 0x72, 0x32, 0x0F, 0x1D, 0x6B, 0x81, 0xD6, 0xBE, 0x10, 0x58, 0xDD, 0x33, 0x4B, 0xA3,
+    0xDD, 0xB5, 0x93, 0x6D, 0x38, 0x82, 0x50, 0x64, 0x8C, 0x9C, 0x0C, 0x00, 0xD9, 0xDC, 0xA3, 0x39,
+    0xC9, 0x3B, 0xBA, 0xF0, 0x38, 0xC5, 0x5D, 0x2C, 0x43, 0xA4, 0xFC, 0x8E, 0xDA, 0x55, 0x2C, 0x73,
+    0xC3, 0xE0, 0xE7, 0x88, 0x8F, 0xFC, 0xBE, 0x69, 0x9F, 0xF7, 0xF6, 0x4F, 0xFE, 0x22, 0xBB, 0x1D,
+    0x03, 0xE1, 0x1E, 0x8F, 0xA6, 0x4C, 0x27, 0xD4, 0x66, 0x7D, 0x4E, 0x55, 0x6C, 0xA2, 0xBA, 0x79,
+    0x71, 0x0E, 0x84, 0x65, 0x41, 0x3B, 0x8F, 0x07, 0xA9, 0xC1, 0x07, 0xA5, 0x6D, 0x5B, 0x1C, 0x9C,
+    0x6D, 0x04, 0x75, 0xA9, 0xA6, 0x7A, 0x04, 0x16, 0xD1, 0xC1, 0x0A, 0x43, 0x0C, 0x6B, 0x1C, 0x51,
+    0xA8, 0x54, 0x44, 0x18, 0x55, 0x03, 0x80, 0x00, 0x1D, 0x05, 0x4C, 0x23, 0xAF, 0x2D, 0xC8, 0xEA,
+    0x84, 0x89, 0x04, 0x75, 0x22, 0xC7, 0x59, 0xB6, 0x75, 0xC2, 0x47, 0x00, 0x23, 0xA9, 0x16, 0x3A,
+    0xF7, 0x5B, 0x3F, 0x12, 0x84, 0x89, 0x04, 0x75, 0x20, 0x8E, 0xA1, 0xB3, 0xB2, 0x12, 0x1E, 0x23,
+    0xA9, 0x04, 0x75, 0x9B, 0x67, 0x5C, 0x24, 0x48, 0xB1, 0xD4, 0x8B, 0x1D, 0x66, 0xD9, 0xD9, 0x09,
+    0x12, 0x08, 0xEA, 0x41, 0x1D, 0x66, 0xD9, 0xD7, 0x09, 0x0F, 0x11, 0xD4, 0x82, 0x3A, 0xCD, 0xB3,
+    0xAE, 0x12, 0x24, 0x58, 0xEA, 0x45, 0x8E, 0xB3, 0x6C, 0xEC, 0x84, 0x89, 0x04, 0x75, 0x20, 0x8E,
+    0xA1, 0xB3, 0xAE, 0x12, 0x1E, 0x23, 0xA9, 0x04, 0x75, 0x9B, 0x67, 0x64, 0x24, 0x48, 0x23, 0xA9,
+    0x16, 0x3A, 0xCD, 0xB3, 0xAE, 0x12, 0x38, 0x01, 0x1D, 0x48, 0x23, 0xAF, 0x75, 0xB3, 0xF1, 0x28,
+    0x48, 0x90, 0x47, 0x52, 0x08, 0xEA, 0x1B, 0x3A, 0xE1, 0x22, 0x41, 0x1D, 0x3C, 0x47, 0x59, 0xB6,
+    0x76, 0x42, 0x44, 0x8B, 0x1D, 0x48, 0xB1, 0xD6, 0x6D, 0x9D, 0x70, 0x91, 0x20, 0x8E, 0xA4, 0x11,
+    0xD6, 0x6D, 0x9D, 0x70, 0x91, 0x20, 0x8E, 0x9E, 0x23, 0xAC, 0xDB, 0x3B, 0x21, 0x22, 0x45, 0x8E,
+    0xA4, 0x11, 0xD6, 0x6D, 0x9D, 0x70, 0x91, 0x20, 0x8E, 0xA4, 0x11, 0xD6, 0x6D, 0x9D, 0x90, 0x91,
+    0x20, 0x8E, 0x9E, 0x23, 0xA8, 0x6C, 0xEB, 0x84, 0x89, 0x16, 0x3A, 0x91, 0x63, 0xAC, 0xDB, 0x3B,
+    0x21, 0x23, 0xFF, 0xD9,
+};
+
+#endif // NATIVE_TEST_PATTERN_H
@@ -0,0 +1,147 @@
+// Host benchmark for the JpegDc DC-only decoder (exposure gating, warm-up).
+//
+// Decodes each JPEG repeatedly with luma map and histogram output and prints
+// the time per frame and the luminance classification inputs, plus the best
+// time of the 1/8-scale color decode used for thumbnails (dcimg_ms) and of
+// the burst scoring pass with AC energy (score_ms, ac_rms). Each frame is
+// also decoded with an overfull Huffman table, which must be refused (exit
+// code 2 otherwise). Built standalone against the NativeHal headers, no
+// firmware or PlatformIO needed:
+//
+//   g++ -O2 -std=gnu++17 -Inative/NativeHal/include -Ilib/JpegDc \
+//       native/bench/jpeg_dc_bench.cpp lib/JpegDc/JpegDc.cpp -o .native/jpeg_dc_bench
+//   .native/jpeg_dc_bench frames/*.jpg
+//
+// The ESP32-S3 (240 MHz, frame in PSRAM) runs this roughly 15-25x slower
+// than a desktop core.
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "JpegDc.h"
+
+// NativeHal's Arduino.cpp is not linked into the benchmark
+void* ps_malloc(size_t size) {
+    return malloc(size);
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    data.resize((size_t)ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+// Move all codes of the first DHT table to length 2, more than fit in two
+// bits: the decoder must refuse the frame rather than build the table
+static bool rejectsMalformedDht(std::vector<uint8_t> jpeg) {
+    for (size_t pos = 2; pos + 21 < jpeg.size(); pos++) {
+        if (jpeg[pos] == 0xFF && jpeg[pos + 1] == 0xC4) {
+            uint8_t* counts = &jpeg[pos + 5];
+            int total = 0;
+            for (int i = 0; i < 16; i++) {
+                total += counts[i];
+                counts[i] = 0;
+            }
+            counts[1] = (uint8_t)(total < 255 ? total : 255);
+            jpeg_dc_stats_t stats;
+            uint32_t histogram[JPEG_DC_HISTOGRAM_BINS];
+            return !JpegDc::analyze(jpeg.data(), jpeg.size(), stats, nullptr, 0, histogram);
+        }
+    }
+    return true;  // No DHT to corrupt
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s [-n iterations] frame.jpg...\n", argv[0]);
+        return 1;
+    }
+
+    int iterations = 50;
+    int first = 1;
+    if (argc > 3 && strcmp(argv[1], "-n") == 0) {
+        iterations = atoi(argv[2]);
+        first = 3;
+    }
+
+    bool malformedAccepted = false;
+    printf("%-28s %9s %9s %7s %7s %7s %8s %8s %9s %9s %7s\n",
+           "frame", "bytes", "size", "meanY", "<=24", ">=245", "avg_ms", "min_ms", "dcimg_ms", "score_ms", "ac_rms");
+    for (int i = first; i < argc; i++) {
+        std::vector<uint8_t> jpeg;
+        if (!readFile(argv[i], jpeg)) {
+            fprintf(stderr, "%s: not readable\n", argv[i]);
+            continue;
+        }
+
+        jpeg_dc_stats_t stats;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        JpegDc::dimensions(jpeg.data(), jpeg.size(), width, height);
+        std::vector<uint8_t> luma(((width + 15) / 16 * 2) * ((height + 15) / 16 * 2));
+        uint32_t histogram[JPEG_DC_HISTOGRAM_BINS];
+
+        double total = 0;
+        double best = 1e9;
+        bool ok = true;
+        for (int n = 0; n < iterations && ok; n++) {
+            auto start = std::chrono::steady_clock::now();
+            ok = JpegDc::analyze(jpeg.data(), jpeg.size(), stats, luma.data(), luma.size(), histogram);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            total += ms;
+            best = ms < best ? ms : best;
+        }
+        if (!ok) {
+            printf("%-28s decode failed\n", argv[i]);
+            continue;
+        }
+
+        std::vector<uint8_t> bgr((size_t)((width + 7) / 8) * ((height + 7) / 8) * 3);
+        double bestImage = 1e9;
+        for (int n = 0; n < iterations && ok; n++) {
+            uint16_t outWidth = 0;
+            uint16_t outHeight = 0;
+            auto start = std::chrono::steady_clock::now();
+            ok = JpegDc::dcImage(jpeg.data(), jpeg.size(), bgr.data(), bgr.size(), outWidth, outHeight);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            bestImage = ms < bestImage ? ms : bestImage;
+        }
+
+        // Burst scoring: histogram plus AC energy, no luma map
+        jpeg_dc_stats_t scored;
+        uint32_t scoreHistogram[JPEG_DC_HISTOGRAM_BINS];
+        double bestScore = 1e9;
+        for (int n = 0; n < iterations && ok; n++) {
+            auto start = std::chrono::steady_clock::now();
+            ok = JpegDc::analyze(jpeg.data(), jpeg.size(), scored, nullptr, 0, scoreHistogram, true);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            bestScore = ms < bestScore ? ms : bestScore;
+        }
+
+        uint32_t blocks = (uint32_t)stats.blocksX * stats.blocksY;
+        uint32_t dark = 0;
+        uint32_t bright = 0;
+        for (int level = 0; level < JPEG_DC_HISTOGRAM_BINS; level++) {
+            dark += level <= 24 ? histogram[level] : 0;
+            bright += level >= 245 ? histogram[level] : 0;
+        }
+        char size[16];
+        snprintf(size, sizeof(size), "%ux%u", stats.width, stats.height);
+        printf("%-28s %9zu %9s %7.1f %6.1f%% %6.1f%% %8.2f %8.2f %9.2f %9.2f %7.1f\n", argv[i], jpeg.size(), size,
+               stats.meanY, 100.0 * dark / blocks, 100.0 * bright / blocks, total / iterations, best, bestImage,
+               bestScore, sqrt(scored.acEnergy));
+
+        if (!rejectsMalformedDht(jpeg)) {
+            printf("%-28s malformed DHT accepted\n", argv[i]);
+            malformedAccepted = true;
+        }
+    }
+    return malformedAccepted ? 2 : 0;
+}
@@ -0,0 +1,138 @@
+// Host benchmark for the upload response handling (UploadResponseParser).
+//
+// Compares the heap allocations and time per response of the old path
+// (http.getString() into a String, then parsed twice into a
+// DynamicJsonDocument(2048), by isOtaAvailable() and parseOtaInfo()) with the
+// filtered single parse from the stream. Allocations are counted by wrapping
+// glibc's malloc/calloc/realloc. Built standalone against the NativeHal
+// headers and ArduinoJson, no firmware or PlatformIO needed:
+//
+//   g++ -O2 -std=gnu++17 -DNATIVE_BUILD -DNATIVE_NO_ARDUINO_MAIN -pthread \
+//       -DARDUINOJSON_ENABLE_ARDUINO_STRING=1 -DARDUINOJSON_ENABLE_ARDUINO_STREAM=1 \
+//       -Inative/NativeHal/include -Ilib/UploadResponse -Ilib/OTAManager \
+//       -I.pio/libdeps/native/ArduinoJson/src \
+//       native/bench/upload_response_bench.cpp lib/UploadResponse/UploadResponse.cpp \
+//       native/NativeHal/src/*.cpp -o .native/upload_response_bench
+//   .native/upload_response_bench
+//
+// The ESP32 heap allocator is slower than glibc's and fragments the internal
+// heap, so the allocation count matters more than the host time.
+
+#include <chrono>
+#include "UploadResponse.h"
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+
+static size_t allocations = 0;
+
+extern "C" void* malloc(size_t size) {
+    allocations++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    allocations++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) {
+    allocations++;
+    return __libc_realloc(ptr, size);
+}
+
+// upload.php answers, without and with an OTA offer
+static const char* const NO_UPDATE =
+    "{\"success\":true,\"device_id\":\"AA:BB:CC:DD:EE:FF\",\"timestamp\":\"2026-10-16 07:00:02\","
+    "\"size\":412345,\"filename\":\"2026-10-16_07_00_02.jpg\",\"thumbnail\":\"2026-10-16_07_00_02_thumb.jpg\","
+    "\"server_time\":1792134003,\"ota\":{\"available\":false}}";
+static const char* const UPDATE =
+    "{\"success\":true,\"device_id\":\"AA:BB:CC:DD:EE:FF\",\"timestamp\":\"2026-10-16 07:00:02\","
+    "\"size\":412345,\"filename\":\"2026-10-16_07_00_02.jpg\",\"thumbnail\":\"2026-10-16_07_00_02_thumb.jpg\","
+    "\"server_time\":1792134003,\"ota\":{\"available\":true,\"firmware_file\":\"espcam-1.4.0.bin\","
+    "\"firmware_version\":\"1.4.0\",\"download_url\":\"https://cams.example.org/cams/ota-download.php?file=espcam-1.4.0.bin\","
+    "\"size\":1187456,\"sha256\":\"9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08\",\"mandatory\":false}}";
+
+/**
+ * Response body as HTTPClient hands it over: a socket stream
+ */
+class BufferStream : public Stream {
+public:
+    explicit BufferStream(const char* data) : _data(data), _length(strlen(data)), _pos(0) {}
+    int available() override { return (int)(_length - _pos); }
+    int read() override { return _pos < _length ? (uint8_t)_data[_pos++] : -1; }
+    int peek() override { return _pos < _length ? (uint8_t)_data[_pos] : -1; }
+    size_t write(uint8_t) override { return 0; }
+
+private:
+    const char* _data;
+    size_t _length;
+    size_t _pos;
+};
+
+// Old OTAManager::parseOtaInfo(), without the serial output
+static OtaUpdateInfo parseOtaInfo(const String& jsonResponse) {
+    OtaUpdateInfo info;
+    info.available = false;
+    DynamicJsonDocument doc(2048);
+    if (deserializeJson(doc, jsonResponse) || !doc.containsKey("ota")) {
+        return info;
+    }
+    JsonObject ota = doc["ota"];
+    info.available = ota["available"] | false;
+    if (info.available) {
+        info.firmwareFile = ota["firmware_file"] | "";
+        info.firmwareVersion = ota["firmware_version"] | "";
+        info.downloadUrl = ota["download_url"] | "";
+        info.size = ota["size"] | 0;
+        info.sha256 = ota["sha256"] | "";
+        info.mandatory = ota["mandatory"] | false;
+    }
+    return info;
+}
+
+static bool oldPath(const char* body) {
+    BufferStream stream(body);
+    String response;
+    response.reserve(strlen(body));  // HTTPClient::getString() with Content-Length
+    while (stream.available()) {
+        response += (char)stream.read();
+    }
+    if (!parseOtaInfo(response).available) {  // isOtaAvailable()
+        return false;
+    }
+    return parseOtaInfo(response).available;  // handleOtaUpdate()
+}
+
+static bool newPath(const char* body) {
+    BufferStream stream(body);
+    UploadResponse response;
+    return UploadResponseParser::parse(stream, response) && response.ota.available;
+}
+
+static void run(const char* name, const char* body, bool (*path)(const char*), int iterations) {
+    bool available = path(body);  // Warm-up
+
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++) {
+        path(body);
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    size_t count = allocations - before;
+
+    printf("%-22s %-8s %6zu %12.1f %9.2f\n", name, available ? "yes" : "no",
+           strlen(body), (double)count / iterations, us / iterations);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 2 && strcmp(argv[1], "-n") == 0 ? atoi(argv[2]) : 10000;
+
+    printf("%-22s %-8s %6s %12s %9s\n", "path", "ota", "bytes", "allocs/resp", "us/resp");
+    run("getString + 2x parse", NO_UPDATE, oldPath, iterations);
+    run("stream + filter", NO_UPDATE, newPath, iterations);
+    run("getString + 2x parse", UPDATE, oldPath, iterations);
+    run("stream + filter", UPDATE, newPath, iterations);
+    return 0;
+}
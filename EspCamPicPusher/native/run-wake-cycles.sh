@@ -0,0 +1,53 @@
+#!/bin/bash
+# Run the native firmware build through consecutive wake cycles.
+#
+# Each process run is one boot. Deep sleep ends the process with exit code 0
+# and ESP.restart() with exit code 3; both persist RTC memory to
+# $NATIVE_DATA_DIR/rtc.bin so the next run sees the correct wake cause.
+#
+# Usage: native/run-wake-cycles.sh [cycles] [-- wrapper...]
+#   cycles   Number of boots to run (default: 5)
+#   wrapper  Optional command prefix, e.g. "-- valgrind --tool=callgrind"
+#
+# Example:
+#   pio run -e native
+#   NATIVE_CAMERA_DIR=~/frames NATIVE_HOST_OVERRIDE=127.0.0.1:8000 native/run-wake-cycles.sh 10
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+PROJECT_DIR="$(dirname "$SCRIPT_DIR")"
+PROGRAM="${NATIVE_PROGRAM:-$PROJECT_DIR/.pio/build/native/program}"
+
+CYCLES=5
+if [ -n "$1" ] && [ "$1" != "--" ]; then
+    CYCLES="$1"
+    shift
+fi
+if [ "$1" == "--" ]; then
+    shift
+fi
+WRAPPER=("$@")
+
+if [ ! -x "$PROGRAM" ]; then
+    echo "ERROR: $PROGRAM not found - build it with: pio run -e native"
+    exit 1
+fi
+
+export NATIVE_DATA_DIR="${NATIVE_DATA_DIR:-$PROJECT_DIR/.native}"
+mkdir -p "$NATIVE_DATA_DIR"
+
+for ((cycle = 1; cycle <= CYCLES; cycle++)); do
+    echo "=== Wake cycle $cycle/$CYCLES ==="
+    START_NS=$(date +%s%N)
+    "${WRAPPER[@]}" "$PROGRAM"
+    EXIT_CODE=$?
+    ELAPSED_MS=$(( ($(date +%s%N) - START_NS) / 1000000 ))
+
+    case $EXIT_CODE in
+        0) echo "=== Cycle $cycle: deep sleep after ${ELAPSED_MS} ms wall time ===" ;;
+        3) echo "=== Cycle $cycle: restart after ${ELAPSED_MS} ms wall time ===" ;;
+        *)
+            echo "=== Cycle $cycle: exited with code $EXIT_CODE, stopping ==="
+            exit $EXIT_CODE
+            ;;
+    esac
+done
@@ -1,8 +1,7 @@
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WiFiClientSecure.h>
-#include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include "config.h"
 #include "globals.h"
 #include "ConfigManager.h"
 #include "ScheduleManager.h"
@@ -10,121 +9,705 @@
 #include "CameraCapture.h"
 #include "OTAManager.h"
 #include "RemoteLogger.h"
+#include "ImageQueue.h"
+#include "StageTimer.h"
+#include "FramePool.h"
+#include "WarmCamera.h"
+#include "JpegDc.h"
+#include "SleepManager.h"
+#include "SceneSignature.h"
+#include "Thumbnail.h"
+#include "AdaptiveQuality.h"
+#include "UploadResponse.h"
+#include "ImageDigest.h"
 
 // ============================================================================
-// Image Capture and Upload
+// Upload Gating (timer wake)
 // ============================================================================
 
-bool captureAndPostImage() {
-    Serial.println("\n--- Capturing Image ---");
+#define UPLOAD_GATE_MAGIC 0x47415445      // "GATE"
+#define SCENE_SIGNATURE_MAGIC 0x5343454E  // "SCEN"
 
-    if (!cameraInitialized) {
-        Serial.println("Camera not initialized!");
+static const time_t GATE_VALID_EPOCH = 1600000000;
+
+enum UploadVerdict {
+    UPLOAD_IMAGE,       // Send the JPEG
+    UPLOAD_SKIP,        // Send nothing (black or blown-out frame)
+    UPLOAD_HEARTBEAT    // Send an "unchanged" heartbeat instead of the JPEG
+};
+
+// Block luminance histogram of the analyzed frame (loop task only)
+static uint32_t lumaHistogram[JPEG_DC_HISTOGRAM_BINS];
+
+// Signature of the analyzed frame, stored in RTC memory once it was uploaded
+static uint8_t frameSignature[SCENE_SIGNATURE_CELLS];
+static bool frameSignatureValid = false;
+static uint16_t frameWidth = 0;
+static uint16_t frameHeight = 0;
+
+// Distance to the last uploaded frame, sent with the heartbeat
+static scene_distance_t sceneDistance;
+
+static rtc_upload_gate_t* uploadGate() {
+    rtc_upload_gate_t* gate = sleepManager.getUploadGateCache();
+    if (gate->magic != UPLOAD_GATE_MAGIC) {
+        memset(gate, 0, sizeof(rtc_upload_gate_t));
+        gate->magic = UPLOAD_GATE_MAGIC;
+    }
+    return gate;
+}
+
+/**
+ * DC pass over the frame: luminance histogram, plus the scene signature if
+ * scene change detection is on (timed as the "gate" stage)
+ * @return false if the JPEG could not be decoded
+ */
+static bool analyzeFrame(const uint8_t* jpeg, size_t len, uint16_t width, uint16_t height,
+                         jpeg_dc_stats_t& stats, unsigned long& analyzeMs) {
+    unsigned long start = millis();
+    StageTimer::start(STAGE_ANALYZE);
+
+    // Luma block map in PSRAM, sized for the MCU-padded grid of any sampling
+    uint8_t* lumaBlocks = nullptr;
+    size_t maxBlocks = 0;
+    if (SCENE_CHANGE_ENABLED) {
+        maxBlocks = (size_t)((width + 15) / 16 * 2) * ((height + 15) / 16 * 2);
+        lumaBlocks = (uint8_t*)ps_malloc(maxBlocks);
+        if (!lumaBlocks) {
+            maxBlocks = 0;
+        }
+    }
+
+    bool analyzed = JpegDc::analyze(jpeg, len, stats, lumaBlocks, maxBlocks, lumaHistogram);
+    if (analyzed && lumaBlocks) {
+        frameSignatureValid = SceneSignature::build(stats, lumaBlocks, frameSignature);
+        frameWidth = stats.width;
+        frameHeight = stats.height;
+    }
+    free(lumaBlocks);
+
+    StageTimer::stop(STAGE_ANALYZE);
+    analyzeMs = millis() - start;
+    return analyzed;
+}
+
+/**
+ * Decide whether a timer-wake frame is worth sending. Frames whose 8x8
+ * blocks are almost all black (night) or blown out are skipped, except for a
+ * keep-alive upload every EXPOSURE_GATE_KEEPALIVE_SEC.
+ * @return true if the frame should be dropped
+ */
+static bool gateExposure(const jpeg_dc_stats_t& stats, unsigned long analyzeMs, time_t now) {
+    uint32_t blocks = (uint32_t)stats.blocksX * stats.blocksY;
+    uint32_t dark = 0;
+    uint32_t bright = 0;
+    for (int level = 0; level < JPEG_DC_HISTOGRAM_BINS; level++) {
+        if (level <= EXPOSURE_GATE_DARK_LEVEL) {
+            dark += lumaHistogram[level];
+        } else if (level >= EXPOSURE_GATE_BRIGHT_LEVEL) {
+            bright += lumaHistogram[level];
+        }
+    }
+    uint32_t darkPct = dark * 100 / blocks;
+    uint32_t brightPct = bright * 100 / blocks;
+    Serial.printf("Exposure: mean Y %.1f, %u%% black, %u%% blown out (%lu ms)\n",
+                  stats.meanY, darkPct, brightPct, analyzeMs);
+
+    const char* verdict = nullptr;
+    if (darkPct >= EXPOSURE_GATE_BLOCK_PCT) {
+        verdict = "dark";
+    } else if (brightPct >= EXPOSURE_GATE_BLOCK_PCT) {
+        verdict = "blown out";
+    }
+    if (!verdict) {
         return false;
     }
 
-    // Acquire camera mutex to prevent concurrent access from web server
-    if (!CameraMutex::lock(5000)) {
-        Serial.println("Failed to acquire camera mutex (timeout)");
+    rtc_upload_gate_t* gate = uploadGate();
+    DynamicJsonDocument doc(256);
+    JsonObject context = doc.to<JsonObject>();
+    context["luma"] = roundf(stats.meanY * 10.0f) / 10.0f;
+    context["dark_pct"] = darkPct;
+    context["bright_pct"] = brightPct;
+    context["analyze_ms"] = analyzeMs;
+    context["skipped"] = gate->skippedCount;
+
+    if (gate->lastUploadAt == 0 || now - gate->lastUploadAt >= EXPOSURE_GATE_KEEPALIVE_SEC) {
+        Serial.printf("Frame is %s, sending anyway as keep-alive (%u skipped)\n", verdict, gate->skippedCount);
+        RemoteLogger::info("Gate", String("Keep-alive upload of ") + verdict + " frame", context);
         return false;
     }
 
-    // Capture image with sensor warm-up for proper AWB/AEC/AGC
-    camera_fb_t * fb = CameraCapture::captureFrame(true);
+    gate->skippedCount++;
+    gate->skippedTotal++;
+    Serial.printf("Frame is %s, upload skipped (%u since last upload)\n", verdict, gate->skippedCount);
+    RemoteLogger::info("Gate", String("Skipped ") + verdict + " frame", context);
+    return true;
+}
 
-    if (!fb) {
-        CameraMutex::unlock();
+/**
+ * Compare the frame's signature with the one of the last uploaded frame.
+ * A full image still goes out every SCENE_CHANGE_MAX_UNCHANGED_SEC, and the
+ * comparison is always against the last upload, so slow drift adds up.
+ * @return true if the scene is unchanged and a heartbeat is enough
+ */
+static bool checkSceneChange(time_t now) {
+    rtc_scene_signature_t* last = sleepManager.getSceneSignatureCache();
+    if (!SCENE_CHANGE_ENABLED || !frameSignatureValid || last->magic != SCENE_SIGNATURE_MAGIC ||
+        last->width != frameWidth || last->height != frameHeight ||
+        now - last->savedAt >= SCENE_CHANGE_MAX_UNCHANGED_SEC) {
         return false;
     }
 
-    // Prepare HTTPS POST
-    Serial.println("\n--- Uploading Image ---");
-    WiFiClientSecure client;
-    client.setInsecure(); // For testing; use proper certificate validation in production
+    sceneDistance = SceneSignature::compare(frameSignature, last->cells, SCENE_CHANGE_CELL_DELTA);
+    bool unchanged = sceneDistance.meanDiff < SCENE_CHANGE_MEAN_DIFF &&
+                     sceneDistance.changedCells <= SCENE_CHANGE_MAX_CELLS;
+    Serial.printf("Scene: mean diff %.1f, %u cells changed -> %s\n",
+                  sceneDistance.meanDiff, sceneDistance.changedCells, unchanged ? "unchanged" : "changed");
+    if (unchanged) {
+        last->unchangedCount++;
+        last->unchangedTotal++;
+    }
+    return unchanged;
+}
 
-    HTTPClient http;
+/**
+ * Gate a timer-wake frame before it is sent. Only small JPEGs are checked
+ * for exposure: a black or white frame compresses extremely well, so a
+ * larger one has too much detail to be gated. High-priority slots are never
+ * gated; their frame is still analyzed for the scene signature.
+ */
+static UploadVerdict gateUpload(const uint8_t* jpeg, size_t len, UploadPriority priority) {
+    frameSignatureValid = false;
+    time_t now = time(nullptr);
+    if (currentMode != MODE_CAPTURE || now < GATE_VALID_EPOCH) {
+        return UPLOAD_IMAGE;
+    }
 
-    // Build upload URL from base URL (base URL can include path like /cams)
-    String uploadUrl = String(configManager.getServerUrl()) + "/upload.php";
-    http.begin(client, uploadUrl);
+    uint16_t width = 0;
+    uint16_t height = 0;
+    if (!JpegDc::dimensions(jpeg, len, width, height)) {
+        return UPLOAD_IMAGE;
+    }
+    bool gated = priority != PRIORITY_HIGH;
+    bool checkExposure = EXPOSURE_GATE_ENABLED && gated &&
+                         len <= (size_t)(EXPOSURE_GATE_MAX_BYTES_PER_PIXEL * width * height);
+    if (!checkExposure && !SCENE_CHANGE_ENABLED) {
+        return UPLOAD_IMAGE;
+    }
 
-    // Set headers
-    http.addHeader("Content-Type", "image/jpeg");
-    http.addHeader("X-Auth-Token", configManager.getAuthToken());
-    http.addHeader("X-Device-ID", WiFi.macAddress());
-    http.addHeader("X-Firmware-Version", otaManager.getFirmwareVersion());
+    jpeg_dc_stats_t stats;
+    unsigned long analyzeMs = 0;
+    if (!analyzeFrame(jpeg, len, width, height, stats, analyzeMs)) {
+        return UPLOAD_IMAGE;
+    }
+    if (checkExposure && gateExposure(stats, analyzeMs, now)) {
+        return UPLOAD_SKIP;
+    }
+    return gated && checkSceneChange(now) ? UPLOAD_HEARTBEAT : UPLOAD_IMAGE;
+}
+
+// Restart the keep-alive period and remember the scene after an image went out
+static void noteUpload() {
+    time_t now = time(nullptr);
+    if (now >= GATE_VALID_EPOCH) {
+        rtc_upload_gate_t* gate = uploadGate();
+        gate->lastUploadAt = now;
+        gate->skippedCount = 0;
+    }
 
-    // Get formatted timestamp
+    // Without a signature of this frame the stored one no longer matches the last upload
+    rtc_scene_signature_t* last = sleepManager.getSceneSignatureCache();
+    if (!frameSignatureValid || now < GATE_VALID_EPOCH) {
+        last->magic = 0;
+        return;
+    }
+    memcpy(last->cells, frameSignature, SCENE_SIGNATURE_CELLS);
+    last->width = frameWidth;
+    last->height = frameHeight;
+    last->savedAt = now;
+    if (last->magic != SCENE_SIGNATURE_MAGIC) {
+        last->unchangedTotal = 0;
+    }
+    last->unchangedCount = 0;
+    last->magic = SCENE_SIGNATURE_MAGIC;
+}
+
+// Report a heartbeat sent instead of the image to the server log
+static void logHeartbeat(bool sent) {
+    const rtc_scene_signature_t* last = sleepManager.getSceneSignatureCache();
+    DynamicJsonDocument doc(256);
+    JsonObject context = doc.to<JsonObject>();
+    context["mean_diff"] = roundf(sceneDistance.meanDiff * 10.0f) / 10.0f;
+    context["changed_cells"] = sceneDistance.changedCells;
+    context["unchanged"] = last->unchangedCount;
+    context["since_upload_sec"] = (long)(time(nullptr) - last->savedAt);
+    if (sent) {
+        RemoteLogger::info("Scene", "Unchanged, heartbeat sent", context);
+    } else {
+        RemoteLogger::warn("Scene", "Unchanged, heartbeat failed", context);
+    }
+}
+
+// ============================================================================
+// Adaptive JPEG Quality (timer wake)
+// ============================================================================
+
+/**
+ * Coarsen the capture quality so the frame fits the byte budget of the link
+ * measured in previous wakes; the slot's quality is the finest used.
+ * Call with CameraMutex held, after selectSlotProfile().
+ */
+static void selectAdaptiveQuality() {
+    if (!ADAPTIVE_QUALITY_ENABLED || currentMode != MODE_CAPTURE || !isWiFiConnected()) {
+        return;
+    }
+
+    uint32_t target = AdaptiveQuality::targetBytes(ADAPTIVE_QUALITY_SEND_MS, WiFi.RSSI());
+    if (target == 0) {
+        return;  // No upload measured yet
+    }
+    if (target < ADAPTIVE_QUALITY_MIN_BYTES) {
+        target = ADAPTIVE_QUALITY_MIN_BYTES;
+    }
+
+    int slotQuality = CameraCapture::getCaptureQuality();
+    int quality = AdaptiveQuality::qualityFor(target, CameraCapture::getCaptureOutputPixels(),
+                                              slotQuality, ADAPTIVE_QUALITY_WORST);
+    if (quality < 0) {
+        return;
+    }
+    Serial.printf("Adaptive quality: %u KB target (%.1f KB/s, RSSI %d dBm) -> quality %d (slot %d)\n",
+                  target / 1024, AdaptiveQuality::getThroughput() / 1024, WiFi.RSSI(), quality, slotQuality);
+    if (quality != slotQuality) {
+        CameraCapture::setCaptureProfile(CameraCapture::getCaptureFrameSize(), quality);
+
+        DynamicJsonDocument doc(256);
+        JsonObject context = doc.to<JsonObject>();
+        context["quality"] = quality;
+        context["slot_quality"] = slotQuality;
+        context["target_kb"] = target / 1024;
+        context["throughput_kbps"] = roundf(AdaptiveQuality::getThroughput() / 1024 * 10.0f) / 10.0f;
+        context["rssi"] = WiFi.RSSI();
+        RemoteLogger::info("Camera", "Adaptive quality", context);
+    }
+}
+
+// Learn the JPEG size at the capture quality
+static void recordFrameSize(size_t len) {
+    if (ADAPTIVE_QUALITY_ENABLED) {
+        AdaptiveQuality::recordFrame(CameraCapture::getCaptureQuality(), len,
+                                     CameraCapture::getCaptureOutputPixels());
+    }
+}
+
+// Learn the link throughput from the timed upload of the live image
+static void recordUploadThroughput(int httpResponseCode, size_t bodyBytes) {
+    uint32_t sendMs = StageTimer::getMs(STAGE_SEND);
+    if (!ADAPTIVE_QUALITY_ENABLED || currentMode != MODE_CAPTURE || sendMs == 0) {
+        return;  // Not timed, or never connected: nothing learned about the link
+    }
+    AdaptiveQuality::recordUpload(bodyBytes, sendMs, WiFi.RSSI(), httpResponseCode > 0);
+}
+
+// ============================================================================
+// Image Capture and Upload
+// ============================================================================
+
+static String currentTimestamp() {
     struct tm timeinfo;
-    String timestamp = "unknown";
     if (ScheduleManager::getCurrentTime(&timeinfo)) {
-        timestamp = ScheduleManager::formatTime(&timeinfo);
+        return ScheduleManager::formatTime(&timeinfo);
     }
-    http.addHeader("X-Timestamp", timestamp);
+    return "unknown";
+}
 
-    // Send POST request
-    int httpResponseCode = http.POST(fb->buf, fb->len);
+/**
+ * Report how long the sensor took to settle to the server log
+ * (called from the main task; the warm-up may have run in the camera prep task)
+ */
+static void logWarmUp() {
+    const warmup_stats_t& warmUp = CameraCapture::getLastWarmUp();
+    if (warmUp.frames == 0) {
+        return;
+    }
 
-    // Release frame buffer and mutex
-    CameraCapture::releaseFrame(fb);
-    CameraMutex::unlock();
+    DynamicJsonDocument doc(256);
+    JsonObject context = doc.to<JsonObject>();
+    context["frames"] = warmUp.frames;
+    context["warmup_ms"] = warmUp.durationMs;
+    context["converged"] = warmUp.converged;
+    if (warmUp.meanY >= 0) {
+        context["luma"] = roundf(warmUp.meanY * 10.0f) / 10.0f;
+    }
+    if (warmUp.aec > 0) {
+        context["aec"] = warmUp.aec;
+        context["gain"] = warmUp.gain;
+    }
+    RemoteLogger::info("Camera", warmUp.converged ? "Sensor converged" : "Sensor warm-up hit cap", context);
+}
 
-    // Check response
-    bool success = false;
-    String response = "";
-    if (httpResponseCode > 0) {
-        Serial.printf("HTTP Response code: %d\n", httpResponseCode);
-        response = http.getString();
-        Serial.println("Response: " + response);
-
-        if (httpResponseCode >= 200 && httpResponseCode < 300) {
-            Serial.println("✓ Image uploaded successfully!");
-            success = true;
-
-            // If validation pending, confirm OTA first — BEFORE checking for new OTA.
-            // Without this guard the server still sees ota_scheduled set and would
-            // offer the same firmware again, sending the device into an OTA loop
-            // before validateOtaUpdate() ever runs.
-            if (otaValidationPending) {
-                validateOtaUpdate();
-            }
+/**
+ * Report which burst frame was kept and how the scores spread
+ */
+static void logBurst() {
+    const burst_stats_t& burst = CameraCapture::getLastBurst();
+    if (burst.frames == 0) {
+        return;
+    }
+
+    DynamicJsonDocument doc(256);
+    JsonObject context = doc.to<JsonObject>();
+    context["frames"] = burst.frames;
+    context["kept"] = burst.best + 1;
+    context["score"] = roundf(burst.bestScore * 1000.0f) / 1000.0f;
+    context["worst_score"] = roundf(burst.worstScore * 1000.0f) / 1000.0f;
+    context["sharpness"] = roundf(burst.sharpness * 1000.0f) / 1000.0f;
+    context["clipped_pct"] = roundf(burst.clippedPct * 10.0f) / 10.0f;
+    context["burst_ms"] = burst.durationMs;
+    RemoteLogger::info("Camera", "Burst capture", context);
+}
+
+/**
+ * Report the wake-cycle stage breakdown to the server log (timer wake only)
+ */
+static void logWakeTiming() {
+    if (currentMode != MODE_CAPTURE) {
+        return;
+    }
+
+    DynamicJsonDocument doc(512);
+    JsonObject context = doc.to<JsonObject>();
+    context["fw"] = otaManager.getFirmwareVersion();
+    StageTimer::addTo(context);
+    RemoteLogger::info("Timing", "Wake cycle stages", context);
+}
+
+/**
+ * Compare the RTC clock with the server time of an upload response and force
+ * an NTP sync on the next timer wake if it drifted too far
+ */
+static void checkServerTime(time_t serverTime) {
+    if (serverTime <= 0) {
+        return;  // Older server
+    }
+
+    long drift = (long)(time(nullptr) - serverTime);
+    if (labs(drift) <= SERVER_TIME_MAX_DRIFT_SEC) {
+        return;
+    }
+
+    Serial.printf("Clock is %ld s off the server time, NTP sync on next wake\n", drift);
+    sleepManager.setLastNtpSync(0);
+
+    DynamicJsonDocument doc(128);
+    JsonObject context = doc.to<JsonObject>();
+    context["drift_sec"] = drift;
+    RemoteLogger::warn("Time", "Clock drift against server time", context);
+}
+
+// Switch to the slot's capture profile and warm up unless the camera prep
+// task already did on that frame size, with stage timing
+static void warmUpTimed(int slot) {
+    if (CameraCapture::restoreCaptureProfile()) {
+        cameraWarmedUp = false;
+    }
+    if (!cameraWarmedUp) {
+        StageTimer::start(STAGE_WARMUP);
+        warmUpSensorForSlot(slot);
+        StageTimer::stop(STAGE_WARMUP);
+        cameraWarmedUp = true;
+    }
+}
+
+// Warm up and capture, with stage timing
+static camera_fb_t* captureTimedFrame(int slot) {
+    warmUpTimed(slot);
+    cameraWarmedUp = false;
+
+    StageTimer::start(STAGE_CAPTURE);
+    camera_fb_t* fb = CameraCapture::captureFrame(false);
+    StageTimer::stop(STAGE_CAPTURE);
+    return fb;
+}
+
+// Burst settings of the schedule slot this capture belongs to (1 frame if unknown)
+static int slotBurstFrames(int slot, unsigned long& budgetMs) {
+    budgetMs = 0;
+    if (slot < 0) {
+        return 1;
+    }
+    budgetMs = configManager.getBurstBudgetMs(slot);
+    return configManager.getBurstFrames(slot);
+}
+
+/**
+ * Warm up and capture a burst into the frame pool, keeping the best frame
+ * (timed as the capture stage). Returns an empty handle if the slot takes a
+ * single frame or the burst failed; the sensor then stays marked as warmed
+ * up for captureTimedFrame().
+ */
+static FrameRef captureTimedBurst(int slot) {
+    unsigned long budgetMs = 0;
+    int frames = slotBurstFrames(slot, budgetMs);
+    if (frames <= 1) {
+        return FrameRef();
+    }
 
-            // Check for OTA available (only when not in a validation cycle)
-            if (!otaValidationPending && otaManager.isOtaAvailable(response)) {
-                Serial.println("\n[OTA] Update available in server response");
+    warmUpTimed(slot);
+    StageTimer::start(STAGE_CAPTURE);
+    FrameRef frame = CameraCapture::captureBurst(frames, budgetMs);
+    StageTimer::stop(STAGE_CAPTURE);
+    if (frame) {
+        cameraWarmedUp = false;
+    }
+    return frame;
+}
+
+// Thumbnail to upload with the image, timed as the "thumb" stage
+static void createThumbnail(const uint8_t* jpeg, size_t len, thumbnail_t& thumbnail) {
+    memset(&thumbnail, 0, sizeof(thumbnail));
+    if (!THUMBNAIL_ENABLED) {
+        return;
+    }
+
+    StageTimer::start(STAGE_THUMBNAIL);
+    bool created = Thumbnail::create(jpeg, len, THUMBNAIL_JPEG_QUALITY, THUMBNAIL_MAX_BYTES, thumbnail);
+    StageTimer::stop(STAGE_THUMBNAIL);
+    if (created) {
+        Serial.printf("Thumbnail: %ux%u, %u bytes (decode %u ms, encode %u ms)\n",
+                      thumbnail.width, thumbnail.height, (unsigned)thumbnail.length,
+                      thumbnail.decodeMs, thumbnail.encodeMs);
+    }
+}
+
+bool captureAndPostImage() {
+    Serial.println("\n--- Capturing Image ---");
+    lastImageQueued = false;
 
-                // handleOtaUpdate saves OTA info to NVS and reboots into
-                // dedicated OTA mode (no camera, no web server, no AsyncTCP).
-                // This call does not return — the device will restart.
-                handleOtaUpdate(response);
+    if (!cameraInitialized) {
+        Serial.println("Camera not initialized!");
+        return false;
+    }
+
+    // Capture profile of the schedule slot; the warm camera task keeps
+    // grabbing on the previous one until it sees the change
+    int slot = currentCaptureSlot();
+    UploadPriority priority = slot >= 0 ? configManager.getUploadPriority(slot) : PRIORITY_NORMAL;
+    bool profileChanged = false;
+    if (CameraMutex::lock(5000)) {
+        profileChanged = selectSlotProfile(slot);
+        selectAdaptiveQuality();
+        CameraMutex::unlock();
+    }
+
+    // Config mode: the warm camera task already holds a settled, recent frame
+    uint32_t warmAgeMs = 0;
+    FrameRef frame = profileChanged ? FrameRef() : WarmCamera::latest(&warmAgeMs);
+    bool warmFrame = (bool)frame;
+    camera_fb_t * fb = nullptr;
+    if (warmFrame) {
+        Serial.printf("Using warm camera frame (%u ms old, %u bytes)\n", warmAgeMs, frame.length());
+    } else {
+        // Acquire camera mutex to prevent concurrent access from web server
+        if (!CameraMutex::lock(5000)) {
+            Serial.println("Failed to acquire camera mutex (timeout)");
+            return false;
+        }
+
+        // Capture image with sensor warm-up for proper AWB/AEC/AGC
+        // (skipped once if the camera prep task already warmed the sensor up);
+        // a burst lands in the frame pool directly
+        frame = captureTimedBurst(slot);
+        if (frame) {
+            logWarmUp();
+            logBurst();
+            saveSensorState();
+            CameraMutex::unlock();
+        } else {
+            fb = captureTimedFrame(slot);
+
+            if (!fb) {
+                CameraMutex::unlock();
+                return false;
+            }
+            logWarmUp();
+            saveSensorState();
+
+            // Move the JPEG into the frame pool and free the camera for the web
+            // preview; if no slot is free, keep the driver buffer (and the mutex)
+            // for the duration of the upload as before
+            frame = FramePool::copy(fb);
+            if (frame) {
+                CameraCapture::releaseFrame(fb);
+                CameraMutex::unlock();
+                fb = nullptr;
             }
+        }
+    }
+    const uint8_t* jpeg = frame ? frame.data() : fb->buf;
+    size_t jpegLen = frame ? frame.length() : fb->len;
+    if (!warmFrame) {
+        recordFrameSize(jpegLen);
+    }
+
+    // SHA-256 for X-Content-SHA256 on the other core, while this one gates
+    // the frame and makes the thumbnail; joined before the upload, and
+    // always before the frame is released (the task reads it)
+    ImageDigest digest;
+    if (UPLOAD_SHA256_ENABLED) {
+        digest.start(jpeg, jpegLen, UPLOAD_SHA256_CORE);
+    }
+
+    UploadVerdict verdict = gateUpload(jpeg, jpegLen, priority);
+    if (verdict == UPLOAD_SKIP) {
+        digest.get();
+        frame.reset();
+        if (fb) {
+            CameraCapture::releaseFrame(fb);
+            CameraMutex::unlock();
+        }
+        return true;  // Nothing worth sending, not a failure
+    }
+
+    String timestamp = currentTimestamp();
+    UploadResponse response;
+    int httpResponseCode = -1;
+    if (isWiFiConnected()) {
+        if (verdict == UPLOAD_HEARTBEAT) {
+            char distance[48];
+            snprintf(distance, sizeof(distance), "mean=%.1f,changed=%u",
+                     sceneDistance.meanDiff, sceneDistance.changedCells);
+            httpResponseCode = postHeartbeat(timestamp, distance, response);
         } else {
-            Serial.println("✗ Upload failed with HTTP error");
+            thumbnail_t thumbnail;
+            createThumbnail(jpeg, jpegLen, thumbnail);
+            unsigned long joinStart = millis();
+            const uint8_t* sha256 = digest.get();
+            if (sha256) {
+                Serial.printf("SHA-256: %u ms on core %d, waited %lu ms\n", digest.getHashMs(),
+                              UPLOAD_SHA256_CORE, millis() - joinStart);
+            }
+            httpResponseCode = postImage(jpeg, jpegLen, timestamp, response, nullptr,
+                                         thumbnail.data, thumbnail.length, sha256);
+            recordUploadThroughput(httpResponseCode, jpegLen + thumbnail.length);
+            Thumbnail::release(thumbnail);
+        }
+    }
+    bool success = httpResponseCode >= 200 && httpResponseCode < 300;
+    logWakeTiming();
+    if (verdict == UPLOAD_HEARTBEAT) {
+        logHeartbeat(success);
+    } else if (success) {
+        noteUpload();
+    }
+
+    // Keep the image for delivery on the next good connection (an unchanged
+    // scene is not worth queueing, the server already has it, nor is the
+    // image of a low-priority slot). An image turned away for good (bad
+    // token, disabled camera, too large) would only be turned away again
+    bool refused = httpResponseCode == 401 || httpResponseCode == 403 || httpResponseCode == 413;
+    if (!success && !refused && verdict == UPLOAD_IMAGE && priority != PRIORITY_LOW &&
+        ImageQueue::push(jpeg, jpegLen, timestamp, otaManager.getFirmwareVersion())) {
+        Serial.println("Image queued for later delivery");
+        lastImageQueued = true;
+    }
+
+    // Release frame and mutex
+    digest.get();
+    frame.reset();
+    if (fb) {
+        CameraCapture::releaseFrame(fb);
+        CameraMutex::unlock();
+    }
+
+    if (success) {
+        checkServerTime(response.serverTime);
+
+        // Connection is known good: deliver images queued during earlier outages
+        drainImageQueue(QUEUE_DRAIN_BUDGET_MS);
+
+        // If validation pending, confirm OTA first — BEFORE checking for new OTA.
+        // Without this guard the server still sees ota_scheduled set and would
+        // offer the same firmware again, sending the device into an OTA loop
+        // before validateOtaUpdate() ever runs.
+        if (otaValidationPending) {
+            validateOtaUpdate();
+        }
+
+        // Check for OTA available (only when not in a validation cycle)
+        if (!otaValidationPending && response.ota.available) {
+            Serial.println("\n[OTA] Update available in server response");
+
+            // handleOtaUpdate saves OTA info to NVS and reboots into
+            // dedicated OTA mode (no camera, no web server, no AsyncTCP).
+            // This call does not return — the device will restart.
+            handleOtaUpdate(response.ota);
         }
-    } else {
-        Serial.printf("✗ Upload failed: %s\n", http.errorToString(httpResponseCode).c_str());
     }
 
-    http.end();
     return success;
 }
 
+bool captureToQueue() {
+    Serial.println("\n--- Capturing Image (offline) ---");
+
+    if (!ImageQueue::isReady() || !waitForCameraPrep(10000)) {
+        return false;
+    }
+
+    // Not worth the queue space: handled, nothing to deliver later
+    int slot = currentCaptureSlot();
+    UploadPriority priority = slot >= 0 ? configManager.getUploadPriority(slot) : PRIORITY_NORMAL;
+    if (priority == PRIORITY_LOW) {
+        Serial.println("Low-priority slot, not captured for the queue");
+        return true;
+    }
+
+    if (!CameraMutex::lock(5000)) {
+        Serial.println("Failed to acquire camera mutex (timeout)");
+        return false;
+    }
+
+    selectSlotProfile(slot);
+    FrameRef frame = captureTimedBurst(slot);
+    camera_fb_t * fb = frame ? nullptr : captureTimedFrame(slot);
+
+    bool queued = false;
+    if (frame || fb) {
+        saveSensorState();
+        const uint8_t* jpeg = frame ? frame.data() : fb->buf;
+        size_t jpegLen = frame ? frame.length() : fb->len;
+        recordFrameSize(jpegLen);
+        if (gateUpload(jpeg, jpegLen, priority) != UPLOAD_IMAGE) {
+            queued = true;  // Handled: nothing worth delivering later
+        } else {
+            queued = ImageQueue::push(jpeg, jpegLen, currentTimestamp(), otaManager.getFirmwareVersion());
+        }
+        CameraCapture::releaseFrame(fb);
+    }
+    CameraMutex::unlock();
+    return queued;
+}
+
 // ============================================================================
 // OTA Scheduling and Validation (called exclusively from captureAndPostImage)
 // ============================================================================
 
-void handleOtaUpdate(const String& response) {
+void handleOtaUpdate(const OtaUpdateInfo& otaInfo) {
     Serial.println("\n======================================");
     Serial.println("[OTA] OTA Update Available - Preparing Reboot");
     Serial.println("======================================");
 
-    OtaUpdateInfo otaInfo = otaManager.parseOtaInfo(response);
-
     if (!otaInfo.available) {
         Serial.println("[OTA] No update available");
-        RemoteLogger::warn("OTA", "parseOtaInfo returned no update");
+        RemoteLogger::warn("OTA", "handleOtaUpdate called without an update");
         return;
     }
+    Serial.printf("  Firmware: %s\n", otaInfo.firmwareFile.c_str());
+    Serial.printf("  Version: %s\n", otaInfo.firmwareVersion.c_str());
+    Serial.printf("  Size: %d bytes\n", otaInfo.size);
+    Serial.printf("  SHA256: %s\n", otaInfo.sha256.c_str());
 
     // Check if this firmware has failed too many times (max 3 retries)
     static const uint32_t OTA_MAX_RETRIES = 3;
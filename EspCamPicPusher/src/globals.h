@@ -8,6 +8,9 @@ class ScheduleManager;
 class SleepManager;
 class WebConfigServer;
 class OTAManager;
+struct QueuedImage;
+struct UploadResponse;
+struct OtaUpdateInfo;
 
 // ============================================================================
 // Operating Mode
@@ -33,9 +36,11 @@ extern OTAManager otaManager;
 extern OperatingMode currentMode;
 extern unsigned long lastNtpUpdate;
 extern bool cameraInitialized;
+extern bool cameraWarmedUp;
 extern bool isApMode;
 extern bool otaValidationPending;
 extern String pendingOtaFirmwareFile;
+extern bool lastImageQueued;      // captureAndPostImage() kept its undelivered image in the ImageQueue
 
 // ============================================================================
 // Function Declarations
@@ -43,12 +48,27 @@ extern String pendingOtaFirmwareFile;
 
 void setupSerial();
 bool setupWiFiSTA();
+bool setupWiFiFastConnect();
 void setupWiFiAPSTA();
 String generateApSsid();
 bool isWiFiConnected();
 void setupCamera();
+void startCameraPrep();
+bool waitForCameraPrep(uint32_t timeoutMs);
+void updateWarmCamera();
+void saveSensorState();
+int currentCaptureSlot();
+bool selectSlotProfile(int slot);
+bool warmUpSensorForSlot(int slot);
 void setupTime();
 bool captureAndPostImage();
+bool captureToQueue();
+int postImage(const uint8_t* buf, size_t len, const String& timestamp, UploadResponse& response,
+              const QueuedImage* queued = nullptr, const uint8_t* thumbnail = nullptr,
+              size_t thumbnailLen = 0, const uint8_t* sha256 = nullptr);
+int postHeartbeat(const String& timestamp, const char* sceneDistance, UploadResponse& response);
+void startUploadPreconnect();
+uint32_t drainImageQueue(unsigned long budgetMs);
 void blinkLED(int times, int delayMs);
 
 void runConfigMode();
@@ -57,6 +77,6 @@ void runWaitMode();
 void runOtaMode();
 void enterSleepMode();
 bool shouldEnterSleepMode();
-void handleOtaUpdate(const String& response);
+void handleOtaUpdate(const OtaUpdateInfo& otaInfo);
 void validateOtaUpdate();
 String resolveHostname();
@@ -20,9 +20,11 @@ OperatingMode currentMode = MODE_CONFIG;
 
 unsigned long lastNtpUpdate = 0;
 bool cameraInitialized = false;
+bool cameraWarmedUp = false;
 bool isApMode = false;
 bool otaValidationPending = false;
 String pendingOtaFirmwareFile = "";
+bool lastImageQueued = false;
 
 // ============================================================================
 // Main Loop
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include <ESPmDNS.h>
+#include "config.h"
 #include "globals.h"
 #include "ConfigManager.h"
 #include "SleepManager.h"
@@ -14,6 +15,9 @@ void runCaptureMode() {
     Serial.println("Executing scheduled capture");
     Serial.println("======================================");
 
+    // Barrier: camera prep task started in setupCaptureMode()
+    waitForCameraPrep(10000);
+
     if (!cameraInitialized) {
         Serial.println("ERROR: Camera not initialized");
         sleepManager.incrementFailedCaptures();
@@ -27,6 +31,7 @@ void runCaptureMode() {
             webServer = new WebConfigServer(&configManager);
             webServer->setCameraReady(false);
             webServer->setCaptureCallback(captureAndPostImage);
+            webServer->setStreamProfile(STREAM_FRAME_SIZE, STREAM_JPEG_QUALITY, STREAM_MAX_FPS);
             if (webServer->begin()) {
                 MDNS.addService("http", "tcp", 80);
             }
@@ -42,6 +47,11 @@ void runCaptureMode() {
         Serial.println("✓ Capture successful!");
         sleepManager.resetFailedCaptures();
         blinkLED(2, 100);
+    } else if (lastImageQueued) {
+        // Server unreachable, the image waits in the queue: an outage is not
+        // a fault to stay awake for
+        Serial.println("✓ Capture queued for later delivery");
+        blinkLED(3, 100);
     } else {
         Serial.println("✗ Capture failed");
         sleepManager.incrementFailedCaptures();
@@ -56,6 +66,7 @@ void runCaptureMode() {
             webServer = new WebConfigServer(&configManager);
             webServer->setCameraReady(cameraInitialized);
             webServer->setCaptureCallback(captureAndPostImage);
+            webServer->setStreamProfile(STREAM_FRAME_SIZE, STREAM_JPEG_QUALITY, STREAM_MAX_FPS);
             if (webServer->begin()) {
                 MDNS.addService("http", "tcp", 80);
             }
@@ -7,6 +7,7 @@
 #include "ScheduleManager.h"
 #include "SleepManager.h"
 #include "WebConfigServer.h"
+#include "WarmCamera.h"
 
 // ============================================================================
 // Config Mode — web server active, handles manual and scheduled captures
@@ -27,6 +28,9 @@ void runConfigMode() {
             Serial.println("✓ Manual capture successful!");
             sleepManager.resetFailedCaptures();
             blinkLED(2, 100);
+        } else if (lastImageQueued) {
+            Serial.println("✗ Manual capture not delivered, queued for later");
+            blinkLED(3, 100);
         } else {
             Serial.println("✗ Manual capture failed");
             sleepManager.incrementFailedCaptures();
@@ -80,6 +84,8 @@ void runConfigMode() {
     }
     lastCheck = millis();
 
+    updateWarmCamera();
+
     // Check AP+STA status every 10 seconds
     if (isApMode && (millis() - lastApCheck >= 10000)) {
         lastApCheck = millis();
@@ -125,6 +131,9 @@ void runConfigMode() {
                         Serial.println("✓ Capture successful!");
                         sleepManager.resetFailedCaptures();
                         blinkLED(2, 100);
+                    } else if (lastImageQueued) {
+                        Serial.println("✓ Capture queued for later delivery");
+                        blinkLED(3, 100);
                     } else {
                         Serial.println("✗ Capture failed");
                         sleepManager.incrementFailedCaptures();
@@ -146,6 +155,7 @@ void runConfigMode() {
     // Check if timeout expired
     if (webServer && webServer->isTimeoutExpired()) {
         Serial.println("\n=== Web server timeout expired ===");
+        WarmCamera::stop();
 
         // If in AP mode, restart to retry
         if (isApMode) {
@@ -45,6 +45,9 @@ void runWaitMode() {
             Serial.println("✓ Capture successful!");
             sleepManager.resetFailedCaptures();
             blinkLED(2, 100);
+        } else if (lastImageQueued) {
+            Serial.println("✓ Capture queued for later delivery");
+            blinkLED(3, 100);
         } else {
             Serial.println("✗ Capture failed");
             sleepManager.incrementFailedCaptures();
@@ -11,6 +11,10 @@
 #include "WebConfigServer.h"
 #include "OTAManager.h"
 #include "RemoteLogger.h"
+#include "ImageQueue.h"
+#include "StageTimer.h"
+#include "AdaptiveQuality.h"
+#include "esp_timer.h"
 
 // ============================================================================
 // Serial and Time Setup
@@ -91,6 +95,7 @@ static void setupConfigMode() {
     }
 
     setupCamera();
+    ImageQueue::begin();
 
     // Only setup time if WiFi is connected (NTP requires internet)
     if (wifiConnected || isWiFiConnected()) {
@@ -126,6 +131,7 @@ static void setupConfigMode() {
     webServer = new WebConfigServer(&configManager);
     webServer->setCameraReady(cameraInitialized);
     webServer->setCaptureCallback(captureAndPostImage);
+    webServer->setStreamProfile(STREAM_FRAME_SIZE, STREAM_JPEG_QUALITY, STREAM_MAX_FPS);
     webServer->setApMode(isApMode);
     if (!webServer->begin()) {
         Serial.println("ERROR: Failed to start web server");
@@ -149,12 +155,28 @@ static void setupConfigMode() {
 
 // Capture mode boot: timer wake — capture one image then return to sleep.
 static void setupCaptureMode() {
+    // Camera init + warm-up on the other core; joined in runCaptureMode()
+    startCameraPrep();
+    ImageQueue::begin();
+
     // Get WiFi retry count
     uint32_t retryCount = sleepManager.getWifiRetryCount();
     Serial.printf("WiFi retry attempt: %u/5\n", retryCount);
 
-    bool wifiConnected = setupWiFiSTA();
+    StageTimer::start(STAGE_WIFI);
+    bool wifiConnected = setupWiFiFastConnect();
+    StageTimer::stop(STAGE_WIFI);
     if (!wifiConnected) {
+        // Keep the schedule: store this slot's image and deliver it on the
+        // next good connection instead of retrying every 5 minutes. A queued
+        // image is handled, not a failed capture
+        configTime(configManager.getGmtOffsetSec(), configManager.getDaylightOffsetSec(), "");
+        if (captureToQueue()) {
+            Serial.println("\nWiFi unavailable, image queued - sleeping until next scheduled capture");
+            sleepManager.resetWifiRetryCount();
+            enterSleepMode();
+            // Code never reaches here
+        }
         sleepManager.incrementFailedCaptures();
 
         if (retryCount < 5) {
@@ -175,6 +197,9 @@ static void setupCaptureMode() {
     // WiFi connected successfully - reset retry counter
     sleepManager.resetWifiRetryCount();
 
+    // Upload connection is opened while the camera warms up; taken over by the upload
+    startUploadPreconnect();
+
     // Initialize remote logger
     RemoteLogger::begin(
         configManager.getServerUrl(),
@@ -182,14 +207,14 @@ static void setupCaptureMode() {
         WiFi.macAddress()
     );
 
-    setupCamera();
-
     // Check if NTP sync needed (>24 hours since last)
     time_t lastSync = sleepManager.getLastNtpSync();
     time_t now = time(nullptr);
     if (lastSync == 0 || (now - lastSync) > 86400) {
         Serial.println("NTP sync required...");
+        StageTimer::start(STAGE_NTP);
         setupTime();
+        StageTimer::stop(STAGE_NTP);
         sleepManager.setLastNtpSync(time(nullptr));
     } else {
         Serial.println("Using RTC time (NTP sync not required)");
@@ -222,20 +247,27 @@ static void setupCaptureMode() {
 void setup() {
     setupSerial();
     blinkLED(3, 200); // Visual indication of startup
+    StageTimer::add(STAGE_BOOT, (uint32_t)(esp_timer_get_time() / 1000));
 
     // Initialize sleep manager
+    StageTimer::start(STAGE_RTC);
     sleepManager.begin();
+    StageTimer::stop(STAGE_RTC);
+    StageTimer::begin(sleepManager.getStageTimingCache());
+    AdaptiveQuality::begin(sleepManager.getAdaptiveQualityCache());
 
     // Initialize camera mutex for thread-safe access
     CameraMutex::init();
 
     // Initialize configuration manager
+    StageTimer::start(STAGE_CONFIG);
     if (!configManager.begin()) {
         Serial.println("ERROR: Failed to initialize configuration");
         blinkLED(10, 100);
         delay(5000);
         ESP.restart();
     }
+    StageTimer::stop(STAGE_CONFIG);
 
     // Check for pending OTA update BEFORE initializing anything else.
     // This ensures a clean, minimal boot: no camera, no web server,
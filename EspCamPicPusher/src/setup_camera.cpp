@@ -2,14 +2,172 @@
 #include "esp_camera.h"
 #include "config.h"
 #include "globals.h"
+#include "ConfigManager.h"
 #include "SleepManager.h"
+#include "CameraMutex.h"
+#include "CameraCapture.h"
+#include "StageTimer.h"
+#include "FramePool.h"
+#include "WarmCamera.h"
+#include "WebConfigServer.h"
+
+// ============================================================================
+// Sensor Exposure Seeding (RTC memory)
+// ============================================================================
+
+#define SENSOR_STATE_MAGIC 0x53454E53  // "SENS"
+
+static const time_t VALID_EPOCH = 1600000000;
+
+// Slots are keyed by UTC hour: daylight follows the sun rather than the
+// DST-shifted wall clock, and the TZ env is not restored yet when the camera
+// prep task starts
+static int sensorSlotIndex(time_t t) {
+    return (int)((t % 86400) / 3600);
+}
+
+// Snapshot for the current hour, else the neighbouring hours
+static const rtc_sensor_slot_t* findSensorSlot(time_t now) {
+    const rtc_sensor_state_t* cache = sleepManager.getSensorStateCache();
+    if (cache->magic != SENSOR_STATE_MAGIC) {
+        return nullptr;
+    }
+
+    static const int offsets[] = { 0, -1, 1 };
+    int hour = sensorSlotIndex(now);
+    for (int offset : offsets) {
+        const rtc_sensor_slot_t* slot = &cache->slots[(hour + offset + SENSOR_STATE_SLOTS) % SENSOR_STATE_SLOTS];
+        if (slot->savedAt > 0 && now >= slot->savedAt && now - slot->savedAt <= SENSOR_STATE_MAX_AGE_SEC) {
+            return slot;
+        }
+    }
+    return nullptr;
+}
+
+// Start AEC/AGC from the exposure that converged around this time of day
+// instead of the fixed defaults. Runs during camera init, before anything
+// else can use the camera.
+static void seedSensorExposure() {
+    time_t now = time(nullptr);
+    if (now < VALID_EPOCH) {
+        return;  // No clock yet (first power-on)
+    }
+
+    const rtc_sensor_slot_t* slot = findSensorSlot(now);
+    if (!slot) {
+        Serial.println("No exposure snapshot for this time of day, using sensor defaults");
+        return;
+    }
+    if (CameraCapture::setExposure(slot->aec, slot->gain)) {
+        sleepManager.getSensorStateCache()->seededCount++;
+        Serial.printf("Sensor seeded from %02d:00 UTC snapshot (AEC %u, gain %u, luma %u)\n",
+                      sensorSlotIndex(slot->savedAt), slot->aec, slot->gain, slot->luma);
+    }
+}
+
+void saveSensorState() {
+    const warmup_stats_t& warmUp = CameraCapture::getLastWarmUp();
+    time_t now = time(nullptr);
+    if (!warmUp.converged || warmUp.aec == 0 || now < VALID_EPOCH) {
+        return;  // Only keep settled exposures
+    }
+
+    rtc_sensor_state_t* cache = sleepManager.getSensorStateCache();
+    if (cache->magic != SENSOR_STATE_MAGIC) {
+        memset(cache, 0, sizeof(rtc_sensor_state_t));
+        cache->magic = SENSOR_STATE_MAGIC;
+    }
+
+    rtc_sensor_slot_t* slot = &cache->slots[sensorSlotIndex(now)];
+    slot->savedAt = now;
+    slot->aec = warmUp.aec;
+    slot->gain = warmUp.gain;
+    slot->luma = warmUp.meanY < 0 ? 0 : (uint8_t)min(warmUp.meanY + 0.5f, 255.0f);
+}
+
+// ============================================================================
+// Schedule Slot Profiles
+// ============================================================================
+
+// Region of interest from the config, aligned for the sensor window (the
+// OV2640 DSP window and output size are set in units of 4 pixels, JPEG MCUs
+// are 16 wide): shrunk to multiples of 16 around its center. Width 0 = full frame.
+static capture_window_t captureWindow() {
+    capture_window_t window = {};
+    int width = configManager.getRoiWidth() / 16 * 16;
+    int height = configManager.getRoiHeight() / 16 * 16;
+    if (width <= 0 || height <= 0 || (width >= ROI_SENSOR_WIDTH && height >= ROI_SENSOR_HEIGHT)) {
+        return window;
+    }
+
+    window.x = (uint16_t)(configManager.getRoiX() + (configManager.getRoiWidth() - width) / 2);
+    window.y = (uint16_t)(configManager.getRoiY() + (configManager.getRoiHeight() - height) / 2);
+    window.width = (uint16_t)width;
+    window.height = (uint16_t)height;
+    return window;
+}
+
+// Schedule slot this capture belongs to (nearest), -1 without a clock
+int currentCaptureSlot() {
+    time_t now = time(nullptr);
+    if (now < VALID_EPOCH) {
+        return -1;
+    }
+
+    // Local time from the configured offsets (what configTime() is given), so
+    // the camera prep task gets the same slot before the TZ env is restored
+    time_t local = now + configManager.getGmtOffsetSec() + configManager.getDaylightOffsetSec();
+    struct tm timeinfo;
+    gmtime_r(&local, &timeinfo);
+    return configManager.findCaptureSlot(timeinfo.tm_hour, timeinfo.tm_min);
+}
+
+// Frame size and quality of a slot (-1 = defaults). With a region of interest
+// the window defines the output size, so only the quality is the slot's.
+static void slotCaptureProfile(int slot, framesize_t& frameSize, int& quality) {
+    frameSize = slot >= 0 ? (framesize_t)configManager.getCaptureFrameSize(slot) : CAMERA_FRAME_SIZE;
+    quality = slot >= 0 ? configManager.getCaptureQuality(slot) : CAMERA_JPEG_QUALITY;
+
+    capture_window_t window = captureWindow();
+    if (window.width) {
+        frameSize = CameraCapture::coveringFrameSize(window.width, window.height);
+    }
+}
+
+// Make the slot's frame size and quality the capture profile; the sensor
+// switches on the next warm-up or capture (CameraMutex held). Returns true if
+// the profile changed.
+bool selectSlotProfile(int slot) {
+    framesize_t frameSize;
+    int quality;
+    slotCaptureProfile(slot, frameSize, quality);
+    return CameraCapture::setCaptureProfile(frameSize, quality);
+}
+
+// Warm-up with the frame/time caps of the slot's policy (CameraMutex held)
+bool warmUpSensorForSlot(int slot) {
+    switch (slot >= 0 ? configManager.getWarmUpPolicy(slot) : WARMUP_NORMAL) {
+        case WARMUP_QUICK:
+            return CameraCapture::warmUpSensor(WARMUP_QUICK_MAX_FRAMES, WARMUP_QUICK_MAX_MS);
+        case WARMUP_THOROUGH:
+            return CameraCapture::warmUpSensor(WARMUP_THOROUGH_MAX_FRAMES, WARMUP_THOROUGH_MAX_MS);
+        case WARMUP_NORMAL:
+        default:
+            return CameraCapture::warmUpSensor(WARMUP_NORMAL_MAX_FRAMES, WARMUP_NORMAL_MAX_MS);
+    }
+}
 
 // ============================================================================
 // Camera Setup
 // ============================================================================
 
-void setupCamera() {
+// Hardware init and sensor defaults. Touches no shared state besides
+// cameraInitialized, the frame pool setup and the RTC exposure slots (not
+// used by the loop task until the prep task is joined) so it can run on the
+// camera prep task.
+static bool initCamera() {
     Serial.println("\n--- Camera Setup ---");
+    StageTimer::start(STAGE_CAMERA_INIT);
 
     camera_config_t config;
     config.ledc_channel = LEDC_CHANNEL_0;
@@ -31,28 +189,43 @@ void setupCamera() {
     config.pin_pwdn = PWDN_GPIO_NUM;
     config.pin_reset = RESET_GPIO_NUM;
     config.xclk_freq_hz = 20000000;
-    config.frame_size = CAMERA_FRAME_SIZE;
+
+    // The driver buffers must hold the largest frame of any schedule slot;
+    // with a region of interest only the smallest frame size covering it, the
+    // sensor window crops to it below. The sensor starts on the profile of
+    // the slot this wake belongs to.
+    capture_window_t window = captureWindow();
+    framesize_t frameSize = window.width ? CameraCapture::coveringFrameSize(window.width, window.height)
+                                         : (framesize_t)configManager.getMaxCaptureFrameSize();
+    int slot = currentCaptureSlot();
+    framesize_t slotFrameSize;
+    int slotQuality;
+    slotCaptureProfile(slot, slotFrameSize, slotQuality);
+    config.frame_size = frameSize;
     config.pixel_format = PIXFORMAT_JPEG;
     config.grab_mode = CAMERA_GRAB_LATEST;
     config.fb_location = CAMERA_FB_IN_PSRAM;
-    config.jpeg_quality = CAMERA_JPEG_QUALITY;
-    config.fb_count = 1;
+    config.jpeg_quality = slotQuality;
+    // Config mode with the warm camera task: second buffer so the sensor keeps
+    // streaming while one frame is held, GRAB_LATEST hands out the newest
+    config.fb_count = (currentMode == MODE_CONFIG && WARM_CAMERA_INTERVAL_MS > 0) ? 2 : 1;
 
     // Initialize camera
     esp_err_t err = esp_camera_init(&config);
     if (err != ESP_OK) {
         Serial.printf("Camera init failed with error 0x%x\n", err);
         cameraInitialized = false;
-
-        // In capture mode, count as failed attempt
-        if (currentMode == MODE_CAPTURE) {
-            sleepManager.incrementFailedCaptures();
-        }
-        return;
+        StageTimer::stop(STAGE_CAMERA_INIT);
+        return false;
     }
 
     cameraInitialized = true;
     Serial.println("Camera initialized successfully");
+    CameraCapture::setCaptureProfile(slotFrameSize, slotQuality);
+
+    // Slots sized like the driver's JPEG buffer (esp32-camera: width * height / 5)
+    FramePool::begin(FRAME_POOL_SLOTS,
+                     (size_t)resolution[frameSize].width * resolution[frameSize].height / 5);
 
     // Get sensor for additional settings
     sensor_t * s = esp_camera_sensor_get();
@@ -79,5 +252,117 @@ void setupCamera() {
         s->set_vflip(s, 0);          // 0 = disable , 1 = enable
         s->set_dcw(s, 1);            // 0 = disable , 1 = enable
         s->set_colorbar(s, 0);       // 0 = disable , 1 = enable
+
+        if (window.width) {
+            CameraCapture::setCaptureWindow(window);
+        } else {
+            CameraCapture::restoreCaptureProfile();  // Slot frame size below the buffer size
+        }
+        seedSensorExposure();
+    }
+
+    StageTimer::stop(STAGE_CAMERA_INIT);
+    return true;
+}
+
+void setupCamera() {
+    if (!initCamera()) {
+        // In capture mode, count as failed attempt
+        if (currentMode == MODE_CAPTURE) {
+            sleepManager.incrementFailedCaptures();
+        }
+    }
+}
+
+// ============================================================================
+// Camera Prep Task (timer wake)
+// ============================================================================
+
+// Camera init + warm-up run on core 0 while the loop task (core 1) brings up
+// WiFi, NTP and OTA. runCaptureMode() joins before the real capture, so the
+// awake time is the longer of the two stages instead of their sum.
+static SemaphoreHandle_t cameraPrepDone = nullptr;
+static const uint32_t CAMERA_PREP_STACK_SIZE = 8192;
+
+static void cameraPrepTask(void* param) {
+    unsigned long start = millis();
+    if (initCamera() && CameraMutex::lock(5000)) {
+        StageTimer::start(STAGE_WARMUP);
+        warmUpSensorForSlot(currentCaptureSlot());
+        StageTimer::stop(STAGE_WARMUP);
+        cameraWarmedUp = true;
+        CameraMutex::unlock();
+    }
+    Serial.printf("Camera prep finished in %lu ms\n", millis() - start);
+
+    xSemaphoreGive(cameraPrepDone);
+    vTaskDelete(NULL);
+}
+
+void startCameraPrep() {
+    cameraPrepDone = xSemaphoreCreateBinary();
+    if (cameraPrepDone &&
+        xTaskCreatePinnedToCore(cameraPrepTask, "camera_prep", CAMERA_PREP_STACK_SIZE,
+                                nullptr, 1, nullptr, 0) == pdPASS) {
+        return;
+    }
+
+    Serial.println("WARNING: Camera prep task not started, initializing inline");
+    if (cameraPrepDone) {
+        vSemaphoreDelete(cameraPrepDone);
+        cameraPrepDone = nullptr;
+    }
+    initCamera();
+}
+
+bool waitForCameraPrep(uint32_t timeoutMs) {
+    if (!cameraPrepDone) {
+        return cameraInitialized;
+    }
+
+    unsigned long start = millis();
+    if (xSemaphoreTake(cameraPrepDone, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+        // The task is stuck in the camera driver. It may hold CameraMutex and
+        // the sensor, and whenever it returns it sets cameraInitialized and
+        // gives cameraPrepDone. It cannot be stopped from here, so this wake
+        // ends without touching any camera state: deep sleep, or a restart
+        // into config mode after repeated failures, powers it down with the
+        // rest of the chip.
+        Serial.printf("ERROR: Camera prep not finished after %u ms\n", timeoutMs);
+        sleepManager.incrementFailedCaptures();
+        if (sleepManager.shouldStayAwake(3)) {
+            Serial.println("Too many failures - restarting into config mode");
+            delay(1000);
+            ESP.restart();
+        }
+        Serial.println("Skipping this capture");
+        enterSleepMode();
+        // Code never reaches here
+    }
+    Serial.printf("Camera prep joined (waited %lu ms)\n", millis() - start);
+
+    vSemaphoreDelete(cameraPrepDone);
+    cameraPrepDone = nullptr;
+    return cameraInitialized;
+}
+
+// ============================================================================
+// Warm Camera (config mode)
+// ============================================================================
+
+// Called from the config-mode loop. Runs the warm camera task while the web
+// UI is in use; stops it ahead of the web timeout (the device is about to
+// sleep or wait) and while /stream owns the sensor profile.
+void updateWarmCamera() {
+    if (WARM_CAMERA_INTERVAL_MS == 0 || !cameraInitialized || !webServer) {
+        return;
+    }
+
+    bool wanted = webServer->getRemainingSeconds() > WARM_CAMERA_STOP_BEFORE_TIMEOUT_SEC &&
+                  !webServer->isStreaming();
+    if (wanted && !WarmCamera::isRunning()) {
+        WarmCamera::start(WARM_CAMERA_INTERVAL_MS, WARM_CAMERA_CORE);
+    } else if (!wanted && WarmCamera::isRunning()) {
+        WarmCamera::stop();
     }
 }
@@ -1,8 +1,11 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <ESPmDNS.h>
+#include "freertos/event_groups.h"
+#include "config.h"
 #include "globals.h"
 #include "ConfigManager.h"
+#include "SleepManager.h"
 
 // ============================================================================
 // WiFi Setup Functions
@@ -83,6 +86,123 @@ void setupWiFiAPSTA() {
     Serial.println("===========================\n");
 }
 
+// ============================================================================
+// STA Connection (event-driven)
+// ============================================================================
+
+#define WIFI_CACHE_MAGIC 0x57494649  // "WIFI"
+
+// Set from the WiFi event task, waited on by the connecting task
+static EventGroupHandle_t wifiEvents = nullptr;
+static const EventBits_t WIFI_GOT_IP_BIT = (1 << 0);
+static const EventBits_t WIFI_DISCONNECTED_BIT = (1 << 1);
+
+static void onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            xEventGroupSetBits(wifiEvents, WIFI_GOT_IP_BIT);
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            xEventGroupSetBits(wifiEvents, WIFI_DISCONNECTED_BIT);
+            break;
+        default:
+            break;
+    }
+}
+
+static void initWiFiEvents() {
+    if (wifiEvents) {
+        return;
+    }
+    wifiEvents = xEventGroupCreate();
+    WiFi.onEvent(onWiFiEvent);
+}
+
+// Blocks until GOT_IP or the timeout. A disconnect ends the wait only when
+// failOnDisconnect is set; otherwise the core's auto-reconnect gets the full
+// timeout to recover (e.g. AP busy on the first attempt).
+static bool waitForWiFi(unsigned long timeoutMs, bool failOnDisconnect) {
+    unsigned long start = millis();
+    while (true) {
+        unsigned long elapsed = millis() - start;
+        if (elapsed >= timeoutMs) {
+            return WiFi.status() == WL_CONNECTED;
+        }
+
+        EventBits_t bits = xEventGroupWaitBits(wifiEvents, WIFI_GOT_IP_BIT | WIFI_DISCONNECTED_BIT,
+                                               pdTRUE, pdFALSE, pdMS_TO_TICKS(timeoutMs - elapsed));
+        if (bits & WIFI_GOT_IP_BIT) {
+            return true;
+        }
+        if ((bits & WIFI_DISCONNECTED_BIT) && failOnDisconnect) {
+            return false;
+        }
+    }
+}
+
+static uint32_t hashCredentials(const char* ssid, const char* password) {
+    // FNV-1a over SSID, separator, password
+    uint32_t hash = 2166136261u;
+    for (const char* p = ssid; *p; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash = (hash ^ 0) * 16777619u;
+    for (const char* p = password; *p; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    return hash;
+}
+
+// Remember the association and DHCP lease for the next timer wake
+static void saveWiFiCache(const char* ssid, const char* password) {
+    rtc_wifi_cache_t* cache = sleepManager.getWifiCache();
+    uint8_t* bssid = WiFi.BSSID();
+    if (!bssid) {
+        return;
+    }
+
+    memcpy(cache->bssid, bssid, sizeof(cache->bssid));
+    cache->channel = (uint8_t)WiFi.channel();
+    cache->localIp = (uint32_t)WiFi.localIP();
+    cache->gateway = (uint32_t)WiFi.gatewayIP();
+    cache->subnet = (uint32_t)WiFi.subnetMask();
+    cache->dns1 = (uint32_t)WiFi.dnsIP(0);
+    cache->dns2 = (uint32_t)WiFi.dnsIP(1);
+    cache->credentialsHash = hashCredentials(ssid, password);
+    cache->savedAt = time(nullptr);
+    cache->magic = WIFI_CACHE_MAGIC;
+}
+
+static bool isWiFiCacheUsable(const char* ssid, const char* password) {
+    rtc_wifi_cache_t* cache = sleepManager.getWifiCache();
+    if (cache->magic != WIFI_CACHE_MAGIC || cache->credentialsHash != hashCredentials(ssid, password)) {
+        return false;
+    }
+
+    // The lease was obtained before NTP (config mode boot): start its age now
+    static const time_t VALID_EPOCH = 1600000000;
+    time_t now = time(nullptr);
+    if (now > VALID_EPOCH && cache->savedAt < VALID_EPOCH) {
+        cache->savedAt = now;
+    }
+    if (now > VALID_EPOCH && now - cache->savedAt > WIFI_FAST_CONNECT_MAX_AGE_SEC) {
+        Serial.println("Cached IP lease expired, renewing via DHCP");
+        return false;
+    }
+    return true;
+}
+
+static void onStaConnected(const String& hostname) {
+    Serial.printf("IP address: %s\n", WiFi.localIP().toString().c_str());
+    Serial.printf("Signal strength: %d dBm\n", WiFi.RSSI());
+    Serial.printf("Hostname: %s\n", hostname.c_str());
+    if (!MDNS.begin(hostname.c_str())) {
+        Serial.println("WARNING: mDNS start failed");
+    } else {
+        Serial.printf("mDNS: http://%s.local/\n", hostname.c_str());
+    }
+}
+
 bool setupWiFiSTA() {
     Serial.println("\n--- WiFi STA Setup ---");
 
@@ -94,30 +214,61 @@ bool setupWiFiSTA() {
     // setHostname() must be called BEFORE WiFi.begin() so that the DHCP
     // DISCOVER/REQUEST packets carry the desired hostname option.
     String hostname = resolveHostname();
+    initWiFiEvents();
     WiFi.mode(WIFI_STA);
     WiFi.setHostname(hostname.c_str());
-    WiFi.begin(ssid, password);
 
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 30) {
-        delay(500);
-        Serial.print(".");
-        attempts++;
-    }
+    unsigned long start = millis();
+    xEventGroupClearBits(wifiEvents, WIFI_GOT_IP_BIT | WIFI_DISCONNECTED_BIT);
+    WiFi.begin(ssid, password);
 
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\nWiFi connected!");
-        Serial.printf("IP address: %s\n", WiFi.localIP().toString().c_str());
-        Serial.printf("Signal strength: %d dBm\n", WiFi.RSSI());
-        Serial.printf("Hostname: %s\n", hostname.c_str());
-        if (!MDNS.begin(hostname.c_str())) {
-            Serial.println("WARNING: mDNS start failed");
-        } else {
-            Serial.printf("mDNS: http://%s.local/\n", hostname.c_str());
-        }
+    if (waitForWiFi(WIFI_CONNECT_TIMEOUT_MS, false)) {
+        Serial.printf("WiFi connected! (%lu ms)\n", millis() - start);
+        saveWiFiCache(ssid, password);
+        onStaConnected(hostname);
         return true;
     } else {
-        Serial.println("\nWiFi connection failed!");
+        Serial.println("WiFi connection failed!");
         return false;
     }
 }
+
+bool setupWiFiFastConnect() {
+    const char* ssid = configManager.getWifiSsid();
+    const char* password = configManager.getWifiPassword();
+
+    if (!isWiFiCacheUsable(ssid, password)) {
+        return setupWiFiSTA();
+    }
+
+    Serial.println("\n--- WiFi Fast Connect ---");
+    rtc_wifi_cache_t* cache = sleepManager.getWifiCache();
+    Serial.printf("Connecting to: %s (channel %u, cached IP %s)\n", ssid, cache->channel,
+                  IPAddress(cache->localIp).toString().c_str());
+
+    String hostname = resolveHostname();
+    initWiFiEvents();
+    WiFi.mode(WIFI_STA);
+    WiFi.setHostname(hostname.c_str());
+
+    // Static config from the cached lease skips DHCP; channel + BSSID skip the scan
+    WiFi.config(IPAddress(cache->localIp), IPAddress(cache->gateway), IPAddress(cache->subnet),
+                IPAddress(cache->dns1), IPAddress(cache->dns2));
+
+    unsigned long start = millis();
+    xEventGroupClearBits(wifiEvents, WIFI_GOT_IP_BIT | WIFI_DISCONNECTED_BIT);
+    WiFi.begin(ssid, password, cache->channel, cache->bssid);
+
+    if (waitForWiFi(WIFI_FAST_CONNECT_TIMEOUT_MS, true)) {
+        Serial.printf("WiFi connected via fast connect! (%lu ms)\n", millis() - start);
+        onStaConnected(hostname);
+        return true;
+    }
+
+    // AP moved to another channel/BSSID or lease no longer valid: full scan + DHCP
+    Serial.printf("Fast connect failed after %lu ms, falling back to full scan\n", millis() - start);
+    cache->magic = 0;
+    WiFi.disconnect();
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    return setupWiFiSTA();
+}
@@ -0,0 +1,998 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include <memory>
+#include <vector>
+#include "config.h"
+#include "globals.h"
+#include "ConfigManager.h"
+#include "SleepManager.h"
+#include "OTAManager.h"
+#include "RemoteLogger.h"
+#include "TlsSessionClient.h"
+#include "ImageQueue.h"
+#include "StageTimer.h"
+#include "MultipartBody.h"
+#include "UploadResponse.h"
+#include "ImageDigest.h"
+
+// ============================================================================
+// Upload Pre-connect (timer wake)
+// ============================================================================
+
+// DNS, TCP connect and the TLS handshake of the live upload run in their own
+// task while the camera prep task warms up the sensor. The first upload of the
+// wake joins it and hands the open connection to HTTPClient, which reuses a
+// connected client instead of connecting again. If the pre-connect failed or
+// the server closed the connection meanwhile, the upload connects as before.
+//
+// The task owns nothing global: client, semaphore and target live in a heap
+// job. An upload that gives up waiting marks the job abandoned under
+// preconnectLock, and the task frees it once connect() returns.
+struct PreconnectJob {
+    TlsSessionClient* client;
+    SemaphoreHandle_t done;   // Given by the task when connect() returned
+    String host;
+    uint16_t port;
+    bool abandoned;           // The upload stopped waiting, the task frees the job
+};
+
+static PreconnectJob* preconnectJob = nullptr;
+static SemaphoreHandle_t preconnectLock = nullptr;  // Guards PreconnectJob::abandoned, never deleted
+static const uint32_t PRECONNECT_STACK_SIZE = 8192;
+
+static void freePreconnectJob(PreconnectJob* job) {
+    vSemaphoreDelete(job->done);
+    delete job->client;
+    delete job;
+}
+
+static void preconnectTask(void* param) {
+    PreconnectJob* job = static_cast<PreconnectJob*>(param);
+    unsigned long start = millis();
+    if (job->client->connect(job->host.c_str(), job->port)) {
+        Serial.printf("[Upload] Pre-connected to %s:%u in %lu ms (%s)\n", job->host.c_str(),
+                      job->port, millis() - start,
+                      job->client->sessionResumed() ? "resumed" : "full handshake");
+    } else {
+        Serial.printf("[Upload] Pre-connect to %s:%u failed\n", job->host.c_str(), job->port);
+    }
+
+    xSemaphoreTake(preconnectLock, portMAX_DELAY);
+    bool abandoned = job->abandoned;
+    if (!abandoned) {
+        xSemaphoreGive(job->done);
+    }
+    xSemaphoreGive(preconnectLock);
+    if (abandoned) {
+        freePreconnectJob(job);
+    }
+    vTaskDelete(NULL);
+}
+
+void startUploadPreconnect() {
+    if (!UPLOAD_PRECONNECT_ENABLED || preconnectJob) {
+        return;
+    }
+
+    // scheme://host[:port][/path], same defaults as HTTPClient
+    String url = configManager.getServerUrl();
+    int hostStart = url.indexOf("://");
+    if (hostStart < 0) {
+        return;
+    }
+    uint16_t port = url.startsWith("https") ? 443 : 80;
+    hostStart += 3;
+    int hostEnd = url.indexOf('/', hostStart);
+    if (hostEnd < 0) {
+        hostEnd = url.length();
+    }
+    int colon = url.indexOf(':', hostStart);
+    if (colon >= 0 && colon < hostEnd) {
+        port = url.substring(colon + 1, hostEnd).toInt();
+        hostEnd = colon;
+    }
+    String host = url.substring(hostStart, hostEnd);
+    if (host.length() == 0 || port == 0) {
+        return;
+    }
+
+    if (!preconnectLock) {
+        preconnectLock = xSemaphoreCreateMutex();
+    }
+    PreconnectJob* job = new PreconnectJob{new TlsSessionClient(), xSemaphoreCreateBinary(), host, port, false};
+    job->client->setInsecure(); // For testing; use proper certificate validation in production
+    job->client->setSessionCache(sleepManager.getTlsSessionCache());
+
+    if (preconnectLock && job->done &&
+        xTaskCreatePinnedToCore(preconnectTask, "upload_preconnect", PRECONNECT_STACK_SIZE,
+                                job, 1, nullptr, 1) == pdPASS) {
+        preconnectJob = job;
+        return;
+    }
+
+    Serial.println("WARNING: Upload pre-connect task not started");
+    if (job->done) {
+        vSemaphoreDelete(job->done);
+    }
+    delete job->client;
+    delete job;
+}
+
+/**
+ * Join the pre-connect task and take over its connection
+ * @param waitedMs Receives the time spent waiting for the handshake to finish
+ * @return Connected client (owned by the caller), nullptr if there is none
+ */
+static TlsSessionClient* takePreconnectedClient(uint32_t& waitedMs) {
+    waitedMs = 0;
+    PreconnectJob* job = preconnectJob;
+    if (!job) {
+        return nullptr;
+    }
+    preconnectJob = nullptr;
+
+    unsigned long start = millis();
+    if (xSemaphoreTake(job->done, pdMS_TO_TICKS(UPLOAD_PRECONNECT_WAIT_MS)) != pdTRUE) {
+        // Task is stuck in the handshake and still uses the job: hand it over,
+        // unless connect() returned right now
+        xSemaphoreTake(preconnectLock, portMAX_DELAY);
+        bool finished = xSemaphoreTake(job->done, 0) == pdTRUE;
+        job->abandoned = !finished;
+        xSemaphoreGive(preconnectLock);
+        if (!finished) {
+            Serial.printf("[Upload] Pre-connect not finished after %u ms, connecting again\n",
+                          UPLOAD_PRECONNECT_WAIT_MS);
+            return nullptr;
+        }
+    }
+    waitedMs = millis() - start;
+
+    TlsSessionClient* client = job->client;
+    job->client = nullptr;
+    freePreconnectJob(job);
+    if (!client->connected()) {
+        delete client;
+        return nullptr;
+    }
+    Serial.printf("[Upload] Using pre-connected client (waited %u ms)\n", waitedMs);
+    return client;
+}
+
+// ============================================================================
+// Image Upload
+// ============================================================================
+
+/**
+ * Report TLS session resumption result and savings to the server log
+ * @param preconnected True if the handshake ran ahead in the pre-connect task
+ */
+static void logTlsHandshake(const TlsSessionClient& client, bool preconnected) {
+    if (client.getHandshakeMs() == 0) {
+        return;  // No handshake completed
+    }
+
+    const rtc_tls_session_t* cache = sleepManager.getTlsSessionCache();
+    DynamicJsonDocument doc(256);
+    JsonObject context = doc.to<JsonObject>();
+    context["resumed"] = client.sessionResumed();
+    context["preconnected"] = preconnected;
+    context["handshake_ms"] = client.getHandshakeMs();
+    context["saved_ms"] = client.getSavedMs();
+    context["resumed_total"] = cache->resumedCount;
+    context["full_total"] = cache->fullCount;
+    context["saved_ms_total"] = cache->savedMsTotal;
+    RemoteLogger::info("TLS", client.sessionResumed() ? "Session resumed" : "Full handshake", context);
+}
+
+/**
+ * Parse the body of a 2xx upload.php answer once, straight from the socket;
+ * a chunked body has to be de-chunked by HTTPClient first
+ */
+static void readUploadResponse(HTTPClient& http, UploadResponse& response) {
+    if (http.getSize() >= 0) {
+        UploadResponseParser::parse(*http.getStreamPtr(), response);
+    } else {
+        UploadResponseParser::parse(http.getString(), response);
+    }
+}
+
+/**
+ * Set the headers of an upload.php request
+ * @param timed Add the stage breakdown of this wake (X-Wake-Timing)
+ */
+static void addUploadHeaders(HTTPClient& http, const String& contentType, const String& timestamp,
+                             const QueuedImage* queued, const char* sceneDistance, bool timed) {
+    http.addHeader("Content-Type", contentType);
+    http.addHeader("X-Auth-Token", configManager.getAuthToken());
+    http.addHeader("X-Device-ID", WiFi.macAddress());
+    http.addHeader("X-Firmware-Version", otaManager.getFirmwareVersion());
+    http.addHeader("X-Timestamp", timestamp);
+    if (queued) {
+        http.addHeader("X-Queue-Retries", String(queued->header.retries));
+        http.addHeader("X-Capture-Firmware", queued->header.firmware);
+    }
+    if (sceneDistance) {
+        http.addHeader("X-Capture-Status", "unchanged");
+        http.addHeader("X-Scene-Distance", sceneDistance);
+    }
+    if (timed) {
+        http.addHeader("X-Wake-Timing", StageTimer::header());
+    }
+}
+
+/**
+ * POST one JPEG, or an "unchanged" heartbeat without body, to upload.php.
+ * With a thumbnail, both go as multipart/form-data parts "image" and
+ * "thumbnail", read straight from their buffers.
+ * @param queued Queue entry when re-sending a stored image, nullptr for a live capture
+ * @param sceneDistance Heartbeat only: distance to the last uploaded frame
+ * @param thumbnail Optional thumbnail JPEG (nullptr = raw JPEG body)
+ * @param sha256 Optional SHA-256 of the JPEG, sent in X-Content-SHA256
+ * @param response Receives the parsed response of a 2xx answer
+ * @return HTTP status code, or a negative HTTPClient error code
+ */
+static int postUpload(const uint8_t* buf, size_t len, const String& timestamp, UploadResponse& response,
+                      const QueuedImage* queued, const char* sceneDistance,
+                      const uint8_t* thumbnail, size_t thumbnailLen, const uint8_t* sha256) {
+    // Prepare HTTPS POST
+    Serial.println(sceneDistance ? "\n--- Sending Heartbeat ---" : "\n--- Uploading Image ---");
+    uint32_t preconnectWaitMs;
+    std::unique_ptr<TlsSessionClient> preconnected(takePreconnectedClient(preconnectWaitMs));
+    TlsSessionClient localClient;
+    TlsSessionClient& client = preconnected ? *preconnected : localClient;
+    client.setInsecure(); // For testing; use proper certificate validation in production
+    client.setSessionCache(sleepManager.getTlsSessionCache());
+
+    HTTPClient http;  // Declared after the clients: its destructor still stops the connection
+
+    // Build upload URL from base URL (base URL can include path like /cams)
+    String uploadUrl = String(configManager.getServerUrl()) + "/upload.php";
+
+    MultipartBody body;
+    if (thumbnail) {
+        body.addData("image", "image.jpg", buf, len);
+        body.addData("thumbnail", "thumbnail.jpg", thumbnail, thumbnailLen);
+        body.finish();
+    }
+    String contentType = thumbnail ? body.contentType() : String("image/jpeg");
+
+    // Stage breakdown of this wake (the live image of a timer wake only)
+    bool timed = !queued && currentMode == MODE_CAPTURE;
+
+    char sha256Hex[ImageDigest::SIZE * 2 + 1];
+    if (sha256) {
+        ImageDigest::toHex(sha256, sha256Hex);
+    }
+
+    http.begin(client, uploadUrl);
+    addUploadHeaders(http, contentType, timestamp, queued, sceneDistance, timed);
+    if (sha256) {
+        http.addHeader("X-Content-SHA256", sha256Hex);
+    }
+
+    // Send POST request
+    uint32_t postStart = millis();
+    int httpResponseCode = thumbnail ? http.sendRequest("POST", &body, body.length())
+                                     : http.POST((uint8_t*)buf, len);
+
+    uint32_t connectedAt = client.getConnectedAtMs();
+    uint32_t lastWriteAt = client.getLastWriteAtMs();
+    // HTTPClient connects again if the pre-connected client was closed meanwhile
+    bool reused = preconnected && connectedAt != 0 && connectedAt <= postStart;
+    if (timed && connectedAt != 0) {
+        // A reused connection was ready before the POST started: only the
+        // wait for its handshake is on the critical path
+        uint32_t sendStart = reused ? postStart : connectedAt;
+        StageTimer::add(STAGE_TLS, reused ? preconnectWaitMs : connectedAt - postStart);
+        if (lastWriteAt >= sendStart) {
+            StageTimer::add(STAGE_SEND, lastWriteAt - sendStart);
+            StageTimer::add(STAGE_RESPONSE, millis() - lastWriteAt);
+        }
+    }
+
+    logTlsHandshake(client, reused);
+
+    // Check response
+    response = UploadResponse();
+    if (httpResponseCode > 0) {
+        Serial.printf("HTTP Response code: %d\n", httpResponseCode);
+
+        if (httpResponseCode >= 200 && httpResponseCode < 300) {
+            readUploadResponse(http, response);
+            Serial.printf("Response: success %s, OTA %s\n", response.success ? "yes" : "no",
+                          response.ota.available ? "offered" : "none");
+            if (response.duplicate) {
+                Serial.println("✓ Server already has this image");
+            } else {
+                Serial.println(sceneDistance ? "✓ Heartbeat sent" : "✓ Image uploaded successfully!");
+            }
+        } else {
+            Serial.println("Response: " + http.getString());
+            Serial.println("✗ Upload failed with HTTP error");
+        }
+    } else {
+        Serial.printf("✗ Upload failed: %s\n", http.errorToString(httpResponseCode).c_str());
+    }
+
+    http.end();
+    return httpResponseCode;
+}
+
+// ============================================================================
+// Resumable Upload
+// ============================================================================
+
+// Images of UPLOAD_RESUMABLE_MIN_BYTES and more go to upload-resumable.php in
+// UPLOAD_RESUMABLE_CHUNK_BYTES pieces. The server keeps every byte that
+// arrived, so after a broken connection the upload asks for the stored offset
+// and continues from there: within the wake on a new connection, and on a
+// later wake from the queue, with the session kept in RTC memory.
+#define RESUMABLE_UPLOAD_MAGIC 0x52555053  // "RUPS"
+
+static bool resumableUnsupported = false;  // Server has no upload-resumable.php (this wake)
+
+/**
+ * JPEG sent through a resumable session: a frame in memory or a queue entry on flash
+ */
+struct ResumableSource {
+    const uint8_t* data = nullptr;  // Frame in memory, nullptr for a queue entry
+    File file;                      // Queue entry, JPEG at offset sizeof(queued_image_header_t)
+    size_t length = 0;
+};
+
+static rtc_resumable_upload_t* resumableState() {
+    rtc_resumable_upload_t* state = sleepManager.getResumableUploadCache();
+    if (state->magic != RESUMABLE_UPLOAD_MAGIC) {
+        memset(state, 0, sizeof(rtc_resumable_upload_t));
+        state->magic = RESUMABLE_UPLOAD_MAGIC;
+    }
+    return state;
+}
+
+static bool isSameImage(const rtc_resumable_upload_t& session, size_t length, const char* timestamp) {
+    return session.session[0] && session.length == length && strcmp(session.timestamp, timestamp) == 0;
+}
+
+/**
+ * Keep the session of an upload that broke off for a later wake, or drop
+ * the stored one once its image was delivered or rejected
+ */
+static void saveResumableSession(const rtc_resumable_upload_t& session) {
+    rtc_resumable_upload_t* state = resumableState();
+    if (session.session[0]) {
+        int16_t rejectedStatus = state->rejectedStatus;
+        memcpy(state, &session, sizeof(rtc_resumable_upload_t));
+        state->magic = RESUMABLE_UPLOAD_MAGIC;
+        state->rejectedStatus = rejectedStatus;
+    } else if (isSameImage(*state, session.length, session.timestamp)) {
+        state->session[0] = '\0';
+    }
+}
+
+/**
+ * Remember whether the server rejected an image for its headers alone
+ * (bad token, disabled camera, too large). PHP reads a POST body before
+ * upload.php runs, so upload.php cannot turn such an image away before it
+ * was transferred. A session open carries no image bytes: while the
+ * rejection lasts, postImage() sends every image through one, and a
+ * camera that stays rejected costs a few hundred bytes per wake.
+ */
+static void rememberRejection(int code) {
+    bool rejected = code == 401 || code == 403 || code == 413;
+    if (rejected || (code >= 200 && code < 300)) {
+        resumableState()->rejectedStatus = rejected ? code : 0;
+    }
+}
+
+/**
+ * Set the headers every upload-resumable.php request carries
+ */
+static void addSessionHeaders(HTTPClient& http) {
+    http.addHeader("X-Auth-Token", configManager.getAuthToken());
+    http.addHeader("X-Device-ID", WiFi.macAddress());
+    http.addHeader("X-Firmware-Version", otaManager.getFirmwareVersion());
+}
+
+/**
+ * Read the offset the server has stored from a session answer
+ * ({"session": "...", "offset": n, ...}); a completed session also carries
+ * the upload.php response fields
+ * @param session Receives the session ID if the answer has one
+ * @param response Receives the upload.php fields once the image is complete
+ * @return Stored offset, -1 if the answer has none
+ */
+static int64_t readSessionOffset(HTTPClient& http, rtc_resumable_upload_t& session, UploadResponse& response) {
+    String body = http.getString();
+    StaticJsonDocument<256> filter;
+    filter["session"] = true;
+    filter["offset"] = true;
+    StaticJsonDocument<256> doc;
+    if (deserializeJson(doc, body, DeserializationOption::Filter(filter))) {
+        return -1;
+    }
+    const char* id = doc["session"] | "";
+    if (id[0]) {
+        snprintf(session.session, sizeof(session.session), "%s", id);
+    }
+    int64_t offset = doc["offset"] | -1LL;
+    if (offset >= 0 && (uint32_t)offset >= session.length) {
+        UploadResponseParser::parse(body, response);
+    }
+    return offset;
+}
+
+/**
+ * Add the request and response time of one request of a resumable upload
+ */
+static void addRequestTiming(const TlsSessionClient& client, uint32_t requestStart,
+                             uint32_t& sendMs, uint32_t& responseMs) {
+    uint32_t start = max(requestStart, client.getConnectedAtMs());
+    uint32_t lastWriteAt = client.getLastWriteAtMs();
+    if (lastWriteAt >= start) {
+        sendMs += lastWriteAt - start;
+        responseMs += millis() - lastWriteAt;
+    }
+}
+
+/**
+ * Open the session of an image (POST). The server answers with the offset
+ * it already has if the same image was started before.
+ * @param thumbnail Optional thumbnail JPEG, sent as the request body
+ * @param timed Add the stage breakdown of this wake (X-Wake-Timing)
+ * @param offset Receives the stored offset
+ * @return HTTP status code, or a negative HTTPClient error code
+ */
+static int openResumableSession(HTTPClient& http, TlsSessionClient& client, const String& url,
+                                rtc_resumable_upload_t& session, const QueuedImage* queued,
+                                const uint8_t* thumbnail, size_t thumbnailLen, bool timed,
+                                int64_t& offset, UploadResponse& response) {
+    char sha256[ImageDigest::SIZE * 2 + 1];
+    ImageDigest::toHex(session.sha256, sha256);
+
+    http.begin(client, url);
+    addUploadHeaders(http, "image/jpeg", session.timestamp, queued, nullptr, timed);
+    http.addHeader("X-Upload-Length", String(session.length));
+    http.addHeader("X-Content-SHA256", sha256);
+    int code = http.sendRequest("POST", (uint8_t*)thumbnail, thumbnail ? thumbnailLen : 0);
+    if (code >= 200 && code < 300) {
+        offset = readSessionOffset(http, session, response);
+        if (offset < 0 || !session.session[0]) {
+            Serial.println("✗ Resumable session answer not understood");
+            return HTTPC_ERROR_NO_HTTP_SERVER;
+        }
+        Serial.printf("[Upload] Session %s opened, server has %u of %u bytes\n",
+                      session.session, (unsigned)offset, session.length);
+    } else if (code > 0) {
+        Serial.println("Response: " + http.getString());
+    }
+    http.end();
+    return code;
+}
+
+/**
+ * Ask for the offset the server has stored of an open session (GET)
+ * @return HTTP status code (404 = session unknown or expired), or a negative HTTPClient error code
+ */
+static int queryResumableSession(HTTPClient& http, TlsSessionClient& client, const String& url,
+                                 rtc_resumable_upload_t& session, int64_t& offset,
+                                 UploadResponse& response) {
+    http.begin(client, url + "?session=" + session.session);
+    addSessionHeaders(http);
+    int code = http.GET();
+    if (code >= 200 && code < 300) {
+        offset = readSessionOffset(http, session, response);
+        if (offset < 0) {
+            Serial.println("✗ Resumable session answer not understood");
+            return HTTPC_ERROR_NO_HTTP_SERVER;
+        }
+        Serial.printf("[Upload] Resuming session %s, server has %u of %u bytes\n",
+                      session.session, (unsigned)offset, session.length);
+    } else if (code > 0) {
+        http.getString();
+    }
+    http.end();
+    return code;
+}
+
+/**
+ * Send the JPEG bytes [offset, offset + length) of a session (PUT)
+ * @param stored Receives the offset the server has stored after the request
+ *               (also on 409, when `offset` was not the server's)
+ * @param response Receives the upload.php fields when this was the last chunk
+ * @return HTTP status code, or a negative HTTPClient error code
+ */
+static int putResumableChunk(HTTPClient& http, TlsSessionClient& client, const String& url,
+                             rtc_resumable_upload_t& session, ResumableSource& source,
+                             uint32_t offset, size_t length, int64_t& stored, UploadResponse& response) {
+    http.begin(client, url + "?session=" + session.session);
+    addSessionHeaders(http);
+    http.addHeader("Content-Type", "application/octet-stream");
+    http.addHeader("X-Upload-Offset", String(offset));
+
+    int code;
+    if (source.data) {
+        code = http.sendRequest("PUT", (uint8_t*)source.data + offset, length);
+    } else {
+        source.file.seek(sizeof(queued_image_header_t) + offset);
+        code = http.sendRequest("PUT", &source.file, length);
+    }
+
+    stored = -1;
+    if (code >= 200 && code < 300 && offset + length == session.length) {
+        readUploadResponse(http, response);
+        stored = session.length;
+    } else if ((code >= 200 && code < 300) || code == 409) {
+        stored = readSessionOffset(http, session, response);
+    } else if (code > 0) {
+        Serial.println("Response: " + http.getString());
+    }
+    http.end();
+    return code;
+}
+
+/**
+ * Send a JPEG through upload-resumable.php: open the session (or ask an open
+ * one for its offset), then PUT chunks from the server's offset on. A broken
+ * connection is replaced up to UPLOAD_RESUMABLE_ATTEMPTS times.
+ * @param session Session state of this image (sha256, length and timestamp set);
+ *                the session ID is cleared once the image is delivered or rejected
+ * @param queued Queue entry when re-sending a stored image, nullptr for a live capture
+ * @param thumbnail Optional thumbnail JPEG, sent when the session is opened
+ * @param response Receives the parsed response of the completed upload
+ * @return HTTP status code, or a negative HTTPClient error code
+ */
+static int postResumable(ResumableSource& source, rtc_resumable_upload_t& session,
+                         UploadResponse& response, const QueuedImage* queued,
+                         const uint8_t* thumbnail, size_t thumbnailLen) {
+    Serial.printf("\n--- Uploading Image (resumable, %u bytes) ---\n", session.length);
+    String url = String(configManager.getServerUrl()) + "/upload-resumable.php";
+    bool timed = !queued && currentMode == MODE_CAPTURE;
+    uint32_t tlsMs = 0;
+    uint32_t sendMs = 0;
+    uint32_t responseMs = 0;
+    int64_t offset = 0;
+    bool chunked = false;
+    int code = HTTPC_ERROR_CONNECTION_REFUSED;
+    response = UploadResponse();
+
+    for (uint32_t attempt = 0; attempt < UPLOAD_RESUMABLE_ATTEMPTS; attempt++) {
+        uint32_t preconnectWaitMs = 0;
+        std::unique_ptr<TlsSessionClient> preconnected(attempt == 0 ? takePreconnectedClient(preconnectWaitMs)
+                                                                    : nullptr);
+        TlsSessionClient localClient;
+        TlsSessionClient& client = preconnected ? *preconnected : localClient;
+        client.setInsecure(); // For testing; use proper certificate validation in production
+        client.setSessionCache(sleepManager.getTlsSessionCache());
+        HTTPClient http;  // Declared after the clients: its destructor still stops the connection
+
+        // Where does the server stand?
+        uint32_t attemptStart = millis();
+        code = HTTPC_ERROR_CONNECTION_REFUSED;
+        if (session.session[0]) {
+            code = queryResumableSession(http, client, url, session, offset, response);
+            if (code == 404) {
+                Serial.println("[Upload] Session unknown to the server, starting over");
+                session.session[0] = '\0';
+            }
+        }
+        if (!session.session[0]) {
+            code = openResumableSession(http, client, url, session, queued, thumbnail, thumbnailLen,
+                                        timed, offset, response);
+        }
+        addRequestTiming(client, attemptStart, sendMs, responseMs);
+        if (code >= 200 && code < 300) {
+            session.committed = (uint32_t)offset;
+        }
+
+        uint32_t connectedAt = client.getConnectedAtMs();
+        bool reused = preconnected && connectedAt != 0 && connectedAt <= attemptStart;
+        tlsMs += reused ? preconnectWaitMs : (connectedAt >= attemptStart ? connectedAt - attemptStart : 0);
+        logTlsHandshake(client, reused);
+
+        // Chunks from the server's offset on; a 409 corrects the offset
+        while (code >= 200 && code < 300 && offset < session.length) {
+            size_t length = min(UPLOAD_RESUMABLE_CHUNK_BYTES, (size_t)(session.length - offset));
+            int64_t stored = -1;
+            uint32_t requestStart = millis();
+            code = putResumableChunk(http, client, url, session, source, (uint32_t)offset, length,
+                                     stored, response);
+            addRequestTiming(client, requestStart, sendMs, responseMs);
+            chunked = true;
+            if ((code >= 200 && code < 300) || code == 409) {
+                if (stored < 0) {
+                    Serial.println("✗ Resumable session answer not understood");
+                    code = HTTPC_ERROR_NO_HTTP_SERVER;
+                    break;
+                }
+                offset = stored;
+                session.committed = (uint32_t)offset;
+                code = 200;
+            }
+        }
+
+        if (code >= 200 && code < 300) {
+            Serial.printf("HTTP Response code: %d (%u attempt(s))\n", code, attempt + 1);
+            Serial.printf("Response: success %s, OTA %s\n", response.success ? "yes" : "no",
+                          response.ota.available ? "offered" : "none");
+            Serial.println("✓ Image uploaded successfully!");
+            session.session[0] = '\0';
+            break;
+        }
+        if (code > 0) {
+            // The server refused the session or a chunk (or the checksum of the
+            // whole image): sending again will not help, except for 408/429/5xx
+            Serial.printf("✗ Resumable upload failed with HTTP %d\n", code);
+            if (code >= 400 && code < 500 && code != 408 && code != 429) {
+                session.session[0] = '\0';
+            }
+            break;
+        }
+        if (client.getConnectedAtMs() == 0) {
+            Serial.printf("✗ Upload failed: %s\n", http.errorToString(code).c_str());
+            break;  // Server not reachable: nothing to resume
+        }
+        Serial.printf("[Upload] Connection lost at %u of %u bytes: %s\n", session.committed,
+                      session.length, http.errorToString(code).c_str());
+    }
+
+    // An old server's 404 is followed by a plain upload.php request that has
+    // its own timing. Without a chunk (rejected, or a duplicate) only the
+    // thumbnail went out: that says nothing about the link, all is response
+    if (timed && code != 404 && code != 405) {
+        StageTimer::add(STAGE_TLS, tlsMs);
+        if (chunked) {
+            StageTimer::add(STAGE_SEND, sendMs);
+        }
+        StageTimer::add(STAGE_RESPONSE, chunked ? responseMs : sendMs + responseMs);
+    }
+    return code;
+}
+
+// ============================================================================
+// Upload Entry Points
+// ============================================================================
+
+int postImage(const uint8_t* buf, size_t len, const String& timestamp, UploadResponse& response,
+              const QueuedImage* queued, const uint8_t* thumbnail, size_t thumbnailLen,
+              const uint8_t* sha256) {
+    // Last image rejected: open a session first, without the thumbnail
+    int16_t rejectedStatus = resumableState()->rejectedStatus;
+    bool resumable = UPLOAD_RESUMABLE_ENABLED && !resumableUnsupported &&
+                     (len >= UPLOAD_RESUMABLE_MIN_BYTES || rejectedStatus != 0);
+
+    // Digest of X-Content-SHA256; the live capture hashes on the other core
+    // (see ImageDigest), a queued image here
+    uint8_t digest[ImageDigest::SIZE];
+    if (!sha256 && (UPLOAD_SHA256_ENABLED || resumable)) {
+        ImageDigest::compute(buf, len, digest);
+        sha256 = digest;
+    }
+
+    if (resumable) {
+        // A queued image sent one by one may continue the stored session
+        rtc_resumable_upload_t session = {};
+        const rtc_resumable_upload_t* state = resumableState();
+        if (isSameImage(*state, len, timestamp.c_str())) {
+            session = *state;
+        } else {
+            memcpy(session.sha256, sha256, sizeof(session.sha256));
+            session.length = len;
+            snprintf(session.timestamp, sizeof(session.timestamp), "%s", timestamp.c_str());
+        }
+
+        if (rejectedStatus != 0) {
+            Serial.printf("[Upload] Last image was rejected (HTTP %d), checking with a session open\n",
+                          rejectedStatus);
+            thumbnail = nullptr;
+        }
+
+        ResumableSource source;
+        source.data = buf;
+        source.length = len;
+        int code = postResumable(source, session, response, queued, thumbnail, thumbnailLen);
+        if (code != 404 && code != 405) {
+            saveResumableSession(session);
+            rememberRejection(code);
+            return code;
+        }
+        Serial.println("[Upload] Server has no resumable endpoint, sending in one request");
+        resumableUnsupported = true;
+    }
+    int code = postUpload(buf, len, timestamp, response, queued, nullptr, thumbnail, thumbnailLen,
+                          UPLOAD_SHA256_ENABLED ? sha256 : nullptr);
+    rememberRejection(code);
+    return code;
+}
+
+int postHeartbeat(const String& timestamp, const char* sceneDistance, UploadResponse& response) {
+    return postUpload(nullptr, 0, timestamp, response, nullptr, sceneDistance, nullptr, 0, nullptr);
+}
+
+// ============================================================================
+// Batch Upload
+// ============================================================================
+
+/**
+ * POST several queued images as one multipart/form-data request to
+ * upload-batch.php, streaming the JPEGs straight from LittleFS. One connection
+ * and one TLS handshake cover the whole batch.
+ * @param headers Queue entries to send
+ * @param count Number of entries
+ * @param statuses Receives the per-item HTTP status from the response (0 = not reported)
+ * @return HTTP status code of the request, or a negative HTTPClient error code
+ */
+static int postImageBatch(const queued_image_header_t* headers, uint32_t count, int* statuses) {
+    Serial.printf("\n--- Uploading Batch (%u images) ---\n", count);
+
+    MultipartBody body;
+    for (uint32_t i = 0; i < count; i++) {
+        statuses[i] = 0;
+        File file = ImageQueue::openImage(headers[i].seq);
+        if (!file) {
+            continue;
+        }
+
+        // Per-item metadata; crc32 lets the server reject images corrupted on flash
+        DynamicJsonDocument doc(256);
+        doc["seq"] = headers[i].seq;
+        doc["timestamp"] = headers[i].timestamp;
+        doc["retries"] = headers[i].retries;
+        doc["capture_firmware"] = headers[i].firmware;
+        doc["size"] = headers[i].length;
+        char crc[9];
+        snprintf(crc, sizeof(crc), "%08x", (unsigned)headers[i].crc32);
+        doc["crc32"] = crc;
+        String meta;
+        serializeJson(doc, meta);
+
+        body.addField("meta[" + String(i) + "]", meta, "application/json");
+        body.addFile("image[" + String(i) + "]", String(headers[i].seq) + ".jpg", file,
+                     sizeof(queued_image_header_t), headers[i].length);
+    }
+    body.finish();
+
+    uint32_t preconnectWaitMs;
+    std::unique_ptr<TlsSessionClient> preconnected(takePreconnectedClient(preconnectWaitMs));
+    TlsSessionClient localClient;
+    TlsSessionClient& client = preconnected ? *preconnected : localClient;
+    client.setInsecure(); // For testing; use proper certificate validation in production
+    client.setSessionCache(sleepManager.getTlsSessionCache());
+
+    HTTPClient http;
+    String uploadUrl = String(configManager.getServerUrl()) + "/upload-batch.php";
+    http.begin(client, uploadUrl);
+    http.setTimeout(15000);  // Server processes every image before it answers
+
+    http.addHeader("Content-Type", body.contentType());
+    http.addHeader("X-Auth-Token", configManager.getAuthToken());
+    http.addHeader("X-Device-ID", WiFi.macAddress());
+    http.addHeader("X-Firmware-Version", otaManager.getFirmwareVersion());
+
+    uint32_t postStart = millis();
+    int httpResponseCode = http.sendRequest("POST", &body, body.length());
+
+    uint32_t connectedAt = client.getConnectedAtMs();
+    logTlsHandshake(client, preconnected && connectedAt != 0 && connectedAt <= postStart);
+
+    if (httpResponseCode > 0) {
+        Serial.printf("HTTP Response code: %d (%u bytes sent)\n", httpResponseCode, (unsigned)body.length());
+        String response = http.getString();
+
+        // {"success":true,"results":[{"seq":12,"status":200,...},...]}
+        DynamicJsonDocument doc(512 + count * 256);
+        if (httpResponseCode >= 200 && httpResponseCode < 300 && !deserializeJson(doc, response)) {
+            for (JsonObject result : doc["results"].as<JsonArray>()) {
+                uint32_t seq = result["seq"] | 0;
+                for (uint32_t i = 0; i < count; i++) {
+                    if (headers[i].seq == seq) {
+                        statuses[i] = result["status"] | 0;
+                    }
+                }
+            }
+        } else if (httpResponseCode >= 200 && httpResponseCode < 300) {
+            Serial.println("✗ Batch response not understood: " + response);
+        }
+    } else {
+        Serial.printf("✗ Batch upload failed: %s\n", http.errorToString(httpResponseCode).c_str());
+    }
+
+    http.end();
+    return httpResponseCode;
+}
+
+// ============================================================================
+// Store-and-Forward Queue Drain
+// ============================================================================
+
+/**
+ * Apply the delivery result of one queued image
+ * @return false if the failure is transient and draining should stop
+ */
+static bool settleQueuedImage(uint32_t seq, int code, uint32_t& sent, uint32_t& dropped) {
+    if (code >= 200 && code < 300) {
+        ImageQueue::remove(seq);
+        sent++;
+        return true;
+    }
+
+    // Permanent rejection (bad image, too large): retrying will not help. A
+    // checksum or CRC mismatch (422) is damage on the way, retried up to
+    // QUEUE_MAX_CHECKSUM_RETRIES: an entry refused that often will not get
+    // through and would hold up the entries behind it
+    if (code >= 400 && code < 500 && code != 408 && code != 422 && code != 429) {
+        Serial.printf("[Queue] Server rejected entry %u (HTTP %d), dropping\n", seq, code);
+        ImageQueue::remove(seq);
+        dropped++;
+        return true;
+    }
+
+    // Transient failure: keep the entry for the next wake. A count that
+    // cannot be written (0) would never reach the limit
+    uint32_t retries = ImageQueue::incrementRetries(seq);
+    uint32_t maxRetries = code == 422 ? QUEUE_MAX_CHECKSUM_RETRIES : QUEUE_MAX_RETRIES;
+    if (retries == 0 || retries >= maxRetries) {
+        Serial.printf("[Queue] Entry %u failed %u times, dropping\n", seq, retries);
+        ImageQueue::remove(seq);
+        dropped++;
+    }
+    return false;
+}
+
+/**
+ * Continue the session of a queued image whose upload broke off on an
+ * earlier wake, reading the JPEG from flash
+ * @return false if the delivery failed transiently and draining should stop
+ */
+static bool resumeQueuedImage(uint32_t& sent, uint32_t& dropped) {
+    rtc_resumable_upload_t* state = resumableState();
+    if (!state->session[0] || resumableUnsupported) {
+        return true;
+    }
+
+    std::vector<queued_image_header_t> headers(ImageQueue::count());
+    uint32_t count = ImageQueue::list(headers.data(), headers.size());
+    QueuedImage image;
+    bool found = false;
+    for (uint32_t i = 0; i < count && !found; i++) {
+        found = isSameImage(*state, headers[i].length, headers[i].timestamp);
+        if (found) {
+            image.header = headers[i];
+        }
+    }
+    if (!found) {
+        state->session[0] = '\0';  // Delivered meanwhile, evicted or never queued
+        return true;
+    }
+
+    ResumableSource source;
+    source.file = ImageQueue::openImage(image.header.seq);
+    source.length = image.header.length;
+    if (!source.file) {
+        return true;
+    }
+
+    rtc_resumable_upload_t session = *state;
+    UploadResponse response;
+    int code = postResumable(source, session, response, &image, nullptr, 0);
+    source.file.close();
+    if (code == 404 || code == 405) {
+        Serial.println("[Queue] Server has no resumable endpoint");
+        resumableUnsupported = true;
+        state->session[0] = '\0';
+        return true;
+    }
+    saveResumableSession(session);
+    return settleQueuedImage(image.header.seq, code, sent, dropped);
+}
+
+/**
+ * Fallback for servers without upload-batch.php: one upload.php request per image
+ */
+static void drainImageQueueSingle(unsigned long start, unsigned long budgetMs,
+                                  uint32_t& sent, uint32_t& dropped) {
+    while (sent + dropped < QUEUE_DRAIN_MAX_IMAGES && millis() - start < budgetMs) {
+        QueuedImage image;
+        if (!ImageQueue::peek(image)) {
+            break;
+        }
+        uint32_t seq = image.header.seq;
+
+        UploadResponse response;
+        int code = postImage(image.data, image.header.length, image.header.timestamp, response, &image);
+        ImageQueue::release(image);
+
+        if (!settleQueuedImage(seq, code, sent, dropped)) {
+            break;
+        }
+    }
+}
+
+/**
+ * Send queued images oldest-first in batches until the queue is empty, a
+ * delivery fails or the per-wake budget (time, QUEUE_DRAIN_MAX_IMAGES) is used up
+ * @return Number of images delivered
+ */
+uint32_t drainImageQueue(unsigned long budgetMs) {
+    uint32_t pending = ImageQueue::count();
+    if (pending == 0) {
+        return 0;
+    }
+
+    Serial.printf("\n--- Draining Image Queue (%u queued) ---\n", pending);
+    unsigned long start = millis();
+    uint32_t sent = 0;
+    uint32_t dropped = 0;
+    uint32_t batches = 0;
+    bool batchSupported = true;
+
+    // An image whose upload broke off goes first, from the server's offset
+    bool keepDraining = resumeQueuedImage(sent, dropped);
+
+    while (keepDraining && sent + dropped < QUEUE_DRAIN_MAX_IMAGES) {
+        if (millis() - start >= budgetMs) {
+            Serial.println("[Queue] Time budget exhausted, resuming next wake");
+            break;
+        }
+
+        queued_image_header_t headers[QUEUE_BATCH_MAX_IMAGES];
+        uint32_t n = ImageQueue::list(headers, min(QUEUE_BATCH_MAX_IMAGES, QUEUE_DRAIN_MAX_IMAGES - sent - dropped));
+        if (n == 0) {
+            break;
+        }
+
+        // Cap the request size; the first image always goes
+        size_t bytes = headers[0].length;
+        uint32_t take = 1;
+        while (take < n && bytes + headers[take].length <= QUEUE_BATCH_MAX_BYTES) {
+            bytes += headers[take++].length;
+        }
+
+        int statuses[QUEUE_BATCH_MAX_IMAGES];
+        int code = postImageBatch(headers, take, statuses);
+        batches++;
+
+        if (code == 404 || code == 405) {
+            Serial.println("[Queue] Server has no batch endpoint, sending images one by one");
+            batchSupported = false;
+            break;
+        }
+
+        // Whole request failed: every item counts as a transient failure
+        bool requestOk = code >= 200 && code < 300;
+        bool keepGoing = requestOk;
+        for (uint32_t i = 0; i < take; i++) {
+            int itemCode = requestOk ? statuses[i] : -1;
+            if (!settleQueuedImage(headers[i].seq, itemCode, sent, dropped)) {
+                keepGoing = false;
+            }
+        }
+        if (!keepGoing) {
+            break;
+        }
+    }
+
+    if (!batchSupported) {
+        drainImageQueueSingle(start, budgetMs, sent, dropped);
+    }
+
+    unsigned long elapsed = millis() - start;
+    uint32_t remaining = ImageQueue::count();
+    Serial.printf("[Queue] Sent %u in %u batch(es), dropped %u, %u remaining (%lu ms)\n",
+                  sent, batches, dropped, remaining, elapsed);
+
+    DynamicJsonDocument doc(256);
+    JsonObject context = doc.to<JsonObject>();
+    context["sent"] = sent;
+    context["batches"] = batches;
+    context["dropped"] = dropped;
+    context["remaining"] = remaining;
+    context["elapsed_ms"] = elapsed;
+    if (dropped > 0) {
+        RemoteLogger::warn("Queue", "Queued images dropped", context);
+    } else {
+        RemoteLogger::info("Queue", "Queued images delivered", context);
+    }
+    return sent;
+}
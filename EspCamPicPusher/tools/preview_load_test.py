@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""
+Concurrent /preview load test against the config-mode web server.
+
+Runs rounds of N clients that request /preview at the same moment (barrier
+start), each polling for the shared capture like the config page, and
+reports the 503 rate, p50/p99/max latency and how many distinct
+captures served them (by X-Frame-Timestamp, else by JPEG hash). Meant for the native env
+in real-time config mode (see "Host (native) build" in README.md); also
+works against a device on the LAN.
+
+The warm camera task (WarmCamera) answers previews from its cached frame, so
+to exercise the capture path either set WARM_CAMERA_INTERVAL_MS to 0 or
+test within WARM_CAMERA_STOP_BEFORE_TIMEOUT_SEC of the web timeout.
+
+Usage:
+  tools/preview_load_test.py http://127.0.0.1:8181 --clients 1 4 16 --rounds 5
+"""
+
+import argparse
+import hashlib
+import json
+import threading
+import time
+import urllib.error
+import urllib.request
+
+
+def percentile(sorted_values, pct):
+    """Nearest-rank percentile."""
+    rank = max(1, -(-len(sorted_values) * pct // 100))
+    return sorted_values[int(rank) - 1]
+
+
+def get(url, timeout):
+    """(status, body, headers) of one request; status 0 on a connection error"""
+    try:
+        with urllib.request.urlopen(url, timeout=timeout) as response:
+            return response.status, response.read(), response.headers
+    except urllib.error.HTTPError as e:
+        return e.code, e.read(), e.headers
+    except (urllib.error.URLError, OSError):
+        return 0, b"", {}
+
+
+def fetch(url, timeout, poll):
+    """(status, latency_ms, frame id or None) of a preview, following the
+    202 answer with polls of /preview?capture=N&ticket=T like the config page"""
+    start = time.monotonic()
+    status, body, headers = get(url, timeout)
+    while status == 202 and time.monotonic() - start < timeout:
+        claim = json.loads(body)
+        time.sleep(poll)
+        status, body, headers = get("%s?capture=%d&ticket=%d" % (url, claim["capture"], claim["ticket"]), timeout)
+    latency = (time.monotonic() - start) * 1000.0
+    if status != 200 or not body:
+        return status, latency, None
+    return status, latency, headers.get("X-Frame-Timestamp") or hashlib.sha1(body).hexdigest()
+
+
+def run_round(url, clients, timeout, poll):
+    barrier = threading.Barrier(clients)
+    results = [None] * clients
+
+    def worker(i):
+        barrier.wait()
+        results[i] = fetch(url, timeout, poll)
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(clients)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("base_url", help="Web server base URL, e.g. http://127.0.0.1:8181")
+    parser.add_argument("--clients", type=int, nargs="+", default=[1, 4, 16], help="Concurrency levels")
+    parser.add_argument("--rounds", type=int, default=5, help="Rounds per concurrency level")
+    parser.add_argument("--pause", type=float, default=0.5, help="Seconds between rounds")
+    parser.add_argument("--timeout", type=float, default=30.0, help="Per-preview timeout in seconds")
+    parser.add_argument("--poll", type=float, default=0.1, help="Seconds between polls of a pending capture")
+    options = parser.parse_args()
+
+    url = options.base_url.rstrip("/") + "/preview"
+    print("%7s %6s %6s %6s %6s %8s %8s %8s %9s" %
+          ("clients", "reqs", "200", "503", "other", "p50_ms", "p99_ms", "max_ms", "captures"))
+    for clients in options.clients:
+        samples = []
+        captures = 0
+        for _ in range(options.rounds):
+            results = run_round(url, clients, options.timeout, options.poll)
+            samples.extend(results)
+            captures += len({digest for _, _, digest in results if digest})
+            time.sleep(options.pause)
+
+        latencies = sorted(latency for _, latency, _ in samples)
+        ok = sum(1 for status, _, _ in samples if status == 200)
+        busy = sum(1 for status, _, _ in samples if status == 503)
+        print("%7d %6d %6d %5.1f%% %6d %8.0f %8.0f %8.0f %9d" %
+              (clients, len(samples), ok, 100.0 * busy / len(samples), len(samples) - ok - busy,
+               percentile(latencies, 50), percentile(latencies, 99), latencies[-1], captures))
+
+
+if __name__ == "__main__":
+    main()
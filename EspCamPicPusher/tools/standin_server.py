@@ -0,0 +1,556 @@
+#!/usr/bin/env python3
+"""
+Stand-in for the WebCamPics server endpoints used by the firmware, for host
+testing with the native env (see "Host (native) build" in README.md).
+
+Mirrors the request/response semantics of WebCamPics without PHP or a web
+server: Bearer/X-Auth-Token authentication, X-Device-ID, JPEG and size
+validation, per-item results for batch uploads. Images are written to
+--images-dir/<device>/<timestamp>.jpg; no image processing or OTA offers.
+With --logs-dir, upload.log and camera_<device>_<date>.log are written in the
+WebCamPics log format (input for tools/wake_timing_report.py).
+Like PHP, upload.php requests are answered after their body was read, also
+with "Expect: 100-continue" (the web server sends "100 Continue" itself);
+--disabled cameras get 403 and oversized raw bodies 413.
+
+Endpoints (any base path, matched on the file name):
+  POST upload.php        raw JPEG body, multipart/form-data with image + thumbnail,
+                         or no body with X-Capture-Status: unchanged; X-Content-SHA256
+                         is verified (422) and a known one answered "duplicate"
+  POST upload-batch.php  multipart/form-data with meta[i] (JSON) + image[i]
+  POST/GET/PUT upload-resumable.php
+                         session open (thumbnail body) / stored offset / chunk at
+                         X-Upload-Offset; --break-every N cuts every Nth chunk halfway
+  POST log.php           RemoteLogger JSON batches (printed)
+  POST ota-confirm.php   OTA confirmation (printed)
+
+Usage:
+  tools/standin_server.py --port 18090 --token tok
+  NATIVE_DATA_DIR=/tmp/cam .pio/build/native/program
+"""
+
+import argparse
+import email.parser
+import email.policy
+import hashlib
+import json
+import os
+import re
+import sys
+import time
+import zlib
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+SESSION_MAX_AGE_SEC = 24 * 3600  # Resumable sessions expire like upload-resumable.php's
+SHA256_INDEX_SIZE = 200          # Images per camera in sha256.json, as WebCamPics lib/storage.php
+
+
+def parse_wake_timing(header):
+    """X-Wake-Timing header -> {stage: ms, "prev": {...}} (WebCamPics parseWakeTiming)."""
+    if not header:
+        return None
+
+    def pairs(text):
+        return {m.group(1): int(m.group(2))
+                for m in (re.match(r"^([a-z_]{1,16})=(\d{1,9})$", p.strip()) for p in text.split(",")) if m}
+
+    current, _, previous = header.partition(";")
+    timing = pairs(current)
+    if previous.startswith("prev:") and pairs(previous[5:]):
+        timing["prev"] = pairs(previous[5:])
+    return timing or None
+
+
+def sanitize(identifier):
+    """Directory name for a device ID (WebCamPics sanitizeCameraIdentifier, simplified)."""
+    return re.sub(r"[^A-Za-z0-9_-]", "", identifier.replace(":", "")) or "unknown"
+
+
+class StandInHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    options = None
+    handlers = {}
+    chunk_count = 0
+
+    def log_message(self, fmt, *args):
+        sys.stderr.write("[%s] %s\n" % (time.strftime("%H:%M:%S"), fmt % args))
+
+    def write_log(self, filename, level, component, message, context):
+        """Append one entry in the WebCamPics formatLogEntry() format."""
+        if not self.options.logs_dir:
+            return
+        os.makedirs(self.options.logs_dir, exist_ok=True)
+        line = "[%s] [%s] [%s] %s" % (time.strftime("%Y-%m-%d %H:%M:%S"), level, component, message)
+        if context:
+            line += " " + json.dumps(context, separators=(",", ":"))
+        with open(os.path.join(self.options.logs_dir, filename), "a") as f:
+            f.write(line + "\n")
+
+    def server_time(self):
+        """Unix time of the upload response, shifted by --clock-offset."""
+        return int(time.time()) + self.options.clock_offset
+
+    def reply(self, status, payload):
+        body = json.dumps(payload).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def authenticated(self):
+        token = self.headers.get("X-Auth-Token")
+        if not token:
+            match = re.match(r"Bearer\s+(.+)", self.headers.get("Authorization", ""))
+            token = match.group(1) if match else None
+        return token in self.options.token
+
+    def check_headers(self):
+        """Checks upload.php makes before looking at the image; (status, error) or None."""
+        endpoint = self.path.split("?")[0].rstrip("/").rsplit("/", 1)[-1]
+        if (endpoint not in self.handlers or (endpoint == "upload-batch.php" and self.options.no_batch)
+                or (endpoint == "upload-resumable.php" and self.options.no_resumable)):
+            return 404, "Not found"
+        if not self.authenticated():
+            return 401, "Unauthorized"
+        device_id = self.headers.get("X-Device-ID")
+        if not device_id:
+            return 400, "Missing X-Device-ID header"
+        if endpoint == "upload.php" and self.headers.get("X-Capture-Status", "").lower() != "unchanged":
+            if device_id in self.options.disabled:
+                return 403, "Camera disabled"
+            content_type = self.headers.get("Content-Type", "")
+            length = int(self.headers.get("Content-Length", 0))
+            if not content_type.startswith("multipart/") and length > self.options.max_size_mb * 1024 * 1024:
+                return 413, "Image too large"
+        if endpoint == "upload-resumable.php" and self.command == "POST" and device_id in self.options.disabled:
+            return 403, "Camera disabled"
+        return None
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length", 0))
+        body = self.rfile.read(length)
+        rejected = self.check_headers()
+        if rejected:
+            self.reply(rejected[0], {"error": rejected[1]})
+            return
+        endpoint = self.path.split("?")[0].rstrip("/").rsplit("/", 1)[-1]
+        self.handlers[endpoint](self, self.headers.get("X-Device-ID"), body)
+
+    def store_image(self, device_id, data, timestamp, meta=None):
+        """Validate and save one image; returns (status, result) like upload.php."""
+        meta = meta or {}
+        if not data:
+            return 400, {"error": "No image data received"}
+        if len(data) > self.options.max_size_mb * 1024 * 1024:
+            return 413, {"error": "Image too large"}
+        if device_id in self.options.disabled:
+            return 500, {"error": "Failed to process image"}  # processImage() discards it
+        if "crc32" in meta and "%08x" % zlib.crc32(data) != meta["crc32"].lower():
+            return 422, {"error": "CRC mismatch"}
+        if not data.startswith(b"\xff\xd8"):
+            return 400, {"error": "Invalid image format. Only JPEG is accepted."}
+
+        if not timestamp or timestamp == "unknown":
+            timestamp = time.strftime("%Y-%m-%d %H:%M:%S")
+        filename = timestamp.replace(":", "_").replace(" ", "_") + ".jpg"
+        directory = os.path.join(self.options.images_dir, sanitize(device_id))
+        os.makedirs(directory, exist_ok=True)
+        with open(os.path.join(directory, filename), "wb") as f:
+            f.write(data)
+
+        return 200, {
+            "success": True,
+            "device_id": device_id,
+            "timestamp": timestamp,
+            "size": len(data),
+            "filename": filename,
+        }
+
+    def content_sha256(self):
+        """X-Content-SHA256 in lower case, "" if absent or malformed."""
+        sha256 = (self.headers.get("X-Content-SHA256") or "").lower()
+        return sha256 if re.fullmatch(r"[0-9a-f]{64}", sha256) else ""
+
+    def sha256_index_path(self, device_id):
+        return os.path.join(self.options.images_dir, sanitize(device_id), "sha256.json")
+
+    def find_duplicate(self, device_id, sha256):
+        """File name of the stored image with this SHA-256, or None (findImageBySha256)."""
+        path = self.sha256_index_path(device_id or "")
+        if not sha256 or not os.path.exists(path):
+            return None
+        with open(path) as f:
+            filename = json.load(f).get(sha256)
+        if not filename or not os.path.exists(os.path.join(os.path.dirname(path), filename)):
+            return None
+        return filename
+
+    def remember_sha256(self, device_id, sha256, filename):
+        path = self.sha256_index_path(device_id)
+        index = {}
+        if os.path.exists(path):
+            with open(path) as f:
+                index = json.load(f)
+        index.pop(sha256, None)
+        index[sha256] = filename
+        with open(path, "w") as f:
+            json.dump(dict(list(index.items())[-SHA256_INDEX_SIZE:]), f)
+
+    def duplicate_upload(self, device_id, filename):
+        """(status, result) of upload.php for an image it already has."""
+        self.log_message("duplicate %s of %s", device_id, filename)
+        self.write_log("upload.log", "INFO", "Upload", "Duplicate image from %s" % device_id,
+                       {"filename": filename, "sha256": self.content_sha256()})
+        return 200, {
+            "success": True,
+            "device_id": device_id,
+            "timestamp": self.headers.get("X-Timestamp") or time.strftime("%Y-%m-%d %H:%M:%S"),
+            "duplicate": True,
+            "filename": filename,
+            "server_time": self.server_time(),
+            "ota": {"available": False},
+        }
+
+    def parse_multipart(self, body):
+        """multipart/form-data body -> {field name: payload bytes}."""
+        message = email.parser.BytesParser(policy=email.policy.HTTP).parsebytes(
+            b"Content-Type: " + self.headers.get("Content-Type", "").encode() + b"\r\n\r\n" + body)
+        return {part.get_param("name", header="content-disposition") or "": part.get_payload(decode=True) or b""
+                for part in message.iter_parts()}
+
+    def handle_upload(self, device_id, body):
+        if (self.headers.get("X-Capture-Status") or "").lower() == "unchanged":
+            self.handle_heartbeat(device_id)
+            return
+        sha256 = self.content_sha256()
+        if self.headers.get("X-Content-SHA256") and not sha256:
+            self.reply(400, {"error": "Invalid X-Content-SHA256 header"})
+            return
+        duplicate = self.find_duplicate(device_id, sha256)
+        if duplicate:
+            self.reply(*self.duplicate_upload(device_id, duplicate))
+            return
+        thumbnail = None
+        if self.headers.get("Content-Type", "").startswith("multipart/form-data"):
+            parts = self.parse_multipart(body)
+            body, thumbnail = parts.get("image", b""), parts.get("thumbnail")
+        if sha256 and hashlib.sha256(body).hexdigest() != sha256:
+            self.reply(422, {"error": "Checksum mismatch"})
+            return
+        self.reply(*self.complete_upload(device_id, body, thumbnail, {
+            "timestamp": self.headers.get("X-Timestamp"),
+            "queue_retries": self.headers.get("X-Queue-Retries"),
+            "firmware": self.headers.get("X-Firmware-Version"),
+            "wake_timing": self.headers.get("X-Wake-Timing"),
+            "sha256": sha256,
+        }))
+
+    def complete_upload(self, device_id, body, thumbnail, request, via=""):
+        """Store an image with its thumbnail and log it; (status, result) of upload.php."""
+        status, result = self.store_image(device_id, body, request.get("timestamp"))
+        if status == 200 and thumbnail and thumbnail.startswith(b"\xff\xd8"):
+            path = os.path.join(self.options.images_dir, sanitize(device_id),
+                                result["filename"].replace(".jpg", "_thumb.jpg"))
+            with open(path, "wb") as f:
+                f.write(thumbnail)
+            result["thumbnail"] = os.path.basename(path)
+        if status == 200:
+            if request.get("sha256"):
+                self.remember_sha256(device_id, request["sha256"], result["filename"])
+            result["ota"] = {"available": False}
+            result["server_time"] = self.server_time()
+            queued = request.get("queue_retries")
+            self.log_message("upload%s %s %d bytes%s%s", via, device_id, len(body),
+                             " (queued, %s retries)" % queued if queued is not None else "",
+                             " + %d bytes thumbnail" % len(thumbnail) if "thumbnail" in result else "")
+            context = {"size": len(body), "filename": result["filename"]}
+            if "thumbnail" in result:
+                context["thumbnail_size"] = len(thumbnail)
+            timing = parse_wake_timing(request.get("wake_timing"))
+            if timing:
+                context["firmware"] = request.get("firmware")
+                context["wake_timing"] = timing
+            self.write_log("upload.log", "INFO", "Upload", "Image received from %s%s" % (device_id, via), context)
+        return status, result
+
+    def handle_heartbeat(self, device_id):
+        """Scene unchanged since the last image: nothing stored, like upload.php."""
+        distance = self.headers.get("X-Scene-Distance") or ""
+        self.log_message("heartbeat %s (%s)", device_id, distance)
+        context = {"scene_distance": distance}
+        timing = parse_wake_timing(self.headers.get("X-Wake-Timing"))
+        if timing:
+            context["firmware"] = self.headers.get("X-Firmware-Version")
+            context["wake_timing"] = timing
+        self.write_log("upload.log", "INFO", "Upload", "Heartbeat from %s (scene unchanged)" % device_id, context)
+        self.reply(200, {
+            "success": True,
+            "device_id": device_id,
+            "timestamp": self.headers.get("X-Timestamp"),
+            "unchanged": True,
+            "ota": {"available": False},
+            "server_time": self.server_time(),
+        })
+
+    def handle_batch(self, device_id, body):
+        content_type = self.headers.get("Content-Type", "")
+        if not content_type.startswith("multipart/form-data"):
+            self.reply(400, {"error": "Expected multipart/form-data"})
+            return
+
+        message = email.parser.BytesParser(policy=email.policy.HTTP).parsebytes(
+            b"Content-Type: " + content_type.encode() + b"\r\n\r\n" + body)
+        metas, images = {}, {}
+        for part in message.iter_parts():
+            name = part.get_param("name", header="content-disposition") or ""
+            match = re.match(r"(meta|image)\[(\d+)\]$", name)
+            if not match:
+                continue
+            payload = part.get_payload(decode=True) or b""
+            if match.group(1) == "meta":
+                metas[int(match.group(2))] = json.loads(payload or b"{}")
+            else:
+                images[int(match.group(2))] = payload
+
+        if not images:
+            self.reply(400, {"error": "No images received (expected image[i] parts)"})
+            return
+
+        results = []
+        for index in sorted(images):
+            meta = metas.get(index, {})
+            item_device = meta.get("device_id", device_id)
+            status, result = self.store_image(item_device, images[index], meta.get("timestamp"), meta)
+            result.pop("success", None)
+            results.append(dict({"seq": meta.get("seq"), "status": status}, **result))
+
+        stored = sum(1 for r in results if r["status"] == 200)
+        self.log_message("batch %s %d bytes, %d/%d stored", device_id, len(body), stored, len(results))
+        self.reply(200, {
+            "success": stored == len(results),
+            "device_id": device_id,
+            "stored": stored,
+            "results": results,
+        })
+
+    def session_paths(self, session_id):
+        base = os.path.join(self.options.images_dir, ".sessions", session_id)
+        return base + ".json", base + ".part", base + "_thumb.jpg"
+
+    def load_session(self, session_id, device_id):
+        """Session meta of this device, or None (unknown, expired or another device's)."""
+        meta_path = self.session_paths(session_id)[0]
+        if not re.fullmatch(r"[0-9a-f]{32}", session_id or "") or not os.path.exists(meta_path):
+            return None
+        with open(meta_path) as f:
+            meta = json.load(f)
+        if sanitize(meta["device_id"]) != sanitize(device_id):
+            return None
+        if time.time() - meta["created"] > SESSION_MAX_AGE_SEC:
+            self.drop_session(session_id)
+            return None
+        return meta
+
+    def save_session(self, session_id, meta):
+        with open(self.session_paths(session_id)[0], "w") as f:
+            json.dump(meta, f)
+
+    def drop_session(self, session_id):
+        for path in self.session_paths(session_id):
+            if os.path.exists(path):
+                os.remove(path)
+
+    def session_state(self, session_id, meta):
+        """Stored offset; a completed session repeats its upload.php result."""
+        part_path = self.session_paths(session_id)[1]
+        offset = meta["length"] if "result" in meta else os.path.getsize(part_path)
+        state = dict(meta.get("result", {}), session=session_id, offset=offset, length=meta["length"])
+        return state
+
+    def query_session_id(self):
+        match = re.search(r"[?&]session=([^&]*)", self.path)
+        return match.group(1) if match else None
+
+    def handle_resumable(self, device_id, body):
+        """POST: open the session of an image, or report the offset of an open one."""
+        try:
+            length = int(self.headers.get("X-Upload-Length", ""))
+        except ValueError:
+            length = 0
+        sha256 = (self.headers.get("X-Content-SHA256") or "").lower()
+        if length <= 0 or not re.fullmatch(r"[0-9a-f]{64}", sha256):
+            self.reply(400, {"error": "Missing X-Upload-Length or X-Content-SHA256 header"})
+            return
+        if length > self.options.max_size_mb * 1024 * 1024:
+            self.reply(413, {"error": "Image too large"})
+            return
+
+        session_id = hashlib.sha256(("%s:%s" % (sanitize(device_id), sha256)).encode()).hexdigest()[:32]
+        duplicate = self.find_duplicate(device_id, sha256)
+        if duplicate:
+            status, result = self.duplicate_upload(device_id, duplicate)
+            self.reply(status, dict(result, session=session_id, offset=length, length=length))
+            return
+        meta = self.load_session(session_id, device_id)
+        if meta:
+            self.reply(200, self.session_state(session_id, meta))
+            return
+
+        os.makedirs(os.path.dirname(self.session_paths(session_id)[0]), exist_ok=True)
+        meta = {
+            "device_id": device_id,
+            "length": length,
+            "sha256": sha256,
+            "created": time.time(),
+            "timestamp": self.headers.get("X-Timestamp"),
+            "queue_retries": self.headers.get("X-Queue-Retries"),
+            "firmware": self.headers.get("X-Firmware-Version"),
+            "wake_timing": self.headers.get("X-Wake-Timing"),
+        }
+        open(self.session_paths(session_id)[1], "wb").close()
+        if body.startswith(b"\xff\xd8"):
+            with open(self.session_paths(session_id)[2], "wb") as f:
+                f.write(body)
+        self.save_session(session_id, meta)
+        self.log_message("session %s opened by %s, %d bytes", session_id, device_id, length)
+        self.reply(201, self.session_state(session_id, meta))
+
+    def do_GET(self):
+        """GET upload-resumable.php?session=<id>: stored offset of a session."""
+        rejected = self.check_headers()
+        if rejected:
+            self.reply(rejected[0], {"error": rejected[1]})
+            return
+        if not self.path.split("?")[0].endswith("upload-resumable.php"):
+            self.reply(405, {"error": "Method not allowed"})
+            return
+        session_id = self.query_session_id()
+        meta = self.load_session(session_id, self.headers.get("X-Device-ID"))
+        if not meta:
+            self.reply(404, {"error": "Unknown upload session"})
+            return
+        self.reply(200, self.session_state(session_id, meta))
+
+    def do_PUT(self):
+        """PUT upload-resumable.php?session=<id>: append the chunk at X-Upload-Offset."""
+        length = int(self.headers.get("Content-Length", 0))
+        rejected = self.check_headers()
+        if not rejected and not self.path.split("?")[0].endswith("upload-resumable.php"):
+            rejected = 405, "Method not allowed"
+        device_id = self.headers.get("X-Device-ID")
+        session_id = self.query_session_id()
+        meta = None if rejected else self.load_session(session_id, device_id)
+        if not rejected and not meta:
+            rejected = 404, "Unknown upload session"
+        if rejected:
+            self.rfile.read(length)
+            self.reply(rejected[0], {"error": rejected[1]})
+            return
+
+        meta_path, part_path, thumb_path = self.session_paths(session_id)
+        state = self.session_state(session_id, meta)
+        offset = int(self.headers.get("X-Upload-Offset", -1))
+        if "result" in meta or offset != state["offset"] or offset + length > meta["length"]:
+            self.rfile.read(length)
+            self.reply(200 if "result" in meta else 409, state)
+            return
+
+        # --break-every: cut every Nth chunk after half its body, as a lost link
+        # would; the half that arrived is kept, as upload-resumable.php does
+        StandInHandler.chunk_count += 1
+        cut = self.options.break_every and StandInHandler.chunk_count % self.options.break_every == 0
+        data = self.rfile.read(length // 2 if cut else length)
+        with open(part_path, "ab") as f:
+            f.write(data)
+        if cut:
+            self.log_message("session %s: connection cut after %d of %d bytes", session_id, len(data), length)
+            self.close_connection = True
+            return
+
+        stored = os.path.getsize(part_path)
+        if stored < meta["length"]:
+            self.reply(200, self.session_state(session_id, meta))
+            return
+
+        with open(part_path, "rb") as f:
+            image = f.read()
+        if hashlib.sha256(image).hexdigest() != meta["sha256"]:
+            self.drop_session(session_id)
+            self.reply(422, {"error": "Checksum mismatch"})
+            return
+        thumbnail = None
+        if os.path.exists(thumb_path):
+            with open(thumb_path, "rb") as f:
+                thumbnail = f.read()
+        status, result = self.complete_upload(device_id, image, thumbnail, meta, " (resumable)")
+        if status != 200:
+            self.drop_session(session_id)
+            self.reply(status, result)
+            return
+
+        # Keep the result, so a camera that missed this answer learns it from GET
+        meta["result"] = result
+        self.save_session(session_id, meta)
+        for path in (part_path, thumb_path):
+            if os.path.exists(path):
+                os.remove(path)
+        self.reply(200, self.session_state(session_id, meta))
+
+    def handle_log(self, device_id, body):
+        try:
+            logs = json.loads(body or b"{}").get("entries", [])
+        except ValueError:
+            self.reply(400, {"success": False, "error": "Invalid JSON"})
+            return
+        for entry in logs:
+            self.log_message("log %s [%s] [%s] %s %s", device_id, entry.get("level"), entry.get("component"),
+                             entry.get("message"), json.dumps(entry.get("context", {})))
+            self.write_log("camera_%s_%s.log" % (re.sub(r"[^a-zA-Z0-9_-]", "_", device_id), time.strftime("%Y-%m-%d")),
+                           str(entry.get("level", "INFO")).upper(), entry.get("component", "Unknown"), entry.get("message", ""), entry.get("context"))
+        self.reply(200, {"success": True, "logged": len(logs)})
+
+    def handle_ota_confirm(self, device_id, body):
+        self.log_message("ota-confirm %s %s", device_id, body.decode(errors="replace"))
+        self.reply(200, {"success": True})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=18090)
+    parser.add_argument("--token", action="append", help="Accepted auth token (repeatable, default: tok)")
+    parser.add_argument("--images-dir", default=".native/standin-images")
+    parser.add_argument("--max-size-mb", type=float, default=5)
+    parser.add_argument("--logs-dir", help="Write WebCamPics-format upload/camera logs here")
+    parser.add_argument("--no-batch", action="store_true", help="Answer 404 on upload-batch.php (old server)")
+    parser.add_argument("--disabled", action="append", default=[],
+                        help="Device ID whose camera is disabled server-side (repeatable, uploads get 403)")
+    parser.add_argument("--no-resumable", action="store_true",
+                        help="Answer 404 on upload-resumable.php (old server)")
+    parser.add_argument("--break-every", type=int, default=0,
+                        help="Cut every Nth resumable chunk after half its body (lossy link test)")
+    parser.add_argument("--clock-offset", type=int, default=0,
+                        help="Seconds added to server_time in upload responses (clock drift test)")
+    options = parser.parse_args()
+    options.token = options.token or ["tok"]
+
+    StandInHandler.options = options
+    StandInHandler.handlers = {
+        "upload.php": StandInHandler.handle_upload,
+        "upload-batch.php": StandInHandler.handle_batch,
+        "upload-resumable.php": StandInHandler.handle_resumable,
+        "log.php": StandInHandler.handle_log,
+        "ota-confirm.php": StandInHandler.handle_ota_confirm,
+    }
+    server = ThreadingHTTPServer((options.host, options.port), StandInHandler)
+    print("Stand-in server on http://%s:%d/ (images in %s)" % (options.host, options.port, options.images_dir))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
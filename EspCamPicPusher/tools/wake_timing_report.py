@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+Per-stage wake-cycle latency percentiles from WebCamPics server logs.
+
+Every scheduled upload carries an X-Wake-Timing header (see StageTimer) that
+upload.php records as "wake_timing" in logs/upload.log. This tool collects
+those entries and prints p50/p90/p99/max per stage, grouped per device and
+firmware version (or per firmware version across the fleet with --fleet).
+
+Stages that end after the upload has left (tls, send, resp, sleep, awake)
+arrive with the next wake as "prev" values and are counted for the firmware
+of that next wake; after an OTA update the first such sample belongs to the
+old version.
+
+With --camera-logs the RemoteLogger "Timing" entries in
+logs/camera_<device>_<date>.log are used instead; they include the upload
+stages of the same wake but are only delivered when the logger flushes.
+
+Usage:
+  tools/wake_timing_report.py /var/www/webcampics/logs
+  tools/wake_timing_report.py --fleet --csv logs/upload.log logs/upload_2026-10-*.log
+"""
+
+import argparse
+import csv
+import glob
+import json
+import os
+import re
+import sys
+
+# StageTimer order; unknown stages are appended alphabetically
+STAGE_ORDER = ["boot", "rtc", "cfg", "wifi", "ntp", "cam", "warm", "cap",
+               "gate", "thumb", "tls", "send", "resp", "sleep", "total", "awake"]
+
+LOG_LINE = re.compile(r"^\[([^\]]+)\] \[([^\]]+)\] \[([^\]]+)\] (.+?) (\{.+\})$")
+UPLOAD_MESSAGE = re.compile(r"^(?:Image received|Heartbeat) from (\S+)")
+CAMERA_LOG_NAME = re.compile(r"^camera_(.+)_\d{4}-\d{2}-\d{2}\.log$")
+
+
+def merge_stages(timing):
+    """Current stages plus the previous wake's stages this one does not have."""
+    stages = {k: v for k, v in timing.items() if k != "prev" and isinstance(v, int)}
+    if "total_ms" in stages:
+        stages["total"] = stages.pop("total_ms")
+    for name, value in (timing.get("prev") or {}).items():
+        if isinstance(value, int) and name not in stages:
+            stages[name] = value
+    return stages
+
+
+def read_upload_log(path):
+    """Yield (device, firmware, stages) from upload.php entries."""
+    with open(path, errors="replace") as f:
+        for line in f:
+            match = LOG_LINE.match(line.strip())
+            if not match or match.group(3) != "Upload":
+                continue
+            device = UPLOAD_MESSAGE.match(match.group(4))
+            try:
+                context = json.loads(match.group(5))
+            except ValueError:
+                continue
+            if device and isinstance(context.get("wake_timing"), dict):
+                yield device.group(1), context.get("firmware") or "unknown", merge_stages(context["wake_timing"])
+
+
+def read_camera_log(path):
+    """Yield (device, firmware, stages) from RemoteLogger Timing entries."""
+    name = CAMERA_LOG_NAME.match(os.path.basename(path))
+    device = name.group(1) if name else os.path.basename(path)
+    with open(path, errors="replace") as f:
+        for line in f:
+            match = LOG_LINE.match(line.strip())
+            if not match or match.group(3) != "Timing":
+                continue
+            try:
+                context = json.loads(match.group(5))
+            except ValueError:
+                continue
+            firmware = context.pop("fw", None) or "unknown"
+            yield device, firmware, merge_stages(context)
+
+
+def expand(paths, camera_logs):
+    pattern = "camera_*.log" if camera_logs else "upload*.log"
+    for path in paths:
+        if os.path.isdir(path):
+            yield from sorted(glob.glob(os.path.join(path, pattern)))
+        else:
+            yield path
+
+
+def percentile(sorted_values, pct):
+    """Nearest-rank percentile."""
+    rank = max(1, -(-len(sorted_values) * pct // 100))
+    return sorted_values[int(rank) - 1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("paths", nargs="+", help="Log files or WebCamPics logs directories")
+    parser.add_argument("--fleet", action="store_true", help="Group by firmware only (all devices)")
+    parser.add_argument("--camera-logs", action="store_true",
+                        help="Read RemoteLogger Timing entries from camera_*.log instead of upload.log")
+    parser.add_argument("--csv", action="store_true", help="CSV output")
+    options = parser.parse_args()
+
+    reader = read_camera_log if options.camera_logs else read_upload_log
+    groups = {}
+    for path in expand(options.paths, options.camera_logs):
+        for device, firmware, stages in reader(path):
+            key = ("*" if options.fleet else device, firmware)
+            samples = groups.setdefault(key, {})
+            for name, value in stages.items():
+                samples.setdefault(name, []).append(value)
+
+    if not groups:
+        sys.exit("No wake timing entries found")
+
+    writer = csv.writer(sys.stdout) if options.csv else None
+    if writer:
+        writer.writerow(["device", "firmware", "stage", "n", "p50", "p90", "p99", "max"])
+
+    for (device, firmware) in sorted(groups):
+        samples = groups[(device, firmware)]
+        order = [s for s in STAGE_ORDER if s in samples] + sorted(s for s in samples if s not in STAGE_ORDER)
+        if not writer:
+            title = "firmware %s" % firmware if options.fleet else "%s  firmware %s" % (device, firmware)
+            print("%s  (%d wakes)" % (title, max(len(v) for v in samples.values())))
+            print("  %-6s %6s %8s %8s %8s %8s" % ("stage", "n", "p50", "p90", "p99", "max"))
+        for stage in order:
+            values = sorted(samples[stage])
+            row = [len(values), percentile(values, 50), percentile(values, 90), percentile(values, 99), values[-1]]
+            if writer:
+                writer.writerow([device, firmware, stage] + row)
+            else:
+                print("  %-6s %6d %8d %8d %8d %8d" % tuple([stage] + row))
+        if not writer:
+            print()
+
+
+if __name__ == "__main__":
+    main()
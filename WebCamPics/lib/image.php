@@ -128,6 +128,33 @@ function hexToRgb($hex) {
     return ['r' => $r, 'g' => $g, 'b' => $b];
 }
 
+/**
+ * Store a thumbnail made by the camera next to the processed image
+ * 
+ * The camera's thumbnail has no rotation, mirroring or text overlay, so it is
+ * only used for cameras without rotation and mirroring; otherwise the
+ * gallery falls back to createThumbnail().
+ * 
+ * @param string $imagePath Processed image path
+ * @param string $thumbnailData Thumbnail JPEG
+ * @param string $mac Camera identifier
+ * @return string|false Thumbnail path, or false if not stored
+ */
+function saveThumbnail($imagePath, $thumbnailData, $mac) {
+    $cameraConfig = getCameraConfig($mac);
+    if (($cameraConfig['rotate'] ?? 0) != 0 || ($cameraConfig['mirror'] ?? 'none') !== 'none') {
+        return false;
+    }
+    
+    // Small JPEG only (camera limit is 32 KB)
+    if (strlen($thumbnailData) > 256 * 1024 || substr($thumbnailData, 0, 2) !== "\xFF\xD8") {
+        return false;
+    }
+    
+    $thumbPath = str_replace('.jpg', '_thumb.jpg', $imagePath);
+    return file_put_contents($thumbPath, $thumbnailData) === false ? false : $thumbPath;
+}
+
 function createThumbnail($imagePath, $maxWidth = 400, $maxHeight = 300) {
     $thumbPath = str_replace('.jpg', '_thumb.jpg', $imagePath);
     
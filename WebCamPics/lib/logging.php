@@ -221,6 +221,45 @@ function logUpload($message, $context = [], $level = LOG_LEVEL_INFO) {
     return writeServerLog('upload.log', $level, 'Upload', $message, $context);
 }
 
+/**
+ * Parse the X-Wake-Timing header cameras send with scheduled uploads
+ * Format: "boot=1210,rtc=2,wifi=301,...,total=2150;prev:tls=251,send=40,resp=95,sleep=203,awake=2890"
+ * (stage durations in ms; "prev" = stages of the previous wake that ended after its upload)
+ * @param string|null $header Header value
+ * @return array|null Stage => ms with the previous wake under 'prev', null if absent or unparsable
+ */
+function parseWakeTiming($header) {
+    if (empty($header) || strlen($header) > 512) {
+        return null;
+    }
+    
+    $sections = explode(';', $header, 2);
+    $timing = parseWakeTimingPairs($sections[0]);
+    if (isset($sections[1]) && strpos($sections[1], 'prev:') === 0) {
+        $previous = parseWakeTimingPairs(substr($sections[1], 5));
+        if (!empty($previous)) {
+            $timing['prev'] = $previous;
+        }
+    }
+    
+    return empty($timing) ? null : $timing;
+}
+
+/**
+ * Parse "name=ms,name=ms" pairs, skipping malformed ones
+ * @param string $list Comma-separated pairs
+ * @return array Stage => ms
+ */
+function parseWakeTimingPairs($list) {
+    $pairs = [];
+    foreach (explode(',', $list) as $pair) {
+        if (preg_match('/^([a-z_]{1,16})=(\d{1,9})$/', trim($pair), $matches)) {
+            $pairs[$matches[1]] = (int)$matches[2];
+        }
+    }
+    return $pairs;
+}
+
 /**
  * Get recent log entries from a file
  * @param string $filename Log filename
@@ -7,6 +7,7 @@
 require_once __DIR__ . '/storage.php';
 require_once __DIR__ . '/logging.php';
 require_once __DIR__ . '/auth.php';
+require_once __DIR__ . '/path.php';
 
 /**
  * Get firmware directory path
@@ -304,6 +305,65 @@ function getOtaSchedule(string $deviceId): ?array {
     return null;
 }
 
+/**
+ * OTA part of an upload response: offer the scheduled firmware (status "pending")
+ * or log why a scheduled update was not offered
+ * @param string $deviceId Camera device ID
+ * @param string $logSuffix Appended to the log messages, e.g. " (legacy upload)"
+ * @return array Value of the response's "ota" field
+ */
+function buildOtaOffer(string $deviceId, string $logSuffix = ''): array {
+    $otaInfo = getOtaSchedule($deviceId);
+    $cameras = loadCamerasConfig();
+    $camera = null;
+    foreach ($cameras as $key => $entry) {
+        $cameraId = $entry['device_id'] ?? $entry['mac'] ?? '';
+        if (strtoupper(str_replace(['-', ':', ' '], '', $cameraId)) === strtoupper(str_replace(['-', ':', ' '], '', $deviceId))) {
+            $camera = $entry;
+            break;
+        }
+    }
+    
+    if ($otaInfo) {
+        // Update OTA status to "pending"
+        updateOtaStatus($deviceId, 'pending', null, null);
+        
+        logOta("OTA offered to $deviceId$logSuffix", [
+            'firmware_file' => $otaInfo['filename'],
+            'version' => $otaInfo['version'],
+            'size' => $otaInfo['size'],
+            'retry_count' => $camera['ota_retry_count'] ?? 0
+        ]);
+        
+        return [
+            'available' => true,
+            'firmware_file' => $otaInfo['filename'],
+            'firmware_version' => $otaInfo['version'],
+            'download_url' => baseUrl('ota-download.php?file=' . urlencode($otaInfo['filename'])),
+            'size' => $otaInfo['size'],
+            'sha256' => $otaInfo['sha256'],
+            'mandatory' => false
+        ];
+    }
+    
+    // Log why OTA was not offered
+    if ($camera && !empty($camera['ota_scheduled'])) {
+        $retryCount = $camera['ota_retry_count'] ?? 0;
+        if ($retryCount >= 2) {
+            logOta("OTA NOT offered to $deviceId: retry limit reached$logSuffix", [
+                'scheduled_firmware' => $camera['ota_scheduled'],
+                'retry_count' => $retryCount
+            ], LOG_LEVEL_WARN);
+        } else {
+            logOta("OTA NOT offered to $deviceId: firmware file validation failed$logSuffix", [
+                'scheduled_firmware' => $camera['ota_scheduled']
+            ], LOG_LEVEL_ERROR);
+        }
+    }
+    
+    return ['available' => false];
+}
+
 /**
  * Schedule OTA update for camera
  * @param string $deviceId Camera device ID
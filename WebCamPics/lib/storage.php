@@ -5,6 +5,9 @@
 
 require_once __DIR__ . '/path.php';
 
+// Images per camera whose SHA-256 is kept for duplicate detection (sha256.json)
+define('SHA256_INDEX_SIZE', 200);
+
 function getImagesDir() {
     return __DIR__ . '/../images';
 }
@@ -94,13 +97,68 @@ function saveImage($identifier, $imageData, $timestamp = null) {
     return $rawPath;
 }
 
+/**
+ * Find an image the camera uploaded before by the SHA-256 of its JPEG
+ * (X-Content-SHA256), so a re-sent image is not stored twice
+ * 
+ * @param string $identifier Camera identifier (MAC address or device ID)
+ * @param string $sha256 Lower-case hex digest
+ * @return string|null File name of the stored image, or null if unknown or deleted
+ */
+function findImageBySha256($identifier, $sha256) {
+    $indexPath = getCameraDir($identifier) . '/sha256.json';
+    $index = is_file($indexPath) ? json_decode(file_get_contents($indexPath), true) : null;
+    $filename = is_array($index) ? ($index[$sha256] ?? null) : null;
+    if (!$filename || !is_file(getCameraDir($identifier) . '/' . basename($filename))) {
+        return null;
+    }
+    return $filename;
+}
+
+/**
+ * Add a stored image to the camera's SHA-256 index (newest SHA256_INDEX_SIZE entries)
+ * 
+ * @param string $identifier Camera identifier (MAC address or device ID)
+ * @param string $sha256 Lower-case hex digest of the JPEG as uploaded
+ * @param string $filename File name of the processed image
+ * @return bool Success
+ */
+function rememberImageSha256($identifier, $sha256, $filename) {
+    $indexPath = ensureCameraDir($identifier) . '/sha256.json';
+    $handle = fopen($indexPath, 'c+');
+    if (!$handle || !flock($handle, LOCK_EX)) {
+        return false;
+    }
+    $index = json_decode(stream_get_contents($handle), true) ?: [];
+    unset($index[$sha256]);
+    $index[$sha256] = $filename;
+    $index = array_slice($index, -SHA256_INDEX_SIZE, null, true);
+    ftruncate($handle, 0);
+    rewind($handle);
+    fwrite($handle, json_encode($index));
+    fclose($handle);
+    return true;
+}
+
+/**
+ * JPEG images in a camera directory, without thumbnails
+ * 
+ * @param string $dir Camera directory
+ * @return array File paths
+ */
+function getImageFiles($dir) {
+    return array_values(array_filter(glob($dir . '/*.jpg') ?: [], function($file) {
+        return substr($file, -10) !== '_thumb.jpg';
+    }));
+}
+
 function getLatestImage($identifier) {
     $dir = getCameraDir($identifier);
     if (!is_dir($dir)) {
         return null;
     }
     
-    $files = glob($dir . '/*.jpg');
+    $files = getImageFiles($dir);
     if (empty($files)) {
         return null;
     }
@@ -118,15 +176,17 @@ function getCameraImages($identifier, $days = 14) {
         return [];
     }
     
-    $files = glob($dir . '/*.jpg');
+    $files = getImageFiles($dir);
     $cutoff = time() - ($days * 24 * 60 * 60);
     
     $images = [];
     foreach ($files as $file) {
         if (filemtime($file) >= $cutoff) {
+            $thumbFile = substr($file, 0, -4) . '_thumb.jpg';
             $images[] = [
                 'path' => $file,
                 'url' => baseUrl('images/' . basename(dirname($file)) . '/' . basename($file)),
+                'thumb_url' => file_exists($thumbFile) ? baseUrl('images/' . basename(dirname($file)) . '/' . basename($thumbFile)) : null,
                 'timestamp' => filemtime($file),
                 'size' => filesize($file)
             ];
@@ -200,7 +260,7 @@ function countCameraImages($identifier) {
         return 0;
     }
     
-    $files = glob($dir . '/*.jpg');
+    $files = getImageFiles($dir);
     return count($files);
 }
 
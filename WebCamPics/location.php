@@ -98,7 +98,7 @@ $cameraInfo = $displayCamera ? getCameraConfig($displayCamera) : null;
                 <?php foreach ($images as $image): ?>
                     <div class="gallery-item">
                         <a href="<?php echo htmlspecialchars($image['url']); ?>" target="_blank">
-                            <img src="<?php echo htmlspecialchars($image['url']); ?>" 
+                            <img src="<?php echo htmlspecialchars($image['thumb_url'] ?? $image['url']); ?>" 
                                  alt="Image from <?php echo date('Y-m-d H:i:s', $image['timestamp']); ?>"
                                  loading="lazy">
                         </a>
@@ -40,6 +40,7 @@ echo "Setting up directories..."
 mkdir -p images
 mkdir -p logs
 mkdir -p config
+mkdir -p uploads
 
 echo "Directories created ✓"
 
@@ -51,6 +52,7 @@ chmod 755 .
 chmod 755 images
 chmod 755 logs
 chmod 755 config
+chmod 755 uploads
 chmod 755 lib
 chmod 755 assets
 
@@ -0,0 +1,158 @@
+<?php
+/**
+ * Batch Image Upload Endpoint
+ * Receives several images in one multipart/form-data request, e.g. an ESP32
+ * draining its store-and-forward queue over a single connection.
+ *
+ * Parts (i = 0..n-1):
+ *   meta[i]   JSON: {"seq": 12, "timestamp": "YYYY-MM-DD HH:MM:SS", "crc32": "1a2b3c4d",
+ *                    "device_id": "...", "retries": 0, "capture_firmware": "1.3.16"}
+ *   image[i]  JPEG file
+ *
+ * Each item is validated and stored like a single upload.php request and gets
+ * its own status in the response; the request itself only fails (non-2xx)
+ * when authentication or the multipart body as a whole is invalid.
+ */
+
+header('Content-Type: application/json');
+
+require_once __DIR__ . '/lib/auth.php';
+require_once __DIR__ . '/lib/storage.php';
+require_once __DIR__ . '/lib/image.php';
+require_once __DIR__ . '/lib/ota.php';
+require_once __DIR__ . '/lib/logging.php';
+
+// Only accept POST requests
+if ($_SERVER['REQUEST_METHOD'] !== 'POST') {
+    http_response_code(405);
+    echo json_encode(['error' => 'Method not allowed']);
+    exit;
+}
+
+// Authenticate request (Bearer token, same as upload.php)
+if (!authenticateRequest()) {
+    http_response_code(401);
+    echo json_encode(['error' => 'Unauthorized']);
+    exit;
+}
+
+// Get device ID (MAC address); items may override it (gateway forwarding several cameras)
+$deviceId = getDeviceId();
+if (!$deviceId) {
+    http_response_code(400);
+    echo json_encode(['error' => 'Missing X-Device-ID header']);
+    exit;
+}
+
+if (!isset($_FILES['image']) || !is_array($_FILES['image']['name'])) {
+    http_response_code(400);
+    echo json_encode(['error' => 'No images received (expected image[i] parts)']);
+    exit;
+}
+
+$config = loadConfig();
+$maxSize = ($config['upload_max_size_mb'] ?? 5) * 1024 * 1024;
+$finfo = new finfo(FILEINFO_MIME_TYPE);
+
+/**
+ * Validate and store one batch item
+ * Returns the per-item result (status mirrors the HTTP code upload.php would send)
+ */
+function processBatchItem($file, $meta, $defaultDeviceId, $maxSize, $finfo) {
+    $result = ['seq' => $meta['seq'] ?? null];
+    $itemDeviceId = $meta['device_id'] ?? $defaultDeviceId;
+
+    if ($file['error'] !== UPLOAD_ERR_OK) {
+        return $result + ['status' => 400, 'error' => 'File upload failed: ' . $file['error']];
+    }
+
+    $imageData = file_get_contents($file['tmp_name']);
+    if ($imageData === false || empty($imageData)) {
+        return $result + ['status' => 400, 'error' => 'No image data received'];
+    }
+
+    $imageSize = strlen($imageData);
+    if ($imageSize > $maxSize) {
+        return $result + ['status' => 413, 'error' => 'Image too large'];
+    }
+
+    // End-to-end integrity of images stored on the camera's flash
+    if (isset($meta['crc32']) && strcasecmp(hash('crc32b', $imageData), $meta['crc32']) !== 0) {
+        return $result + ['status' => 422, 'error' => 'CRC mismatch'];
+    }
+
+    if ($finfo->buffer($imageData) !== 'image/jpeg') {
+        return $result + ['status' => 400, 'error' => 'Invalid image format. Only JPEG is accepted.'];
+    }
+
+    // Auto-create config entry for new cameras (hidden by default)
+    if (!cameraConfigExists($itemDeviceId)) {
+        createDefaultCameraConfig($itemDeviceId);
+    }
+
+    $timestamp = $meta['timestamp'] ?? null;
+    if ($timestamp === 'unknown') {
+        $timestamp = null;
+    }
+
+    $rawPath = saveImage($itemDeviceId, $imageData, $timestamp);
+    if (!$rawPath) {
+        return $result + ['status' => 500, 'error' => 'Failed to save image'];
+    }
+
+    $processedPath = processImage($rawPath, $itemDeviceId);
+    if (!$processedPath) {
+        return $result + ['status' => 500, 'error' => 'Failed to process image'];
+    }
+
+    logUpload("Image received from $itemDeviceId (batch)", [
+        'size' => $imageSize,
+        'filename' => basename($processedPath),
+        'retries' => $meta['retries'] ?? 0
+    ]);
+
+    return $result + [
+        'status' => 200,
+        'device_id' => $itemDeviceId,
+        'timestamp' => $timestamp ?? date('Y-m-d H:i:s'),
+        'size' => $imageSize,
+        'filename' => basename($processedPath)
+    ];
+}
+
+$results = [];
+$stored = 0;
+foreach ($_FILES['image']['name'] as $index => $name) {
+    $file = [
+        'name' => $name,
+        'tmp_name' => $_FILES['image']['tmp_name'][$index],
+        'error' => $_FILES['image']['error'][$index],
+    ];
+    $meta = json_decode($_POST['meta'][$index] ?? '{}', true) ?: [];
+
+    $result = processBatchItem($file, $meta, $deviceId, $maxSize, $finfo);
+    if ($result['status'] === 200) {
+        $stored++;
+    }
+    $results[] = $result;
+}
+
+// Update firmware version if provided
+$firmwareVersion = $_SERVER['HTTP_X_FIRMWARE_VERSION'] ?? null;
+if ($firmwareVersion) {
+    updateCameraFirmwareVersion($deviceId, $firmwareVersion);
+}
+
+logUpload("Batch from $deviceId", [
+    'items' => count($results),
+    'stored' => $stored
+]);
+
+// OTA offers stay with upload.php: the camera only acts on them after a live upload
+http_response_code(200);
+echo json_encode([
+    'success' => $stored === count($results),
+    'device_id' => $deviceId,
+    'stored' => $stored,
+    'results' => $results
+]);
@@ -0,0 +1,332 @@
+<?php
+/**
+ * Resumable Image Upload Endpoint
+ * Receives a large image in chunks, so a camera on a weak link continues a
+ * broken upload from the stored offset instead of sending the image again.
+ *
+ *   POST /upload-resumable.php
+ *        Open the session of an image. Headers as upload.php plus
+ *        X-Upload-Length (JPEG bytes) and X-Content-SHA256 (hex of the JPEG);
+ *        the body is the camera's thumbnail (optional). 201 for a new session,
+ *        200 with the stored offset when the image already has one.
+ *   GET  /upload-resumable.php?session=<id>
+ *        Stored offset of a session, 404 if unknown or expired.
+ *   PUT  /upload-resumable.php?session=<id>
+ *        Append the body at X-Upload-Offset. 409 with the stored offset on a
+ *        mismatch. The chunk that completes the image is verified and stored
+ *        like an upload.php request, and answered with its response.
+ *
+ * Session responses: {"session": "...", "offset": 131072, "length": 512000},
+ * a completed session adds the upload.php fields (success, filename, ota, ...).
+ * An image already stored (same SHA-256, see findImageBySha256) is complete
+ * when the session is opened, with "duplicate": true.
+ * Sessions are kept in uploads/ for UPLOAD_SESSION_MAX_AGE_SEC; the session ID
+ * derives from device and checksum, so the same image always maps to it.
+ */
+
+header('Content-Type: application/json');
+
+require_once __DIR__ . '/lib/auth.php';
+require_once __DIR__ . '/lib/storage.php';
+require_once __DIR__ . '/lib/image.php';
+require_once __DIR__ . '/lib/ota.php';
+require_once __DIR__ . '/lib/logging.php';
+
+define('UPLOAD_SESSION_MAX_AGE_SEC', 24 * 3600);
+
+// A lost connection ends php://input early; keep what arrived
+ignore_user_abort(true);
+
+$method = $_SERVER['REQUEST_METHOD'];
+if (!in_array($method, ['POST', 'GET', 'PUT'], true)) {
+    http_response_code(405);
+    echo json_encode(['error' => 'Method not allowed']);
+    exit;
+}
+
+// Authenticate request (Bearer token, same as upload.php)
+if (!authenticateRequest()) {
+    http_response_code(401);
+    echo json_encode(['error' => 'Unauthorized']);
+    exit;
+}
+
+// Get device ID (MAC address)
+$deviceId = getDeviceId();
+if (!$deviceId) {
+    http_response_code(400);
+    echo json_encode(['error' => 'Missing X-Device-ID header']);
+    exit;
+}
+
+/**
+ * Paths of a session: meta JSON, received JPEG bytes, thumbnail
+ */
+function uploadSessionPaths($sessionId) {
+    $base = __DIR__ . '/uploads/' . $sessionId;
+    return [$base . '.json', $base . '.part', $base . '.thumb'];
+}
+
+/**
+ * Session meta of this device, or null (unknown, expired or another device's)
+ */
+function loadUploadSession($sessionId, $deviceId) {
+    if (!is_string($sessionId) || !preg_match('/^[0-9a-f]{32}$/', $sessionId)) {
+        return null;
+    }
+    [$metaPath] = uploadSessionPaths($sessionId);
+    $meta = is_file($metaPath) ? json_decode(file_get_contents($metaPath), true) : null;
+    if (!is_array($meta) || sanitizeCameraIdentifier($meta['device_id']) !== sanitizeCameraIdentifier($deviceId)) {
+        return null;
+    }
+    if (time() - $meta['created'] > UPLOAD_SESSION_MAX_AGE_SEC) {
+        dropUploadSession($sessionId);
+        return null;
+    }
+    return $meta;
+}
+
+function saveUploadSession($sessionId, $meta) {
+    [$metaPath] = uploadSessionPaths($sessionId);
+    return file_put_contents($metaPath, json_encode($meta), LOCK_EX) !== false;
+}
+
+function dropUploadSession($sessionId) {
+    foreach (uploadSessionPaths($sessionId) as $path) {
+        if (is_file($path)) {
+            unlink($path);
+        }
+    }
+}
+
+/**
+ * Stored offset; a completed session repeats its upload.php result
+ */
+function uploadSessionState($sessionId, $meta) {
+    [, $partPath] = uploadSessionPaths($sessionId);
+    clearstatcache(true, $partPath);
+    $offset = isset($meta['result']) ? $meta['length'] : (is_file($partPath) ? filesize($partPath) : 0);
+    return array_merge($meta['result'] ?? [], [
+        'session' => $sessionId,
+        'offset' => $offset,
+        'length' => $meta['length']
+    ]);
+}
+
+/**
+ * Remove sessions older than UPLOAD_SESSION_MAX_AGE_SEC (abandoned uploads)
+ */
+function cleanupUploadSessions() {
+    foreach (glob(__DIR__ . '/uploads/*.json') ?: [] as $metaPath) {
+        if (time() - filemtime($metaPath) > UPLOAD_SESSION_MAX_AGE_SEC) {
+            dropUploadSession(basename($metaPath, '.json'));
+        }
+    }
+}
+
+function sendJson($status, $data) {
+    http_response_code($status);
+    echo json_encode($data);
+    exit;
+}
+
+// ============================================================================
+// POST: open a session
+// ============================================================================
+
+if ($method === 'POST') {
+    $config = loadConfig();
+    $maxSize = ($config['upload_max_size_mb'] ?? 5) * 1024 * 1024;
+
+    // Auto-create config entry for new cameras (disabled by default)
+    if (!cameraConfigExists($deviceId)) {
+        createDefaultCameraConfig($deviceId);
+    }
+    $cameraConfig = getCameraConfig($deviceId);
+    if (($cameraConfig['status'] ?? 'enabled') === 'disabled') {
+        sendJson(403, ['error' => 'Camera disabled']);
+    }
+
+    $length = (int)(getHeaderCaseInsensitive('X-Upload-Length') ?? 0);
+    $sha256 = strtolower(getHeaderCaseInsensitive('X-Content-SHA256') ?? '');
+    if ($length <= 0 || !preg_match('/^[0-9a-f]{64}$/', $sha256)) {
+        sendJson(400, ['error' => 'Missing X-Upload-Length or X-Content-SHA256 header']);
+    }
+    if ($length > $maxSize) {
+        sendJson(413, ['error' => 'Image too large']);
+    }
+
+    $sessionId = substr(hash('sha256', sanitizeCameraIdentifier($deviceId) . ':' . $sha256), 0, 32);
+
+    // Stored before (by any endpoint): complete without a single chunk
+    $duplicateOf = findImageBySha256($deviceId, $sha256);
+    if ($duplicateOf) {
+        logUpload("Duplicate image from $deviceId", [
+            'filename' => $duplicateOf,
+            'sha256' => $sha256
+        ]);
+        sendJson(200, [
+            'success' => true,
+            'device_id' => $deviceId,
+            'timestamp' => getTimestamp() ?? date('Y-m-d H:i:s'),
+            'duplicate' => true,
+            'filename' => $duplicateOf,
+            'server_time' => time(),
+            'ota' => buildOtaOffer($deviceId, ' (resumable upload)'),
+            'session' => $sessionId,
+            'offset' => $length,
+            'length' => $length
+        ]);
+    }
+
+    $meta = loadUploadSession($sessionId, $deviceId);
+    if ($meta) {
+        sendJson(200, uploadSessionState($sessionId, $meta));
+    }
+
+    $sessionsDir = __DIR__ . '/uploads';
+    if (!is_dir($sessionsDir)) {
+        mkdir($sessionsDir, 0755, true);
+    }
+    cleanupUploadSessions();
+
+    [, $partPath, $thumbPath] = uploadSessionPaths($sessionId);
+    $meta = [
+        'device_id' => $deviceId,
+        'length' => $length,
+        'sha256' => $sha256,
+        'created' => time(),
+        'timestamp' => getTimestamp(),
+        'firmware' => $_SERVER['HTTP_X_FIRMWARE_VERSION'] ?? null,
+        'wake_timing' => parseWakeTiming($_SERVER['HTTP_X_WAKE_TIMING'] ?? null)
+    ];
+    if (file_put_contents($partPath, '') === false || !saveUploadSession($sessionId, $meta)) {
+        sendJson(500, ['error' => 'Failed to create upload session']);
+    }
+
+    // Thumbnail rides along with the session, stored with the image at the end
+    if ((int)($_SERVER['CONTENT_LENGTH'] ?? 0) <= 256 * 1024) {
+        $thumbnailData = file_get_contents('php://input');
+        if ($thumbnailData && substr($thumbnailData, 0, 2) === "\xFF\xD8") {
+            file_put_contents($thumbPath, $thumbnailData);
+        }
+    }
+
+    sendJson(201, uploadSessionState($sessionId, $meta));
+}
+
+// ============================================================================
+// GET / PUT: session of the query string
+// ============================================================================
+
+$sessionId = $_GET['session'] ?? '';
+$meta = loadUploadSession($sessionId, $deviceId);
+if (!$meta) {
+    sendJson(404, ['error' => 'Unknown upload session']);
+}
+
+if ($method === 'GET') {
+    sendJson(200, uploadSessionState($sessionId, $meta));
+}
+
+// PUT: append the chunk, under a lock so a retried request cannot interleave
+[, $partPath, $thumbPath] = uploadSessionPaths($sessionId);
+$chunkLength = (int)($_SERVER['CONTENT_LENGTH'] ?? 0);
+$offset = (int)(getHeaderCaseInsensitive('X-Upload-Offset') ?? -1);
+
+$part = fopen($partPath, 'ab');
+if (!$part || !flock($part, LOCK_EX)) {
+    sendJson(500, ['error' => 'Failed to open upload session']);
+}
+$state = uploadSessionState($sessionId, $meta);
+if (isset($meta['result'])) {
+    sendJson(200, $state);
+}
+if ($offset !== $state['offset'] || $offset + $chunkLength > $meta['length']) {
+    sendJson(409, $state);
+}
+
+// A broken connection leaves a prefix of the chunk, the camera continues after it
+$input = fopen('php://input', 'rb');
+stream_copy_to_stream($input, $part, $chunkLength);
+fclose($input);
+fflush($part);
+
+$state = uploadSessionState($sessionId, $meta);
+if ($state['offset'] < $meta['length']) {
+    sendJson(200, $state);
+}
+
+// Complete: verify and store like upload.php
+if (!hash_equals($meta['sha256'], hash_file('sha256', $partPath))) {
+    dropUploadSession($sessionId);
+    sendJson(422, ['error' => 'Checksum mismatch']);
+}
+$imageData = file_get_contents($partPath);
+
+// Check if it's a valid JPEG
+$finfo = new finfo(FILEINFO_MIME_TYPE);
+if ($finfo->buffer($imageData) !== 'image/jpeg') {
+    dropUploadSession($sessionId);
+    sendJson(400, ['error' => 'Invalid image format. Only JPEG is accepted.']);
+}
+
+// Save raw image and process it (rotate, add text, etc.)
+$rawPath = saveImage($deviceId, $imageData, $meta['timestamp']);
+$processedPath = $rawPath ? processImage($rawPath, $deviceId) : false;
+if (!$processedPath) {
+    dropUploadSession($sessionId);
+    sendJson(500, ['error' => $rawPath ? 'Failed to process image' : 'Failed to save image']);
+}
+
+$thumbnailData = is_file($thumbPath) ? file_get_contents($thumbPath) : null;
+$thumbnailPath = $thumbnailData ? saveThumbnail($processedPath, $thumbnailData, $deviceId) : false;
+rememberImageSha256($deviceId, $meta['sha256'], basename($processedPath));
+
+// Log the upload (wake-cycle stage breakdown as with upload.php)
+$uploadContext = [
+    'size' => strlen($imageData),
+    'filename' => basename($processedPath)
+];
+if ($thumbnailPath) {
+    $uploadContext['thumbnail_size'] = strlen($thumbnailData);
+}
+if ($meta['wake_timing']) {
+    $uploadContext['firmware'] = $meta['firmware'];
+    $uploadContext['wake_timing'] = $meta['wake_timing'];
+}
+logUpload("Image received from $deviceId (resumable)", $uploadContext);
+
+$response = [
+    'success' => true,
+    'device_id' => $deviceId,
+    'timestamp' => $meta['timestamp'] ?? date('Y-m-d H:i:s'),
+    'size' => strlen($imageData),
+    'filename' => basename($processedPath)
+];
+if ($thumbnailPath) {
+    $response['thumbnail'] = basename($thumbnailPath);
+}
+
+// Server clock, lets the camera detect RTC drift between NTP syncs
+$response['server_time'] = time();
+
+// Update firmware version if provided
+$firmwareVersion = $_SERVER['HTTP_X_FIRMWARE_VERSION'] ?? null;
+if ($firmwareVersion) {
+    updateCameraFirmwareVersion($deviceId, $firmwareVersion);
+}
+
+// Check for OTA schedule
+$response['ota'] = buildOtaOffer($deviceId, ' (resumable upload)');
+
+// Keep the result, so a camera that missed this answer learns it from GET
+$meta['result'] = $response;
+saveUploadSession($sessionId, $meta);
+foreach ([$partPath, $thumbPath] as $path) {
+    if (is_file($path)) {
+        unlink($path);
+    }
+}
+
+sendJson(200, array_merge($response, ['session' => $sessionId, 'offset' => $meta['length'], 'length' => $meta['length']]));
@@ -112,62 +112,7 @@ if (isset($_POST['auth']) && isset($_POST['cam']) && isset($_FILES['pic'])) {
     ];
     
     // Check for OTA schedule
-    $otaInfo = getOtaSchedule($deviceId);
-    if ($otaInfo) {
-        $response['ota'] = [
-            'available' => true,
-            'firmware_file' => $otaInfo['filename'],
-            'firmware_version' => $otaInfo['version'],
-            'download_url' => baseUrl('ota-download.php?file=' . urlencode($otaInfo['filename'])),
-            'size' => $otaInfo['size'],
-            'sha256' => $otaInfo['sha256'],
-            'mandatory' => false
-        ];
-        
-        // Update OTA status to "pending"
-        updateOtaStatus($deviceId, 'pending', null, null);
-        
-        // Log OTA offered (legacy API)
-        $cameras = loadCamerasConfig();
-        $retryCount = 0;
-        foreach ($cameras as $key => $camera) {
-            $cameraId = $camera['device_id'] ?? $camera['mac'] ?? '';
-            if (strtoupper(str_replace(['-', ':', ' '], '', $cameraId)) === strtoupper(str_replace(['-', ':', ' '], '', $deviceId))) {
-                $retryCount = $camera['ota_retry_count'] ?? 0;
-                break;
-            }
-        }
-        logOta("OTA offered to $deviceId (legacy upload)", [
-            'firmware_file' => $otaInfo['filename'],
-            'version' => $otaInfo['version'],
-            'size' => $otaInfo['size'],
-            'retry_count' => $retryCount
-        ]);
-    } else {
-        $response['ota'] = ['available' => false];
-        
-        // Log why OTA was not offered
-        $cameras = loadCamerasConfig();
-        foreach ($cameras as $key => $camera) {
-            $cameraId = $camera['device_id'] ?? $camera['mac'] ?? '';
-            if (strtoupper(str_replace(['-', ':', ' '], '', $cameraId)) === strtoupper(str_replace(['-', ':', ' '], '', $deviceId))) {
-                if (!empty($camera['ota_scheduled'])) {
-                    $retryCount = $camera['ota_retry_count'] ?? 0;
-                    if ($retryCount >= 2) {
-                        logOta("OTA NOT offered to $deviceId: retry limit reached (legacy upload)", [
-                            'scheduled_firmware' => $camera['ota_scheduled'],
-                            'retry_count' => $retryCount
-                        ], LOG_LEVEL_WARN);
-                    } else {
-                        logOta("OTA NOT offered to $deviceId: firmware file validation failed (legacy upload)", [
-                            'scheduled_firmware' => $camera['ota_scheduled']
-                        ], LOG_LEVEL_ERROR);
-                    }
-                }
-                break;
-            }
-        }
-    }
+    $response['ota'] = buildOtaOffer($deviceId, ' (legacy upload)');
     
     // Return success response (JSON format)
     http_response_code(200);
@@ -198,55 +143,167 @@ if (!cameraConfigExists($deviceId)) {
 // Get timestamp from header
 $timestamp = getTimestamp();
 
-// Get image data from POST body
-$imageData = file_get_contents('php://input');
-if (empty($imageData)) {
+// Wake-cycle stage breakdown of scheduled captures
+$wakeTiming = parseWakeTiming($_SERVER['HTTP_X_WAKE_TIMING'] ?? null);
+
+// SHA-256 of the JPEG (X-Content-SHA256, optional): the body is verified
+// against it, and an image stored before is not stored again
+$contentSha256 = strtolower($_SERVER['HTTP_X_CONTENT_SHA256'] ?? '');
+if ($contentSha256 !== '' && !preg_match('/^[0-9a-f]{64}$/', $contentSha256)) {
     http_response_code(400);
-    echo json_encode(['error' => 'No image data received']);
+    echo json_encode(['error' => 'Invalid X-Content-SHA256 header']);
     exit;
 }
+$duplicateOf = $contentSha256 !== '' ? findImageBySha256($deviceId, $contentSha256) : null;
 
-// Validate image size
-$imageSize = strlen($imageData);
-$config = loadConfig();
-$maxSize = ($config['upload_max_size_mb'] ?? 5) * 1024 * 1024;
+// Scene unchanged since the camera's last image (EspCamPicPusher scene change
+// detection): no body and nothing to store, the camera only checks in
+$captureStatus = strtolower($_SERVER['HTTP_X_CAPTURE_STATUS'] ?? '');
 
-if ($imageSize > $maxSize) {
-    http_response_code(413);
-    echo json_encode(['error' => 'Image too large']);
-    exit;
-}
+if ($captureStatus === 'unchanged') {
+    $heartbeatContext = [
+        'scene_distance' => substr($_SERVER['HTTP_X_SCENE_DISTANCE'] ?? '', 0, 64)
+    ];
+    if ($wakeTiming) {
+        $heartbeatContext['firmware'] = $_SERVER['HTTP_X_FIRMWARE_VERSION'] ?? null;
+        $heartbeatContext['wake_timing'] = $wakeTiming;
+    }
+    logUpload("Heartbeat from $deviceId (scene unchanged)", $heartbeatContext);
+    
+    $response = [
+        'success' => true,
+        'device_id' => $deviceId,
+        'timestamp' => $timestamp ?? date('Y-m-d H:i:s'),
+        'unchanged' => true
+    ];
+} elseif ($duplicateOf) {
+    // Re-sent after a lost answer (timeout and retry, or from the camera's
+    // queue): PHP has read the body already, only the second copy is avoided.
+    // upload-resumable.php answers a known image before any of it is sent
+    logUpload("Duplicate image from $deviceId", [
+        'filename' => $duplicateOf,
+        'sha256' => $contentSha256
+    ]);
+    
+    $response = [
+        'success' => true,
+        'device_id' => $deviceId,
+        'timestamp' => $timestamp ?? date('Y-m-d H:i:s'),
+        'duplicate' => true,
+        'filename' => $duplicateOf
+    ];
+} else {
+    $config = loadConfig();
+    $maxSize = ($config['upload_max_size_mb'] ?? 5) * 1024 * 1024;
 
-// Check if it's a valid JPEG
-$finfo = new finfo(FILEINFO_MIME_TYPE);
-$mimeType = $finfo->buffer($imageData);
-if ($mimeType !== 'image/jpeg') {
-    http_response_code(400);
-    echo json_encode(['error' => 'Invalid image format. Only JPEG is accepted.']);
-    exit;
-}
+    // Checks that need no image data. PHP has read the request body before
+    // this script runs, so the camera has sent it anyway; a camera turned
+    // away here opens a resumable session (no image bytes) for its next one
+    $cameraConfig = getCameraConfig($deviceId);
+    if (($cameraConfig['status'] ?? 'enabled') === 'disabled') {
+        http_response_code(403);
+        echo json_encode(['error' => 'Camera disabled']);
+        exit;
+    }
+    if (!isset($_FILES['image']) && (int)($_SERVER['CONTENT_LENGTH'] ?? 0) > $maxSize) {
+        http_response_code(413);
+        echo json_encode(['error' => 'Image too large']);
+        exit;
+    }
 
-// Save raw image
-$rawPath = saveImage($deviceId, $imageData, $timestamp);
-if (!$rawPath) {
-    http_response_code(500);
-    echo json_encode(['error' => 'Failed to save image']);
-    exit;
-}
+    // Get image data: multipart/form-data with the camera's thumbnail, or the raw POST body
+    $thumbnailData = null;
+    if (isset($_FILES['image'])) {
+        $imageData = $_FILES['image']['error'] === UPLOAD_ERR_OK ? file_get_contents($_FILES['image']['tmp_name']) : '';
+        if (isset($_FILES['thumbnail']) && $_FILES['thumbnail']['error'] === UPLOAD_ERR_OK) {
+            $thumbnailData = file_get_contents($_FILES['thumbnail']['tmp_name']);
+        }
+    } else {
+        $imageData = file_get_contents('php://input');
+    }
+    if (empty($imageData)) {
+        http_response_code(400);
+        echo json_encode(['error' => 'No image data received']);
+        exit;
+    }
 
-// Process image (rotate, add text, etc.)
-$processedPath = processImage($rawPath, $deviceId);
-if (!$processedPath) {
-    http_response_code(500);
-    echo json_encode(['error' => 'Failed to process image']);
-    exit;
+    // Validate image size
+    $imageSize = strlen($imageData);
+    if ($imageSize > $maxSize) {
+        http_response_code(413);
+        echo json_encode(['error' => 'Image too large']);
+        exit;
+    }
+
+    // A body cut short (or altered) on the way is refused, not stored
+    if ($contentSha256 !== '' && !hash_equals($contentSha256, hash('sha256', $imageData))) {
+        http_response_code(422);
+        echo json_encode(['error' => 'Checksum mismatch']);
+        exit;
+    }
+
+    // Check if it's a valid JPEG
+    $finfo = new finfo(FILEINFO_MIME_TYPE);
+    $mimeType = $finfo->buffer($imageData);
+    if ($mimeType !== 'image/jpeg') {
+        http_response_code(400);
+        echo json_encode(['error' => 'Invalid image format. Only JPEG is accepted.']);
+        exit;
+    }
+
+    // Save raw image
+    $rawPath = saveImage($deviceId, $imageData, $timestamp);
+    if (!$rawPath) {
+        http_response_code(500);
+        echo json_encode(['error' => 'Failed to save image']);
+        exit;
+    }
+
+    // Process image (rotate, add text, etc.)
+    $processedPath = processImage($rawPath, $deviceId);
+    if (!$processedPath) {
+        http_response_code(500);
+        echo json_encode(['error' => 'Failed to process image']);
+        exit;
+    }
+
+    // Store the camera's thumbnail as is, so the gallery does not need to make one
+    $thumbnailPath = $thumbnailData ? saveThumbnail($processedPath, $thumbnailData, $deviceId) : false;
+
+    if ($contentSha256 !== '') {
+        rememberImageSha256($deviceId, $contentSha256, basename($processedPath));
+    }
+    
+    // Log the upload (with the wake-cycle stage breakdown of scheduled captures,
+    // aggregated by EspCamPicPusher/tools/wake_timing_report.py)
+    $uploadContext = [
+        'size' => $imageSize,
+        'filename' => basename($processedPath)
+    ];
+    if ($thumbnailPath) {
+        $uploadContext['thumbnail_size'] = strlen($thumbnailData);
+    }
+    if ($wakeTiming) {
+        $uploadContext['firmware'] = $_SERVER['HTTP_X_FIRMWARE_VERSION'] ?? null;
+        $uploadContext['wake_timing'] = $wakeTiming;
+    }
+    logUpload("Image received from $deviceId", $uploadContext);
+
+    // Build success response
+    $response = [
+        'success' => true,
+        'device_id' => $deviceId,
+        'timestamp' => $timestamp ?? date('Y-m-d H:i:s'),
+        'size' => $imageSize,
+        'filename' => basename($processedPath)
+    ];
+    if ($thumbnailPath) {
+        $response['thumbnail'] = basename($thumbnailPath);
+    }
 }
 
-// Log the upload
-logUpload("Image received from $deviceId", [
-    'size' => $imageSize,
-    'filename' => basename($processedPath)
-]);
+// Server clock, lets the camera detect RTC drift between NTP syncs
+$response['server_time'] = time();
 
 // Update firmware version if provided
 $firmwareVersion = $_SERVER['HTTP_X_FIRMWARE_VERSION'] ?? null;
@@ -254,72 +311,8 @@ if ($firmwareVersion) {
     updateCameraFirmwareVersion($deviceId, $firmwareVersion);
 }
 
-// Build success response
-$response = [
-    'success' => true,
-    'device_id' => $deviceId,
-    'timestamp' => $timestamp ?? date('Y-m-d H:i:s'),
-    'size' => $imageSize,
-    'filename' => basename($processedPath)
-];
-
 // Check for OTA schedule
-$otaInfo = getOtaSchedule($deviceId);
-if ($otaInfo) {
-    $response['ota'] = [
-        'available' => true,
-        'firmware_file' => $otaInfo['filename'],
-        'firmware_version' => $otaInfo['version'],
-        'download_url' => baseUrl('ota-download.php?file=' . urlencode($otaInfo['filename'])),
-        'size' => $otaInfo['size'],
-        'sha256' => $otaInfo['sha256'],
-        'mandatory' => false
-    ];
-    
-    // Update OTA status to "pending"
-    updateOtaStatus($deviceId, 'pending', null, null);
-    
-    // Log OTA offered
-    $cameras = loadCamerasConfig();
-    $retryCount = 0;
-    foreach ($cameras as $key => $camera) {
-        $cameraId = $camera['device_id'] ?? $camera['mac'] ?? '';
-        if (strtoupper(str_replace(['-', ':', ' '], '', $cameraId)) === strtoupper(str_replace(['-', ':', ' '], '', $deviceId))) {
-            $retryCount = $camera['ota_retry_count'] ?? 0;
-            break;
-        }
-    }
-    logOta("OTA offered to $deviceId", [
-        'firmware_file' => $otaInfo['filename'],
-        'version' => $otaInfo['version'],
-        'size' => $otaInfo['size'],
-        'retry_count' => $retryCount
-    ]);
-} else {
-    $response['ota'] = ['available' => false];
-    
-    // Log why OTA was not offered
-    $cameras = loadCamerasConfig();
-    foreach ($cameras as $key => $camera) {
-        $cameraId = $camera['device_id'] ?? $camera['mac'] ?? '';
-        if (strtoupper(str_replace(['-', ':', ' '], '', $cameraId)) === strtoupper(str_replace(['-', ':', ' '], '', $deviceId))) {
-            if (!empty($camera['ota_scheduled'])) {
-                $retryCount = $camera['ota_retry_count'] ?? 0;
-                if ($retryCount >= 2) {
-                    logOta("OTA NOT offered to $deviceId: retry limit reached", [
-                        'scheduled_firmware' => $camera['ota_scheduled'],
-                        'retry_count' => $retryCount
-                    ], LOG_LEVEL_WARN);
-                } else {
-                    logOta("OTA NOT offered to $deviceId: firmware file validation failed", [
-                        'scheduled_firmware' => $camera['ota_scheduled']
-                    ], LOG_LEVEL_ERROR);
-                }
-            }
-            break;
-        }
-    }
-}
+$response['ota'] = buildOtaOffer($deviceId);
 
 // Return success response
 http_response_code(200);